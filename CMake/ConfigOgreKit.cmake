@@ -42,6 +42,7 @@ macro (configure_ogrekit ROOT OGREPATH OGRE_BACKEND)
 	option(OGREKIT_USE_STATIC_FREEIMAGE		"Compile and link statically FreeImage and all its plugins" ON)	
 	option(OGREKIT_MINIMAL_FREEIMAGE_CODEC	"Compile minimal FreeImage Codec(PNG/JPEG/TGA)" OFF)
 	option(OGREKIT_ENABLE_UNITTESTS			"Enable / Disable UnitTests" OFF)
+	option(OGREKIT_ENABLE_BENCHMARKS		"Enable / Disable scene update benchmarks" OFF)
 	#option(OGREKIT_USE_FILETOOLS			"Compile FBT file format utilities" ON)
 	# CAUTION: As of the blender 2.63-update bparse do not work for the moment! So set FBT as default for now
 	option(OGREKIT_USE_BPARSE				"Compile bParse file format utilities" OFF) #FBT alternative 
@@ -53,6 +54,7 @@ macro (configure_ogrekit ROOT OGREPATH OGRE_BACKEND)
 	option(OGREKIT_COMPILE_OPENSTEER		"Enable / Disable OpenSteer build" OFF)
 	option(OGREKIT_USE_PROCESSMANAGER       "Enable / Disable ProcessManager build" ON)
 	option(OGREKIT_COMPILE_SOFTBODY			"Enable / Disable Bullet Softbody build" OFF)
+	option(OGREKIT_COMPILE_BULLET_MULTITHREADED	"Enable / Disable Bullet threaded dispatcher and solver build" OFF)
 	option(OGREKIT_USE_NNODE				"Use Logic Node (It's Nodal Logic, not Blender LogicBrick)" OFF)
 	option(OGREKIT_USE_PARTICLE				"Use Paritcle" ON)
 	option(OGREKIT_COMPILE_OGRE_COMPONENTS	"Enable compile additional Ogre components (RTShader, Terrain, Paging, ... etc)" OFF)
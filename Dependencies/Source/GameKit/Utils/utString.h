@@ -219,8 +219,8 @@ public:
 		return m_hash;
 	}
 
-	UT_INLINE bool operator== (const utHashedString &v) const    {return hash() == v.hash();}
-	UT_INLINE bool operator!= (const utHashedString &v) const    {return hash() != v.hash();}
+	UT_INLINE bool operator== (const utHashedString &v) const    {return hash() == v.hash() && m_key == v.m_key;}
+	UT_INLINE bool operator!= (const utHashedString &v) const    {return !(*this == v);}
 	UT_INLINE bool operator== (const UThash &v) const            {return hash() == v;}
 	UT_INLINE bool operator!= (const UThash &v) const            {return hash() != v;}
 
@@ -29,6 +29,7 @@
 
 #include "utCommon.h"
 #include <memory.h>
+#include <string.h>
 
 
 #define _UT_CACHE_LIMIT 999
@@ -1059,8 +1060,11 @@ public:
 		return m_hash;
 	}
 
-	UT_INLINE bool operator== (const utCharHashKey &v) const    {return hash() == v.hash();}
-	UT_INLINE bool operator!= (const utCharHashKey &v) const    {return hash() != v.hash();}
+	UT_INLINE bool operator== (const utCharHashKey &v) const
+	{
+		return hash() == v.hash() && (m_key == v.m_key || (m_key && v.m_key && !strcmp(m_key, v.m_key)));
+	}
+	UT_INLINE bool operator!= (const utCharHashKey &v) const    {return !(*this == v);}
 	UT_INLINE bool operator== (const UThash &v) const           {return hash() == v;}
 	UT_INLINE bool operator!= (const UThash &v) const           {return hash() != v;}
 };
@@ -1077,8 +1081,8 @@ public:
 	UT_INLINE UTint32 key(void)  const  { return m_key; }
 	UT_INLINE UThash  hash(void) const  { return static_cast<UThash>(m_key) * _UT_INITIAL_FNV; }
 
-	UT_INLINE bool operator== (const utIntHashKey &v) const {return hash() == v.hash();}
-	UT_INLINE bool operator!= (const utIntHashKey &v) const {return hash() != v.hash();}
+	UT_INLINE bool operator== (const utIntHashKey &v) const {return m_key == v.m_key;}
+	UT_INLINE bool operator!= (const utIntHashKey &v) const {return m_key != v.m_key;}
 	UT_INLINE bool operator== (const UThash &v) const       {return hash() == v;}
 	UT_INLINE bool operator!= (const UThash &v) const       {return hash() != v;}
 };
@@ -1105,8 +1109,8 @@ public:
 	}
 
 
-	UT_INLINE bool operator== (const utPointerHashKey &v) const {return hash() == v.hash();}
-	UT_INLINE bool operator!= (const utPointerHashKey &v) const {return hash() != v.hash();}
+	UT_INLINE bool operator== (const utPointerHashKey &v) const {return m_key == v.m_key;}
+	UT_INLINE bool operator!= (const utPointerHashKey &v) const {return m_key != v.m_key;}
 	UT_INLINE bool operator== (const UThash &v) const           {return hash() == v;}
 	UT_INLINE bool operator!= (const UThash &v) const           {return hash() != v;}
 };
@@ -1131,25 +1135,21 @@ struct utHashEntry
 	}
 };
 
-#define _UT_UTHASHTABLE_HASH(key)   ((key.hash() & (m_capacity - 1)))
-#define _UT_UTHASHTABLE_HKHASH(key) ((hk & (m_capacity - 1)))
 // Initial table size
 #define _UT_UTHASHTABLE_INIT     32
 #define _UT_UTHASHTABLE_EXPANSE  (m_size * 2)
 
-// Force power of two table size.
-#define _UT_UTHASHTABLE_FORCE_POW2 1
+// Probe slots per entry, keeps the load factor at or below 1/2.
+#define _UT_UTHASHTABLE_SLOTS    2
 #define _UT_UTHASHTABLE_STAT       0
 #define _UT_UTHASHTABLE_STAT_ALLOC 0
 
 
-#if _UT_UTHASHTABLE_FORCE_POW2 == 1
 #define _UT_UTHASHTABLE_POW2(x) \
 	--x; x |= x >> 16; x |= x >> 8; x |= x >> 4; \
 	x |= x >> 2; x |= x >> 1; ++x;
 
 #define _UT_UTHASHTABLE_IS_POW2(x) (x && !((x-1) & x))
-#endif
 
 
 #if _UT_UTHASHTABLE_STAT == 1
@@ -1158,6 +1158,11 @@ struct utHashEntry
 #endif
 
 
+// Entries are stored densely in insertion order (removal moves the last
+// entry into the hole), so ptr(), at() and the iterators walk a flat array.
+// Lookups go through a separate open addressed index of (hash, entry) slots
+// using linear probing. Deletion shifts the following cluster back instead
+// of leaving tombstones, so probe lengths never degrade.
 template < typename Key, typename Value>
 class utHashTable
 {
@@ -1188,24 +1193,37 @@ public:
 	typedef utHashTableIterator<utHashTable<Key, Value> > Iterator;
 	typedef const utHashTableIterator<utHashTable<Key, Value> > ConstIterator;
 
+private:
+
+	// Truncated hash, compared before touching the entry array.
+	struct Slot
+	{
+		UTuint32 hash;
+		UTuint32 index;
+	};
+
+	typedef Slot *SlotArray;
+
+	enum { EMPTY = 0xFFFFFFFF };
 
 public:
 
 	utHashTable()
-		:    m_size(0), m_capacity(0), m_lastPos(UT_NPOS),
-		     m_iptr(0), m_nptr(0), m_bptr(0), m_cache(0)
+		:    m_size(0), m_capacity(0), m_mask(0), m_lastPos(UT_NPOS), m_lastKey(UT_NPOS),
+		     m_slots(0), m_bptr(0), m_cache(0)
 	{
 	}
 
 	utHashTable(UTsize capacity)
-		:    m_size(0), m_capacity(0), m_lastPos(UT_NPOS),
-		     m_iptr(0), m_nptr(0), m_bptr(0), m_cache(0)
+		:    m_size(0), m_capacity(0), m_mask(0), m_lastPos(UT_NPOS), m_lastKey(UT_NPOS),
+		     m_slots(0), m_bptr(0), m_cache(0)
 	{
+		reserve(capacity);
 	}
 
 	utHashTable(const utHashTable &rhs)
-		:    m_size(0), m_capacity(0), m_lastPos(UT_NPOS),
-		     m_iptr(0), m_nptr(0), m_bptr(0), m_cache(0)
+		:    m_size(0), m_capacity(0), m_mask(0), m_lastPos(UT_NPOS), m_lastKey(UT_NPOS),
+		     m_slots(0), m_bptr(0), m_cache(0)
 	{
 		doCopy(rhs);
 	}
@@ -1221,42 +1239,42 @@ public:
 
 	void clear(bool useCache = false)
 	{
+		m_lastKey = UT_NPOS;
+		m_lastPos = UT_NPOS;
+
 		if (!useCache)
 		{
-			m_size = m_capacity = 0;
-			m_lastKey = UT_NPOS;
-			m_lastPos = UT_NPOS;
+			m_size = m_capacity = m_mask = 0;
 			m_cache = 0;
 
 			delete [] m_bptr;
-			delete [] m_iptr;
-			delete [] m_nptr;
-			m_bptr = 0; m_iptr = 0; m_nptr = 0;
+			delete [] m_slots;
+			m_bptr = 0; m_slots = 0;
 		}
 		else
 		{
 			++m_cache;
 			if (m_cache > _UT_CACHE_LIMIT)
 				clear(false);
-			else
+			else if (m_slots)
 			{
-				m_size = 0;
-				m_lastKey = UT_NPOS;
-				m_lastPos = UT_NPOS;
-
-
-				UTsize i;
-
-				// Must zero 
-				for (i=0; i<m_capacity; ++i)
+				// Sparse tables only visit the slots in use.
+				UTsize i, nr = m_mask + 1;
+				if (m_size * 4 < nr)
+				{
+					for (i = 0; i < m_size; ++i)
+						m_slots[slotOf(m_bptr[i].first.hash(), i)].index = EMPTY;
+				}
+				else
 				{
-					m_iptr[i] = UT_NPOS;
-					m_nptr[i] = UT_NPOS;
+					for (i = 0; i < nr; ++i)
+						m_slots[i].index = EMPTY;
 				}
+				m_size = 0;
 			}
 		}
-
 	}
+
 	Value              &at(UTsize i)                    { UT_ASSERT(m_bptr && i >= 0 && i < m_size); return m_bptr[i].second; }
 	Value              &operator [](UTsize i)           { UT_ASSERT(m_bptr && i >= 0 && i < m_size); return m_bptr[i].second; }
 	const Value        &at(UTsize i)const               { UT_ASSERT(m_bptr && i >= 0 && i < m_size); return m_bptr[i].second; }
@@ -1268,25 +1286,16 @@ public:
 	// Find and cache key
 	Value* get(const Key &key)
 	{
-		if (!m_bptr || m_size == 0)
-			return (Value*)0;
-
-
-		UThash hr = key.hash();
-
-		if (m_lastKey != hr)
-		{
-			UTsize i = find(key);
-			if (i == UT_NPOS) return (Value*)0;
-
-
-			UT_ASSERT(i >=0 && i < m_size);
-
-			m_lastKey = hr;
-			m_lastPos = i;
-		}
+		UTsize i = find(key);
+		if (i == UT_NPOS) return (Value*)0;
+		return &m_bptr[i].second;
+	}
 
-		return &m_bptr[m_lastPos].second;
+	const Value* get(const Key &key) const
+	{
+		UTsize i = find(key);
+		if (i == UT_NPOS) return (const Value*)0;
+		return &m_bptr[i].second;
 	}
 
 
@@ -1295,33 +1304,24 @@ public:
 
 	UTsize find(const Key &key) const
 	{
-		if (m_capacity == 0 || m_capacity == UT_NPOS || m_size == 0)
+		if (m_size == 0)
 			return UT_NPOS;
 
-		UTsize hk = key.hash();
+		UThash hk = key.hash();
 
 		// Short cut.
-		if (m_lastPos != UT_NPOS && m_lastKey == hk)
+		if (m_lastPos != UT_NPOS && m_lastKey == hk && m_bptr[m_lastPos].first == key)
 			return m_lastPos;
 
+		UTsize s = findSlot(key, hk);
+		if (s == UT_NPOS)
+			return UT_NPOS;
 
-		UThash hr = _UT_UTHASHTABLE_HKHASH(hk);
-
-		UT_ASSERT(m_bptr && m_iptr && m_nptr);
-
-		UTsize fh = m_iptr[hr];
-		while (fh != UT_NPOS && (key != m_bptr[fh].first))
-			fh = m_nptr[fh];
-
-
-		if (fh != UT_NPOS)
-		{
-			m_lastKey = hk;
-			m_lastPos = fh;
+		m_lastKey = hk;
+		m_lastPos = m_slots[s].index;
 
-			UT_ASSERT(fh >= 0  && fh < m_size);
-		}
-		return fh;
+		UT_ASSERT(m_lastPos < m_size);
+		return m_lastPos;
 	}
 
 
@@ -1330,84 +1330,63 @@ public:
 
 	void remove(const Key &key)
 	{
-		UThash hash, lhash;
-		UTsize index, pindex, findex;
+		if (m_size == 0)
+			return;
 
-		findex = find(key);
-		if (findex == UT_NPOS || m_capacity == 0 || m_size == 0)
+		UTsize s = findSlot(key, key.hash());
+		if (s == UT_NPOS)
 			return;
 
 		m_lastKey = UT_NPOS;
 		m_lastPos = UT_NPOS;
-		UT_ASSERT(m_bptr && m_iptr && m_nptr);
-
-
-		hash = _UT_UTHASHTABLE_HASH(key);
-
-		index  = m_iptr[hash];
-		pindex = UT_NPOS;
-		while (index != findex)
-		{
-			pindex = index;
-			index = m_nptr[index];
-		}
 
-		if (pindex != UT_NPOS)
-		{
-			UT_ASSERT(m_nptr[pindex] == findex);
-			m_nptr[pindex] = m_nptr[findex];
-		}
-		else
-			m_iptr[hash] = m_nptr[findex];
+		UTsize findex = m_slots[s].index;
+		eraseSlot(s);
 
+		// Keep the entries dense, move the last one into the hole.
 		UTsize lindex = m_size - 1;
-		if (lindex == findex)
-		{
-			--m_size;
-			//m_bptr[m_size].~Entry();
-			return;
-		}
-
-		lhash = _UT_UTHASHTABLE_HASH(m_bptr[lindex].first);
-		index  = m_iptr[lhash];
-		pindex = UT_NPOS;
-		while (index != lindex)
+		if (lindex != findex)
 		{
-			pindex = index;
-			index = m_nptr[index];
+			m_slots[slotOf(m_bptr[lindex].first.hash(), lindex)].index = (UTuint32)findex;
+			m_bptr[findex] = m_bptr[lindex];
 		}
 
-		if (pindex != UT_NPOS)
-		{
-			UT_ASSERT(m_nptr[pindex] == lindex);
-			m_nptr[pindex] = m_nptr[lindex];
-		}
-		else
-			m_iptr[lhash] = m_nptr[lindex];
-
-		m_bptr[findex] = m_bptr[lindex];
-		m_nptr[findex] = m_iptr[lhash];
-		m_iptr[lhash] = findex;
-
 		--m_size;
-		//m_bptr[m_size].~Entry();
-		return;
 	}
 
 	bool insert(const Key &key, const Value &val)
 	{
-		if (find(key) != UT_NPOS)
-			return false;
+		const UTuint32 hk = (UTuint32)key.hash();
+
+		// One probe finds either the key or the free slot it goes into.
+		UTsize i = UT_NPOS;
+		if (m_slots)
+		{
+			i = home(hk);
+			while (m_slots[i].index != EMPTY)
+			{
+				if (m_slots[i].hash == hk && m_bptr[m_slots[i].index].first == key)
+					return false;
+				i = (i + 1) & m_mask;
+			}
+		}
 
 		if (m_size == m_capacity)
+		{
 			reserve(m_size == 0 ? _UT_UTHASHTABLE_INIT : _UT_UTHASHTABLE_EXPANSE);
+			i = UT_NPOS;
+		}
 
-		const UThash hr = _UT_UTHASHTABLE_HASH(key);
-
-		UT_ASSERT(m_bptr && m_iptr && m_nptr);
+		UT_ASSERT(m_bptr && m_slots);
 		m_bptr[m_size] = Entry(key, val);
-		m_nptr[m_size] = m_iptr[hr];
-		m_iptr[hr] = m_size;
+
+		if (i == UT_NPOS)
+			insertSlot(hk, m_size);
+		else
+		{
+			m_slots[i].hash  = hk;
+			m_slots[i].index = (UTuint32)m_size;
+		}
 
 		++m_size;
 		return true;
@@ -1438,49 +1417,33 @@ public:
 
 	void report(void) const
 	{
-		if (m_capacity == 0 || m_capacity == UT_NPOS || m_size == 0)
+		if (m_size == 0)
 			return;
 
-		UT_ASSERT(m_bptr && m_iptr && m_nptr);
-
+		UT_ASSERT(m_bptr && m_slots);
 
-		UTsize min_col= m_size, max_col = 0;
-		UTsize i, tot=0, avg = 0;
-		for (i=0; i<m_size; ++i)
+		UTsize min_probe = m_size, max_probe = 0;
+		UTsize i, tot = 0, avg = 0;
+		for (i = 0; i < m_size; ++i)
 		{
-			Key &key = m_bptr[i].first;
-
-			UThash hr = _UT_UTHASHTABLE_HASH(key);
-
-			UTsize nr = 0;
-
-			UTsize fh = m_iptr[hr];
-			while (fh != UT_NPOS && (key != m_bptr[fh].first))
-			{
-				fh = m_nptr[fh];
-				nr++;
-			}
+			UTsize s = slotOf(m_bptr[i].first.hash(), i);
+			UTsize nr = (s - home(m_slots[s].hash)) & m_mask;
 
-			if (nr < min_col)
-				min_col = nr;
-			if (nr > max_col)
-				max_col = nr;
+			if (nr < min_probe)
+				min_probe = nr;
+			if (nr > max_probe)
+				max_probe = nr;
 
 			tot += nr;
 			avg += nr ? 1 : 0;
 		}
 
-#if _UT_UTHASHTABLE_FORCE_POW2 == 1
-		printf("Results using forced power of 2 expansion.\n\n");
-#else
-		printf("Results using unaltered expansion.\n\n");
-#endif
-		printf("\tTotal number of collisions %i for a table of size %i.\n\t\tusing (%s)\n", tot, m_size, typeid(Key).name());
-		printf("\tThe minimum number of collisions per key: %i\n", min_col);
-		printf("\tThe maximum number of collisions per key: %i\n", max_col);
+		printf("\tTotal probe distance %i for a table of size %i (%i slots).\n\t\tusing (%s)\n", (int)tot, (int)m_size, (int)(m_mask + 1), typeid(Key).name());
+		printf("\tThe minimum probe distance per key: %i\n", (int)min_probe);
+		printf("\tThe maximum probe distance per key: %i\n", (int)max_probe);
 
 		int favr = (int)(100.f * ((float)avg / (float)m_size));
-		printf("\tThe average number of key collisions: %i\n\n", favr);
+		printf("\tKeys displaced from their home slot: %i%%\n\n", favr);
 
 		if (tot == 0)
 			printf("\nCongratulations lookup is 100%% linear!\n\n");
@@ -1493,103 +1456,138 @@ public:
 
 private:
 
-	void doCopy(const utHashTable<Key, Value> &rhs)
+	// The key types already mix their hashes, same as the chained table used.
+	UT_INLINE UTsize home(UTuint32 hk) const { return hk & m_mask; }
+
+
+	UTsize findSlot(const Key &key, UThash hash) const
 	{
-		if (rhs.empty())
-			clear();
-		else if (rhs.valid())
-		{			
-			reserve(rhs.m_capacity);
+		UT_ASSERT(m_slots);
 
-			UTsize i, b;
-			m_size     = rhs.m_size;
-			m_capacity = rhs.m_capacity;
+		const UTuint32 hk = (UTuint32)hash;
+		UTsize i = home(hk);
+		for (;;)
+		{
+			const Slot &s = m_slots[i];
+			if (s.index == EMPTY)
+				return UT_NPOS;
+			if (s.hash == hk && m_bptr[s.index].first == key)
+				return i;
+			i = (i + 1) & m_mask;
+		}
+	}
 
-			b = m_size > 0 ? m_size - 1 : 0;
 
-			// Zero i & n (from end of buffer)
-			for (i=b; i<m_capacity; ++i)
-				m_nptr[i] = m_iptr[i] = UT_NPOS;
+	// Slot referencing a known entry.
+	UTsize slotOf(UThash hash, UTsize index) const
+	{
+		UTsize i = home((UTuint32)hash);
+		while (m_slots[i].index != index)
+			i = (i + 1) & m_mask;
+		return i;
+	}
 
-			for (i=0; i<m_size; ++i)
-			{
-				m_bptr[i] = rhs.m_bptr[i];
-				m_iptr[i] = rhs.m_iptr[i];
-				m_nptr[i] = rhs.m_nptr[i];
-			}
-		}
 
+	void insertSlot(UTuint32 hk, UTsize index)
+	{
+		UTsize i = home(hk);
+		while (m_slots[i].index != EMPTY)
+			i = (i + 1) & m_mask;
+
+		m_slots[i].hash  = hk;
+		m_slots[i].index = (UTuint32)index;
 	}
 
-	template<typename ArrayType>
-	void reserveType(ArrayType **old, UTsize nr, bool cpy=false)
+
+	// Backward shift deletion, pull later cluster members into the hole
+	// unless that would move them before their home slot.
+	void eraseSlot(UTsize i)
 	{
-		UTsize i;
-		ArrayType *nar = new ArrayType[nr];
-		if ((*old)!= 0)
+		UTsize j = i;
+		for (;;)
 		{
-			if (cpy)
+			j = (j + 1) & m_mask;
+			if (m_slots[j].index == EMPTY)
+				break;
+
+			UTsize k = home(m_slots[j].hash);
+			if (i <= j ? (k <= i || k > j) : (k <= i && k > j))
 			{
-				const ArrayType *oar = (*old);
-				for (i = 0; i < m_size; i++) nar[i] = oar[i];
+				m_slots[i] = m_slots[j];
+				i = j;
 			}
-			delete [](*old);
 		}
-		(*old) = nar;
+		m_slots[i].index = EMPTY;
 	}
 
 
-	void rehash(UTsize nr)
+	void doCopy(const utHashTable<Key, Value> &rhs)
 	{
-#if _UT_UTHASHTABLE_FORCE_POW2
+		clear();
+
+		if (!rhs.empty() && rhs.valid())
+		{
+			rehash(rhs.m_capacity);
+			UT_ASSERT(m_mask == rhs.m_mask);
+
+			UTsize i;
+			for (i = 0; i < rhs.m_size; ++i)
+				m_bptr[i] = rhs.m_bptr[i];
+			for (i = 0; i <= m_mask; ++i)
+				m_slots[i] = rhs.m_slots[i];
+
+			m_size = rhs.m_size;
+		}
+	}
 
+
+	void rehash(UTsize nr)
+	{
 		if (!_UT_UTHASHTABLE_IS_POW2(nr))
 		{
 			_UT_UTHASHTABLE_POW2(nr);
 		}
 
 #if _UT_UTHASHTABLE_STAT_ALLOC == 1
-		printf("Expanding tables: %i\n", nr);
+		printf("Expanding tables: %i\n", (int)nr);
 #endif
 		UT_ASSERT(_UT_UTHASHTABLE_IS_POW2(nr));
+		UT_ASSERT(nr * _UT_UTHASHTABLE_SLOTS < EMPTY);
 
+		UTsize i;
+		EntryArray entries = new Entry[nr];
+		for (i = 0; i < m_size; ++i)
+			entries[i] = m_bptr[i];
 
-#else
-
-#if _UT_UTHASHTABLE_STAT_ALLOC == 1
-		printf("Expanding tables: %i\n", nr);
-#endif
-
-#endif
-
-		reserveType<Entry>(&m_bptr, nr, true);
-		reserveType<UTsize>(&m_iptr, nr);
-		reserveType<UTsize>(&m_nptr, nr);
-
+		delete [] m_bptr;
+		m_bptr = entries;
 		m_capacity = nr;
-		UT_ASSERT(m_bptr && m_iptr && m_nptr);
 
+		SlotArray oslots = m_slots;
+		UTsize onr = m_slots ? m_mask + 1 : 0;
 
-		UTsize i, h;
-		for (i=0; i<m_capacity; ++i)
-			m_iptr[i] = m_nptr[i] = UT_NPOS;
+		m_slots = new Slot[nr * _UT_UTHASHTABLE_SLOTS];
+		m_mask  = nr * _UT_UTHASHTABLE_SLOTS - 1;
+		for (i = 0; i <= m_mask; ++i)
+			m_slots[i].index = EMPTY;
 
-		for (i = 0; i < m_size; i++)
+		// Reuse the stored hashes, keys are not touched.
+		for (i = 0; i < onr; ++i)
 		{
-			h = _UT_UTHASHTABLE_HASH(m_bptr[i].first);
-			m_nptr[i] = m_iptr[h];
-			m_iptr[h] = i;
+			if (oslots[i].index != EMPTY)
+				insertSlot(oslots[i].hash, oslots[i].index);
 		}
+
+		delete [] oslots;
 	}
 
 
 
-	UTsize m_size, m_capacity;
+	UTsize m_size, m_capacity, m_mask;
 	mutable UTsize m_lastPos;
 	mutable UTsize m_lastKey;
 
-	IndexArray m_iptr;
-	IndexArray m_nptr;
+	SlotArray  m_slots;
 	EntryArray m_bptr;
 	UTsize m_cache;
 };
@@ -1671,8 +1669,8 @@ public:
 			return m_cache;
 
 		}
-		UT_INLINE bool operator== (const THashKey &v) const     {return hash() == v.hash();}
-		UT_INLINE bool operator!= (const THashKey &v) const     {return hash() != v.hash();}
+		UT_INLINE bool operator== (const THashKey &v) const     {return m_key == v.m_key;}
+		UT_INLINE bool operator!= (const THashKey &v) const     {return !(m_key == v.m_key);}
 		UT_INLINE bool operator== (const UThash &v) const       {return hash() == v;}
 		UT_INLINE bool operator!= (const UThash &v) const       {return hash() != v;}
 	};
@@ -1690,7 +1688,8 @@ public:
 
 
 	utHashSet() {}
-	utHashSet(const utHashSet &oth) : m_table(oth) {}
+	utHashSet(UTsize capacity) : m_table(capacity) {}
+	utHashSet(const utHashSet &oth) : m_table(oth.m_table) {}
 	~utHashSet() {m_table.clear();}
 
 
@@ -1710,7 +1709,9 @@ public:
 	}
 
 
-	UTsize find(const T &v) { return m_table.find(v); }
+	UTsize find(const T &v) const { return m_table.find(v); }
+
+	void reserve(UTsize nr) { m_table.reserve(nr); }
 
 
 	UT_INLINE T       &operator[](UTsize idx)        { UT_ASSERT(idx >= 0 && idx < size()); return m_table.at(idx); }
@@ -1719,6 +1720,7 @@ public:
 	UT_INLINE const T &at(UTsize idx) const          { UT_ASSERT(idx >= 0 && idx < size()); return m_table.at(idx); }
 
 	UT_INLINE UTsize size(void)  const              { return m_table.size(); }
+	UT_INLINE UTsize capacity(void) const           { return m_table.capacity(); }
 	UT_INLINE bool   empty(void) const              { return m_table.empty();}
 	UT_INLINE Pointer      ptr(void)                { return m_table.ptr();}
 	UT_INLINE ConstPointer ptr(void) const          { return m_table.ptr();}
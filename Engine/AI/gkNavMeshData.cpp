@@ -38,7 +38,7 @@
 typedef gkGameObject::NavMeshData NavMeshData;
 
 gkNavMeshData::gkNavMeshData(gkScene* scene)
-	: m_object(0), m_scene(scene), m_hasChanged(false)
+	: m_object(0), m_scene(scene), m_hasChanged(false), m_moved(false)
 {
 	GK_ASSERT(m_scene);
 }
@@ -62,7 +62,7 @@ void gkNavMeshData::destroyInstance(gkGameObject* pObj)
 
 	int indexBase = pObj->getNavData().triangleBaseIndex;
 	size_t vertexBaseIndex = indexBase / 2;
-	size_t normalBaseIndex = indexBase / 6;
+	size_t normalBaseIndex = indexBase / 3;
 
 	int nIndex = pObj->getNavData().nIndex;
 	size_t nVertex = nIndex / 2;
@@ -73,13 +73,17 @@ void gkNavMeshData::destroyInstance(gkGameObject* pObj)
 	{
 		gkCriticalSection::Lock guard(m_cs);
 
+		gkVector3 bmin, bmax;
+		getBounds(vertexBaseIndex, nVertex, bmin, bmax);
+		markDirty(bmin, bmax);
+
 		gkMeshData::TRIANGLES::iterator it = m_data.tris.erase(m_data.tris.begin() + indexBase, m_data.tris.begin() + indexBase + nIndex);
 		m_data.verts.erase(m_data.verts.begin() + vertexBaseIndex, m_data.verts.begin() + vertexBaseIndex + nVertex);
 		m_data.normals.erase(m_data.normals.begin() + normalBaseIndex, m_data.normals.begin() + normalBaseIndex + nNormal);
 
 		while (it != m_data.tris.end())
 		{
-			if (*it > indexBase)
+			if (*it >= (int)vertexBaseIndex)
 			{
 				*it -= indexValue;
 			}
@@ -109,10 +113,10 @@ void gkNavMeshData::updateOrCreate(gkGameObject* pObj)
 
 	if (m_object && m_object->isInstanced())
 	{
-		AddCollisionObj();
+		// resting objects report the same transform again, skip those
+		if (AddCollisionObj())
+			m_hasChanged = true;
 	}
-
-	m_hasChanged = true;
 }
 
 void gkNavMeshData::destroyInstances()
@@ -130,6 +134,7 @@ void gkNavMeshData::destroyInstances()
 	m_data.verts.clear();
 	m_data.tris.clear();
 	m_data.normals.clear();
+	m_dirty.clear();
 
 	m_hasChanged = true;
 }
@@ -204,14 +209,21 @@ void gkNavMeshData::addTriangle(const gkVector3& v1, const gkVector3& v2, const
 	}
 	else
 	{
-		size_t tBaseIndex = m_object->getNavData().triangleBaseIndex + triangleIndex;
-		size_t vBaseIndex = tBaseIndex / 2;
-		size_t nBaseIndex = tBaseIndex / 6;
+		// 3 vertices, 6 indices and 2 normals per triangle
+		size_t tBaseIndex = m_object->getNavData().triangleBaseIndex;
+		size_t vBaseIndex = tBaseIndex / 2 + triangleIndex * 3;
+		size_t nBaseIndex = tBaseIndex / 3 + triangleIndex * 2;
+
+		if (vBaseIndex + 2 >= m_data.verts.size())
+			return;
 
 		gkVector3& ov1 = m_data.verts[vBaseIndex];
 		gkVector3& ov2 = m_data.verts[vBaseIndex+1];
 		gkVector3& ov3 = m_data.verts[vBaseIndex+2];
 
+		if (ov1 != v1 || ov2 != v2 || ov3 != v3)
+			m_moved = true;
+
 		ov1 = v1;
 		ov2 = v2;
 		ov3 = v3;
@@ -229,13 +241,21 @@ struct minH : public std::binary_function<gkVector3, gkVector3, bool>
 	bool operator()(const gkVector3& a, const gkVector3& b) const  { return a.y < b.y; }
 };
 
-void gkNavMeshData::AddCollisionObj()
+bool gkNavMeshData::AddCollisionObj()
 {
 	gkCriticalSection::Lock guard(m_cs);
 
 	size_t vIndex = m_data.verts.size();
 	size_t tIndex = m_data.tris.size();
 
+	// an update overwrites the object's triangles in place, remember where they were
+	const NavMeshData& navData = m_object->getNavData();
+	gkVector3 oldMin, oldMax;
+
+	m_moved = navData.isEmpty();
+	if (!m_moved)
+		getBounds(navData.triangleBaseIndex / 2, navData.nIndex / 2, oldMin, oldMax);
+
 	gkScene* pScene = m_object->getOwner();
 
 	GK_ASSERT(pScene);
@@ -330,7 +350,23 @@ void gkNavMeshData::AddCollisionObj()
 		float hMax = std::max_element(it0, it1, minH())->y;
 
 		m_object->setNavData(NavMeshData(tIndex, n, hMin, hMax));
+
+		if (n)
+		{
+			gkVector3 bmin, bmax;
+			getBounds(vIndex, m_data.verts.size() - vIndex, bmin, bmax);
+			markDirty(bmin, bmax);
+		}
+	}
+	else if (m_moved)
+	{
+		gkVector3 bmin, bmax;
+		getBounds(navData.triangleBaseIndex / 2, navData.nIndex / 2, bmin, bmax);
+		markDirty(oldMin, oldMax);
+		markDirty(bmin, bmax);
 	}
+
+	return m_moved;
 }
 
 bool gkNavMeshData::isValid(gkGameObject* pObj)
@@ -361,3 +397,106 @@ bool gkNavMeshData::isValid(gkGameObject* pObj)
 
 	return active;
 }
+
+void gkNavMeshData::getBounds(size_t firstVert, size_t nVerts, gkVector3& bmin, gkVector3& bmax) const
+{
+	bmin = gkVector3(FLT_MAX, FLT_MAX, FLT_MAX);
+	bmax = gkVector3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+	for (size_t i = firstVert; i < firstVert + nVerts && i < m_data.verts.size(); ++i)
+	{
+		bmin.makeFloor(m_data.verts[i]);
+		bmax.makeCeil(m_data.verts[i]);
+	}
+}
+
+void gkNavMeshData::markDirty(const gkVector3& bmin, const gkVector3& bmax)
+{
+	if (bmin.x > bmax.x)
+		return;
+
+	// nobody is collecting them (single tile builds), keep one box
+	if (m_dirty.size() >= 256)
+	{
+		m_dirty[0].merge(bmin);
+		m_dirty[0].merge(bmax);
+		return;
+	}
+
+	m_dirty.push_back(gkBoundingBox(bmin, bmax));
+}
+
+void gkNavMeshData::popDirtyBounds(BOUNDS& bounds)
+{
+	gkCriticalSection::Lock guard(m_cs);
+
+	bounds.swap(m_dirty);
+	m_dirty.clear();
+}
+
+void gkNavMeshData::addAreas(gkMeshData* p, const gkVector3& bmin, const gkVector3& bmax) const
+{
+	gkGameObjectSet& objs = m_scene->getInstancedObjects();
+	gkGameObjectSet::Iterator it = objs.iterator();
+	while (it.hasMoreElements())
+	{
+		gkGameObject* pObj = it.getNext();
+		const NavMeshData& navData = pObj->getNavData();
+
+		if (navData.isEmpty())
+			continue;
+
+		gkMeshData::Area area;
+		getBounds(navData.triangleBaseIndex / 2, navData.nIndex / 2, area.bmin, area.bmax);
+
+		if (area.bmax.x < bmin.x || area.bmin.x > bmax.x || area.bmax.z < bmin.z || area.bmin.z > bmax.z)
+			continue;
+
+		area.bmin.y = navData.hmin;
+		area.bmax.y = navData.hmax;
+		area.flag = pObj->getProperties().m_findPathFlag;
+
+		p->areas.push_back(area);
+	}
+}
+
+gkMeshData* gkNavMeshData::cloneData(const gkVector3& bmin, const gkVector3& bmax) const
+{
+	gkCriticalSection::Lock guard(m_cs);
+
+	gkMeshData* p = new gkMeshData;
+
+	// every triangle owns 3 vertices, 6 indices (both windings) and 2 normals
+	size_t ntris = m_data.verts.size() / 3;
+
+	for (size_t i = 0; i < ntris; ++i)
+	{
+		const gkVector3& v1 = m_data.verts[i * 3];
+		const gkVector3& v2 = m_data.verts[i * 3 + 1];
+		const gkVector3& v3 = m_data.verts[i * 3 + 2];
+
+		if (gkMax(v1.x, gkMax(v2.x, v3.x)) < bmin.x || gkMin(v1.x, gkMin(v2.x, v3.x)) > bmax.x ||
+		        gkMax(v1.z, gkMax(v2.z, v3.z)) < bmin.z || gkMin(v1.z, gkMin(v2.z, v3.z)) > bmax.z)
+			continue;
+
+		int a = (int)p->verts.size();
+
+		p->verts.push_back(v1);
+		p->verts.push_back(v2);
+		p->verts.push_back(v3);
+
+		p->tris.push_back(a);
+		p->tris.push_back(a + 1);
+		p->tris.push_back(a + 2);
+		p->tris.push_back(a + 2);
+		p->tris.push_back(a + 1);
+		p->tris.push_back(a);
+
+		p->normals.push_back(m_data.normals[i * 2]);
+		p->normals.push_back(m_data.normals[i * 2 + 1]);
+	}
+
+	addAreas(p, bmin, bmax);
+
+	return p;
+}
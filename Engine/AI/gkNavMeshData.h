@@ -63,22 +63,39 @@ public:
 
 		p->copy(m_data);
 
+		addAreas(p, gkVector3(-FLT_MAX, -FLT_MAX, -FLT_MAX), gkVector3(FLT_MAX, FLT_MAX, FLT_MAX));
+
 		return p;
 	}
 
+	// Clones only the triangles and object areas overlapping [bmin, bmax] on the ground plane.
+	gkMeshData* cloneData(const gkVector3& bmin, const gkVector3& bmax) const;
+
 	GK_INLINE bool hasChanged() const { return m_hasChanged; }
 	GK_INLINE void resetHasChanged() { m_hasChanged = false; }
 
+	typedef std::vector<gkBoundingBox> BOUNDS;
+
+	// Regions whose geometry changed since the last call, in navigation space (y up).
+	void popDirtyBounds(BOUNDS& bounds);
+	GK_INLINE bool hasDirtyBounds() const { return !m_dirty.empty(); }
+
 private:
 
 	void processTriangle(btVector3* triangle, int partId, int triangleIndex);
 
 	void addTriangle(const gkVector3& v1, const gkVector3& v2, const gkVector3& v3, int triangleIndex);
 
-	void AddCollisionObj();
+	bool AddCollisionObj();
 
 	bool isValid(gkGameObject* pObj);
 
+	void addAreas(gkMeshData* p, const gkVector3& bmin, const gkVector3& bmax) const;
+
+	void getBounds(size_t firstVert, size_t nVerts, gkVector3& bmin, gkVector3& bmax) const;
+
+	void markDirty(const gkVector3& bmin, const gkVector3& bmax);
+
 private:
 
 	mutable gkCriticalSection m_cs;
@@ -92,6 +109,10 @@ private:
 	gkScene* m_scene;
 
 	bool m_hasChanged;
+
+	bool m_moved;
+
+	BOUNDS m_dirty;
 };
 
 
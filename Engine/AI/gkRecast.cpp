@@ -39,19 +39,22 @@
 #include "DetourNavMeshBuilder.h"
 #include "DetourNavMesh.h"
 #include <memory>
+#include <algorithm>
+#include <cfloat>
 
 gkDetourNavMesh::~gkDetourNavMesh()
 {
 	if (m_p) delete m_p;
 }
 
-PDT_NAV_MESH gkRecast::createNavMesh(PMESHDATA meshData, const Config& config)
+gkDetourTiles::~gkDetourTiles()
 {
-	if (!meshData.get())
-		return PDT_NAV_MESH(0);
-
-	rcConfig cfg;
+	for (TILES::iterator it = m_tiles.begin(); it != m_tiles.end(); ++it)
+		delete [] it->data;
+}
 
+static void gkSetupRecastConfig(const gkRecast::Config& config, rcConfig& cfg)
+{
 	cfg.cs = config.CELL_SIZE;
 	cfg.ch = config.CELL_HEIGHT;
 
@@ -71,6 +74,15 @@ PDT_NAV_MESH gkRecast::createNavMesh(PMESHDATA meshData, const Config& config)
 	cfg.borderSize = cfg.walkableRadius + 4; // Reserve enough padding.
 	cfg.detailSampleDist = config.DETAIL_SAMPLE_DIST < 0.9f ? 0 : cfg.cs * config.DETAIL_SAMPLE_DIST;
 	cfg.detailSampleMaxError = cfg.ch * config.DETAIL_SAMPLE_ERROR;
+}
+
+PDT_NAV_MESH gkRecast::createNavMesh(PMESHDATA meshData, const Config& config)
+{
+	if (!meshData.get())
+		return PDT_NAV_MESH(0);
+
+	rcConfig cfg;
+	gkSetupRecastConfig(config, cfg);
 
 	if (!meshData->getVertCount())
 		return PDT_NAV_MESH(0);
@@ -314,6 +326,420 @@ PDT_NAV_MESH gkRecast::createNavMesh(PMESHDATA meshData, const Config& config)
 	return navMesh;
 }
 
+// Builds a single tile from the triangles binned to it. Leaves data at 0 for empty tiles.
+static bool gkBuildTile(const gkMeshData& mesh, const std::vector<int>& tris, const rcConfig& base,
+                        const float* orig, const gkRecast::TileCoord& tile, unsigned char** outData, int* outDataSize)
+{
+	*outData = 0;
+	*outDataSize = 0;
+
+	if (tris.empty())
+		return true;
+
+	rcConfig cfg = base;
+
+	const float* verts = mesh.getVerts();
+	const int nverts = mesh.getVertCount();
+	const int ntris = (int)tris.size() / 3;
+	const float tileWidth = cfg.tileSize * cfg.cs;
+	const float border = cfg.borderSize * cfg.cs;
+
+	float tbmin[3], tbmax[3];
+	tbmin[0] = orig[0] + tile.x * tileWidth;
+	tbmin[2] = orig[2] + tile.y * tileWidth;
+	tbmax[0] = tbmin[0] + tileWidth;
+	tbmax[2] = tbmin[2] + tileWidth;
+
+	tbmin[1] = FLT_MAX;
+	tbmax[1] = -FLT_MAX;
+	for (size_t i = 0; i < tris.size(); ++i)
+	{
+		float h = verts[tris[i] * 3 + 1];
+		tbmin[1] = gkMin(tbmin[1], h);
+		tbmax[1] = gkMax(tbmax[1], h);
+	}
+
+	// The heightfield covers the tile plus a border, so regions line up with the neighbours.
+	rcVcopy(cfg.bmin, tbmin);
+	rcVcopy(cfg.bmax, tbmax);
+	cfg.bmin[0] -= border;
+	cfg.bmin[2] -= border;
+	cfg.bmax[0] += border;
+	cfg.bmax[2] += border;
+	cfg.width = cfg.tileSize + cfg.borderSize * 2;
+	cfg.height = cfg.tileSize + cfg.borderSize * 2;
+
+	rcHeightfield heightField;
+	if (!rcCreateHeightfield(heightField, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch))
+	{
+		gkPrintf("buildTile: Could not create solid heightfield.");
+		return false;
+	}
+
+	{
+		utArray<unsigned char> triflags;
+		triflags.resize(ntris);
+		memset(triflags.ptr(), 0, ntris * sizeof(unsigned char));
+
+		rcMarkWalkableTriangles(cfg.walkableSlopeAngle, verts, nverts, &tris[0], ntris, triflags.ptr());
+		rcRasterizeTriangles(verts, nverts, &tris[0], triflags.ptr(), ntris, heightField);
+	}
+
+	rcFilterLedgeSpans(cfg.walkableHeight, cfg.walkableClimb, heightField);
+	rcFilterWalkableLowHeightSpans(cfg.walkableHeight, heightField);
+
+	rcCompactHeightfield chf;
+	if (!rcBuildCompactHeightfield(cfg.walkableHeight, cfg.walkableClimb, RC_WALKABLE, heightField, chf))
+	{
+		gkPrintf("buildTile: Could not build compact data.");
+		return false;
+	}
+
+	if (!rcErodeArea(RC_WALKABLE_AREA, cfg.walkableRadius, chf))
+	{
+		gkPrintf("buildTile: Could not erode.");
+		return false;
+	}
+
+	for (gkMeshData::AREAS::const_iterator it = mesh.areas.begin(); it != mesh.areas.end(); ++it)
+	{
+		if (it->bmax.x < cfg.bmin[0] || it->bmin.x > cfg.bmax[0] ||
+		        it->bmax.z < cfg.bmin[2] || it->bmin.z > cfg.bmax[2])
+			continue;
+
+		rcMarkBoxArea(it->bmin.ptr(), it->bmax.ptr(), it->flag, chf);
+	}
+
+	if (!rcBuildDistanceField(chf))
+	{
+		gkPrintf("buildTile: Could not build distance field.");
+		return false;
+	}
+
+	if (!rcBuildRegions(chf, cfg.borderSize, cfg.minRegionSize, cfg.mergeRegionSize))
+	{
+		gkPrintf("buildTile: Could not build regions.");
+		return false;
+	}
+
+	rcContourSet cset;
+	if (!rcBuildContours(chf, cfg.maxSimplificationError, cfg.maxEdgeLen, cset))
+	{
+		gkPrintf("buildTile: Could not create contours.");
+		return false;
+	}
+
+	if (!cset.nconts)
+		return true;
+
+	rcPolyMesh pmesh;
+	if (!rcBuildPolyMesh(cset, cfg.maxVertsPerPoly, pmesh))
+	{
+		gkPrintf("buildTile: Could not triangulate contours.");
+		return false;
+	}
+
+	if (!pmesh.npolys)
+		return true;
+
+	rcPolyMeshDetail dmesh;
+	if (!rcBuildPolyMeshDetail(pmesh, chf, cfg.detailSampleDist, cfg.detailSampleMaxError, dmesh))
+	{
+		gkPrintf("buildTile: Could not build detail mesh.");
+		return false;
+	}
+
+	// Remove the border from the poly mesh, Detour finds the portals
+	// to the neighbour tiles at 0 and tileSize.
+	for (int i = 0; i < pmesh.nverts; ++i)
+	{
+		unsigned short* v = &pmesh.verts[i * 3];
+		v[0] -= (unsigned short)cfg.borderSize;
+		v[2] -= (unsigned short)cfg.borderSize;
+	}
+
+	for (int i = 0; i < pmesh.npolys; ++i)
+		pmesh.flags[i] = 0xFFFF & pmesh.areas[i];
+
+	dtNavMeshCreateParams params;
+	memset(&params, 0, sizeof(params));
+	params.verts = pmesh.verts;
+	params.vertCount = pmesh.nverts;
+	params.polys = pmesh.polys;
+	params.polyAreas = pmesh.areas;
+	params.polyFlags = pmesh.flags;
+	params.polyCount = pmesh.npolys;
+	params.nvp = pmesh.nvp;
+	params.detailMeshes = dmesh.meshes;
+	params.detailVerts = dmesh.verts;
+	params.detailVertsCount = dmesh.nverts;
+	params.detailTris = dmesh.tris;
+	params.detailTriCount = dmesh.ntris;
+	params.walkableHeight = cfg.walkableHeight * cfg.ch;
+	params.walkableRadius = cfg.walkableRadius * cfg.cs;
+	params.walkableClimb = cfg.walkableClimb * cfg.ch;
+	params.tileX = tile.x;
+	params.tileY = tile.y;
+	rcVcopy(params.bmin, tbmin);
+	rcVcopy(params.bmax, tbmax);
+	params.bmin[1] = pmesh.bmin[1];
+	params.bmax[1] = pmesh.bmax[1];
+	params.cs = cfg.cs;
+	params.ch = cfg.ch;
+	params.tileSize = cfg.tileSize;
+
+	if (!dtCreateNavMeshData(&params, outData, outDataSize))
+	{
+		gkPrintf("buildTile: Could not build Detour tile %d %d.", tile.x, tile.y);
+		return false;
+	}
+
+	return true;
+}
+
+// Bins the triangles of mesh to the requested tiles and builds them.
+static void gkBuildTiles(const gkMeshData& mesh, const rcConfig& cfg, const float* orig,
+                         const gkRecast::TILE_COORDS& coords, gkDetourTiles& out)
+{
+	if (coords.empty())
+		return;
+
+	int minx = coords[0].x, maxx = coords[0].x;
+	int miny = coords[0].y, maxy = coords[0].y;
+
+	for (size_t i = 1; i < coords.size(); ++i)
+	{
+		minx = gkMin(minx, coords[i].x);
+		maxx = gkMax(maxx, coords[i].x);
+		miny = gkMin(miny, coords[i].y);
+		maxy = gkMax(maxy, coords[i].y);
+	}
+
+	const int w = maxx - minx + 1;
+	const int h = maxy - miny + 1;
+
+	std::vector<char> wanted(w * h, 0);
+	for (size_t i = 0; i < coords.size(); ++i)
+		wanted[(coords[i].y - miny) * w + coords[i].x - minx] = 1;
+
+	std::vector< std::vector<int> > bins(w * h);
+
+	if (mesh.getVertCount())
+	{
+		const float tileWidth = cfg.tileSize * cfg.cs;
+		const float border = cfg.borderSize * cfg.cs;
+		const float* verts = mesh.getVerts();
+		const int* tris = mesh.getTris();
+		const int ntris = mesh.getTriCount();
+
+		for (int t = 0; t < ntris; ++t)
+		{
+			const int* tri = &tris[t * 3];
+			const float* a = &verts[tri[0] * 3];
+			const float* b = &verts[tri[1] * 3];
+			const float* c = &verts[tri[2] * 3];
+
+			float x0 = gkMin(a[0], gkMin(b[0], c[0])) - border, x1 = gkMax(a[0], gkMax(b[0], c[0])) + border;
+			float z0 = gkMin(a[2], gkMin(b[2], c[2])) - border, z1 = gkMax(a[2], gkMax(b[2], c[2])) + border;
+
+			int tx0 = gkMax((int)floorf((x0 - orig[0]) / tileWidth), minx);
+			int tx1 = gkMin((int)floorf((x1 - orig[0]) / tileWidth), maxx);
+			int ty0 = gkMax((int)floorf((z0 - orig[2]) / tileWidth), miny);
+			int ty1 = gkMin((int)floorf((z1 - orig[2]) / tileWidth), maxy);
+
+			for (int ty = ty0; ty <= ty1; ++ty)
+			{
+				for (int tx = tx0; tx <= tx1; ++tx)
+				{
+					int cell = (ty - miny) * w + tx - minx;
+					if (!wanted[cell])
+						continue;
+
+					std::vector<int>& bin = bins[cell];
+					bin.push_back(tri[0]);
+					bin.push_back(tri[1]);
+					bin.push_back(tri[2]);
+				}
+			}
+		}
+	}
+
+	out.m_tiles.reserve(out.m_tiles.size() + coords.size());
+
+	for (size_t i = 0; i < coords.size(); ++i)
+	{
+		gkDetourTiles::Tile tile;
+		tile.x = coords[i].x;
+		tile.y = coords[i].y;
+
+		gkBuildTile(mesh, bins[(tile.y - miny) * w + tile.x - minx], cfg, orig, coords[i], &tile.data, &tile.dataSize);
+
+		out.m_tiles.push_back(tile);
+	}
+}
+
+PDT_NAV_MESH gkRecast::createTiledNavMesh(PMESHDATA meshData, const Config& config)
+{
+	if (!meshData.get() || !meshData->getVertCount())
+		return PDT_NAV_MESH(0);
+
+	rcConfig cfg;
+	gkSetupRecastConfig(config, cfg);
+
+	GK_ASSERT(cfg.tileSize > 0 && "TILE_SIZE must be positive");
+
+	rcTimeVal totStartTime = rcGetPerformanceTimer();
+
+	float bmin[3], bmax[3];
+	rcCalcBounds(meshData->getVerts(), meshData->getVertCount(), bmin, bmax);
+
+	const float tileWidth = cfg.tileSize * cfg.cs;
+	const int tw = (int)((bmax[0] - bmin[0]) / tileWidth) + 1;
+	const int th = (int)((bmax[2] - bmin[2]) / tileWidth) + 1;
+
+	// Tile and polygon ids share 22 bits of a dtPolyRef, tiles outside
+	// the grid are never built.
+	int tileBits = 1;
+	while ((1 << tileBits) < tw * th)
+		++tileBits;
+
+	if (tileBits > 14)
+	{
+		gkPrintf("Could not build tiled navmesh: %d x %d tiles, raise TILE_SIZE.", tw, th);
+		return PDT_NAV_MESH(0);
+	}
+
+	dtNavMeshParams params;
+	memset(&params, 0, sizeof(params));
+	rcVcopy(params.orig, bmin);
+	params.tileWidth = tileWidth;
+	params.tileHeight = tileWidth;
+	params.maxTiles = 1 << tileBits;
+	params.maxPolys = 1 << (22 - tileBits);
+	params.maxNodes = 2048;
+
+	PDT_NAV_MESH navMesh(new gkDetourNavMesh(new dtNavMesh));
+
+	if (!navMesh->m_p->init(&params))
+	{
+		gkPrintf("Could not init tiled Detour navmesh");
+		return PDT_NAV_MESH(0);
+	}
+
+	navMesh->m_tilesX = tw;
+	navMesh->m_tilesY = th;
+
+	TILE_COORDS coords;
+	coords.reserve(tw * th);
+	for (int y = 0; y < th; ++y)
+	{
+		for (int x = 0; x < tw; ++x)
+			coords.push_back(TileCoord(x, y));
+	}
+
+	PDT_TILES tiles(new gkDetourTiles);
+	gkBuildTiles(*meshData.get(), cfg, params.orig, coords, *tiles.get());
+
+	int ntiles = replaceTiles(navMesh, tiles);
+
+	rcTimeVal totEndTime = rcGetPerformanceTimer();
+
+	gkPrintf("Tiled navigation mesh created: %d tiles, %.1fms", ntiles, rcGetDeltaTimeUsec(totStartTime, totEndTime) / 1000.0f);
+
+	return navMesh;
+}
+
+PDT_TILES gkRecast::buildTiles(PMESHDATA meshData, const Config& config, PDT_NAV_MESH navMesh, const TILE_COORDS& tiles)
+{
+	PDT_TILES result(new gkDetourTiles);
+
+	if (!meshData.get() || !navMesh.get() || !navMesh->m_p)
+		return result;
+
+	rcConfig cfg;
+	gkSetupRecastConfig(config, cfg);
+
+	gkBuildTiles(*meshData.get(), cfg, navMesh->m_p->getParams()->orig, tiles, *result.get());
+
+	return result;
+}
+
+int gkRecast::replaceTiles(PDT_NAV_MESH navMesh, PDT_TILES tiles)
+{
+	if (!navMesh.get() || !navMesh->m_p || !tiles.get())
+		return 0;
+
+	dtNavMesh* mesh = navMesh->m_p;
+	int added = 0;
+
+	for (gkDetourTiles::TILES::iterator it = tiles->m_tiles.begin(); it != tiles->m_tiles.end(); ++it)
+	{
+		dtTileRef ref = mesh->getTileRefAt(it->x, it->y);
+		if (ref)
+			mesh->removeTile(ref, 0, 0);
+
+		if (!it->data)
+			continue;
+
+		// the navmesh owns the data from here on
+		if (mesh->addTile(it->data, it->dataSize, DT_TILE_FREE_DATA))
+			++added;
+		else
+		{
+			gkPrintf("Could not add navmesh tile %d %d.", it->x, it->y);
+			delete [] it->data;
+		}
+
+		it->data = 0;
+	}
+
+	return added;
+}
+
+bool gkRecast::hasTileLayout(PDT_NAV_MESH navMesh, const Config& config)
+{
+	if (!navMesh.get() || !navMesh->m_p)
+		return false;
+
+	const dtNavMeshParams* params = navMesh->m_p->getParams();
+	return params->maxTiles > 1 && gkFuzzyEq(params->tileWidth, config.TILE_SIZE * config.CELL_SIZE);
+}
+
+void gkRecast::getTiles(PDT_NAV_MESH navMesh, const Config& config, const gkVector3& bmin, const gkVector3& bmax, TILE_SET& tiles)
+{
+	if (!navMesh.get() || !navMesh->m_p)
+		return;
+
+	const dtNavMeshParams* params = navMesh->m_p->getParams();
+	const float border = ((int)ceilf(config.AGENT_RADIUS / config.CELL_SIZE) + 4) * config.CELL_SIZE;
+
+	int tx0 = gkMax((int)floorf((bmin.x - border - params->orig[0]) / params->tileWidth), 0);
+	int tx1 = gkMin((int)floorf((bmax.x + border - params->orig[0]) / params->tileWidth), navMesh->m_tilesX - 1);
+	int ty0 = gkMax((int)floorf((bmin.z - border - params->orig[2]) / params->tileHeight), 0);
+	int ty1 = gkMin((int)floorf((bmax.z + border - params->orig[2]) / params->tileHeight), navMesh->m_tilesY - 1);
+
+	for (int y = ty0; y <= ty1; ++y)
+	{
+		for (int x = tx0; x <= tx1; ++x)
+			tiles.insert(TileCoord(x, y));
+	}
+}
+
+void gkRecast::getTileBounds(PDT_NAV_MESH navMesh, const Config& config, const TileCoord& tile, gkVector3& bmin, gkVector3& bmax)
+{
+	GK_ASSERT(navMesh.get() && navMesh->m_p);
+
+	const dtNavMeshParams* params = navMesh->m_p->getParams();
+	const float border = ((int)ceilf(config.AGENT_RADIUS / config.CELL_SIZE) + 4) * config.CELL_SIZE;
+
+	bmin.x = params->orig[0] + tile.x * params->tileWidth - border;
+	bmin.y = -FLT_MAX;
+	bmin.z = params->orig[2] + tile.y * params->tileHeight - border;
+	bmax.x = bmin.x + params->tileWidth + border * 2;
+	bmax.y = FLT_MAX;
+	bmax.z = bmin.z + params->tileHeight + border * 2;
+}
+
 bool gkRecast::findPath(PDT_NAV_MESH navMesh, const gkVector3& from, const gkVector3& to, const gkVector3& polyPickExt, int maxPathPolys, PATH_POINTS& path, unsigned short includeFlags, unsigned short excludeFlags)
 {
 	GK_ASSERT(!(includeFlags & excludeFlags) && "includeFlags with excludeFlags cannot overlap");
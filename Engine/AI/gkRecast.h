@@ -29,21 +29,42 @@
 
 #include "gkCommon.h"
 #include "gkMeshData.h"
+#include <set>
 
 class dtNavMesh;
 
 struct gkDetourNavMesh : public gkReferences
 {
 	dtNavMesh* m_p;
+	int m_tilesX, m_tilesY; // tile grid of a tiled mesh
 
-	gkDetourNavMesh() : m_p(0) {}
-	gkDetourNavMesh(dtNavMesh* p) : m_p(p) {}
+	gkDetourNavMesh() : m_p(0), m_tilesX(0), m_tilesY(0) {}
+	gkDetourNavMesh(dtNavMesh* p) : m_p(p), m_tilesX(0), m_tilesY(0) {}
 	~gkDetourNavMesh();
 };
 
 typedef gkPtrRef<gkDetourNavMesh> PDT_NAV_MESH;
 typedef std::vector<gkVector3> PATH_POINTS;
 
+// Tile blobs built off the main thread, handed to gkRecast::replaceTiles.
+// A tile without data is removed from the navigation mesh.
+struct gkDetourTiles : public gkReferences
+{
+	struct Tile
+	{
+		int x, y;
+		unsigned char* data;
+		int dataSize;
+	};
+
+	typedef std::vector<Tile> TILES;
+	TILES m_tiles;
+
+	~gkDetourTiles();
+};
+
+typedef gkPtrRef<gkDetourTiles> PDT_TILES;
+
 struct gkRecast
 {
 	struct Config
@@ -62,6 +83,7 @@ struct gkRecast
 		gkScalar DETAIL_SAMPLE_DIST;
 		gkScalar DETAIL_SAMPLE_ERROR;
 		int TILE_SIZE;
+		bool TILED;
 
 		Config()
 		{
@@ -78,15 +100,68 @@ struct gkRecast
 			VERTS_PER_POLY = 6;
 			DETAIL_SAMPLE_DIST = 6.0f;
 			DETAIL_SAMPLE_ERROR = 1.0f;
-			TILE_SIZE = 16;
+			TILE_SIZE = 64;
+			TILED = false;
 		}
 	};
 
+	struct TileCoord
+	{
+		int x, y;
+
+		TileCoord(int tx = 0, int ty = 0) : x(tx), y(ty) {}
+		bool operator == (const TileCoord& o) const { return x == o.x && y == o.y; }
+		bool operator < (const TileCoord& o) const { return y < o.y || (y == o.y && x < o.x); }
+	};
+
+	typedef std::vector<TileCoord> TILE_COORDS;
+	typedef std::set<TileCoord> TILE_SET;
+
 	static PDT_NAV_MESH createNavMesh(
 	    PMESHDATA meshData,
 	    const Config& config
 	);
 
+	// Builds every tile covering meshData into a tiled navigation mesh.
+	static PDT_NAV_MESH createTiledNavMesh(
+	    PMESHDATA meshData,
+	    const Config& config
+	);
+
+	// Rebuilds the given tiles of a tiled navigation mesh. Only reads the
+	// (immutable) tile layout of navMesh, so it is safe to run off the main thread.
+	static PDT_TILES buildTiles(
+	    PMESHDATA meshData,
+	    const Config& config,
+	    PDT_NAV_MESH navMesh,
+	    const TILE_COORDS& tiles
+	);
+
+	// Swaps rebuilt tiles into navMesh. Must run on the thread doing path queries.
+	static int replaceTiles(PDT_NAV_MESH navMesh, PDT_TILES tiles);
+
+	// True when navMesh is tiled with the tile size of config.
+	static bool hasTileLayout(PDT_NAV_MESH navMesh, const Config& config);
+
+	// Adds the tiles of the navmesh grid affected by geometry inside [bmin, bmax]
+	// (navigation space, y up).
+	static void getTiles(
+	    PDT_NAV_MESH navMesh,
+	    const Config& config,
+	    const gkVector3& bmin,
+	    const gkVector3& bmax,
+	    TILE_SET& tiles
+	);
+
+	// Bounds of the geometry a tile is built from, including its border.
+	static void getTileBounds(
+	    PDT_NAV_MESH navMesh,
+	    const Config& config,
+	    const TileCoord& tile,
+	    gkVector3& bmin,
+	    gkVector3& bmax
+	);
+
 	static bool findPath(
 	    PDT_NAV_MESH navMesh,
 	    const gkVector3& from,
@@ -0,0 +1,176 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "gkSteeringGrid.h"
+#include "gkSteeringObject.h"
+
+
+gkSteeringGrid::gkSteeringGrid(gkScalar cellSize)
+	:    m_cellSize(gkMax(cellSize, (gkScalar)0.01f)),
+	     m_invCellSize(1.f / m_cellSize),
+	     m_count(0)
+{
+}
+
+
+gkSteeringGrid::~gkSteeringGrid()
+{
+}
+
+
+gkSteeringGrid::CellKey gkSteeringGrid::getCell(const gkVector3& pos) const
+{
+	return CellKey((int)Ogre::Math::Floor(pos.x * m_invCellSize), (int)Ogre::Math::Floor(pos.y * m_invCellSize));
+}
+
+
+void gkSteeringGrid::addToCell(gkSteeringObject* obj, const CellKey& key)
+{
+	UTsize pos = m_cells.find(key);
+	if (pos == UT_NPOS)
+	{
+		m_cells.insert(key, Agents());
+		pos = m_cells.find(key);
+	}
+
+	m_cells.at(pos).push_back(obj);
+
+	obj->m_gridX = key.m_x;
+	obj->m_gridY = key.m_y;
+	obj->m_inGrid = true;
+}
+
+
+void gkSteeringGrid::removeFromCell(gkSteeringObject* obj)
+{
+	Agents* agents = m_cells.get(CellKey(obj->m_gridX, obj->m_gridY));
+	if (agents)
+		agents->erase(agents->find(obj));
+
+	obj->m_inGrid = false;
+}
+
+
+void gkSteeringGrid::insert(gkSteeringObject* obj)
+{
+	GK_ASSERT(obj && !obj->m_inGrid);
+
+	addToCell(obj, getCell(obj->position()));
+	++m_count;
+}
+
+
+void gkSteeringGrid::remove(gkSteeringObject* obj)
+{
+	if (!obj->m_inGrid)
+		return;
+
+	removeFromCell(obj);
+	--m_count;
+
+	if (!m_count)
+		m_cells.clear();
+}
+
+
+void gkSteeringGrid::update(gkSteeringObject* obj)
+{
+	if (!obj->m_inGrid)
+		return;
+
+	CellKey key = getCell(obj->position());
+	if (key.m_x == obj->m_gridX && key.m_y == obj->m_gridY)
+		return;
+
+	removeFromCell(obj);
+	addToCell(obj, key);
+}
+
+
+void gkSteeringGrid::query(const gkVector3& bmin, const gkVector3& bmax, Agents& out) const
+{
+	if (!m_count)
+		return;
+
+	const gkScalar pad = m_cellSize * 0.5f;
+
+	CellKey lo = getCell(gkVector3(bmin.x - pad, bmin.y - pad, 0));
+	CellKey hi = getCell(gkVector3(bmax.x + pad, bmax.y + pad, 0));
+
+	// a huge area visits the populated cells instead of every empty one
+	if ((UTsize)(hi.m_x - lo.m_x + 1) * (UTsize)(hi.m_y - lo.m_y + 1) > m_cells.size())
+	{
+		for (UTsize i = 0; i < m_cells.size(); ++i)
+		{
+			const CellKey& key = m_cells.keyAt(i);
+			if (key.m_x < lo.m_x || key.m_x > hi.m_x || key.m_y < lo.m_y || key.m_y > hi.m_y)
+				continue;
+
+			const Agents& agents = m_cells.at(i);
+			for (UTsize j = 0; j < agents.size(); ++j)
+				out.push_back(agents[j]);
+		}
+		return;
+	}
+
+	for (int y = lo.m_y; y <= hi.m_y; ++y)
+	{
+		for (int x = lo.m_x; x <= hi.m_x; ++x)
+		{
+			const Agents* agents = m_cells.get(CellKey(x, y));
+			if (!agents)
+				continue;
+
+			for (UTsize j = 0; j < agents->size(); ++j)
+				out.push_back((*agents)[j]);
+		}
+	}
+}
+
+
+void gkSteeringGrid::setCellSize(gkScalar size)
+{
+	size = gkMax(size, (gkScalar)0.01f);
+	if (gkFuzzyEq(size, m_cellSize))
+		return;
+
+	Agents all;
+	all.reserve(m_count);
+
+	for (UTsize i = 0; i < m_cells.size(); ++i)
+	{
+		const Agents& agents = m_cells.at(i);
+		for (UTsize j = 0; j < agents.size(); ++j)
+			all.push_back(agents[j]);
+	}
+
+	m_cells.clear();
+	m_cellSize = size;
+	m_invCellSize = 1.f / size;
+
+	for (UTsize i = 0; i < all.size(); ++i)
+		addToCell(all[i], getCell(all[i]->position()));
+}
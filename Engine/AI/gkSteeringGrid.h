@@ -0,0 +1,89 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _gkSteeringGrid_h_
+#define _gkSteeringGrid_h_
+
+#include "gkCommon.h"
+#include "gkMathUtils.h"
+
+class gkSteeringObject;
+
+// Uniform grid on the ground plane (x, y) bucketing steering agents,
+// neighbour queries only visit the cells around the query area.
+class gkSteeringGrid
+{
+public:
+
+	typedef utArray<gkSteeringObject*> Agents;
+
+	gkSteeringGrid(gkScalar cellSize = 4.f);
+	~gkSteeringGrid();
+
+	void insert(gkSteeringObject* obj);
+	void remove(gkSteeringObject* obj);
+
+	// Moves obj to the cell of its current position, cheap while it stays in the same cell.
+	void update(gkSteeringObject* obj);
+
+	// Appends the agents binned to cells overlapping [bmin, bmax], callers test the exact shape.
+	// Cells are refreshed once per agent update, the area is padded by half a cell for the drift.
+	void query(const gkVector3& bmin, const gkVector3& bmax, Agents& out) const;
+
+	void setCellSize(gkScalar size);
+	GK_INLINE gkScalar getCellSize(void) const { return m_cellSize; }
+
+	GK_INLINE UTsize getAgentCount(void) const { return m_count; }
+
+private:
+
+	class CellKey
+	{
+	public:
+		CellKey() : m_x(0), m_y(0) {}
+		CellKey(int x, int y) : m_x(x), m_y(y) {}
+
+		GK_INLINE UThash hash(void) const { return ((UThash)m_x * 0x8DA6B343) ^ ((UThash)m_y * 0xD8163841); }
+
+		GK_INLINE bool operator== (const CellKey& v) const { return m_x == v.m_x && m_y == v.m_y; }
+		GK_INLINE bool operator!= (const CellKey& v) const { return !(*this == v); }
+
+		int m_x, m_y;
+	};
+
+	typedef utHashTable<CellKey, Agents> Cells;
+
+	CellKey getCell(const gkVector3& pos) const;
+	void addToCell(gkSteeringObject* obj, const CellKey& key);
+	void removeFromCell(gkSteeringObject* obj);
+
+	Cells    m_cells;
+	gkScalar m_cellSize;
+	gkScalar m_invCellSize;
+	UTsize   m_count;
+};
+
+#endif//_gkSteeringGrid_h_
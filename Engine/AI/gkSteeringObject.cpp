@@ -41,7 +41,7 @@
 
 using namespace OpenSteer;
 
-gkSteeringObject::OTHERS gkSteeringObject::m_others;
+gkSteeringGrid gkSteeringObject::m_grid;
 
 /////////////////////////////////
 
@@ -318,6 +318,10 @@ gkSteeringObject::gkSteeringObject(gkGameObject* obj, gkScalar maxSpeed, const g
 	  m_speed(0),
 	  m_maxForce(maxSpeed),
 	  m_maxSpeed(maxSpeed),
+	  m_neighborRadius(0),
+	  m_gridX(0),
+	  m_gridY(0),
+	  m_inGrid(false),
 	  m_state(UNKNOWN),
 	  m_smoothedAcceleration(Vec3::zero),
 	  m_forward(forward),
@@ -339,14 +343,66 @@ gkSteeringObject::gkSteeringObject(gkGameObject* obj, gkScalar maxSpeed, const g
 	GK_ASSERT(m_radius && "m_radius cannot be zero!!!");
 	GK_ASSERT(m_mass && "m_mass cannot be zero!!!");
 
+	// anything further away can't reach us within a couple of seconds
+	m_neighborRadius = gkMax(m_maxSpeed * 2.f, m_radius * 8.f);
+
 	reset();
 
-	gkSteeringObject::m_others.insert(this);
+	m_grid.insert(this);
 }
 
 gkSteeringObject::~gkSteeringObject()
 {
-	gkSteeringObject::m_others.erase(this);
+	m_grid.remove(this);
+}
+
+void gkSteeringObject::getNeighbors(const gkVector3& center, gkScalar radius, NEIGHBORS& out, const gkSteeringObject* ignore)
+{
+	const gkVector3 ext(radius, radius, radius);
+
+	UTsize first = out.size();
+	m_grid.query(center - ext, center + ext, out);
+
+	for (UTsize i = first; i < out.size();)
+	{
+		gkSteeringObject* e = out[i];
+		const gkScalar r = radius + e->radius();
+
+		if (e == ignore || (e->position() - center).squaredLength() > r * r)
+			out.erase(i); // swaps the last one in, recheck i
+		else
+			++i;
+	}
+}
+
+void gkSteeringObject::getNeighborsInCorridor(const gkVector3& from, const gkVector3& to, gkScalar halfWidth, NEIGHBORS& out, const gkSteeringObject* ignore)
+{
+	const gkVector3 ext(halfWidth, halfWidth, halfWidth);
+
+	gkVector3 bmin(from), bmax(from);
+	bmin.makeFloor(to);
+	bmax.makeCeil(to);
+
+	UTsize first = out.size();
+	m_grid.query(bmin - ext, bmax + ext, out);
+
+	const gkVector3 dir = to - from;
+	const gkScalar len2 = dir.squaredLength();
+
+	for (UTsize i = first; i < out.size();)
+	{
+		gkSteeringObject* e = out[i];
+		const gkVector3 p = e->position();
+		const gkScalar r = halfWidth + e->radius();
+
+		// distance to the segment
+		gkScalar t = len2 > 0 ? gkClamp<gkScalar>((p - from).dotProduct(dir) / len2, 0, 1) : 0;
+
+		if (e == ignore || (from + dir * t - p).squaredLength() > r * r)
+			out.erase(i);
+		else
+			++i;
+	}
 }
 
 void gkSteeringObject::reset()
@@ -400,6 +456,8 @@ void gkSteeringObject::measurePathCurvature (const float elapsedTime)
 
 bool gkSteeringObject::update(gkScalar tick)
 {
+	m_grid.update(this);
+
 	if (!inGoal())
 	{
 		STATE newState = UNKNOWN;
@@ -517,11 +575,17 @@ bool gkSteeringObject::clearPathToGoal(const gkVector3& goalPosition, gkGameObje
 
 		const bool goalIsAside = isAside(goalPosition, 0.5);
 
-		OTHERS::iterator it = gkSteeringObject::m_others.begin();
+		// blockers are tested at 0.3 * distance ahead of where they are now, so
+		// anything further than this from the corridor can't end up inside it
+		const float reach = sideThreshold + behindThreshold;
+		const float drift = 0.3f * (goalDistance + reach) / 0.7f;
 
-		while (it != gkSteeringObject::m_others.end())
+		m_neighbors.clear(true);
+		getNeighborsInCorridor(position(), goalPosition, reach + drift, m_neighbors, this);
+
+		for (UTsize i = 0; i < m_neighbors.size(); ++i)
 		{
-			gkSteeringObject& e = **it;
+			gkSteeringObject& e = *m_neighbors[i];
 
 			if (this->m_obj != e.m_obj && target != e.m_obj && e.speed() > std::numeric_limits<gkScalar>::epsilon())
 			{
@@ -559,8 +623,6 @@ bool gkSteeringObject::clearPathToGoal(const gkVector3& goalPosition, gkGameObje
 					}
 				}
 			}
-
-			++it;
 		}
 	}
 
@@ -597,11 +659,12 @@ Vec3 gkSteeringObject::steerToEvadeOthers(const gkGameObject* target)
 	// sum up weighted evasion
 	Vec3 evade (0, 0, 0);
 
-	OTHERS::iterator it = gkSteeringObject::m_others.begin();
+	m_neighbors.clear(true);
+	getNeighbors(position(), m_neighborRadius, m_neighbors, this);
 
-	while (it != gkSteeringObject::m_others.end())
+	for (UTsize i = 0; i < m_neighbors.size(); ++i)
 	{
-		gkSteeringObject& e = **it;
+		gkSteeringObject& e = *m_neighbors[i];
 
 		if (this->m_obj != e.m_obj && target != e.m_obj && e.speed() > std::numeric_limits<float>::epsilon())
 		{
@@ -628,8 +691,6 @@ Vec3 gkSteeringObject::steerToEvadeOthers(const gkGameObject* target)
 
 			evade += adjustedFlee;
 		}
-
-		++it;
 	}
 	return evade;
 }
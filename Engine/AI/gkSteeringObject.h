@@ -29,6 +29,7 @@
 
 #include "gkGameObject.h"
 #include "gkSteering.h"
+#include "gkSteeringGrid.h"
 #include "AbstractVehicle.h"
 #include "SteerLibrary.h"
 
@@ -55,6 +56,8 @@ public:
 	gkSteeringObject(gkGameObject* obj, gkScalar maxSpeed, const gkVector3& forward, const gkVector3& up, const gkVector3& side);
 	virtual ~gkSteeringObject();
 
+	GK_INLINE gkGameObject* getObject(void) const { return m_obj; }
+
 	GK_INLINE gkVector3 side() const { return m_obj->getOrientation() * m_side; }
 	GK_INLINE gkVector3 up() const { return m_obj->getOrientation() * m_up; }
 	GK_INLINE gkVector3 forward() const { return m_obj->getOrientation() * m_forward; }
@@ -94,6 +97,21 @@ public:
 
 	gkString getDebugStringState() const;
 
+	// Radius steerToEvadeOthers looks for other agents in.
+	GK_INLINE gkScalar getNeighborRadius() const { return m_neighborRadius; }
+	GK_INLINE void setNeighborRadius(gkScalar r) { m_neighborRadius = r; }
+
+	typedef gkSteeringGrid::Agents NEIGHBORS;
+
+	// Agents whose bounding sphere touches the sphere (center, radius).
+	static void getNeighbors(const gkVector3& center, gkScalar radius, NEIGHBORS& out, const gkSteeringObject* ignore = 0);
+
+	// Agents whose bounding sphere touches the capsule from -> to with the given radius.
+	static void getNeighborsInCorridor(const gkVector3& from, const gkVector3& to, gkScalar halfWidth, NEIGHBORS& out, const gkSteeringObject* ignore = 0);
+
+	// Index shared by all agents, the cell size should be near the usual query radius.
+	static gkSteeringGrid& getGrid(void) { return m_grid; }
+
 protected:
 
 	void applySteeringForce(const OpenSteer::Vec3& force, const float elapsedTime);
@@ -116,8 +134,9 @@ protected:
 
 	gkGameObject* m_obj;
 
-	typedef std::set<gkSteeringObject*> OTHERS;
-	static OTHERS m_others;
+	static gkSteeringGrid m_grid;
+
+	float m_neighborRadius; // evade agents within this distance
 
 	float m_mass;       // mass (defaults to unity so acceleration=force)
 
@@ -134,6 +153,13 @@ protected:
 
 private:
 
+	friend class gkSteeringGrid;
+
+	int m_gridX, m_gridY;
+	bool m_inGrid;
+
+	NEIGHBORS m_neighbors;
+
 	STATE m_state;
 
 	gkVector3 m_smoothedAcceleration;
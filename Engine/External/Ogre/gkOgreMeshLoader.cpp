@@ -28,16 +28,23 @@
 #include "gkOgreMaterialLoader.h"
 #include "gkMesh.h"
 #include "gkSkeletonResource.h"
+#include "gkMeshOptimizer.h"
+#include "gkEngine.h"
+#include "gkUserDefs.h"
 
 #include "OgreMesh.h"
 #include "OgreSubMesh.h"
 #include "OgreMeshManager.h"
 #include "OgreHardwareBufferManager.h"
+#include "OgreDistanceLodStrategy.h"
 
 
 static const UTuint16 gk16BitClamp = (0xFFFF) - 1;
 static const UTuint32 gk32BitClamp = (0xFFFFFFFF) - 1;
 
+// smaller submeshes keep their full index list in every level
+#define GK_LOD_MIN_INDICES 96
+
 
 gkMeshLoader::gkMeshLoader(gkMesh* me)
 	:    m_mesh(me)
@@ -62,7 +69,28 @@ gkMeshLoader::~gkMeshLoader()
 
 
 
-void gkMeshLoader::loadSubMesh(Ogre::SubMesh* submesh, gkSubMesh* gks)
+static Ogre::HardwareIndexBufferSharedPtr gkCreateIndexBuffer(Ogre::HardwareIndexBuffer::IndexType type, const unsigned int* indices, UTsize count)
+{
+	Ogre::HardwareIndexBufferSharedPtr indexBuffer = Ogre::HardwareBufferManager::getSingleton().createIndexBuffer(type,
+	        count,
+	        Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+
+	if (type == Ogre::HardwareIndexBuffer::IT_32BIT)
+		indexBuffer->writeData(0, count * sizeof(unsigned int), indices, true);
+	else
+	{
+		unsigned short* indices16 = static_cast<unsigned short*>(indexBuffer->lock(Ogre::HardwareBuffer::HBL_DISCARD));
+		for (UTsize cur = 0; cur < count; cur++)
+			*indices16++ = (unsigned short)indices[cur];
+		indexBuffer->unlock();
+	}
+
+	return indexBuffer;
+}
+
+
+
+void gkMeshLoader::loadSubMesh(Ogre::SubMesh* submesh, gkSubMesh* gks, bool packNormals, const gkMesh::LodDistances& lods)
 {
 	UTsize iBufSize = gks->getIndexBuffer().size() * 3, vBufSize = gks->getVertexBuffer().size();
 
@@ -75,6 +103,38 @@ void gkMeshLoader::loadSubMesh(Ogre::SubMesh* submesh, gkSubMesh* gks)
 	// converting to tri list
 	submesh->operationType = Ogre::RenderOperation::OT_TRIANGLE_LIST;
 
+
+	gkSkeletonResource* skel = m_mesh->getSkeleton();
+	gkSubMesh::DeformVerts& dvbuf = gks->getDeformVertexBuffer();
+
+	// skinning rewrites position and normal only, keep the rest in a static stream
+	bool skinned = skel && !dvbuf.empty();
+	unsigned short staticSource = skinned ? 1 : 0;
+
+
+	// triangle list, reordered for the post transform cache and renumbered
+	// so vertices are fetched in the order they are first drawn
+	utArray<unsigned int> indices;
+	indices.resize(iBufSize);
+	{
+		const gkTriangle* ibuf = gks->getIndexBuffer().ptr();
+		for (UTsize cur = 0; cur < iBufSize / 3; cur++)
+		{
+			indices[cur * 3]     = ibuf[cur].i0;
+			indices[cur * 3 + 1] = ibuf[cur].i1;
+			indices[cur * 3 + 2] = ibuf[cur].i2;
+		}
+	}
+
+	gkMeshOptimizer::Remap remap;
+	bool optimize = gkEngine::getSingleton().getUserDefs().meshOptimize && iBufSize > 0;
+	if (optimize)
+	{
+		gkMeshOptimizer::optimizeVertexCache(indices.ptr(), iBufSize, vBufSize);
+		gkMeshOptimizer::optimizeVertexFetch(indices.ptr(), iBufSize, vBufSize, remap);
+	}
+
+
 	UTsize offs = 0;
 
 	// fill in the declaration
@@ -87,15 +147,20 @@ void gkMeshLoader::loadSubMesh(Ogre::SubMesh* submesh, gkSubMesh* gks)
 
 	// no, blending weights
 
-	// normals
-	decl->addElement(0, offs, Ogre::VET_FLOAT3, Ogre::VES_NORMAL);
-	offs += Ogre::VertexElement::getTypeSize(Ogre::VET_FLOAT3);
+	// normals, packed as xyz + pad
+	Ogre::VertexElementType normalType = packNormals ? Ogre::VET_SHORT4 : Ogre::VET_FLOAT3;
+	decl->addElement(0, offs, normalType, Ogre::VES_NORMAL);
+	offs += Ogre::VertexElement::getTypeSize(normalType);
+
+	UTsize dynamicSize = offs;
+	if (skinned)
+		offs = 0;
 
 	// texture coordinates
 	int maxTco = gks->getUvLayerCount();
 	for (int lay = 0; lay < maxTco; ++lay)
 	{
-		decl->addElement(0, offs, Ogre::VET_FLOAT2, Ogre::VES_TEXTURE_COORDINATES, lay);
+		decl->addElement(staticSource, offs, Ogre::VET_FLOAT2, Ogre::VES_TEXTURE_COORDINATES, lay);
 		offs += Ogre::VertexElement::getTypeSize(Ogre::VET_FLOAT2);
 	}
 
@@ -103,78 +168,94 @@ void gkMeshLoader::loadSubMesh(Ogre::SubMesh* submesh, gkSubMesh* gks)
 	if (diffuseVert)
 	{
 		// diffuse colours
-		decl->addElement(0, offs, Ogre::VET_COLOUR_ABGR, Ogre::VES_DIFFUSE);
+		decl->addElement(staticSource, offs, Ogre::VET_COLOUR_ABGR, Ogre::VES_DIFFUSE);
 		offs += Ogre::VertexElement::getTypeSize(Ogre::VET_COLOUR_ABGR);
 	}
 
 	// no, specular colours
 
-	Ogre::HardwareVertexBufferSharedPtr vertBuf = Ogre::HardwareBufferManager::getSingleton().createVertexBuffer(offs,
-	        submesh->vertexData->vertexCount,
-	        Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+	UTsize staticSize = offs;
+	if (!skinned)
+		dynamicSize = staticSize;
 
 
-	// bind the source
+	// bind the sources
 	Ogre::VertexBufferBinding* bind = submesh->vertexData->vertexBufferBinding;
-	bind->setBinding(0, vertBuf);
 
-
-	// index buffer
-	Ogre::HardwareIndexBuffer::IndexType buff_type = (iBufSize > gk16BitClamp) ?
-	        Ogre::HardwareIndexBuffer::IT_32BIT : Ogre::HardwareIndexBuffer::IT_16BIT;
-
-	Ogre::HardwareIndexBufferSharedPtr indexBuffer = Ogre::HardwareBufferManager::getSingleton().createIndexBuffer(buff_type,
-	        iBufSize,
+	Ogre::HardwareVertexBufferSharedPtr vertBuf = Ogre::HardwareBufferManager::getSingleton().createVertexBuffer(dynamicSize,
+	        submesh->vertexData->vertexCount,
 	        Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+	bind->setBinding(0, vertBuf);
 
-	//
-	submesh->indexData->indexCount = iBufSize;
-	submesh->indexData->indexBuffer = indexBuffer;
-
-
-	// build index items
+	Ogre::HardwareVertexBufferSharedPtr staticBuf = vertBuf;
+	if (skinned && staticSize > 0)
 	{
-		bool using32 = buff_type == Ogre::HardwareIndexBuffer::IT_32BIT;
+		staticBuf = Ogre::HardwareBufferManager::getSingleton().createVertexBuffer(staticSize,
+		            submesh->vertexData->vertexCount,
+		            Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+		bind->setBinding(1, staticBuf);
+	}
 
-		unsigned int* indices32 = 0;
-		unsigned short* indices16 = 0;
 
-		if (!using32)
-			indices16 = static_cast<unsigned short*>(indexBuffer->lock(Ogre::HardwareBuffer::HBL_NORMAL));
-		else
-			indices32 = static_cast<unsigned int*>(indexBuffer->lock(Ogre::HardwareBuffer::HBL_NORMAL));
+	// index buffer, 16 bit as long as every vertex can be addressed
+	Ogre::HardwareIndexBuffer::IndexType buff_type = (vBufSize > gk16BitClamp) ?
+	        Ogre::HardwareIndexBuffer::IT_32BIT : Ogre::HardwareIndexBuffer::IT_16BIT;
 
+	submesh->indexData->indexCount = iBufSize;
+	submesh->indexData->indexBuffer = gkCreateIndexBuffer(buff_type, indices.ptr(), iBufSize);
 
-		UTsize iBufTot = iBufSize / 3;
 
-		gkTriangle* ibuf = gks->getIndexBuffer().ptr();
+	// reduced levels share the vertex buffer, each simplified from the one before
+	submesh->mLodFaceList.resize(lods.size());
+	if (!lods.empty())
+	{
+		utArray<gkVector3> positions;
+		positions.resize(vBufSize);
+		for (UTsize i = 0; i < vBufSize; ++i)
+			positions[i] = gks->getVertexBuffer()[i].co;
+
+		utArray<unsigned int> lodIndices;
+		lodIndices.resize(iBufSize);
+		for (UTsize i = 0; i < iBufSize / 3; i++)
+		{
+			const gkTriangle& tri = gks->getIndexBuffer()[i];
+			lodIndices[i * 3]     = tri.i0;
+			lodIndices[i * 3 + 1] = tri.i1;
+			lodIndices[i * 3 + 2] = tri.i2;
+		}
 
-		for (UTsize cur = 0; cur < iBufTot; cur++)
+		UTsize lodSize = iBufSize;
+		for (UTsize l = 0; l < lods.size(); ++l)
 		{
-			const gkTriangle& i = ibuf[cur];
-			if (using32)
-			{
-				*indices32++ = (unsigned int)i.i0;
-				*indices32++ = (unsigned int)i.i1;
-				*indices32++ = (unsigned int)i.i2;
-			}
-			else
-			{
-				*indices16++ = (unsigned short)i.i0;
-				*indices16++ = (unsigned short)i.i1;
-				*indices16++ = (unsigned short)i.i2;
-			}
+			UTsize target = (UTsize)(lodSize / 3 * m_mesh->getLodReduction()) * 3;
+			if (target >= GK_LOD_MIN_INDICES)
+				lodSize = gkMeshOptimizer::simplify(lodIndices.ptr(), lodIndices.ptr(), lodSize, positions.ptr(), vBufSize, target);
+
+			utArray<unsigned int> level;
+			level.resize(lodSize);
+			for (UTsize i = 0; i < lodSize; ++i)
+				level[i] = optimize ? remap[lodIndices[i]] : lodIndices[i];
+
+			if (optimize)
+				gkMeshOptimizer::optimizeVertexCache(level.ptr(), lodSize, vBufSize);
+
+			Ogre::IndexData* lodData = OGRE_NEW Ogre::IndexData();
+			lodData->indexStart  = 0;
+			lodData->indexCount  = lodSize;
+			lodData->indexBuffer = gkCreateIndexBuffer(buff_type, level.ptr(), lodSize);
+			submesh->mLodFaceList[l] = lodData;
 		}
-		indexBuffer->unlock();
 	}
 
 	// build vertex items
 	{
-		unsigned char* vptr = static_cast<unsigned char*>(vertBuf->lock(Ogre::HardwareBuffer::HBL_NORMAL));
-
-		Ogre::VertexData* vdata = submesh->vertexData;
+		unsigned char* dptr = static_cast<unsigned char*>(vertBuf->lock(Ogre::HardwareBuffer::HBL_NORMAL));
+		unsigned char* sptr = dptr;
+		if (staticBuf != vertBuf)
+			sptr = static_cast<unsigned char*>(staticBuf->lock(Ogre::HardwareBuffer::HBL_NORMAL));
 
 		float*           fptr = 0;
+		short*           nptr = 0;
 		unsigned int*    iptr = 0;
 
 
@@ -183,22 +264,39 @@ void gkMeshLoader::loadSubMesh(Ogre::SubMesh* submesh, gkSubMesh* gks)
 		UTsize i = 0;
 		while (i < vBufSize)
 		{
+			UTsize dest = optimize ? remap[i] : i;
 			const gkVertex& vtx = vbuf[i++];
 
 			// packed as
 			// VES_POSITION | VES_NORMAL | VES_TEXTURE_COORDINATES[<8] | |= VES_DIFFUSE
+			// with the texture coordinates and colour in source 1 when skinned
 
 			// VES_POSITION
-			fptr = (float*)vptr;
+			fptr = (float*)(dptr + dest * dynamicSize);
 
 			*fptr++ = vtx.co.x;
 			*fptr++ = vtx.co.y;
 			*fptr++ = vtx.co.z;
 
 			// VES_NORMAL
-			*fptr++ = vtx.no.x;
-			*fptr++ = vtx.no.y;
-			*fptr++ = vtx.no.z;
+			if (packNormals)
+			{
+				nptr = (short*)fptr;
+				*nptr++ = (short)gkClamp<gkScalar>(vtx.no.x * 32767.f, -32767.f, 32767.f);
+				*nptr++ = (short)gkClamp<gkScalar>(vtx.no.y * 32767.f, -32767.f, 32767.f);
+				*nptr++ = (short)gkClamp<gkScalar>(vtx.no.z * 32767.f, -32767.f, 32767.f);
+				*nptr++ = 0;
+				fptr = (float*)nptr;
+			}
+			else
+			{
+				*fptr++ = vtx.no.x;
+				*fptr++ = vtx.no.y;
+				*fptr++ = vtx.no.z;
+			}
+
+			if (skinned)
+				fptr = (float*)(sptr + dest * staticSize);
 
 
 			// VES_TEXTURE_COORDINATES
@@ -216,25 +314,16 @@ void gkMeshLoader::loadSubMesh(Ogre::SubMesh* submesh, gkSubMesh* gks)
 				// VES_DIFFUSE
 				iptr    = (unsigned int*)fptr;
 				*iptr++ = vtx.vcol;
-
-				// goto next
-				vptr = (unsigned char*)iptr;
 			}
-			else
-				// goto next
-				vptr = (unsigned char*)fptr;
-
 		}
 
 		vertBuf->unlock();
-		gkSkeletonResource* skel = m_mesh->getSkeleton();
+		if (staticBuf != vertBuf)
+			staticBuf->unlock();
 
 
 		if (skel)
 		{
-			gkSubMesh::DeformVerts& dvbuf = gks->getDeformVertexBuffer();
-
-
 			i = 0;
 			UTsize totvert = dvbuf.size();
 			gkSubMesh::DeformVerts::Pointer dvp = dvbuf.ptr();
@@ -251,22 +340,12 @@ void gkMeshLoader::loadSubMesh(Ogre::SubMesh* submesh, gkSubMesh* gks)
 					if (bone)
 					{
 						vba.boneIndex   = bone->_getBoneIndex();
-						vba.vertexIndex = dvtx.vertexId;
+						vba.vertexIndex = optimize && (UTsize)dvtx.vertexId < vBufSize ? remap[dvtx.vertexId] : dvtx.vertexId;
 						vba.weight      = dvtx.weight;
 						submesh->addBoneAssignment(vba);
 					}
 				}
 			}
-
-			if (totvert > 0)
-			{
-#if OGRE_VERSION >= 0x10800
-				Ogre::VertexDeclaration* newDecl = decl->getAutoOrganisedDeclaration(true, false, false);
-#else
-				Ogre::VertexDeclaration* newDecl = decl->getAutoOrganisedDeclaration(true, false);
-#endif
-				vdata->reorganiseBuffers(newDecl);
-			}
 		}
 	}
 }
@@ -286,7 +365,27 @@ void gkMeshLoader::loadResource(Ogre::Resource* res)
 
 
 
+	// tangents and skinning read the normals back as floats
+	gkUserDefs& defs = gkEngine::getSingleton().getUserDefs();
+	bool packNormals = defs.meshPackNormals && !defs.isD3DRenderSystem() && !m_mesh->getSkeleton();
+
 	gkMesh::SubMeshIterator iter = m_mesh->getSubMeshIterator();
+	while (packNormals && iter.hasMoreElements())
+	{
+		if (iter.getNext()->getMaterial().m_tangentLayer != -1)
+			packNormals = false;
+	}
+
+	// explicit levels from the mesh, else the engine wide default
+	gkMesh::LodDistances lods = m_mesh->getLodDistances();
+	if (lods.empty() && defs.meshLodLevels > 0 && !defs.headless)
+	{
+		gkScalar dist = defs.meshLodDistance;
+		for (int i = 0; i < defs.meshLodLevels; ++i, dist *= 2.f)
+			lods.push_back(dist);
+	}
+
+	iter = m_mesh->getSubMeshIterator();
 	while (iter.hasMoreElements())
 	{
 		gkSubMesh* gks = iter.getNext();
@@ -295,7 +394,7 @@ void gkMeshLoader::loadResource(Ogre::Resource* res)
 		submesh->setMaterialName(gks->getMaterialName());
 
 		gkMaterialLoader::loadSubMeshMaterial(gks, m_mesh->getGroupName());
-		loadSubMesh(submesh, gks);
+		loadSubMesh(submesh, gks, packNormals, lods);
 
 		t = gks->getMaterial().m_tangentLayer;
 		if (t!=-1)
@@ -305,6 +404,19 @@ void gkMeshLoader::loadResource(Ogre::Resource* res)
 		}
 	}
 
+	if (!lods.empty())
+	{
+		// face lists are already filled per submesh, this only sizes the usage list
+		omesh->_setLodInfo((unsigned short)(lods.size() + 1), false);
+		for (UTsize l = 0; l < lods.size(); ++l)
+		{
+			Ogre::MeshLodUsage usage;
+			usage.userValue = lods[l];
+			omesh->_setLodUsage((unsigned short)(l + 1), usage);
+		}
+		omesh->setLodStrategy(Ogre::DistanceLodStrategy::getSingletonPtr());
+	}
+
 	omesh->_setBounds(m_mesh->getBoundingBox(), false);
 	omesh->_setBoundingSphereRadius(m_mesh->getBoundingBox().getSize().squaredLength());
 	
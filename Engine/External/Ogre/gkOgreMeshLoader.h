@@ -29,6 +29,7 @@
 
 #include "OgreResource.h"
 #include "utCommon.h"
+#include "utTypes.h"
 class gkMesh;
 class gkSubMesh;
 
@@ -43,7 +44,7 @@ public:
 
 
 private:
-	void loadSubMesh(Ogre::SubMesh* submesh, gkSubMesh* gks);
+	void loadSubMesh(Ogre::SubMesh* submesh, gkSubMesh* gks, bool packNormals, const utArray<Ogre::Real>& lods);
 	void loadResource(Ogre::Resource* res);
 
 	gkMesh* m_mesh;
@@ -290,18 +290,9 @@ gkAnimation* gkAnimationLoader::convertObjectIpoToAnimation(Blender::Ipo* bipo,
 //	return act;
 //}
 
-void gkAnimationLoader::convertAction24(Blender::bAction* action, gkScalar animfps)
+static void convertAction24Channels(gkKeyedAnimation* act, Blender::bAction* action, gkScalar start, gkScalar animfps)
 {
 	// 2.4x actions are always Pose actions 
-	gkKeyedAnimation* act = gkAnimationManager::getSingleton().createKeyedAnimation(gkResourceName(GKB_IDNAME(action), m_groupName));
-	
-	if(!act)
-		return;
-	
-	// min/max
-	gkScalar start, end;
-	get24ActionStartEnd(action, start, end);
-	
 	Blender::bActionChannel* bac = (Blender::bActionChannel*)action->chanbase.first;
 	
 	while (bac)
@@ -314,23 +305,11 @@ void gkAnimationLoader::convertAction24(Blender::bAction* action, gkScalar animf
 				
 		bac = bac->next;
 	}
-	
-	// apply time range
-	act->setLength( (end-start)/animfps);
 }
 
 
-void gkAnimationLoader::convertAction25(Blender::bAction* action, gkScalar animfps)
+static void convertAction25Channels(gkKeyedAnimation* act, Blender::bAction* action, gkScalar start, gkScalar animfps)
 {
-	gkKeyedAnimation* act = gkAnimationManager::getSingleton().createKeyedAnimation(gkResourceName(GKB_IDNAME(action), m_groupName));
-	
-	if(!act)
-		return;
-	
-	// min/max
-	gkScalar start, end;
-	get25ActionStartEnd(action, start, end);
-	
 	Blender::FCurve* bfc = (Blender::FCurve*)action->curves.first;
 	
 	while (bfc)
@@ -414,10 +393,35 @@ void gkAnimationLoader::convertAction25(Blender::bAction* action, gkScalar animf
 		
 		bfc = bfc->next;
 	}
+}
+
+
+gkKeyedAnimation* gkAnimationLoader::createAction(Blender::bAction* action, bool pre25compat, gkScalar animfps, gkScalar& start)
+{
+	gkKeyedAnimation* act = gkAnimationManager::getSingleton().createKeyedAnimation(gkResourceName(GKB_IDNAME(action), m_groupName));
 	
+	if(!act)
+		return 0;
+	
+	// min/max
+	gkScalar end;
+	if (pre25compat)
+		get24ActionStartEnd(action, start, end);
+	else
+		get25ActionStartEnd(action, start, end);
 	
 	// apply time range
 	act->setLength( (end-start)/animfps);
+	return act;
+}
+
+
+void gkAnimationLoader::convertActionChannels(gkKeyedAnimation* act, Blender::bAction* action, bool pre25compat, gkScalar start, gkScalar animfps)
+{
+	if (pre25compat)
+		convertAction24Channels(act, action, start, animfps);
+	else
+		convertAction25Channels(act, action, start, animfps);
 }
 
 
@@ -438,7 +442,7 @@ void gkAnimationLoader::convert25AnimData(gkGameObject* obj, Blender::AnimData*
 		
 		if(!act)
 		{
-			convertAction25(adt->action, animfps);
+			convertAction(adt->action, false, animfps);
 			act =  dynamic_cast<gkAnimation*>(gkAnimationManager::getSingleton().getByName(name));
 		}
 		
@@ -454,10 +458,10 @@ void gkAnimationLoader::convert25AnimData(gkGameObject* obj, Blender::AnimData*
 
 void gkAnimationLoader::convertAction(Blender::bAction* action, bool pre25compat, gkScalar animfps)
 {
-	if(pre25compat)
-		convertAction24(action, animfps);
-	else
-		convertAction25(action, animfps);
+	gkScalar start;
+	gkKeyedAnimation* act = createAction(action, pre25compat, animfps, start);
+	if(act)
+		convertActionChannels(act, action, pre25compat, start, animfps);
 }
 
 
@@ -35,8 +35,6 @@ class gkAnimationLoader
 	const gkResourceNameString	m_groupName;
 
 	gkAnimation* convertObjectIpoToAnimation(Blender::Ipo* bipo, gkScalar animfps);
-	void convertAction24(Blender::bAction* action, gkScalar animfps);
-	void convertAction25(Blender::bAction* action, gkScalar animfps);
 	void convert25AnimData(gkGameObject* obj, Blender::AnimData* adt, gkScalar animfps);
 
 public:
@@ -47,6 +45,12 @@ public:
 	void convertAction(Blender::bAction* action, bool pre25compat, gkScalar animfps);
 	void convertActions(gkBlendListIterator& actions, bool pre25compat, gkScalar animfps);
 
+	// Split form of convertAction. createAction makes the timed, empty resource and must
+	// run on the main thread; convertActionChannels only fills that resource from the
+	// curves and can run on a loader worker.
+	gkKeyedAnimation* createAction(Blender::bAction* action, bool pre25compat, gkScalar animfps, gkScalar& start);
+	static void convertActionChannels(gkKeyedAnimation* act, Blender::bAction* action, bool pre25compat, gkScalar start, gkScalar animfps);
+
 	void convertObject(class gkGameObject* obj, Blender::Object* bobj, bool pre25compat, gkScalar animfps);
 	void convertLamp(class gkGameObject* obj, Blender::Object* bobj, bool pre25compat, gkScalar animfps);
 	void convertCamera(class gkGameObject* obj, Blender::Object* bobj, bool pre25compat, gkScalar animfps);
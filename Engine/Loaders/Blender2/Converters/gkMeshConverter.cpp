@@ -28,6 +28,7 @@
 #include "gkBlenderDefines.h"
 #include "gkMeshConverter.h"
 #include "OgreKit.h"
+#include "Thread/gkCriticalSection.h"
 
 
 #define VEC3CPY(a, b) {a.x= b[0]; a.y= b[1]; a.z= b[2];}
@@ -37,6 +38,11 @@
 #define VEC3CPN(a, b) {a.x= (b[0]/32767.f); a.y= (b[1]/32767.f); a.z= (b[2]/32767.f);}
 
 
+// meshes convert on loader workers, texture face names stay unique
+static gkCriticalSection gkTextureFaceLock;
+static int gkTextureFaceUid = 0;
+
+
 static void gkLoaderUtils_getLayers_legacy(
     Blender::Mesh* mesh,
     Blender::MTFace** eightLayerArray,
@@ -295,10 +301,11 @@ void gkBlenderMeshConverter::convertTextureFace(gkMaterialProperties& gma, gkMes
 	gma.m_mode = hk.m_mode;
 	if (imas)
 	{
-		static char buf[32];
-		static int uid = 0;
-
-		sprintf(buf, "TextureFace %i", (uid++));
+		char buf[32];
+		{
+			gkCriticalSection::Lock guard(gkTextureFaceLock);
+			sprintf(buf, "TextureFace %i", (gkTextureFaceUid++));
+		}
 		gma.m_name = buf;
 	}
 
@@ -52,6 +52,7 @@
 #include "gkTextFile.h"
 #include "gkEngine.h"
 #include "gkUserDefs.h"
+#include "Thread/gkThreadPool.h"
 
 #ifdef OGREKIT_OPENAL_SOUND
 # include "Sound/gkSoundManager.h"
@@ -67,6 +68,80 @@
 
 
 
+// CPU side conversion, resources themselves are created on the main thread
+
+class gkBlendTextureCall : public gkCall
+{
+public:
+	gkBlendTextureCall(gkTextureLoader* loader) : m_loader(loader) {}
+
+	void run() { m_loader->decode(); }
+
+private:
+	gkTextureLoader* m_loader;
+};
+
+
+class gkBlendActionCall : public gkCall
+{
+public:
+	gkBlendActionCall(gkKeyedAnimation* act, Blender::bAction* action, bool pre25compat, gkScalar start, gkScalar animfps)
+		:	m_act(act), m_action(action), m_pre25compat(pre25compat), m_start(start), m_animfps(animfps)
+	{
+	}
+
+	void run() { gkAnimationLoader::convertActionChannels(m_act, m_action, m_pre25compat, m_start, m_animfps); }
+
+private:
+	gkKeyedAnimation* m_act;
+	Blender::bAction* m_action;
+	bool              m_pre25compat;
+	gkScalar          m_start, m_animfps;
+};
+
+
+#ifdef OGREKIT_OPENAL_SOUND
+
+class gkBlendSoundCall : public gkCall
+{
+public:
+	gkBlendSoundCall(gkSound* sound, const gkString& path)
+		:	m_sound(sound), m_path(path), m_data(0), m_size(0)
+	{
+	}
+
+	gkBlendSoundCall(gkSound* sound, void* data, UTsize size)
+		:	m_sound(sound), m_data(data), m_size(size)
+	{
+	}
+
+	void run()
+	{
+		if (m_data)
+		{
+			// load from buffer
+			if (m_sound->load(m_data, m_size))
+				gkLogMessage("Sound: Loaded buffer " << m_sound->getName() << ".");
+		}
+		else
+		{
+			// Attempt to stream from file
+			if (m_sound->load(m_path.c_str()))
+				gkLogMessage("Sound: Loaded file " << m_path << " as" << m_sound->getName() << ".");
+		}
+	}
+
+private:
+	gkSound* m_sound;
+	gkString m_path;
+	void*    m_data;
+	UTsize   m_size;
+};
+
+#endif
+
+
+
 gkBlendFile::gkBlendFile(const gkString& blendToLoad, const gkString& group)
 	:	m_name(blendToLoad),
 		m_group(group),
@@ -76,7 +151,8 @@ gkBlendFile::gkBlendFile(const gkString& blendToLoad, const gkString& group)
 		m_hasBFont(false),
 		m_file(0),
 		m_memoryBlend(0),
-		m_memoryBlendSize(0)
+		m_memoryBlendSize(0),
+		m_pool(0)
 {
 }
 
@@ -89,7 +165,8 @@ gkBlendFile::gkBlendFile(const void* mem, int size, const gkString& group)
 		m_hasBFont(false),
 		m_file(0),
 		m_memoryBlend(mem),
-		m_memoryBlendSize(size)
+		m_memoryBlendSize(size),
+		m_pool(0)
 
 {
 }
@@ -133,11 +210,23 @@ bool gkBlendFile::parse(int opts, const gkString& scene)
 
 	m_findScene = scene;
 
+	gkUserDefs& defs = gkEngine::getSingleton().getUserDefs();
+	if (defs.loaderThreads != 0)
+	{
+		UTsize workers = defs.loaderThreads > 0 ? (UTsize)defs.loaderThreads : gkThreadPool::getHardwareThreads();
+		m_pool = new gkThreadPool("BlendLoader", workers);
+	}
+
 	if (opts & gkBlendLoader::LO_ONLY_ACTIVE_SCENE)
 		loadActive();
 	else
 		createInstances();
 
+	// calls still reference the blend data
+	waitConvert();
+	delete m_pool;
+	m_pool = 0;
+
 	delete m_file;
 	m_file = 0;
 	return true;
@@ -181,6 +270,9 @@ void gkBlendFile::loadActive(void)
 		{
 			gkBlenderSceneConverter conv(this, sc);
 			conv.convert(false);
+
+			// instances copy converted objects
+			waitConvert();
 			conv.convertGroupInstances();
 			m_activeScene = (gkScene*)gkSceneManager::getSingleton().getByName(gkResourceName(GKB_IDNAME(sc), m_group));
 			if (m_activeScene)
@@ -227,6 +319,8 @@ void gkBlendFile::createInstances(void)
 	}
 	// a second pass for creating groupinstances. groups from all scenes have to be converted before the
 	// group-instances can be created.
+	waitConvert();
+
 	iter = m_file->getSceneList();
 	while (iter.hasMoreElements())
 	{
@@ -254,6 +348,34 @@ void gkBlendFile::createInstances(void)
 
 
 
+void gkBlendFile::_enqueueConvert(gkPtrRef<gkCall> call)
+{
+	if (m_pool)
+		m_pool->enqueue(call);
+	else
+		call->run();
+}
+
+
+void gkBlendFile::waitConvert(void)
+{
+	if (m_pool)
+		m_pool->wait();
+
+#ifdef OGREKIT_OPENAL_SOUND
+	gkSoundManager* mgr = gkSoundManager::getSingletonPtr();
+
+	for (UTsize i = 0; i < m_pendingSounds.size(); ++i)
+	{
+		if (!m_pendingSounds[i]->getStream())
+			mgr->destroy(m_pendingSounds[i]);
+	}
+	m_pendingSounds.clear();
+#endif
+}
+
+
+
 gkScene* gkBlendFile::getSceneByName(const gkString& name)
 {
 
@@ -309,6 +431,10 @@ void gkBlendFile::buildTextFiles(void)
 
 void gkBlendFile::buildAllTextures(void)
 {
+	// no render system (headless), images are only needed for drawing
+	if (!Ogre::TextureManager::getSingletonPtr())
+		return;
+
 	gkBlendListIterator iter = m_file->getImageList();
 
 	while (iter.hasMoreElements())	
@@ -331,7 +457,13 @@ void gkBlendFile::buildAllTextures(void)
 				tex = Ogre::TextureManager::getSingleton().create(GKB_IDNAME(ima), m_group, true, loader);
 
 				if (!tex.isNull())
+				{
 					m_loaders.push_back(loader);
+
+					// serial loads keep decoding lazily in loadResource
+					if (m_pool)
+						_enqueueConvert(gkPtrRef<gkCall>(new gkBlendTextureCall(loader)));
+				}
 				else
 					delete loader;
 			}
@@ -438,30 +570,13 @@ void gkBlendFile::buildAllSounds(void)
 				if (!sndObj)
 					continue;
 
-				if (isFile)
-				{
-					// Attempt to stream from file
-					if (!sndObj->load(pth.getPath().c_str()))
-					{
-						mgr->destroy(sndObj);
-						continue;
-					}
+				// failed loads are destroyed in waitConvert
+				m_pendingSounds.push_back(sndObj);
 
-					gkLogMessage("Sound: Loaded file " << pth.getPath() << " as" << GKB_IDNAME(sound) << ".");
-				}
-				else if (pak && pak->data)
-				{
-					// load from buffer
-					if (!sndObj->load(pak->data, pak->size))
-					{
-						mgr->destroy(sndObj);
-						continue;
-					}
-
-					gkLogMessage("Sound: Loaded buffer " << GKB_IDNAME(sound) << ".");
-				}
+				if (isFile)
+					_enqueueConvert(gkPtrRef<gkCall>(new gkBlendSoundCall(sndObj, pth.getPath())));
 				else
-					GK_ASSERT(0);
+					_enqueueConvert(gkPtrRef<gkCall>(new gkBlendSoundCall(sndObj, pak->data, pak->size)));
 			}
 		}
 	}
@@ -498,9 +613,19 @@ void gkBlendFile::buildAllFonts(void)
 void gkBlendFile::buildAllActions(void)
 {
 	gkAnimationLoader anims(m_group);
+	bool pre25compat = m_file->getVersion() <= 249;
 		
-    gkBlendListIterator iter = m_file->getActionList();
-	anims.convertActions(iter, m_file->getVersion() <= 249, m_animFps);
+	gkBlendListIterator iter = m_file->getActionList();
+	while (iter.hasMoreElements())
+	{
+		Blender::bAction* bact = (Blender::bAction*)iter.getNext();
+
+		// the timed resource is created here, curves convert on the pool
+		gkScalar start;
+		gkKeyedAnimation* act = anims.createAction(bact, pre25compat, m_animFps, start);
+		if (act)
+			_enqueueConvert(gkPtrRef<gkCall>(new gkBlendActionCall(act, bact, pre25compat, start, m_animFps)));
+	}
 }
 
 
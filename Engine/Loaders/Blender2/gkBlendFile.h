@@ -34,6 +34,9 @@
 
 //class fbtBlend;
 class gkBlendInternalFile;
+class gkThreadPool;
+class gkCall;
+template <class T> class gkPtrRef;
 
 class gkBlendFile
 {
@@ -63,6 +66,10 @@ public:
 
 	gkBlendInternalFile* _getInternalFile(void) {GK_ASSERT(m_file); return m_file;}
 
+	///Internal, runs CPU side conversion work on the loader pool (or right away when loading serially).
+	///Calls may still read the blend data but must not create resources.
+	void _enqueueConvert(gkPtrRef<gkCall> call);
+
 	///Access to the original group name. Used for placing created resources in the same group.
 	GK_INLINE const gkString& getResourceGroup(void) {return m_group;}
 
@@ -81,6 +88,7 @@ protected:
 
 	void loadActive(void);
 	void createInstances(void);
+	void waitConvert(void);
 
 	void readCurSceneInfo(Blender::Scene* scene);
 
@@ -96,6 +104,10 @@ protected:
 	bool						m_hasBFont;
 	const void*					m_memoryBlend;
 	int							m_memoryBlendSize;
+	gkThreadPool*				m_pool;				// loader workers, alive during parse only
+#ifdef OGREKIT_OPENAL_SOUND
+	utArray<class gkSound*>		m_pendingSounds;	// loading on the pool, destroyed by waitConvert on failure
+#endif
 };
 
 
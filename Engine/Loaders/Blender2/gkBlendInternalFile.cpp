@@ -114,7 +114,10 @@ bool gkBlendInternalFile::parse(const gkString& fname)
 
 #else
 
+	// only what the active scene reaches is linked up front
 	m_file = new fbtBlend();
+	m_file->setLazyLink(true);
+
 	int status = m_file->parse(fname.c_str(), fbtFile::PM_COMPRESSED);
 	if (status != fbtFile::FS_OK)
 	{
@@ -137,6 +140,7 @@ bool gkBlendInternalFile::parse(const void* mem, int size)
 	return false;
 #else
 	m_file = new fbtBlend();
+	m_file->setLazyLink(true);
 
 	// first check to use uncompressed version
 	int status = m_file->parse(mem,size, fbtFile::PM_UNCOMPRESSED,true);
@@ -207,6 +211,7 @@ Blender::Scene* gkBlendInternalFile::getFirstScene()
 		gkBlendListIterator gkBlendInternalFile::FNAME() \
 		{ \
 			GK_ASSERT(m_file); \
+			m_file->linkList(&fbtBlend::FBTNAME); \
 			gkBlendListIterator iter(&m_file->FBTNAME); \
 			return iter; \
 		}
@@ -36,12 +36,35 @@
 #include "gkParticleObject.h"
 #include "gkParticleResource.h"
 #include "OgreKit.h"
+#include "Thread/gkThread.h"
 
 #ifndef OGREKIT_USE_BPARSE
 	#define OGREKIT_USE_FBT
 #endif
 
 
+// triangulation and vertex sharing for one mesh, runs on the blend loader pool
+class gkMeshConvertCall : public gkCall
+{
+public:
+	gkMeshConvertCall(gkMesh* gmesh, Blender::Object* bobj, Blender::Mesh* bmesh)
+		:	m_gmesh(gmesh), m_bobj(bobj), m_bmesh(bmesh)
+	{
+	}
+
+	void run()
+	{
+		gkBlenderMeshConverter meconv(m_gmesh, m_bobj, m_bmesh);
+		meconv.convert();
+	}
+
+private:
+	gkMesh*          m_gmesh;
+	Blender::Object* m_bobj;
+	Blender::Mesh*   m_bmesh;
+};
+
+
 gkBlenderSceneConverter::gkBlenderSceneConverter(gkBlendFile* fp, Blender::Scene* sc)
 	:   m_bscene(sc), m_gscene(0), m_file(fp), m_groupName(fp->getResourceGroup())
 {
@@ -133,6 +156,11 @@ void gkBlenderSceneConverter::convertWorld(void)
 	gkSceneProperties& sprops = m_gscene->getProperties();
 	gkSceneMaterial& props = sprops.m_material;
 
+	if (m_bscene->gm.physubstep > 0)
+		sprops.m_physicsSubSteps = m_bscene->gm.physubstep;
+	if (m_bscene->gm.maxphystep > 0)
+		sprops.m_maxPhysicsSteps = m_bscene->gm.maxphystep;
+
 	if (m_bscene->world)
 	{
 		Blender::World* world = m_bscene->world;
@@ -874,13 +902,33 @@ void gkBlenderSceneConverter::convertObjectMesh(gkGameObject* gobj, Blender::Obj
 	{
 		props.m_mesh = m_gscene->createMesh(GKB_IDNAME(me));
 
-		gkBlenderMeshConverter meconv(props.m_mesh, bobj, me);
-		meconv.convert();
+		m_file->_enqueueConvert(gkPtrRef<gkCall>(new gkMeshConvertCall(props.m_mesh, bobj, me)));
 	}
 	else
 		props.m_mesh = m_gscene->getMesh(GKB_IDNAME(me));
 
 
+	// LOD settings from game properties, the first object naming levels sets them for the mesh
+	if (gobj->hasVariable("lod_distances") && props.m_mesh->getLodDistances().empty())
+	{
+		utStringArray values;
+		utStringUtils::split(values, gobj->getVariable("lod_distances")->getValueString(), " ,;\t");
+
+		gkMesh::LodDistances distances;
+		for (UTsize i = 0; i < values.size(); ++i)
+			distances.push_back(Ogre::StringConverter::parseReal(values[i]));
+
+		gkScalar reduction = 0.5f;
+		if (gobj->hasVariable("lod_reduction"))
+			reduction = gobj->getVariable("lod_reduction")->getValueReal();
+
+		props.m_mesh->setLodLevels(distances, reduction);
+	}
+
+	if (gobj->hasVariable("lod_bias"))
+		props.m_lodBias = gkMax<gkScalar>(gobj->getVariable("lod_bias")->getValueReal(), 0.01f);
+
+
 	props.m_casts = gobj->getProperties().m_physics.isRigidOrDynamic() || !gobj->getProperties().isPhysicsObject();
 
 	Blender::Material* matr = BlenderMaterial(bobj, 0);
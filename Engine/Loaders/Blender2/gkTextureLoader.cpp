@@ -36,7 +36,8 @@
 
 
 gkTextureLoader::gkTextureLoader(Blender::Image* ima)
-	:   m_stream(0)
+	:   m_stream(0),
+	    m_image(0)
 {
 	GK_ASSERT(ima);
 	Blender::PackedFile* pack = ima->packedfile;
@@ -50,10 +51,34 @@ gkTextureLoader::gkTextureLoader(Blender::Image* ima)
 
 gkTextureLoader::~gkTextureLoader()
 {
+	delete m_image;
 	delete m_stream;
 }
 
 
+bool gkTextureLoader::decode(void)
+{
+	if (!m_stream || m_image)
+		return m_image != 0;
+
+	Ogre::Image* ima = new Ogre::Image();
+	try
+	{
+		Ogre::DataStreamPtr stream(OGRE_NEW Ogre::MemoryDataStream(m_stream->ptr(), m_stream->size()));
+		ima->load(stream);
+	}
+	catch (...)
+	{
+		// loadResource decodes again and reports the error
+		delete ima;
+		return false;
+	}
+
+	m_image = ima;
+	return true;
+}
+
+
 void gkTextureLoader::loadResource(Ogre::Resource* resource)
 {
 	Ogre::Texture* texture = static_cast<Ogre::Texture*>(resource);
@@ -64,20 +89,29 @@ void gkTextureLoader::loadResource(Ogre::Resource* resource)
 		return;
 	}
 
-	Ogre::DataStreamPtr stream(OGRE_NEW Ogre::MemoryDataStream(m_stream->ptr(), m_stream->size()));
-
-	Ogre::Image ima;
-	ima.load(stream);
+	// decoded here when the loader pool did not (or failed to), errors go through Ogre
+	Ogre::Image local;
+	Ogre::Image* ima = m_image;
+	if (!ima)
+	{
+		Ogre::DataStreamPtr stream(OGRE_NEW Ogre::MemoryDataStream(m_stream->ptr(), m_stream->size()));
+		local.load(stream);
+		ima = &local;
+	}
 
 	texture->setUsage(Ogre::TU_DEFAULT);
 	texture->setTextureType(Ogre::TEX_TYPE_2D);
 	texture->setNumMipmaps(gkEngine::getSingleton().getUserDefs().defaultMipMap);
-	texture->setWidth(ima.getWidth());
-	texture->setHeight(ima.getHeight());
-	texture->setDepth(ima.getDepth());
-	texture->setFormat(ima.getFormat());
+	texture->setWidth(ima->getWidth());
+	texture->setHeight(ima->getHeight());
+	texture->setDepth(ima->getDepth());
+	texture->setFormat(ima->getFormat());
 
 	Ogre::ConstImagePtrList ptrs;
-	ptrs.push_back(&ima);
+	ptrs.push_back(ima);
 	texture->_loadImages(ptrs);
+
+	// reloads decode again from the packed data
+	delete m_image;
+	m_image = 0;
 }
@@ -29,6 +29,7 @@
 
 #include "gkLoaderCommon.h"
 #include "OgreResource.h"
+#include "OgreImage.h"
 #include "utStreams.h"
 
 
@@ -41,8 +42,13 @@ public:
 
 	void loadResource(Ogre::Resource* resource);
 
+	///Decodes the packed image ahead of loadResource.
+	///Touches no Ogre managers, so it can run on a loader worker thread.
+	bool decode(void);
+
 protected:
 	utMemoryStream*      m_stream;
+	Ogre::Image*         m_image;       // decoded ahead of time, released after upload
 };
 
 
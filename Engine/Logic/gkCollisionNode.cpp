@@ -38,7 +38,8 @@
 
 gkCollisionNode::gkCollisionNode(gkLogicTree* parent, size_t id)
 	: gkLogicNode(parent, id),
-	  m_object(0)
+	  m_object(0),
+	  m_hasBegun(false)
 {
 	ADD_ISOCK(ENABLE, false);
 	ADD_ISOCK(TARGET, 0);
@@ -58,6 +59,7 @@ void gkCollisionNode::initialize()
 	gkScene* pScene = gkEngine::getSingleton().getActiveScene();
 
 	pScene->getDynamicsWorld()->EnableContacts(true);
+	pScene->getDynamicsWorld()->addContactListener(this);
 }
 
 bool gkCollisionNode::evaluate(gkScalar tick)
@@ -90,8 +92,16 @@ void gkCollisionNode::update(gkScalar tick)
 		m_object->enableContactProcessing(true);
 
 		gkContactInfo c;
+		bool hit = m_object->collidesWith(GET_SOCKET_VALUE(COLLIDES_WITH), &c);
 
-		if (m_object->collidesWith(GET_SOCKET_VALUE(COLLIDES_WITH), &c))
+		// touched and left again since the last update
+		if (!hit && m_hasBegun)
+		{
+			c = m_begun;
+			hit = true;
+		}
+
+		if (hit)
 		{
 			SET_SOCKET_VALUE(CONTACT_POSITION, gkVector3(c.point.getPositionWorldOnA()));
 			SET_SOCKET_VALUE(COLLIDED_OBJ, c.collider->getObject());
@@ -104,4 +114,34 @@ void gkCollisionNode::update(gkScalar tick)
 	{
 		m_object->enableContactProcessing(false);
 	}
+
+	m_hasBegun = false;
+}
+
+
+
+void gkCollisionNode::contactBegin(gkPhysicsController* a, gkPhysicsController* b)
+{
+	if (!m_object || (a != m_object && b != m_object) || m_hasBegun)
+		return;
+
+	gkPhysicsController* other = a == m_object ? b : a;
+
+	const gkString& name = GET_SOCKET_VALUE(COLLIDES_WITH);
+	if (!name.empty() && name.find(other->getObject()->getName()) == gkString::npos)
+		return;
+
+	// the table was filled before the event
+	m_hasBegun = m_object->collidesWith(other->getObject(), &m_begun);
+}
+
+
+
+void gkCollisionNode::contactRemoved(gkPhysicsController* cont)
+{
+	if (m_hasBegun && (cont == m_object || cont == m_begun.collider))
+		m_hasBegun = false;
+
+	if (cont == m_object)
+		m_object = 0;
 }
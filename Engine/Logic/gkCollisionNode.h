@@ -29,10 +29,10 @@
 
 #include "LinearMath/btQuickprof.h"
 #include "gkLogicNode.h"
+#include "Physics/gkPhysicsController.h"
 
 
-class gkPhysicsController;
-class gkCollisionNode : public gkLogicNode
+class gkCollisionNode : public gkLogicNode, public gkContactTracker::Listener
 {
 public:
 
@@ -63,10 +63,17 @@ public:
 	void update(gkScalar tick);
 	bool evaluate(gkScalar tick);
 
+	void contactBegin(gkPhysicsController* a, gkPhysicsController* b);
+	void contactRemoved(gkPhysicsController* cont);
+
 private:
 
 	gkPhysicsController* m_object;
 
+	// a contact begun since the last update, it may have ended already
+	gkContactInfo m_begun;
+	bool          m_hasBegun;
+
 	btClock m_timer;
 };
 
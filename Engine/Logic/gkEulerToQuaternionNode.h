@@ -48,6 +48,8 @@ public:
 	{
 		ADD_ISOCK(EUL, gkVector3::ZERO);
 		ADD_OSOCK(QUAT, gkQuaternion::IDENTITY);
+
+		setPure();
 	}
 
 	virtual ~gkEulerToQuaternionNode() {}
@@ -54,6 +54,8 @@ public:
 		ADD_ISOCK(B, T());
 		ADD_OSOCK(IS_TRUE, false);
 		ADD_OSOCK(IS_FALSE, false);
+
+		setPure();
 	}
 
 	virtual ~gkIfNode() {}
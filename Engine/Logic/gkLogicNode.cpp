@@ -34,7 +34,8 @@ using namespace Ogre;
 
 gkLogicNode::gkLogicNode(gkLogicTree* parent, UTsize handle) :
 	m_handle(handle), m_object(0), m_other(0), m_parent(parent),
-	m_hasLinks(false), m_priority(0)
+	m_hasLinks(false), m_priority(0), m_pure(false), m_lastRun(0),
+	m_clock(parent ? parent->_getClock() : 0)
 {
 }
 
@@ -68,6 +68,12 @@ public:
 	GK_INLINE void          setPriority(int v)      {m_priority = v;}
 	GK_INLINE int           getPriority(void)       {return m_priority;}
 
+	// Pure nodes only read their inputs. The compiled tree plan skips
+	// them while none of their inputs changed since the last run.
+	GK_INLINE bool          isPure(void)            {return m_pure;}
+	GK_INLINE gkLogicClock  _getLastRun(void)       {return m_lastRun;}
+	GK_INLINE void          _setLastRun(gkLogicClock v) {m_lastRun = v;}
+
 
 	GK_INLINE Sockets& getInputs(void)  {return m_inputs;}
 	GK_INLINE Sockets& getOutputs(void) {return m_outputs;}
@@ -76,6 +82,7 @@ public:
 	void addISock(gkILogicSocket* dest, T defaultValue)
 	{
 		dest = new gkLogicSocket<T>(this, true, defaultValue);
+		dest->_setClock(m_clock);
 
 		int idx = m_inputs.size() + m_outputs.size();
 
@@ -90,6 +97,7 @@ public:
 	void addOSock(gkILogicSocket* dest, T defaultValue)
 	{
 		dest = new gkLogicSocket<T>(this, false, defaultValue);
+		dest->_setClock(m_clock);
 
 		int idx = m_inputs.size() + m_outputs.size();
 
@@ -134,6 +142,8 @@ public:
 
 
 protected:
+	GK_INLINE void  setPure(void)   {m_pure = true;}
+
 	const UTsize    m_handle;
 	gkGameObject*   m_object, *m_other;
 	gkLogicTree*    m_parent;
@@ -141,6 +151,9 @@ protected:
 	Sockets         m_inputs;
 	Sockets         m_outputs;
 	int             m_priority;
+	bool            m_pure;
+	gkLogicClock    m_lastRun;
+	const gkLogicClock* m_clock;
 
 	gkILogicSocket* m_sockets[N_MAX_SOCKETS];
 };
@@ -57,6 +57,10 @@ void gkILogicSocket::link(gkILogicSocket* fsock)
 
 	fsock->m_connected = m_connected = true;
 
+	// dependents must see the new source at least once
+	touch();
+	fsock->touch();
+
 	if (m_parent)
 	{
 		m_parent->setLinked();
@@ -28,18 +28,42 @@
 #define _gkLogicSocket_h_
 
 #include "gkLogicCommon.h"
+#include "gkMathUtils.h"
+#include "gkString.h"
+
+
+// Compared before a write marks a socket as changed. Types without a
+// cheap comparison always count as changed.
+template<typename T>
+GK_INLINE bool gkSocketChanged(const T& a, const T& b)                       { return true; }
+template<typename T>
+GK_INLINE bool gkSocketChanged(T* const& a, T* const& b)                     { return a != b; }
+GK_INLINE bool gkSocketChanged(const bool& a, const bool& b)                 { return a != b; }
+GK_INLINE bool gkSocketChanged(const int& a, const int& b)                   { return a != b; }
+GK_INLINE bool gkSocketChanged(const gkScalar& a, const gkScalar& b)         { return a != b; }
+GK_INLINE bool gkSocketChanged(const gkVector3& a, const gkVector3& b)       { return a != b; }
+GK_INLINE bool gkSocketChanged(const gkQuaternion& a, const gkQuaternion& b) { return a != b; }
+GK_INLINE bool gkSocketChanged(const gkString& a, const gkString& b)         { return a != b; }
+
+
+// Tree step counter the socket stamps are taken from, 64 bits so it never wraps
+typedef UTuint64 gkLogicClock;
+
+// sockets without a tree clock always look changed
+#define GK_SOCKET_ALWAYS ((gkLogicClock)-1)
+
 
 class gkILogicSocket
 {
 public:
 
 	gkILogicSocket()
-		: m_isInput(true), m_from(0), m_connected(false), m_parent(0)
+		: m_isInput(true), m_from(0), m_clock(0), m_stamp(GK_SOCKET_ALWAYS), m_connected(false), m_parent(0)
 	{
 	}
 
 	gkILogicSocket(gkLogicNode* par, bool isInput)
-		: m_isInput(isInput), m_from(0), m_connected(false), m_parent(par)
+		: m_isInput(isInput), m_from(0), m_clock(0), m_stamp(GK_SOCKET_ALWAYS), m_connected(false), m_parent(par)
 	{
 	}
 
@@ -70,8 +94,30 @@ public:
 		return m_from;
 	}
 
+	// Tree step of the last change, read by the compiled tree plan
+	GK_INLINE gkLogicClock getStamp() const
+	{
+		return m_stamp;
+	}
+
+	GK_INLINE const gkLogicClock* _getClock() const
+	{
+		return m_clock;
+	}
+
+	GK_INLINE void _setClock(const gkLogicClock* clock)
+	{
+		m_clock = clock;
+		m_stamp = clock ? 0 : GK_SOCKET_ALWAYS;
+	}
+
 protected:
 
+	GK_INLINE void touch()
+	{
+		m_stamp = m_clock ? *m_clock : GK_SOCKET_ALWAYS;
+	}
+
 	bool m_isInput;
 
 	typedef utList<gkILogicSocket*> Sockets;
@@ -85,6 +131,9 @@ protected:
 	// from 'this' to sockets (used to link an output socket with one or more than one input socket)
 	Sockets m_to;
 
+	const gkLogicClock* m_clock;
+	gkLogicClock        m_stamp;
+
 private:
 
 	bool m_connected;
@@ -107,35 +156,29 @@ public:
 	{
 	}
 
+	// link() asserts matching socket types, no dynamic_cast per access
+
 	void setValue(const T& value)
 	{
-		if (!m_isInput)
+		if (!m_isInput && !m_to.empty())
 		{
 			SocketIterator sockit(m_to);
 
 			while (sockit.hasMoreElements())
-			{
-				gkLogicSocket<T>* sock = dynamic_cast<gkLogicSocket<T>*>(sockit.getNext());
-
-				GK_ASSERT(sock && "Types have to match");
-
-				sock->setValue(value);
-			}
+				static_cast<gkLogicSocket<T>*>(sockit.getNext())->setValue(value);
 		}
 
-		m_data = value;
+		if (gkSocketChanged(m_data, value))
+		{
+			m_data = value;
+			touch();
+		}
 	}
 
 	T getValue() const
 	{
 		if (m_from)
-		{
-			gkLogicSocket<T>* sock = dynamic_cast<gkLogicSocket<T>*>(m_from);
-
-			GK_ASSERT(sock && "Types have to match");
-
-			return sock->getValue();
-		}
+			return static_cast<gkLogicSocket<T>*>(m_from)->getValue();
 
 		return m_data;
 	}
@@ -143,14 +186,10 @@ public:
 	T& getRefValue()
 	{
 		if (m_from)
-		{
-			gkLogicSocket<T>* sock = dynamic_cast<gkLogicSocket<T>*>(m_from);
-
-			GK_ASSERT(sock && "Types have to match");
-
-			return sock->getRefValue();
-		}
+			return static_cast<gkLogicSocket<T>*>(m_from)->getRefValue();
 
+		// the caller may write through the reference
+		touch();
 		return m_data;
 	}
 
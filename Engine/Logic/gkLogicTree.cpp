@@ -26,6 +26,7 @@
 */
 #include "gkLogicTree.h"
 #include "gkNodeManager.h"
+#include "gkProfiler.h"
 
 using namespace Ogre;
 
@@ -33,7 +34,10 @@ gkLogicTree::gkLogicTree(gkResourceManager *creator, const gkResourceName &name,
 	:	gkResource(creator, name, handle),
 		m_object(0),
 		m_initialized(false), 
-		m_sorted(false)
+		m_sorted(false),
+		m_compiled(false),
+		m_clock(0),
+		m_profileZone(gkProfiler::registerZone("NodeTree " + getName()))
 {
 }
 
@@ -67,6 +71,9 @@ void gkLogicTree::destroyNodes(void)
 			delete iter.getNext();
 	}
 	m_nodes.clear();
+	m_plan.clear();
+	m_planInputs.clear();
+	m_compiled = false;
 	m_uniqueHandle = 0;
 }
 
@@ -167,6 +174,7 @@ void gkLogicTree::solveOrder(bool forceSolve)
 			iter.getNext()->setPriority(0);
 	}
 	m_sorted = true;
+	m_compiled = false;
 
 	gkLogicSolver s;
 	s.solve(this);
@@ -199,6 +207,57 @@ void gkLogicTree::solveOrder(bool forceSolve)
 
 }
 
+void gkLogicTree::compile(void)
+{
+	m_plan.clear();
+	m_planInputs.clear();
+	m_plan.reserve(m_nodes.size());
+
+	NodeIterator iter(m_nodes);
+	while (iter.hasMoreElements())
+	{
+		gkLogicNode* node = iter.getNext();
+
+		PlanStep step = {node, m_planInputs.size(), 0};
+
+		// sockets are fixed at construction, links are read at run time
+		if (node->isPure())
+		{
+			gkLogicNode::SocketIterator sockit(node->getInputs());
+			while (sockit.hasMoreElements())
+			{
+				m_planInputs.push_back(sockit.getNext());
+				step.m_inputCount++;
+			}
+		}
+
+		m_plan.push_back(step);
+	}
+
+	m_compiled = true;
+}
+
+
+static bool gkLogicInputsChanged(gkILogicSocket** inputs, UTsize count, gkLogicClock lastRun)
+{
+	if (lastRun == 0)
+		return true;
+
+	for (UTsize i = 0; i < count; ++i)
+	{
+		gkILogicSocket* sock = inputs[i];
+		if (sock->getStamp() > lastRun)
+			return true;
+
+		// stamps of other trees run on another clock
+		gkILogicSocket* from = sock->getFrom();
+		if (from && (from->getStamp() > lastRun || from->_getClock() != sock->_getClock()))
+			return true;
+	}
+	return false;
+}
+
+
 void gkLogicTree::execute(gkScalar tick)
 {
 	if (m_nodes.empty())
@@ -207,24 +266,48 @@ void gkLogicTree::execute(gkScalar tick)
 		return;
 	}
 
+	GK_PROFILE_ZONE(m_profileZone);
+
 	if (!m_sorted)
 		solveOrder();
 
+	if (!m_compiled)
+		compile();
+
 
 	if (!m_initialized)
 	{
-		NodeIterator iter(m_nodes);
-		while (iter.hasMoreElements())
-			iter.getNext()->initialize();
+		for (UTsize i = 0; i < m_plan.size(); ++i)
+		{
+			m_plan[i].m_node->initialize();
+			m_plan[i].m_node->_setLastRun(0);
+		}
 		m_initialized = true;
 	}
 
-	NodeIterator iter(m_nodes);
-	while (iter.hasMoreElements())
+	PlanStep* steps = m_plan.ptr();
+	gkILogicSocket** inputs = m_planInputs.ptr();
+	const UTsize count = m_plan.size();
+
+	for (UTsize i = 0; i < count; ++i)
 	{
-		gkLogicNode* node = iter.getNext();
+		const PlanStep& step = steps[i];
+		gkLogicNode* node = step.m_node;
+
+		// every step stamps its writes with a new value, so a node sees the
+		// writes of steps before it this tick and of steps after it last tick
+		++m_clock;
+
+		if (step.m_inputCount && !gkLogicInputsChanged(inputs + step.m_firstInput, step.m_inputCount, node->_getLastRun()))
+			continue;
+
 		// can continue
 		if (node->evaluate(tick))
 			node->update(tick);
+
+		node->_setLastRun(m_clock);
 	}
+
+	// writes between ticks are newer than every run
+	++m_clock;
 }
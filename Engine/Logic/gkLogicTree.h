@@ -58,6 +58,7 @@ public:
 	GK_INLINE bool isGroup(void)                    {return !m_name.getName().empty();}
 	GK_INLINE void markDirty(void)                  {m_initialized = false;}
 	GK_INLINE NodeIterator getNodeIterator(void)    {return NodeIterator(m_nodes);}
+	GK_INLINE const gkLogicClock* _getClock(void) const {return &m_clock;}
 
 
 	void attachObject(gkGameObject* ob);
@@ -73,6 +74,7 @@ public:
 		if (m_object) pNode->attachObject(m_object);
 		m_nodes.push_back(pNode);
 		m_uniqueHandle ++;
+		m_compiled = false;
 		return pNode;
 	}
 
@@ -81,11 +83,30 @@ public:
 	void                    freeUnused(void);
 	void                    solveOrder(bool forceSolve = false);
 
+	// lower the sorted node list into the flat execution plan
+	void                    compile(void);
+
 protected:
-	bool                m_initialized, m_sorted;
+
+	struct PlanStep
+	{
+		gkLogicNode*    m_node;
+		UTsize          m_firstInput;   // into m_planInputs, pure nodes only
+		UTsize          m_inputCount;
+	};
+
+	typedef utArray<PlanStep>           Plan;
+	typedef utArray<gkILogicSocket*>    PlanInputs;
+
+
+	bool                m_initialized, m_sorted, m_compiled;
 	size_t              m_uniqueHandle;
 	gkGameObject*       m_object;
 	NodeList            m_nodes;
+	Plan                m_plan;
+	PlanInputs          m_planInputs;
+	gkLogicClock        m_clock;
+	UTsize              m_profileZone;
 };
 
 
@@ -51,6 +51,8 @@ public:
 		ADD_ISOCK(A, T());
 		ADD_ISOCK(B, T());
 		ADD_OSOCK(RESULT, T());
+
+		setPure();
 	}
 
 	virtual ~gkMathNode() {}
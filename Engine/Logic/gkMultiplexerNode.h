@@ -57,6 +57,8 @@ public:
 		ADD_ISOCK(INPUT_TRUE, T());
 		ADD_ISOCK(SEL, false);
 		ADD_OSOCK(OUTPUT, T());
+
+		setPure();
 	}
 
 	virtual ~gkMultiplexerNode() {}
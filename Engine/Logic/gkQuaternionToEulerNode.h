@@ -48,6 +48,8 @@ public:
 	{
 		ADD_ISOCK(QUAT, gkQuaternion::IDENTITY);
 		ADD_OSOCK(EUL, gkVector3::ZERO);
+
+		setPure();
 	}
 
 	virtual ~gkQuaternionToEulerNode() {}
@@ -54,6 +54,8 @@ public:
 		ADD_ISOCK(Y, 0);
 		ADD_ISOCK(Z, 0);
 		ADD_OSOCK(VEC, gkVector3::ZERO);
+
+		setPure();
 	}
 
 	virtual ~gkVectorComposeNode() {}
@@ -54,6 +54,8 @@ public:
 		ADD_OSOCK(X, 0);
 		ADD_OSOCK(Y, 0);
 		ADD_OSOCK(Z, 0);
+
+		setPure();
 	}
 
 	virtual ~gkVectorDecomposeNode() {}
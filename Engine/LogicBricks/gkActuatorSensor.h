@@ -42,6 +42,7 @@ public:
 	gkLogicBrick* clone(gkLogicLink* link, gkGameObject* dest);
 
 	bool query(void);
+	GK_INLINE bool isConcurrent(void) const {return true;}
 	GK_INLINE void            setActuatorName(const gkString& v)       { m_actuatorName = v; }
 	GK_INLINE const gkString& getActuatorName(void)              const { return m_actuatorName;}
 };
@@ -40,6 +40,7 @@ public:
 	gkLogicBrick* clone(gkLogicLink* link, gkGameObject* dest);
 
 	GK_INLINE bool query(void) {return true;}
+	GK_INLINE bool isConcurrent(void) const {return true;}
 };
 
 
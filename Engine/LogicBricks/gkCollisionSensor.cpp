@@ -62,6 +62,7 @@ gkLogicBrick* gkCollisionSensor::clone(gkLogicLink* link, gkGameObject* dest)
 {
 	gkCollisionSensor* sens = new gkCollisionSensor(*this);
 	sens->cloneImpl(link, dest);
+	sens->m_begun.clear();
 	return sens;
 }
 
@@ -72,8 +73,49 @@ bool gkCollisionSensor::query(void)
 	if (!object)
 		return false;
 
+	// contact tables are only kept while the world has listeners
+	if (!getTracker())
+		m_object->getOwner()->getDynamicsWorld()->addContactListener(this);
+
 	bool isTouchSensorTODO = false;
-	return object->sensorCollides(m_prop, m_material, isTouchSensorTODO, isTouchSensorTODO,&m_colObjList);
+	bool result = object->sensorCollides(m_prop, m_material, isTouchSensorTODO, isTouchSensorTODO,&m_colObjList);
 	//OLD-CALL: Just query if there is a collision! What objects collide is not registered
 	//return object->sensorCollides(m_prop, m_material, isTouchSensorTODO, isTouchSensorTODO);
+
+	// touched and left again since the last query
+	for (UTsize i = 0; i < m_begun.size(); ++i)
+	{
+		gkGameObject* ob = m_begun[i];
+		if (m_colObjList.find(ob) == UT_NPOS && gkPhysicsController::sensorTest(ob, m_prop, m_material, isTouchSensorTODO, isTouchSensorTODO))
+		{
+			m_colObjList.push_back(ob);
+			result = true;
+		}
+	}
+	m_begun.resize(0);
+
+	return result;
+}
+
+
+
+void gkCollisionSensor::contactBegin(gkPhysicsController* a, gkPhysicsController* b)
+{
+	gkPhysicsController* object = m_object->getPhysicsController();
+	if (!object || (a != object && b != object) || !object->_isContactListener())
+		return;
+
+	gkGameObject* ob = (a == object ? b : a)->getObject();
+	if (m_begun.find(ob) == UT_NPOS)
+		m_begun.push_back(ob);
+}
+
+
+
+void gkCollisionSensor::contactRemoved(gkPhysicsController* cont)
+{
+	if (cont == m_object->getPhysicsController())
+		m_begun.resize(0);
+	else
+		m_begun.erase(cont->getObject());
 }
@@ -42,10 +42,13 @@ public:
 };
 
 
-class gkCollisionSensor : public gkLogicSensor
+// Listens to its world's contact events from the first query on, so that
+// objects touching only between two queries are still reported.
+class gkCollisionSensor : public gkLogicSensor, public gkDynamicsWorld::ContactListener
 {
 protected:
 	utArray<gkGameObject*> m_colObjList;
+	utArray<gkGameObject*> m_begun;   // contacts begun since the last query
 	gkString m_material, m_prop;
 
 
@@ -58,6 +61,12 @@ public:
 
 	bool query(void);
 
+	// the first query joins the world's listeners, which is not thread safe
+	GK_INLINE bool isConcurrent(void) const {return getTracker() != 0;}
+
+	void contactBegin(gkPhysicsController* a, gkPhysicsController* b);
+	void contactRemoved(gkPhysicsController* cont);
+
 	GK_INLINE void            setMaterial(const gkString& material)       {m_material = material;}
 	GK_INLINE void            setProperty(const gkString& prop)           {m_prop = prop;}
 	GK_INLINE const gkString& getMaterial(void)                     const {return m_material;}
@@ -42,6 +42,7 @@ public:
 	gkLogicBrick* clone(gkLogicLink* link, gkGameObject* dest);
 
 	bool query(void);
+	GK_INLINE bool isConcurrent(void) const {return true;}
 	GK_INLINE void setDelay(unsigned int v)    {m_delay = v;}
 	GK_INLINE void setDuration(unsigned int v) {m_duration = v;}
 	GK_INLINE void setRepeat(bool v)           {m_repeat = v;}
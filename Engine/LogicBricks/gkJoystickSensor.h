@@ -76,6 +76,7 @@ public:
 	gkLogicBrick* clone(gkLogicLink* link, gkGameObject* dest);
 
 	bool query(void);
+	GK_INLINE bool isConcurrent(void) const {return true;}
 
 	GK_INLINE void setJoystickIndex(unsigned int v)    {m_joystickIndex  = v;}
 	GK_INLINE void setElementIndex(unsigned int v)     {m_elementIndex = v;}
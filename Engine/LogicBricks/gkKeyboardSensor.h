@@ -57,6 +57,7 @@ public:
 	gkLogicBrick* clone(gkLogicLink* link, gkGameObject* dest);
 
 	bool query(void);
+	GK_INLINE bool isConcurrent(void) const {return true;}
 
 
 	GK_INLINE void setKey(int v)      {m_key  = v;}
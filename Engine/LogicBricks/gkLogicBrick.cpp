@@ -28,10 +28,12 @@
 #include "gkGameObject.h"
 #include "gkLogicLink.h"
 #include "gkLogicManager.h"
+#include "gkProfiler.h"
 
 gkLogicBrick::gkLogicBrick(gkGameObject* object, gkLogicLink* link, const gkString& name)
 	:       m_object(object), m_name(name), m_link(link), m_stateMask(0), m_pulseState(BM_IDLE),
-	        m_debugMask(0), m_isActive(false), m_priority(0), m_listener(0)
+	        m_debugMask(0), m_isActive(false), m_priority(0), m_listener(0),
+	        m_profileZone(UT_NPOS)
 {
 	GK_ASSERT(m_object);
 	m_scene = m_object->getOwner();
@@ -44,6 +46,11 @@ gkLogicBrick::~gkLogicBrick()
 
 void gkLogicBrick::cloneImpl(gkLogicLink* link, gkGameObject* dest)
 {
+	// clones time under the zone of the brick they were copied from
+	gkProfiler* profiler = gkProfiler::getSingletonPtr();
+	if (profiler && profiler->isDetailed())
+		m_profileZone = _getProfileZone();
+
 	m_object        = dest;
 	m_scene         = m_object->getOwner();
 	m_pulseState    = BM_IDLE;
@@ -88,3 +95,12 @@ const gkString& gkLogicBrick::getObjectGroupName(void) const
 {
 	return m_object->getGroupName();
 }
+
+
+
+UTsize gkLogicBrick::_getProfileZone(void)
+{
+	if (m_profileZone == UT_NPOS)
+		m_profileZone = gkProfiler::registerZone(m_object->getName() + "." + m_name);
+	return m_profileZone;
+}
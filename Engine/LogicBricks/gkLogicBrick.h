@@ -92,6 +92,7 @@ protected:
 	bool                m_isActive;
 	int                 m_priority;
 	Listener*           m_listener;
+	UTsize              m_profileZone;
 
 	virtual void        cloneImpl(gkLogicLink* link, gkGameObject* dest);
 	virtual void        notifyActiveStatus(void) {}
@@ -137,6 +138,9 @@ public:
 	void setPriority(int v);
 
 	const gkString&				getObjectGroupName(void) const;
+
+	// gkProfiler zone, "<object>.<brick>" of the object the brick was authored on
+	UTsize _getProfileZone(void);
 };
 
 
@@ -50,6 +50,24 @@ void gkAbstractDispatcher::doDispatch(SensorList& senslist)
 
 
 
+void gkAbstractDispatcher::collect(SensorList& out)
+{
+	if (!m_sensors.empty())
+	{
+		SensorList::Iterator it = m_sensors.iterator();
+		while (it.hasMoreElements())
+		{
+			gkLogicSensor*   sens = it.getNext();
+			gkGameObject*    obj = sens->getObject();
+
+			if (obj && obj->isInstanced())
+				out.push_back(sens);
+		}
+	}
+}
+
+
+
 void gkAbstractDispatcher::reset(void)
 {
 	if (!m_sensors.empty())
@@ -53,6 +53,9 @@ public:
 	void sort(void);
 	void reset(void);
 
+	///Appends the sensors dispatch() would execute, in the same order.
+	void collect(SensorList& out);
+
 
 	GK_INLINE void connect(gkLogicSensor* sens)      {GK_ASSERT(sens); m_sensors.push_back(sens); }
 	GK_INLINE void disconnect(gkLogicSensor* sens)   {GK_ASSERT(sens); m_sensors.erase(sens); }
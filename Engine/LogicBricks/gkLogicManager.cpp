@@ -36,6 +36,11 @@
 #include "gkLogger.h"
 #include "gkDebugScreen.h"
 #include "gkEngine.h"
+#include "gkProfiler.h"
+#include "gkUserDefs.h"
+#include "gkGameObject.h"
+#include "gkDynamicsWorld.h"
+#include "Thread/gkThreadPool.h"
 
 
 
@@ -62,6 +67,7 @@ gkLogicManager::~gkLogicManager()
 
 	delete []m_dispatchers;
 	m_dispatchers = 0;
+
 	m_logicManagers->erase(this);
 }
 
@@ -180,6 +186,9 @@ gkLogicLink* gkLogicManager::createLink(void)
 
 #define GK_DEBUG_EXEC 1
 
+// brick debug text for the debug screen, queued off the logic thread
+#define gkExecPrintf(...) gkLogf(GK_LOG_INFO, GK_LOG_LOGIC | GK_LOG_SCREEN, __VA_ARGS__)
+
 
 void gkLogicManager::push(gkLogicSensor* a, gkLogicController* b, bool stateValue)
 {
@@ -187,7 +196,7 @@ void gkLogicManager::push(gkLogicSensor* a, gkLogicController* b, bool stateValu
 	{
 #ifdef GK_DEBUG_EXEC
 		if (b->wantsDebug())
-			dsPrintf("Push: Sensor %s to Controller %s: %s\n", a->getName().c_str(), b->getName().c_str(), (stateValue ? "On" : "Off"));
+			gkExecPrintf("Push: Sensor %s to Controller %s: %s\n", a->getName().c_str(), b->getName().c_str(), (stateValue ? "On" : "Off"));
 #endif
 		push(b, a, m_cin, stateValue);
 	}
@@ -201,7 +210,7 @@ void gkLogicManager::push(gkLogicController* ctrl, gkLogicActuator* act, bool st
 	{
 #ifdef GK_DEBUG_EXEC
 		if (act->wantsDebug())
-			dsPrintf("Push: Controller %s to Actuator %s: %s\n", ctrl->getName().c_str(), act->getName().c_str(), (stateValue ? "On" : "Off"));
+			gkExecPrintf("Push: Controller %s to Actuator %s: %s\n", ctrl->getName().c_str(), act->getName().c_str(), (stateValue ? "On" : "Off"));
 #endif
 
 
@@ -257,7 +266,7 @@ void gkLogicManager::notifyState(unsigned int state, gkLogicLink* link)
 #ifdef GK_DEBUG_EXEC
 			if (f == 0 && b[i]->wantsDebug())
 			{
-				dsPrintf("===== State Change %i =====\n", state);
+				gkExecPrintf("===== State Change %i =====\n", state);
 				f = 1;
 			}
 #endif
@@ -267,7 +276,7 @@ void gkLogicManager::notifyState(unsigned int state, gkLogicLink* link)
 				m_aout.push_back(b[i]);
 #ifdef GK_DEBUG_EXEC
 				if (b[i]->wantsDebug())
-					dsPrintf("Pop:  State %s\n", b[i]->getName().c_str());
+					gkExecPrintf("Pop:  State %s\n", b[i]->getName().c_str());
 #endif
 			}
 			++i;
@@ -322,7 +331,7 @@ void gkLogicManager::clearActuators(void)
 		{
 #ifdef GK_DEBUG_EXEC
 			if (b[i]->wantsDebug())
-				dsPrintf("Pop:  Actuator %s\n", b[i]->getName().c_str());
+				gkExecPrintf("Pop:  Actuator %s\n", b[i]->getName().c_str());
 #endif
 			b[i]->setActive(false);
 			m_ain.erase(b[i]);
@@ -348,6 +357,85 @@ void gkLogicManager::sort(void)
 
 
 
+class gkSensorQueryCall : public gkCall
+{
+public:
+	gkSensorQueryCall(gkLogicSensor** sensors, UTsize count)
+		:	m_sensors(sensors), m_count(count)
+	{
+	}
+
+	void run()
+	{
+		for (UTsize i = 0; i < m_count; ++i)
+			m_sensors[i]->_queryAhead();
+	}
+
+private:
+	gkLogicSensor** m_sensors;
+	UTsize          m_count;
+};
+
+
+
+void gkLogicManager::querySensors(gkThreadPool* pool)
+{
+	UTsize i, s;
+
+	m_sensors.resize(0);
+	m_concurrent.resize(0);
+
+	for (i = 0; i < DIS_MAX; ++i)
+		m_dispatchers[i]->collect(m_sensors);
+
+	// headers in dispatch order, keeping the sensors due a query
+	s = 0;
+	for (i = 0; i < m_sensors.size(); ++i)
+	{
+		gkLogicSensor* sens = m_sensors[i];
+		if (!sens->_prepare())
+			continue;
+
+		m_sensors[s++] = sens;
+
+		gkDynamicsWorld* world = sens->queue();
+		if (world && m_batchWorlds.find(world) == UT_NPOS)
+			m_batchWorlds.push_back(world);
+
+		if (sens->_isConcurrent())
+		{
+			// Ogre derives world transforms on first access, do it here so workers only read
+			gkGameObject* obj = sens->getObject();
+			obj->getWorldPosition();
+			obj->getWorldOrientation();
+
+			m_concurrent.push_back(sens);
+		}
+	}
+	m_sensors.resize(s);
+
+	// one batch per world for every ray queued above
+	for (i = 0; i < m_batchWorlds.size(); ++i)
+		m_batchWorlds[i]->runBatch();
+	m_batchWorlds.resize(0);
+
+	// small batches aren't worth waking the workers
+	const UTsize count = m_concurrent.size(), chunk = 64;
+
+	if (pool && count > chunk)
+	{
+		for (i = 0; i < count; i += chunk)
+			pool->enqueue(gkPtrRef<gkCall>(new gkSensorQueryCall(m_concurrent.ptr() + i, gkMin(chunk, count - i))));
+		pool->wait();
+	}
+
+	// the rest queries here, then pulses go to the controllers in the usual order
+	for (i = 0; i < m_sensors.size(); ++i)
+		m_sensors[i]->_finish(m_sensors[i]->_evaluate());
+}
+
+
+
 void gkLogicManager::update(gkScalar delta)
 {
 
@@ -360,9 +448,22 @@ void gkLogicManager::update(gkScalar delta)
 		m_sort = false;
 	}
 
-	i = 0;
-	while (i < DIS_MAX)
-		m_dispatchers[i++]->dispatch();
+	gkProfiler* profiler = gkProfiler::getSingletonPtr();
+	const bool brickZones = profiler && profiler->isDetailed();
+
+	{
+		GK_PROFILE("Sensors");
+
+		gkEngine& engine = gkEngine::getSingleton();
+		if (engine.getUserDefs().logicThreads != 0)
+			querySensors(engine.getSensorPool());
+		else
+		{
+			i = 0;
+			while (i < DIS_MAX)
+				m_dispatchers[i++]->dispatch();
+		}
+	}
 
 	if (!m_cin.empty())
 	{
@@ -370,6 +471,7 @@ void gkLogicManager::update(gkScalar delta)
 		b = m_cin.ptr();
 		while (i < s)
 		{
+			GK_PROFILE_ZONE(brickZones ? b[i]->_getProfileZone() : UT_NPOS);
 			static_cast<gkLogicController*>(b[i])->_execute();
 			b[i]->setActive(false);
 			++i;
@@ -383,6 +485,7 @@ void gkLogicManager::update(gkScalar delta)
 		b = m_ain.ptr();
 		while (i < s)
 		{
+			GK_PROFILE_ZONE(brickZones ? b[i]->_getProfileZone() : UT_NPOS);
 			static_cast<gkLogicActuator*>(b[i])->_execute();
 			if (b[i]->isPulseOff())
 				m_aout.push_back(b[i]);
@@ -37,6 +37,7 @@ class gkLogicController;
 class gkLogicActuator;
 class gkLogicLink;
 class gkAbstractDispatcher;
+class gkThreadPool;
 
 
 enum gkDispatchedTypes
@@ -63,6 +64,7 @@ public:
 	typedef utHashSet<gkLogicBrick*> BrickSet;
 	typedef utList<gkLogicActuator*> TickActuators;
 	typedef utList<gkLogicManager*>	LogicManagerList;
+	typedef utArray<gkLogicSensor*> Sensors;
 protected:
 
 	static LogicManagerList* m_logicManagers;
@@ -77,8 +79,17 @@ protected:
 	TickActuators 				m_tickActuators; // actuators that get processed by the controller.
 											//  This list makes it possible to set the actuator-state to false and only change to true if needed
 
+	// sensors due this tick / the ones queried ahead on the engine's sensor pool
+	Sensors                     m_sensors, m_concurrent;
+
+	// worlds with rays queued by the sensors due this tick
+	utArray<gkDynamicsWorld*>   m_batchWorlds;
+
 	void push(gkLogicBrick* a, gkLogicBrick* b, Bricks& in, bool stateValue);
 
+	// dispatch() split in phases, concurrent sensor queries run on the workers
+	void querySensors(gkThreadPool* pool);
+
 	void clearActuators(void);
 	void clearActive(gkLogicLink* link);
 
@@ -46,6 +46,7 @@ gkLogicSensor::gkLogicSensor(gkGameObject* object, gkLogicLink* link, const gkSt
 	        m_sorted(false), m_isDetector(false),
 	        m_oldState(-1),
 	        m_firstTap(TAP_IN), m_lastTap(TAP_OUT),
+	        m_preDispatch(false), m_hasResult(false), m_result(false),
 	        m_dispatchType(-1)
 {
 }
@@ -133,6 +134,14 @@ bool gkLogicSensor::isPositive(void) const
 
 
 void gkLogicSensor::execute(void)
+{
+	if (_prepare())
+		_finish(_evaluate());
+}
+
+
+
+bool gkLogicSensor::_prepare(void)
 {
 	if (!inActiveState())
 	{
@@ -143,13 +152,13 @@ void gkLogicSensor::execute(void)
 			m_firstExec = true;
 			m_positive  = false;
 		}
-		return;
+		return false;
 	}
 
 	if (m_suspend || m_controllers.empty())
-		return;
+		return false;
 
-	bool doDispatch = false, detDispatch = false;
+	m_preDispatch = false;
 	if (m_oldState != m_link->getState())
 	{
 		m_firstExec = true;
@@ -158,7 +167,7 @@ void gkLogicSensor::execute(void)
 
 		m_oldState = m_link->getState();
 		if (m_isDetector)
-			doDispatch = true;
+			m_preDispatch = true;
 	}
 
 	bool doQuery = false;
@@ -168,88 +177,104 @@ void gkLogicSensor::execute(void)
 		m_tick = 0;
 	}
 
+	return doQuery;
+}
+
+
 
-	if (doQuery)
+bool gkLogicSensor::_evaluate(void)
+{
+	if (m_hasResult)
 	{
-		// Sensor detection.
-		bool lp = m_positive;
+		m_hasResult = false;
+		return m_result;
+	}
 
-		if (m_listener)
-		{
-			if (m_listener->m_mode == gkLogicBrick::Listener::OVERIDE)
-				m_positive = m_listener->executeEvent(this);
-			else
-				m_positive = m_listener->executeEvent(this) && query();
-		}
+	// Sensor detection.
+	if (m_listener)
+	{
+		if (m_listener->m_mode == gkLogicBrick::Listener::OVERIDE)
+			return m_listener->executeEvent(this);
 		else
-			m_positive = query();
+			return m_listener->executeEvent(this) && query();
+	}
+	return query();
+}
 
-		// Sensor Pulse.
-		if (m_pulse == PM_IDLE)
-			doDispatch = lp != m_positive;
-		else
+
+
+void gkLogicSensor::_finish(bool result)
+{
+	bool doDispatch = m_preDispatch, detDispatch = false, doQuery;
+
+	bool lp = m_positive;
+	m_positive = result;
+
+	// Sensor Pulse.
+	if (m_pulse == PM_IDLE)
+		doDispatch = lp != m_positive;
+	else
+	{
+		if (m_pulse & PM_TRUE)
 		{
-			if (m_pulse & PM_TRUE)
-			{
-				if (!m_invert)
-					doDispatch = (lp != m_positive) || m_positive;
-				else
-					doDispatch = (lp != m_positive) || !m_positive;
-			}
-			if (m_pulse & PM_FALSE)
-			{
-				if (!m_invert)
-					doDispatch = (lp != m_positive) || !m_positive;
-				else
-					doDispatch = (lp != m_positive) || m_positive;
-			}
+			if (!m_invert)
+				doDispatch = (lp != m_positive) || m_positive;
+			else
+				doDispatch = (lp != m_positive) || !m_positive;
 		}
-
-		// Tap mode (Switch On->Switch Off)
-		if (m_tap && !(m_pulse & PM_TRUE))
+		if (m_pulse & PM_FALSE)
 		{
-			doQuery = m_positive;
-			if (m_invert)
-				doQuery = !doQuery;
-
-			doDispatch = false;
-			m_pulseState = BM_OFF;
-
-			if (m_firstTap == TAP_IN && doQuery)
-			{
-				doDispatch = true;
-				m_positive = true;
-				m_pulseState = BM_ON;
-				m_firstTap = TAP_OUT;
-				m_lastTap = TAP_IN;
-			}
-			else if (m_lastTap == TAP_IN)
-			{
-				m_positive = false;
-				doDispatch = true;
-				m_lastTap = TAP_OUT;
-			}
+			if (!m_invert)
+				doDispatch = (lp != m_positive) || !m_positive;
 			else
-			{
-				m_positive = false;
-				if (!doQuery)
-					m_firstTap  = TAP_IN;
-			}
+				doDispatch = (lp != m_positive) || m_positive;
 		}
-		else m_pulseState = isPositive() ? BM_ON : BM_OFF;
+	}
+
+	// Tap mode (Switch On->Switch Off)
+	if (m_tap && !(m_pulse & PM_TRUE))
+	{
+		doQuery = m_positive;
+		if (m_invert)
+			doQuery = !doQuery;
 
-		if (m_firstExec)
+		doDispatch = false;
+		m_pulseState = BM_OFF;
+
+		if (m_firstTap == TAP_IN && doQuery)
+		{
+			doDispatch = true;
+			m_positive = true;
+			m_pulseState = BM_ON;
+			m_firstTap = TAP_OUT;
+			m_lastTap = TAP_IN;
+		}
+		else if (m_lastTap == TAP_IN)
+		{
+			m_positive = false;
+			doDispatch = true;
+			m_lastTap = TAP_OUT;
+		}
+		else
 		{
-			m_firstExec = false;
-			if (m_invert && !doDispatch)
-				doDispatch = true;
+			m_positive = false;
+			if (!doQuery)
+				m_firstTap  = TAP_IN;
 		}
-		if (!doDispatch)
-			doDispatch = detDispatch;
+	}
+	else m_pulseState = isPositive() ? BM_ON : BM_OFF;
 
-		// Dispatch results
-		if (doDispatch) dispatch();
+	if (m_firstExec)
+	{
+		m_firstExec = false;
+		if (m_invert && !doDispatch)
+			doDispatch = true;
 	}
+	if (!doDispatch)
+		doDispatch = detDispatch;
+
+	// Dispatch results
+	if (doDispatch) dispatch();
 }
 
 void gkLogicSensor::dispatch(void)
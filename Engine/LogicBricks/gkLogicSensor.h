@@ -59,6 +59,9 @@ protected:
 	// tap detection
 	int m_firstTap, m_lastTap;
 
+	// split execute() state, see gkLogicManager::querySensors
+	bool    m_preDispatch, m_hasResult, m_result;
+
 
 	void cloneImpl(gkLogicLink* link, gkGameObject* dest);
 
@@ -77,6 +80,24 @@ public:
 
 	virtual bool query(void) = 0;
 
+	///True when query() only reads the scene and its own state,
+	///so it may run on a worker while other sensors are queried.
+	virtual bool isConcurrent(void) const {return false;}
+
+	///Called serially ahead of query() when one is due. Sensors casting rays
+	///queue them here and return the world, its batch runs before the queries.
+	virtual gkDynamicsWorld* queue(void) {return 0;}
+
+	///execute() in three steps: header update (true when a query is due),
+	///the query itself, pulse handling and dispatch.
+	bool _prepare(void);
+	bool _evaluate(void);
+	void _finish(bool result);
+
+	///Query ahead of _evaluate() from a worker.
+	GK_INLINE void _queryAhead(void)               {m_result = query(); m_hasResult = true;}
+	GK_INLINE bool _isConcurrent(void) const       {return !m_listener && isConcurrent();}
+
 	void sort(void);
 
 	///Reset the sensor's header to initial state.
@@ -50,20 +50,23 @@ void gkMessageActuator::execute(void)
 	if (isPulseOff())
 		return;
 
-	gkString from, body;
+	gkMessageManager& mgr = gkMessageManager::getSingleton();
 
-	from = m_object->getName();
+	gkMessageManager::Id from    = mgr.intern(m_object->getName());
+	gkMessageManager::Id to      = mgr.intern(m_to);
+	gkMessageManager::Id subject = mgr.intern(m_subject);
 
 	if (m_bodyType == BT_TEXT)
 	{
-		body = m_bodyText;
+		mgr.sendMessage(from, to, subject, m_bodyText.c_str(), m_bodyText.size());
 	}
 	else if (m_bodyType == BT_PROP && m_object->hasVariable(m_bodyProp))
 	{
-		body = m_object->getVariable(m_bodyProp)->getValueString();
+		gkString body = m_object->getVariable(m_bodyProp)->getValueString();
+		mgr.sendMessage(from, to, subject, body.c_str(), body.size());
 	}
-
-	gkMessageManager::getSingleton().sendMessage(from, m_to, m_subject, body);
+	else
+		mgr.sendMessage(from, to, subject, "", 0);
 
 	setPulse(BM_OFF);
 }
@@ -45,8 +45,12 @@ gkMessageSensor::gkMessageSensor(gkGameObject* object, gkLogicLink* link, const
 
 gkMessageSensor::~gkMessageSensor()
 {
-	gkMessageManager::getSingleton().removeListener(m_listener);
+	gkMessageManager& mgr = gkMessageManager::getSingleton();
+	mgr.removeListener(m_listener);
 	delete m_listener;
+
+	for (UTsize i = 0; i < m_messages.size(); ++i)
+		mgr.release(m_messages[i]);
 	m_messages.clear();
 }
 
@@ -55,7 +59,9 @@ gkLogicBrick* gkMessageSensor::clone(gkLogicLink* link, gkGameObject* dest)
 {
 	gkMessageSensor* sens = new gkMessageSensor(*this);
 	sens->cloneImpl(link, dest);
-	sens->m_listener = new gkMessageManager::GenericMessageListener("", "", m_listener->m_subjectFilter);
+	sens->m_messages.clear(); // not retained by the clone
+	sens->m_listener = new gkMessageManager::GenericMessageListener("", dest->getName(), m_listener->getSubjectFilter());
+	sens->m_listener->setAcceptEmptyTo(true);
 	gkMessageManager::getSingleton().addListener(sens->m_listener);
 	return sens;
 }
@@ -63,29 +69,16 @@ gkLogicBrick* gkMessageSensor::clone(gkLogicLink* link, gkGameObject* dest)
 
 bool gkMessageSensor::query(void)
 {
-	bool ret = false;
+	gkMessageManager& mgr = gkMessageManager::getSingleton();
 
-	m_messages.clear();
+	for (UTsize i = 0; i < m_messages.size(); ++i)
+		mgr.release(m_messages[i]);
+	m_messages.resize(0);
+
+	// The listener only takes messages to this object or to everyone. Its
+	// copies stay retained until the next query, so that Logic scripts can
+	// read them however long the sensor waited between queries.
+	m_listener->takeMessages(m_messages);
 
-	if (m_listener->m_messages.size() > 0 )
-	{
-		ret = true;
-
-		// We copy the massages so that Logic scripts can retrieve messages recieved between each logic step
-		utArrayIterator<utArray<gkMessageManager::Message> > iter(m_listener->m_messages);
-		while (iter.hasMoreElements())
-		{
-			gkMessageManager::Message m = iter.peekNext();
-			if (m.m_to==""
-					|| m.m_to == m_object->getName())
-			{
-				m_messages.push_back(m);
-			}
-			iter.getNext();
-		}
-	}
-
-	m_listener->emptyMessages();
-
-	return ret;
+	return !m_messages.empty();
 }
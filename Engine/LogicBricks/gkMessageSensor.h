@@ -47,10 +47,11 @@ public:
 	gkLogicBrick* clone(gkLogicLink* link, gkGameObject* dest);
 
 	bool query(void);
-	GK_INLINE void            setSubject(const gkString& v)       {m_listener->m_subjectFilter = v;}
-	GK_INLINE const gkString& getSubject(void)              const {return m_listener->m_subjectFilter;}
+	GK_INLINE bool isConcurrent(void) const {return true;}
+	GK_INLINE void            setSubject(const gkString& v)       {m_listener->setSubjectFilter(v);}
+	GK_INLINE const gkString& getSubject(void)              const {return m_listener->getSubjectFilter();}
 	GK_INLINE int getMessageCount() { return m_messages.size();}
-	GK_INLINE gkMessageManager::Message getMessage(int nr) { return m_messages.at(nr);}
+	GK_INLINE const gkMessageManager::Message& getMessage(int nr) { return m_messages.at(nr);}
 
 };
 
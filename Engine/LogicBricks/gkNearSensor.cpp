@@ -31,7 +31,6 @@
 #include "gkGameObject.h"
 #include "gkPhysicsController.h"
 #include "gkScene.h"
-#include "gkContactTest.h"
 #include "btBulletDynamicsCommon.h"
 #include "btBulletCollisionCommon.h"
 
@@ -53,6 +52,14 @@ gkLogicBrick* gkNearSensor::clone(gkLogicLink* link, gkGameObject* dest)
 
 
 
+bool gkNearSensor::isConcurrent(void) const
+{
+	// the debug shape is drawn from query()
+	return !m_object->getOwner()->getDynamicsWorld()->getBulletWorld()->getDebugDrawer();
+}
+
+
+
 bool gkNearSensor::query(void)
 {
 	m_nearObjList.clear();
@@ -61,49 +68,29 @@ bool gkNearSensor::query(void)
 
 	btDynamicsWorld* btw = dyn->getBulletWorld();
 
-	gkVector3 vec = m_object->getWorldPosition();
-
-	gkAllContactResultCallback exec;
-
-	btTransform btt;
-	btt.setIdentity();
-	btt.setOrigin(btVector3(vec.x, vec.y, vec.z));
-
-	btSphereShape btss(m_range);
-	if (m_previous)
-		btss.setUnscaledRadius(m_resetrange);
-
-	btCollisionObject btco = btCollisionObject();
-	btco.setCollisionShape(&btss);
-	btco.setWorldTransform(btt);
-
-	btw->contactTest( &btco, exec);
+	const gkVector3 vec = m_object->getWorldPosition();
+	const gkScalar range = m_previous ? m_resetrange : m_range;
 
 	if (btw->getDebugDrawer())
-		btw->debugDrawObject(btt, &btss, btVector3(0, 1, 0));
-
-	if (!exec.hasHit())
-		return m_previous = false;
-	if (exec.m_contactObjects.empty())
-		return m_previous = false;
+	{
+		btTransform btt;
+		btt.setIdentity();
+		btt.setOrigin(gkMathUtils::get(vec));
 
-//	if (m_material.empty() && m_prop.empty())
-//		return m_previous = true;
+		btSphereShape btss(range);
+		btw->debugDrawObject(btt, &btss, btVector3(0, 1, 0));
+	}
 
-	utArray<const btCollisionObject*> contacts = exec.m_contactObjects;
-	utArrayIterator< utArray<const btCollisionObject*> > iter(contacts);
+	// shared with every other sensor asking the same sphere this step
+	const gkDynamicsWorld::QueryResult& hits = dyn->querySphere(vec, range);
 
-	while (iter.hasMoreElements())
+	for (UTsize i = 0; i < hits.size(); ++i)
 	{
-		gkGameObject* ob = gkPhysicsController::castObject(iter.peekNext());
-		if (ob!=m_object && gkPhysicsController::sensorTest(ob, m_prop, m_material)){
-			if (m_nearObjList.find(ob)==UT_NPOS){
-				m_nearObjList.push_back(ob);
-			}
-		}
-
-		iter.getNext();
+		gkGameObject* ob = hits[i];
+		if (ob != m_object && gkPhysicsController::sensorTest(ob, m_prop, m_material))
+			m_nearObjList.push_back(ob);
 	}
+
 	if (m_nearObjList.empty())
 		return m_previous = false;
 	else
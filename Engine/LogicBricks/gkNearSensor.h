@@ -46,6 +46,7 @@ public:
 	gkLogicBrick* clone(gkLogicLink* link, gkGameObject* dest);
 
 	bool query(void);
+	bool isConcurrent(void) const;
 
 	GK_INLINE void setRange(gkScalar v)             {m_range = v;}
 	GK_INLINE void setResetRange(gkScalar v)        {m_resetrange = v;}
@@ -32,7 +32,7 @@
 
 
 gkPropertySensor::gkPropertySensor(gkGameObject* object, gkLogicLink* link, const gkString& name)
-	:   gkLogicSensor(object, link, name), m_old(), m_cur(0), m_type(-1), m_propName(""), m_propVal(), m_propMax(),
+	:   gkLogicSensor(object, link, name), m_old(), m_cur(0), m_type(-1), m_refType(gkVariable::VAR_NULL), m_propName(""), m_propVal(), m_propMax(),
 	    m_init(false), m_change(false)
 
 {
@@ -62,11 +62,8 @@ bool gkPropertySensor::query(void)
 		if (m_object->hasVariable(m_propName))
 		{
 			m_cur = m_object->getVariable(m_propName);
-			m_old.setValue(m_cur->getType(), m_propVal);
+			parseReference();
 			m_change = m_change != ((*m_cur) != (m_old));
-
-			if (m_type == PS_INTERVAL)
-				m_test.setValue(m_cur->getType(), m_propMax);
 		}
 		else
 		{
@@ -77,6 +74,10 @@ bool gkPropertySensor::query(void)
 
 	if (m_cur)
 	{
+		// scripts can change the property type, compare in the current one
+		if (m_type != PS_CHANGED && m_cur->getType() != m_refType)
+			parseReference();
+
 		switch (m_type)
 		{
 		case PS_EQUAL:
@@ -92,8 +93,30 @@ bool gkPropertySensor::query(void)
 			}
 			break;
 		case PS_INTERVAL:
+			if (m_refType == gkVariable::VAR_INT)
+			{
+				int v = m_cur->getValueInt();
+				return v >= m_old.getValueInt() && v <= m_test.getValueInt();
+			}
+			else if (m_refType == gkVariable::VAR_REAL)
+			{
+				gkScalar v = m_cur->getValueReal();
+				return v >= m_old.getValueReal() && v <= m_test.getValueReal();
+			}
 			return (*m_cur) >= (m_old) && (*m_cur) <= (m_test);
 		}
 	}
 	return false;
 }
+
+
+
+void gkPropertySensor::parseReference(void)
+{
+	// values are parsed once into the property type, not on every compare
+	m_refType = m_cur->getType();
+	m_old.setValue(m_refType, m_propVal);
+
+	if (m_type == PS_INTERVAL)
+		m_test.setValue(m_refType, m_propMax);
+}
@@ -50,9 +50,12 @@ protected:
 	gkString    m_propVal;
 	gkString    m_propMax;
 	int         m_type;
+	int         m_refType;
 	gkString    m_propName;
 	bool        m_init, m_change;
 
+	void parseReference(void);
+
 public:
 
 	gkPropertySensor(gkGameObject* object, gkLogicLink* link, const gkString& name);
@@ -61,6 +64,7 @@ public:
 	gkLogicBrick* clone(gkLogicLink* link, gkGameObject* dest);
 
 	bool query(void);
+	GK_INLINE bool isConcurrent(void) const {return true;}
 
 
 	GK_INLINE void  setType(int type)               {m_type = type;}
@@ -31,7 +31,6 @@
 #include "gkGameObject.h"
 #include "gkPhysicsController.h"
 #include "gkScene.h"
-#include "gkContactTest.h"
 #include "btBulletDynamicsCommon.h"
 
 
@@ -49,6 +48,14 @@ gkLogicBrick* gkRadarSensor::clone(gkLogicLink* link, gkGameObject* dest)
 }
 
 
+bool gkRadarSensor::isConcurrent(void) const
+{
+	// the debug shape is drawn from query()
+	return !m_object->getOwner()->getDynamicsWorld()->getBulletWorld()->getDebugDrawer();
+}
+
+
+
 bool gkRadarSensor::query(void)
 {
 	gkScene* scene = m_object->getOwner();
@@ -56,87 +63,60 @@ bool gkRadarSensor::query(void)
 
 	btDynamicsWorld* btw = dyn->getBulletWorld();
 
-	const gkScalar offs = m_range / 2.f;
-	gkEuler ori;
-	gkVector3 dir;
-	switch (m_axis)
-	{
-	case RA_XPOS: {dir = gkVector3(offs, 0, 0);  break;}
-	case RA_YPOS: {dir = gkVector3(0, offs, 0);  break;}
-	case RA_ZPOS: {dir = gkVector3(0, 0, offs);  break;}
-	case RA_XNEG: {dir = gkVector3(-offs, 0, 0); break;}
-	case RA_YNEG: {dir = gkVector3(0, -offs, 0); break;}
-	case RA_ZNEG: {dir = gkVector3(0, 0, -offs); break;}
-	}
-
+	gkVector3 axis;
 	switch (m_axis)
 	{
-	case RA_XPOS: {ori = gkEuler(0,  -90,   0);     break;}
-	case RA_YPOS: {ori = gkEuler(90,  0,    0);     break;}
-	case RA_ZPOS: {ori = gkEuler(0,   180,  0);     break;}
-	case RA_XNEG: {ori = gkEuler(0,  -90, -180);    break;}
-	case RA_YNEG: {ori = gkEuler(90,  0,  -180);    break;}
-	case RA_ZNEG: {ori = gkEuler(0,   0,    0);     break;}
+	case RA_XPOS: {axis = gkVector3(1, 0, 0);  break;}
+	case RA_YPOS: {axis = gkVector3(0, 1, 0);  break;}
+	case RA_ZPOS: {axis = gkVector3(0, 0, 1);  break;}
+	case RA_XNEG: {axis = gkVector3(-1, 0, 0); break;}
+	case RA_YNEG: {axis = gkVector3(0, -1, 0); break;}
+	case RA_ZNEG: {axis = gkVector3(0, 0, -1); break;}
 	}
 
-
-	gkVector3 vec = m_object->getWorldPosition();
-
-	dir = m_object->getWorldOrientation() * dir;
-	btQuaternion btr = gkMathUtils::get(m_object->getWorldOrientation() * ori.toQuaternion());
-
-	gkAllContactResultCallback exec;
-
-	btTransform  btt;
-	btt.setIdentity();
-	btt.setOrigin(btVector3(vec.x + dir.x, vec.y + dir.y, vec.z + dir.z));
-	btt.setRotation(btr);
-
-	btConeShapeZ btcs(m_range * tan(m_angle / 2), m_range);
-
-	btCollisionObject btco = btCollisionObject();
-	btco.setCollisionShape(&btcs);
-	btco.setWorldTransform(btt);
-
-	btw->contactTest( &btco, exec);
+	const gkVector3 vec = m_object->getWorldPosition();
+	axis = m_object->getWorldOrientation() * axis;
 
 	if (btw->getDebugDrawer())
+	{
+		gkEuler ori;
+		switch (m_axis)
+		{
+		case RA_XPOS: {ori = gkEuler(0,  -90,   0);     break;}
+		case RA_YPOS: {ori = gkEuler(90,  0,    0);     break;}
+		case RA_ZPOS: {ori = gkEuler(0,   180,  0);     break;}
+		case RA_XNEG: {ori = gkEuler(0,  -90, -180);    break;}
+		case RA_YNEG: {ori = gkEuler(90,  0,  -180);    break;}
+		case RA_ZNEG: {ori = gkEuler(0,   0,    0);     break;}
+		}
+
+		btTransform btt;
+		btt.setIdentity();
+		btt.setOrigin(gkMathUtils::get(vec + axis * (m_range / 2.f)));
+		btt.setRotation(gkMathUtils::get(m_object->getWorldOrientation() * ori.toQuaternion()));
+
+		btConeShapeZ btcs(m_range * tan(m_angle / 2), m_range);
 		btw->debugDrawObject(btt, &btcs, btVector3(0, 1, 0));
+	}
 
+	// shared with every other sensor asking the same cone this step
+	const gkDynamicsWorld::QueryResult& hits = dyn->queryCone(vec, axis, m_range, m_angle / 2);
 
-	if (!exec.hasHit())
-		return false;
-
-
-	if (m_object->getCollisionObject())
+	for (UTsize i = 0; i < hits.size(); ++i)
 	{
+		gkGameObject* ob = hits[i];
+
 		// don't collide with self ?
 		// See: momo_ogre.blend sensor(Not Ray.Down) state 2
-		if (!exec.m_contactObjects.empty())
-			exec.m_contactObjects.erase(m_object->getCollisionObject());
-	}
-
-
-	if (exec.m_contactObjects.empty())
-		return false;
+		if (ob == m_object)
+			continue;
 
-	if (m_material.empty() && m_prop.empty())
-		return true;
-
-	utArray<const btCollisionObject*> contacts = exec.m_contactObjects;
-
-	utArrayIterator< utArray<const btCollisionObject*> > iter(contacts);
-
-	while (iter.hasMoreElements())
-	{
-		gkGameObject* ob = gkPhysicsController::castObject(iter.peekNext());
+		if (m_material.empty() && m_prop.empty())
+			return true;
 
 		if (gkPhysicsController::sensorTest(ob, m_prop, m_material))
 			return true;
-
-		iter.getNext();
 	}
 
 	return false;
-
 }
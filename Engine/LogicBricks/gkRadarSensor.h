@@ -42,6 +42,7 @@ public:
 	gkLogicBrick* clone(gkLogicLink* link, gkGameObject* dest);
 
 	bool query(void);
+	bool isConcurrent(void) const;
 
 	GK_INLINE void      setAngle(gkScalar v)       {m_angle = v;}
 	GK_INLINE gkScalar  getAngle(void)       const {return m_angle;}
@@ -47,6 +47,7 @@ public:
 	gkLogicBrick* clone(gkLogicLink* link, gkGameObject* dest);
 
 	bool query(void);
+	GK_INLINE bool isConcurrent(void) const {return true;}
 	void setSeed(UTuint32 v);
 
 	GK_INLINE UTuint32 getSeed(void) const {return m_seed;}
@@ -31,13 +31,14 @@
 #include "gkPhysicsController.h"
 #include "gkScene.h"
 #include "gkRayTest.h"
+#include "gkDynamicsWorld.h"
 
 
 
 
 gkRaySensor::gkRaySensor(gkGameObject* object, gkLogicLink* link, const gkString& name)
 	:       gkLogicSensor(object, link, name), m_range(0.01), m_axis(-1),
-                m_material(""), m_prop(""), m_xray(false)
+                m_material(""), m_prop(""), m_xray(false), m_batchIndex(UT_NPOS)
 {
 	m_dispatchType = DIS_CONSTANT;
 	connect();
@@ -49,20 +50,18 @@ gkLogicBrick* gkRaySensor::clone(gkLogicLink* link, gkGameObject* dest)
 {
 	gkRaySensor* sens = new gkRaySensor(*this);
 	sens->cloneImpl(link, dest);
+	sens->m_batchIndex = UT_NPOS;
 	return sens;
 }
 
 
 
-bool gkRaySensor::query(void)
+void gkRaySensor::getRay(gkVector3& from, gkVector3& to)
 {
+	gkVector3 dir;
 
-	gkVector3 from, to, dir;
-	bool result;
-	gkRayTest test;
-	
 	from = m_object->getWorldPosition();
-	
+
 	switch (m_axis)
 	{
 	case RA_XPOS: {dir = gkVector3(m_range, 0, 0);  break;}
@@ -72,29 +71,61 @@ bool gkRaySensor::query(void)
 	case RA_YNEG: {dir = gkVector3(0, -m_range, 0); break;}
 	case RA_ZNEG: {dir = gkVector3(0, 0, -m_range); break;}
 	}
-	
+
 	dir = m_object->getWorldOrientation() * dir;
 	to = from + dir;
-	
-	if(m_xray){
+}
+
+
+
+gkDynamicsWorld* gkRaySensor::queue(void)
+{
+	m_batchIndex = UT_NPOS;
+
+	gkDynamicsWorld* world = m_object->getOwner()->getDynamicsWorld();
+	if (m_xray || !world)
+		return 0;
+
+	gkVector3 from, to;
+	getRay(from, to);
+
+	m_batchIndex = world->queueRay(from, to, m_object);
+	return world;
+}
+
+
+
+bool gkRaySensor::query(void)
+{
+	bool result;
+	bool onlyActorTODO = false;
+
+	if (m_xray)
+	{
+		gkVector3 from, to;
+		gkRayTest test;
+
+		getRay(from, to);
+
+		// m_prop and m_material are tested by the filter
 		xrayFilter xrf(m_object, m_prop, m_material);
-		result = test.collides(from, to, xrf);
+		return test.collides(from, to, xrf);
 	}
-	else
+
+	gkDynamicsWorld* world = m_object->getOwner()->getDynamicsWorld();
+	if (!world)
+		return false;
+
+	// dispatched one by one, nothing was queued ahead
+	if (m_batchIndex == UT_NPOS)
 	{
-		gkRayTest::gkRayTestFilter nmf;
-		result = test.collides(from, to, nmf);
-	}
-	
-	bool onlyActorTODO = false;
-	// if x-ray, m_prop and m_material were already tested
-	if (!m_xray && result){
-		gkGameObject* hit = gkPhysicsController::castObject(test.getCollisionObject());
-		result = hit && gkPhysicsController::sensorTest(hit, m_prop, m_material, onlyActorTODO);
+		queue();
+		world->runBatch();
 	}
-	
-	return result;
-}
-
 
+	const gkDynamicsWorld::BatchHit& hit = world->getBatchHits()[m_batchIndex];
+	m_batchIndex = UT_NPOS;
 
+	result = hit.object && gkPhysicsController::sensorTest(hit.object, m_prop, m_material, onlyActorTODO);
+	return result;
+}
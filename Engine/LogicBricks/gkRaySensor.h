@@ -49,6 +49,9 @@ protected:
 	int         m_axis;
 	gkString    m_material, m_prop;
         bool        m_xray;
+	UTsize      m_batchIndex;   // into the world's batch hits, UT_NPOS when nothing is queued
+
+	void getRay(gkVector3& from, gkVector3& to);
 
 public:
 
@@ -58,6 +61,10 @@ public:
 	gkLogicBrick* clone(gkLogicLink* link, gkGameObject* dest);
 
 	bool query(void);
+	GK_INLINE bool isConcurrent(void) const {return true;}
+
+	// x-ray skips objects on the way, those still cast a single ray
+	gkDynamicsWorld* queue(void);
 
 	GK_INLINE void setRange(gkScalar v)             {m_range = v;}
 	GK_INLINE void setAxis(int v)                   {m_axis = v;}
@@ -50,8 +50,10 @@
 #include "gkMemoryTest.h"
 #include "gkMesh.h"
 #include "gkMeshManager.h"
+#include "gkMeshOptimizer.h"
 #include "gkMessageManager.h"
 #include "gkPath.h"
+#include "gkProfiler.h"
 #include "gkRenderFactory.h"
 #include "gkScene.h"
 #include "gkSceneManager.h"
@@ -175,12 +177,15 @@
 
 #include "Physics/gkCharacter.h"
 #include "Physics/gkContactTest.h"
+#include "Physics/gkContactTracker.h"
 #include "Physics/gkDynamicsWorld.h"
 #include "Physics/gkPhysicsDebug.h"
 #include "Physics/gkRagDoll.h"
 #include "Physics/gkRigidBody.h"
+#include "Physics/gkShapeCache.h"
 #include "Physics/gkSoftBody.h"
 #include "Physics/gkVehicle.h"
+#include "Physics/gkRayBatch.h"
 #include "Physics/gkRayTest.h"
 #include "Physics/gkSweptTest.h"
 
@@ -214,10 +219,12 @@
 #include "Thread/gkQueue.h"
 #include "Thread/gkSyncObj.h"
 #include "Thread/gkThread.h"
+#include "Thread/gkThreadPool.h"
 
 #ifdef OGREKIT_OPENAL_SOUND
 #include "Sound/gkBuffer.h"
 #include "Sound/gkSound.h"
+#include "Sound/gkSoundCache.h"
 #include "Sound/gkSoundManager.h"
 #include "Sound/gkSoundStream.h"
 #include "Sound/gkSoundUtil.h"
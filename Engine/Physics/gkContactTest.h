@@ -29,6 +29,8 @@
 
 #include "utTypes.h"
 #include "btBulletCollisionCommon.h"
+#include "BulletCollision/CollisionShapes/btTriangleShape.h"
+#include "BulletCollision/NarrowPhaseCollision/btGjkEpa2.h"
 
 class gkAllContactResultCallback : public btCollisionWorld::ContactResultCallback
 {
@@ -60,4 +62,85 @@ public:
 	}
 };
 
+
+// Exact overlap of a convex volume with a collision object's shape, for
+// queries that only get AABB candidates from the broadphase. Nothing is
+// shared with the world, so it may run on several threads at once.
+class gkShapeOverlapTest
+{
+private:
+
+	class TriangleCallback : public btTriangleCallback
+	{
+	public:
+		const btConvexShape*    m_shape;
+		btTransform             m_trans;
+		bool                    m_hit;
+
+		TriangleCallback(const btConvexShape* shape, const btTransform& trans)
+			:   m_shape(shape), m_trans(trans), m_hit(false)
+		{
+		}
+
+		void processTriangle(btVector3* tri, int partId, int triangleIndex)
+		{
+			if (m_hit)
+				return;
+
+			btTriangleShape triangle(tri[0], tri[1], tri[2]);
+			triangle.setMargin(0);
+			m_hit = convex(m_shape, m_trans, &triangle, btTransform::getIdentity());
+		}
+	};
+
+public:
+
+	static bool convex(const btConvexShape* a, const btTransform& ta, const btConvexShape* b, const btTransform& tb)
+	{
+		// distance between the core shapes, margins (the radius of a sphere) come on top
+		btGjkEpaSolver2::sResults res;
+		if (!btGjkEpaSolver2::Distance(a, ta, b, tb, btVector3(1, 0, 0), res))
+			return true; // penetrating, or touching when GJK gives up
+
+		return res.distance <= a->getMargin() + b->getMargin();
+	}
+
+	static bool test(const btConvexShape* shape, const btTransform& trans, const btCollisionShape* other, const btTransform& otherTrans)
+	{
+		if (other->isConvex())
+			return convex(shape, trans, static_cast<const btConvexShape*>(other), otherTrans);
+
+		if (other->isCompound())
+		{
+			const btCompoundShape* compound = static_cast<const btCompoundShape*>(other);
+			for (int i = 0; i < compound->getNumChildShapes(); ++i)
+			{
+				if (test(shape, trans, compound->getChildShape(i), otherTrans * compound->getChildTransform(i)))
+					return true;
+			}
+			return false;
+		}
+
+		if (other->isConcave())
+		{
+			// triangles are reported in the mesh's space
+			const btTransform local = otherTrans.inverse() * trans;
+
+			btVector3 aabbMin, aabbMax;
+			shape->getAabb(local, aabbMin, aabbMax);
+
+			TriangleCallback cb(shape, local);
+			static_cast<const btConcaveShape*>(other)->processAllTriangles(&cb, aabbMin, aabbMax);
+			return cb.m_hit;
+		}
+
+		return false;
+	}
+
+	static bool test(const btConvexShape* shape, const btTransform& trans, const btCollisionObject* colObj)
+	{
+		return test(shape, trans, colObj->getCollisionShape(), colObj->getWorldTransform());
+	}
+};
+
 #endif // _gkContactTest_h_
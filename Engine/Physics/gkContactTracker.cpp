@@ -0,0 +1,167 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "gkContactTracker.h"
+
+
+
+gkContactTracker::gkContactTracker(Listener* tables)
+	:	m_tables(tables),
+	    m_stamp(0)
+{
+}
+
+
+
+gkContactTracker::~gkContactTracker()
+{
+	for (UTsize i = 0; i < m_listeners.size(); ++i)
+		m_listeners[i]->m_tracker = 0;
+}
+
+
+
+void gkContactTracker::addListener(Listener* listener)
+{
+	GK_ASSERT(listener);
+
+	if (listener->m_tracker == this)
+		return;
+
+	if (listener->m_tracker)
+		listener->m_tracker->removeListener(listener);
+
+	m_listeners.push_back(listener);
+	listener->m_tracker = this;
+}
+
+
+
+void gkContactTracker::removeListener(Listener* listener)
+{
+	if (listener->m_tracker != this)
+		return;
+
+	m_listeners.erase(listener);
+	listener->m_tracker = 0;
+}
+
+
+
+void gkContactTracker::beginSubstep(void)
+{
+	++m_stamp;
+}
+
+
+
+void gkContactTracker::touch(gkPhysicsController* a, gkPhysicsController* b)
+{
+	Pair pair(a, b);
+
+	UTsize pos = m_pairs.find(pair);
+	bool begin = pos == UT_NPOS;
+
+	// several manifolds of one pair report once
+	if (!begin && m_pairs.at(pos) == m_stamp)
+		return;
+
+	if (begin)
+		m_pairs.insert(pair, m_stamp);
+	else
+		m_pairs.at(pos) = m_stamp;
+
+	UTsize i;
+	for (i = 0; i < m_listeners.size(); ++i)
+	{
+		if (begin)
+			m_listeners[i]->contactBegin(pair.m_a, pair.m_b);
+		else
+			m_listeners[i]->contactPersist(pair.m_a, pair.m_b);
+	}
+}
+
+
+
+void gkContactTracker::endSubstep(void)
+{
+	UTsize i = 0;
+	while (i < m_pairs.size())
+	{
+		// removal moves the last pair into this slot
+		if (m_pairs.at(i) != m_stamp)
+			end(m_pairs.keyAt(i));
+		else
+			++i;
+	}
+}
+
+
+
+void gkContactTracker::remove(gkPhysicsController* cont)
+{
+	UTsize i = 0;
+	while (i < m_pairs.size())
+	{
+		const Pair& pair = m_pairs.keyAt(i);
+		if (pair.m_a == cont || pair.m_b == cont)
+			end(pair);
+		else
+			++i;
+	}
+
+	for (i = 0; i < m_listeners.size(); ++i)
+		m_listeners[i]->contactRemoved(cont);
+}
+
+
+
+void gkContactTracker::reset(void)
+{
+	while (!m_pairs.empty())
+		end(m_pairs.keyAt(m_pairs.size() - 1));
+}
+
+
+
+bool gkContactTracker::isTouching(gkPhysicsController* a, gkPhysicsController* b) const
+{
+	return m_pairs.find(Pair(a, b)) != UT_NPOS;
+}
+
+
+
+void gkContactTracker::end(const Pair& pair)
+{
+	Pair cpy = pair;
+	m_pairs.remove(cpy);
+
+	if (m_tables)
+		m_tables->contactEnd(cpy.m_a, cpy.m_b);
+
+	for (UTsize i = 0; i < m_listeners.size(); ++i)
+		m_listeners[i]->contactEnd(cpy.m_a, cpy.m_b);
+}
@@ -0,0 +1,134 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _gkContactTracker_h_
+#define _gkContactTracker_h_
+
+#include "gkCommon.h"
+
+class gkPhysicsController;
+
+
+// Touching controller pairs of one world, stamped with the substep they
+// were last seen in. Controllers are only compared, never dereferenced.
+class gkContactTracker
+{
+public:
+
+	// Contact events, reported once per substep for every tracked pair.
+	// Listeners leave their tracker when destroyed and the other way round.
+	class Listener
+	{
+	public:
+		Listener() : m_tracker(0) {}
+		Listener(const Listener&) : m_tracker(0) {}
+		virtual ~Listener() { if (m_tracker) m_tracker->removeListener(this); }
+
+		Listener& operator= (const Listener&) {return *this;}
+
+		virtual void contactBegin(gkPhysicsController* a, gkPhysicsController* b) {}
+		virtual void contactPersist(gkPhysicsController* a, gkPhysicsController* b) {}
+		virtual void contactEnd(gkPhysicsController* a, gkPhysicsController* b) {}
+
+		// Sent after the contactEnd events of a controller that leaves the
+		// world, nothing may refer to it afterwards
+		virtual void contactRemoved(gkPhysicsController* cont) {}
+
+		GK_INLINE gkContactTracker* getTracker(void) const {return m_tracker;}
+
+	private:
+		friend class gkContactTracker;
+		gkContactTracker* m_tracker;
+	};
+
+	typedef utArray<Listener*> Listeners;
+
+
+	// Unordered controller pair
+	class Pair
+	{
+	public:
+		gkPhysicsController* m_a;
+		gkPhysicsController* m_b;
+
+		Pair() : m_a(0), m_b(0) {}
+		Pair(gkPhysicsController* a, gkPhysicsController* b)
+			:	m_a(a < b ? a : b), m_b(a < b ? b : a)
+		{
+		}
+
+		UThash hash(void) const
+		{
+			UThash ha = utPointerHashKey(m_a).hash();
+			return ha ^ (utPointerHashKey(m_b).hash() + 0x9e3779b9 + (ha << 6) + (ha >> 2));
+		}
+
+		bool operator== (const Pair& v) const {return m_a == v.m_a && m_b == v.m_b;}
+		bool operator!= (const Pair& v) const {return m_a != v.m_a || m_b != v.m_b;}
+	};
+
+	// pair -> substep it was last seen touching
+	typedef utHashTable<Pair, UTuint32> Pairs;
+
+
+	// Tables, when given, hears every event before the listeners and does
+	// not count as one (see isListening)
+	gkContactTracker(Listener* tables = 0);
+	~gkContactTracker();
+
+	void addListener(Listener* listener);
+	void removeListener(Listener* listener);
+
+	// Nothing needs the manifolds walked when false
+	GK_INLINE bool isListening(void) const {return !m_listeners.empty();}
+
+	void beginSubstep(void);
+	void touch(gkPhysicsController* a, gkPhysicsController* b);
+
+	// Ends the pairs not touched since beginSubstep
+	void endSubstep(void);
+
+	// Ends every pair of cont
+	void remove(gkPhysicsController* cont);
+
+	// Ends every pair
+	void reset(void);
+
+	bool isTouching(gkPhysicsController* a, gkPhysicsController* b) const;
+
+	GK_INLINE UTsize getPairCount(void) const {return m_pairs.size();}
+
+private:
+
+	Listener* m_tables;
+	Listeners m_listeners;
+	Pairs     m_pairs;
+	UTuint32  m_stamp;
+
+	void end(const Pair& pair);
+};
+
+#endif//_gkContactTracker_h_
@@ -35,10 +35,130 @@
 #include "gkCamera.h"
 #include "gkVariable.h"
 #include "gkDbvt.h"
+#include "gkShapeCache.h"
+#include "gkContactTest.h"
+#include "gkRayBatch.h"
+#include "gkLogger.h"
 #include "btBulletDynamicsCommon.h"
 #include "BulletCollision/CollisionDispatch/btGhostObject.h"
+#include "LinearMath/btHashMap.h"
+#include "Thread/gkThreadPool.h"
+
+#ifdef OGREKIT_COMPILE_BULLET_MULTITHREADED
+#include "BulletMultiThreaded/PlatformDefinitions.h"
+#ifdef USE_WIN32_THREADING
+#include "BulletMultiThreaded/Win32ThreadSupport.h"
+#else
+#include "BulletMultiThreaded/PosixThreadSupport.h"
+#endif
+#include "BulletMultiThreaded/SpuGatheringCollisionDispatcher.h"
+#include "BulletMultiThreaded/SpuNarrowPhaseCollisionTask/SpuGatheringCollisionTask.h"
+#include "BulletMultiThreaded/btParallelConstraintSolver.h"
+#include "BulletCollision/CollisionDispatch/btSimulationIslandManager.h"
+#endif
+
+
+
+// Bullet extrapolates motion states past the last fixed step by the
+// leftover time, which overshoots on contact. When physics runs slower than
+// the logic tick, blend between the last two steps by the leftover fraction
+// instead; rendered transforms then lag at most one physics step behind.
+class gkDiscreteDynamicsWorld : public btDiscreteDynamicsWorld
+{
+private:
+	typedef btHashMap<btHashPtr, btTransform> Transforms;
+
+	btScalar   m_interpolationStep;
+	Transforms m_previous;
+
+public:
+	gkDiscreteDynamicsWorld(btDispatcher* dispatcher, btBroadphaseInterface* pairCache,
+	                        btConstraintSolver* solver, btCollisionConfiguration* config)
+		:	btDiscreteDynamicsWorld(dispatcher, pairCache, solver, config),
+			m_interpolationStep(0)
+	{
+	}
+
+	// 0 keeps the default extrapolation
+	void setInterpolationStep(btScalar step) { m_interpolationStep = step; }
+
+
+	void removeRigidBody(btRigidBody* body)
+	{
+		m_previous.remove(body);
+		btDiscreteDynamicsWorld::removeRigidBody(body);
+	}
+
+protected:
+
+	void internalSingleStepSimulation(btScalar timeStep)
+	{
+		if (m_interpolationStep > btScalar(0.))
+		{
+			for (int i = 0; i < m_nonStaticRigidBodies.size(); i++)
+			{
+				btRigidBody* body = m_nonStaticRigidBodies[i];
+				if (body->getMotionState() && !body->isStaticOrKinematicObject())
+					m_previous.insert(body, body->getWorldTransform());
+			}
+		}
+
+		btDiscreteDynamicsWorld::internalSingleStepSimulation(timeStep);
+	}
 
+public:
 
+	void synchronizeMotionStates(void)
+	{
+		if (m_interpolationStep <= btScalar(0.))
+		{
+			btDiscreteDynamicsWorld::synchronizeMotionStates();
+			return;
+		}
+
+		// m_localTime is the time not yet simulated, less than one step
+		btScalar fraction = m_localTime / m_interpolationStep;
+		if (fraction > btScalar(1.))
+			fraction = btScalar(1.);
+
+		for (int i = 0; i < m_nonStaticRigidBodies.size(); i++)
+		{
+			btRigidBody* body = m_nonStaticRigidBodies[i];
+
+			if (!body->getMotionState() || body->isStaticOrKinematicObject())
+				continue;
+			if (!m_synchronizeAllMotionStates && !body->isActive())
+				continue;
+
+			const btTransform& cur = body->getWorldTransform();
+			const btTransform* prev = m_previous.find(body);
+			if (!prev)
+			{
+				// not stepped yet
+				body->getMotionState()->setWorldTransform(cur);
+				continue;
+			}
+
+			btTransform trans;
+			trans.setOrigin(prev->getOrigin().lerp(cur.getOrigin(), fraction));
+			trans.setRotation(prev->getRotation().slerp(cur.getRotation(), fraction));
+			body->getMotionState()->setWorldTransform(trans);
+		}
+	}
+};
+
+
+
+// Keeps each controller's contact table in step with its world's tracker
+class gkContactTables : public gkContactTracker::Listener
+{
+public:
+	void contactEnd(gkPhysicsController* a, gkPhysicsController* b)
+	{
+		a->_removeContact(b);
+		b->_removeContact(a);
+	}
+};
 
 
 
@@ -50,9 +170,17 @@ gkDynamicsWorld::gkDynamicsWorld(const gkString& name, gkScene* scene)
 	        m_ghostPairCallback(0),
 	        m_dispatcher(0),
 	        m_constraintSolver(0),
+	        m_collisionThreads(0),
+	        m_solverThreads(0),
+	        m_fixedStep(gkScalar(1.0) / gkScalar(60.0)),
+	        m_maxSubSteps(1),
 	        m_debug(0),
 	        m_handleContacts(true),
-	        m_dbvt(0)
+	        m_dbvt(0),
+	        m_contactTables(new gkContactTables()),
+	        m_contacts(m_contactTables),
+	        m_batchPool(0),
+	        m_shapeCache(new gkShapeCache())
 {
 	createInstanceImpl();
 }
@@ -61,7 +189,18 @@ gkDynamicsWorld::gkDynamicsWorld(const gkString& name, gkScene* scene)
 
 gkDynamicsWorld::~gkDynamicsWorld()
 {
+	for (UTsize i = 0; i < m_queryResults.size(); ++i)
+		delete m_queryResults[i];
+
+	delete m_batchPool;
+
 	destroyInstanceImpl();
+
+	// the controllers' contacts ended with them
+	delete m_contactTables;
+
+	// after the controllers holding its shapes
+	delete m_shapeCache;
 }
 
 
@@ -73,16 +212,44 @@ void gkDynamicsWorld::createInstanceImpl(void)
 	if (m_dynamicsWorld)
 		return;
 
-	m_collisionConfiguration = new btDefaultCollisionConfiguration();
+	int threads = gkEngine::getSingleton().getUserDefs().physicsThreads;
 
-	m_pairCache = new btDbvtBroadphase();
+#ifdef OGREKIT_COMPILE_BULLET_MULTITHREADED
+	if (threads < 0)
+		threads = (int)gkThreadPool::getHardwareThreads();
 
-	m_ghostPairCallback = new btGhostPairCallback();
-	m_pairCache->getOverlappingPairCache()->setInternalGhostPairCallback(m_ghostPairCallback);
+	if (threads > 1)
+		createThreadedBackend(threads);
+	else
+#else
+	if (threads != 0)
+		gkPrintf("DynamicsWorld: built without OGREKIT_COMPILE_BULLET_MULTITHREADED, physics runs on one thread.\n");
+#endif
+	{
+		m_collisionConfiguration = new btDefaultCollisionConfiguration();
+
+		m_pairCache = new btDbvtBroadphase();
+
+		m_ghostPairCallback = new btGhostPairCallback();
+		m_pairCache->getOverlappingPairCache()->setInternalGhostPairCallback(m_ghostPairCallback);
+
+		m_dispatcher = new btCollisionDispatcher(m_collisionConfiguration);
+		m_constraintSolver = new btSequentialImpulseConstraintSolver();
+		m_dynamicsWorld = new gkDiscreteDynamicsWorld(m_dispatcher, m_pairCache, m_constraintSolver, m_collisionConfiguration);
+	}
+
+	const gkUserDefs& defs = gkEngine::getSingleton().getUserDefs();
+	const gkSceneProperties& props = m_scene->getProperties();
+
+	// internal fixed step, either explicit or a whole fraction of the logic tick
+	gkScalar rate = defs.physicsRate > 0 ? gkScalar(defs.physicsRate) :
+	                gkEngine::getTickRate() * gkScalar(props.m_physicsSubSteps > 0 ? props.m_physicsSubSteps : 1);
+	m_fixedStep = gkScalar(1.0) / rate;
+	m_maxSubSteps = defs.maxPhysicsSteps > 0 ? defs.maxPhysicsSteps : props.m_maxPhysicsSteps;
 
-	m_dispatcher = new btCollisionDispatcher(m_collisionConfiguration);
-	m_constraintSolver = new btSequentialImpulseConstraintSolver();
-	m_dynamicsWorld = new btDiscreteDynamicsWorld(m_dispatcher, m_pairCache, m_constraintSolver, m_collisionConfiguration);
+	// only needed when a logic tick can fall between two physics steps
+	if (defs.physicsInterpolation && m_fixedStep > gkEngine::getStepRate() * gkScalar(1.001))
+		static_cast<gkDiscreteDynamicsWorld*>(m_dynamicsWorld)->setInterpolationStep(m_fixedStep);
 
 	gkVector3& grav = m_scene->getProperties().m_gravity;
 	m_dynamicsWorld->setGravity(btVector3(grav.x, grav.y, grav.z));
@@ -114,6 +281,13 @@ void gkDynamicsWorld::destroyInstanceImpl(void)
 	delete m_dispatcher;
 	m_dispatcher = 0;
 
+	// threads go after the dispatcher and solver that use them
+	delete m_solverThreads;
+	m_solverThreads = 0;
+
+	delete m_collisionThreads;
+	m_collisionThreads = 0;
+
 	delete m_ghostPairCallback;
 	m_ghostPairCallback = 0;
 
@@ -129,6 +303,8 @@ void gkDynamicsWorld::destroyInstanceImpl(void)
 	delete m_dbvt;
 	m_dbvt = 0;
 
+	m_contacts.reset();
+
 	if (!m_objects.empty())
 	{
 		gkPhysicsControllers::Iterator iter = m_objects.iterator();		
@@ -142,6 +318,53 @@ void gkDynamicsWorld::destroyInstanceImpl(void)
 
 
 
+#ifdef OGREKIT_COMPILE_BULLET_MULTITHREADED
+
+static btThreadSupportInterface* gkCreateBulletThreads(const char* name, void (*func)(void*, void*), void* (*lsMemory)(), int threads)
+{
+#ifdef USE_WIN32_THREADING
+	Win32ThreadSupport::Win32ThreadConstructionInfo info(name, func, lsMemory, threads);
+	return new Win32ThreadSupport(info);
+#else
+	PosixThreadSupport::ThreadConstructionInfo info(name, func, lsMemory, threads);
+	return new PosixThreadSupport(info);
+#endif
+}
+
+
+
+
+void gkDynamicsWorld::createThreadedBackend(int threads)
+{
+	// the parallel solver needs every contact in the preallocated pool
+	btDefaultCollisionConstructionInfo cci;
+	cci.m_defaultMaxPersistentManifoldPoolSize = 32768;
+	m_collisionConfiguration = new btDefaultCollisionConfiguration(cci);
+
+	m_pairCache = new btDbvtBroadphase();
+
+	m_ghostPairCallback = new btGhostPairCallback();
+	m_pairCache->getOverlappingPairCache()->setInternalGhostPairCallback(m_ghostPairCallback);
+
+	// narrowphase, manifolds still end up in the dispatcher for substep()
+	m_collisionThreads = gkCreateBulletThreads("gkCollision", processCollisionTask, createCollisionLocalStoreMemory, threads);
+	SpuGatheringCollisionDispatcher* dispatcher = new SpuGatheringCollisionDispatcher(m_collisionThreads, threads, m_collisionConfiguration);
+	dispatcher->setDispatcherFlags(btCollisionDispatcher::CD_DISABLE_CONTACTPOOL_DYNAMIC_ALLOCATION);
+	m_dispatcher = dispatcher;
+
+	m_solverThreads = gkCreateBulletThreads("gkSolver", SolverThreadFunc, SolverlsMemoryFunc, threads);
+	m_constraintSolver = new btParallelConstraintSolver(m_solverThreads);
+
+	btDiscreteDynamicsWorld* world = new gkDiscreteDynamicsWorld(m_dispatcher, m_pairCache, m_constraintSolver, m_collisionConfiguration);
+	world->getSimulationIslandManager()->setSplitIslands(false);
+	world->getDispatchInfo().m_enableSPU = true;
+	m_dynamicsWorld = world;
+}
+
+#endif
+
+
+
 void gkDynamicsWorld::enableDebugPhysics(bool enable, bool debugAabb)
 {
 	if (enable)
@@ -310,6 +533,10 @@ void gkDynamicsWorld::destroyObject(gkPhysicsController* cont)
 	{
 		m_objects.erase(pos);
 
+		removeContacts(cont);
+		clearQueries();
+		m_batch.invalidate(cont->getCollisionObject());
+
 		cont->destroy();
 		delete cont;
 	}
@@ -318,6 +545,22 @@ void gkDynamicsWorld::destroyObject(gkPhysicsController* cont)
 
 
 
+void gkDynamicsWorld::suspendObject(gkPhysicsController* cont, bool v)
+{
+	GK_ASSERT(cont);
+
+	// the pair cache must not keep contacts of a body that left the world
+	if (v)
+		removeContacts(cont);
+
+	cont->suspend(v);
+	clearQueries();
+	m_batch.invalidate(cont->getCollisionObject());
+}
+
+
+
+
 void gkDynamicsWorld::localDrawObject(gkPhysicsController* phyCon)
 {
 	btCollisionObject* colObj = phyCon->getCollisionObject();
@@ -372,9 +615,17 @@ void gkDynamicsWorld::step(gkScalar tick)
 {
 	GK_ASSERT(m_dynamicsWorld);
 
-	//uncomment this for better simulation quality (but a little bit less performance)
-	//	m_dynamicsWorld->stepSimulation(tick,10,1./240.);
-	m_dynamicsWorld->stepSimulation(tick);
+	// cap the substeps of a slow tick so physics can't spiral down; bullet
+	// drops the time past the cap instead of carrying it into the next tick
+	int maxSubSteps = (int)Ogre::Math::Ceil(tick / m_fixedStep);
+	if (maxSubSteps > m_maxSubSteps)
+		maxSubSteps = m_maxSubSteps;
+	if (maxSubSteps < 1)
+		maxSubSteps = 1;
+
+	clearQueries();
+
+	m_dynamicsWorld->stepSimulation(tick, maxSubSteps, m_fixedStep);
 
 	m_dynamicsWorld->debugDrawWorld();
 
@@ -386,14 +637,67 @@ void gkDynamicsWorld::step(gkScalar tick)
 
 void gkDynamicsWorld::resetContacts()
 {
-	if (m_handleContacts && !m_objects.empty())
+	m_contacts.reset();
+}
+
+
+
+void gkDynamicsWorld::removeContacts(gkPhysicsController* cont)
+{
+	m_contacts.remove(cont);
+	cont->_clearContacts();
+}
+
+
+
+void gkDynamicsWorld::updateContacts(void)
+{
+	m_contacts.beginSubstep();
+
+	int nr = m_dispatcher->getNumManifolds();
+
+	for (int i = 0; i < nr; ++i)
 	{
-		gkPhysicsControllers::Iterator iter = m_objects.iterator();
-		while (iter.hasMoreElements())
+		btPersistentManifold* manifold = m_dispatcher->getManifoldByIndexInternal(i);
+
+		gkPhysicsController* colA = gkPhysicsController::castController(manifold->getBody0());
+		gkPhysicsController* colB = gkPhysicsController::castController(manifold->getBody1());
+
+		if (!colA || !colB)
+			continue;
+
+		bool listenA = colA->_isContactListener();
+		bool listenB = colB->_isContactListener();
+
+		// the bulk of manifolds (debris, static geometry) ends here
+		if (!listenA && !listenB)
+			continue;
+
+		const btManifoldPoint* point = 0;
+
+		int nrc = manifold->getNumContacts();
+		for (int j = 0; j < nrc; ++j)
 		{
-			iter.getNext()->_resetContactInfo();
+			const btManifoldPoint& pt = manifold->getContactPoint(j);
+			if (pt.getDistance() < 0.f && (!point || pt.getDistance() < point->getDistance()))
+				point = &pt;
 		}
+
+		// ghosts touch as soon as a manifold exists
+		if (!point && manifold->getBody0()->hasContactResponse() && manifold->getBody1()->hasContactResponse())
+			continue;
+
+		// tables first, listeners read them from the events
+		if (listenA)
+			colA->_setContact(colB, point);
+		if (listenB)
+			colB->_setContact(colA, point);
+
+		m_contacts.touch(colA, colB);
 	}
+
+	// pairs not seen touching this substep have separated
+	m_contacts.endSubstep();
 }
 
 
@@ -408,33 +712,12 @@ void gkDynamicsWorld::presubstep(gkScalar tick)
 
 void gkDynamicsWorld::substep(gkScalar tick)
 {
-	if (m_handleContacts)
-	{
-		int nr = m_dispatcher->getNumManifolds();
-
-		for (int i = 0; i < nr; ++i)
-		{
-			btPersistentManifold* manifold = m_dispatcher->getManifoldByIndexInternal(i);
-
-			gkPhysicsController* colA = gkPhysicsController::castController(manifold->getBody0());
-			gkPhysicsController* colB = gkPhysicsController::castController(manifold->getBody1());
-
-			colA->_resetContactInfo();
-			colB->_resetContactInfo();
-		}
-
-		for (int i = 0; i < nr; ++i)
-		{
-			btPersistentManifold* manifold = m_dispatcher->getManifoldByIndexInternal(i);
+	// nobody to tell, the manifolds are left alone
+	if (m_handleContacts && m_contacts.isListening())
+		updateContacts();
+	else if (m_contacts.getPairCount())
+		resetContacts();
 
-			gkPhysicsController* colA = gkPhysicsController::castController(manifold->getBody0());
-			gkPhysicsController* colB = gkPhysicsController::castController(manifold->getBody1());
-
-			colA->_handleManifold(manifold);
-			colB->_handleManifold(manifold);
-		}
-	}
-	
 	// update callbacks
 	utArrayIterator<gkDynamicsWorld::Listeners> iter(m_listeners);
 	while(iter.hasMoreElements())
@@ -528,3 +811,257 @@ void gkDynamicsWorld::removeListener(gkDynamicsWorld::Listener *listener)
 		m_listeners.erase(listener);
 }
 
+
+
+void gkDynamicsWorld::addContactListener(gkDynamicsWorld::ContactListener* listener)
+{
+	m_contacts.addListener(listener);
+}
+
+
+
+void gkDynamicsWorld::removeContactListener(gkDynamicsWorld::ContactListener* listener)
+{
+	m_contacts.removeListener(listener);
+}
+
+
+
+gkDynamicsWorld::QueryKey::QueryKey(int type, const gkScalar* args, int nargs)
+	:	m_type(type)
+{
+	GK_ASSERT(nargs <= 8);
+	memset(m_args, 0, sizeof(m_args));
+	memcpy(m_args, args, nargs * sizeof(gkScalar));
+}
+
+
+
+UThash gkDynamicsWorld::QueryKey::hash(void) const
+{
+	// FNV-1a over the raw arguments
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(m_args);
+	UThash h = 2166136261u ^ (UThash)m_type;
+	for (size_t i = 0; i < sizeof(m_args); ++i)
+		h = (h ^ p[i]) * 16777619u;
+	return h;
+}
+
+
+
+class gkQueryAabbCallback : public btBroadphaseAabbCallback
+{
+public:
+	utArray<btCollisionObject*>& m_hits;
+
+	gkQueryAabbCallback(utArray<btCollisionObject*>& hits) : m_hits(hits) {}
+
+	bool process(const btBroadphaseProxy* proxy)
+	{
+		btCollisionObject* colObj = static_cast<btCollisionObject*>(proxy->m_clientObject);
+		if (colObj && colObj->getUserPointer())
+			m_hits.push_back(colObj);
+		return true;
+	}
+};
+
+
+
+void gkDynamicsWorld::clearQueries(void)
+{
+	m_queries.clear(true);
+}
+
+
+
+gkDynamicsWorld::QueryResult& gkDynamicsWorld::beginQuery(const QueryKey& key, bool& cached)
+{
+	UTsize pos = m_queries.find(key);
+	if (pos != UT_NPOS)
+	{
+		cached = true;
+		return *m_queryResults[m_queries.at(pos)];
+	}
+
+	// results of older steps are recycled in order
+	UTsize idx = m_queries.size();
+	if (idx == m_queryResults.size())
+		m_queryResults.push_back(new QueryResult());
+
+	m_queries.insert(key, idx);
+
+	QueryResult& res = *m_queryResults[idx];
+	res.clear(true);
+
+	cached = false;
+	return res;
+}
+
+
+
+void gkDynamicsWorld::collectAabb(const gkVector3& aabbMin, const gkVector3& aabbMax, utArray<btCollisionObject*>& hits)
+{
+	GK_ASSERT(m_dynamicsWorld);
+
+	gkQueryAabbCallback cb(hits);
+	m_dynamicsWorld->getBroadphase()->aabbTest(gkMathUtils::get(aabbMin), gkMathUtils::get(aabbMax), cb);
+}
+
+
+
+const gkDynamicsWorld::QueryResult& gkDynamicsWorld::querySphere(const gkVector3& center, gkScalar radius)
+{
+	const gkScalar args[4] = {center.x, center.y, center.z, radius};
+
+	gkCriticalSection::Lock guard(m_queryLock);
+
+	bool cached;
+	QueryResult& res = beginQuery(QueryKey(QueryKey::QK_SPHERE, args, 4), cached);
+	if (cached)
+		return res;
+
+	utArray<btCollisionObject*>& hits = m_queryHits;
+	hits.resize(0);
+
+	const gkVector3 ext(radius, radius, radius);
+	collectAabb(center - ext, center + ext, hits);
+
+	const btVector3 c = gkMathUtils::get(center);
+	const btScalar r2 = radius * radius;
+
+	btSphereShape sphere(radius);
+	btTransform trans;
+	trans.setIdentity();
+	trans.setOrigin(c);
+
+	for (UTsize i = 0; i < hits.size(); ++i)
+	{
+		const btBroadphaseProxy* proxy = hits[i]->getBroadphaseHandle();
+
+		// closest point of the object's bounds, then the shape itself
+		btVector3 p = c;
+		p.setMax(proxy->m_aabbMin);
+		p.setMin(proxy->m_aabbMax);
+
+		if ((p - c).length2() <= r2 && gkShapeOverlapTest::test(&sphere, trans, hits[i]))
+		{
+			gkGameObject* ob = gkPhysicsController::castObject(hits[i]);
+			if (ob && res.find(ob) == UT_NPOS)
+				res.push_back(ob);
+		}
+	}
+
+	return res;
+}
+
+
+
+const gkDynamicsWorld::QueryResult& gkDynamicsWorld::queryCone(const gkVector3& apex, const gkVector3& axis, gkScalar height, gkScalar halfAngle)
+{
+	const gkScalar args[8] = {apex.x, apex.y, apex.z, axis.x, axis.y, axis.z, height, halfAngle};
+
+	gkCriticalSection::Lock guard(m_queryLock);
+
+	bool cached;
+	QueryResult& res = beginQuery(QueryKey(QueryKey::QK_CONE, args, 8), cached);
+	if (cached)
+		return res;
+
+	utArray<btCollisionObject*>& hits = m_queryHits;
+	hits.resize(0);
+
+	// bounds of the apex and the base disc
+	const gkVector3 base = apex + axis * height;
+	const gkScalar baseRadius = height * Ogre::Math::Tan(halfAngle);
+	const gkVector3 disc(
+	    baseRadius * Ogre::Math::Sqrt(gkMax(1.f - axis.x * axis.x, 0.f)),
+	    baseRadius * Ogre::Math::Sqrt(gkMax(1.f - axis.y * axis.y, 0.f)),
+	    baseRadius * Ogre::Math::Sqrt(gkMax(1.f - axis.z * axis.z, 0.f)));
+
+	gkVector3 aabbMin = apex, aabbMax = apex;
+	aabbMin.makeFloor(base - disc);
+	aabbMax.makeCeil(base + disc);
+
+	collectAabb(aabbMin, aabbMax, hits);
+
+	const btVector3 a = gkMathUtils::get(apex);
+	const btVector3 n = gkMathUtils::get(axis);
+	const btScalar sinA = btSin(halfAngle), cosA = btCos(halfAngle);
+
+	// the cone's tip is at +Z, half the height from its center
+	btConeShapeZ cone(baseRadius, height);
+	cone.setMargin(0);
+	btTransform trans;
+	trans.setIdentity();
+	trans.setOrigin(a + n * (height * btScalar(0.5)));
+	trans.setRotation(shortestArcQuat(btVector3(0, 0, 1), -n));
+
+	for (UTsize i = 0; i < hits.size(); ++i)
+	{
+		const btBroadphaseProxy* proxy = hits[i]->getBroadphaseHandle();
+
+		// bounding sphere of the object's bounds against the capped cone, then the shape itself
+		const btVector3 center = (proxy->m_aabbMin + proxy->m_aabbMax) * btScalar(0.5);
+		const btScalar radius = (proxy->m_aabbMax - proxy->m_aabbMin).length() * btScalar(0.5);
+
+		const btVector3 v = center - a;
+		const btScalar along = v.dot(n);
+		if (along < -radius || along > height + radius)
+			continue;
+
+		const btScalar across = (v - n * along).length();
+		if (across * cosA - along * sinA > radius)
+			continue;
+
+		if (!gkShapeOverlapTest::test(&cone, trans, hits[i]))
+			continue;
+
+		gkGameObject* ob = gkPhysicsController::castObject(hits[i]);
+		if (ob && res.find(ob) == UT_NPOS)
+			res.push_back(ob);
+	}
+
+	return res;
+}
+
+
+
+UTsize gkDynamicsWorld::queueRay(const gkVector3& from, const gkVector3& to, gkGameObject* ignore)
+{
+	return queueSweep(from, to, 0.f, ignore);
+}
+
+
+
+UTsize gkDynamicsWorld::queueSweep(const gkVector3& from, const gkVector3& to, gkScalar radius, gkGameObject* ignore)
+{
+	const btCollisionObject* colObj = ignore && ignore->getPhysicsController() ? ignore->getPhysicsController()->getCollisionObject() : 0;
+	return m_batch.queue(from, to, radius, colObj);
+}
+
+
+
+void gkDynamicsWorld::runBatch(void)
+{
+	GK_ASSERT(m_dynamicsWorld);
+
+	const UTsize count = m_batch.getQueuedCount();
+	if (count == 0)
+		return;
+
+	if (!m_batchPool && count > gkRayBatch::CHUNK)
+	{
+		int threads = gkEngine::getSingleton().getUserDefs().rayThreads;
+		if (threads < 0)
+			threads = (int)gkThreadPool::getHardwareThreads();
+		if (threads > 1)
+			m_batchPool = new gkThreadPool("RayBatch", (UTsize)threads);
+	}
+
+	// both backends use a btDbvtBroadphase, see createInstanceImpl
+	m_batch.run(static_cast<btDbvtBroadphase*>(m_pairCache), m_batchPool);
+
+	gkRayBatch::Hits& hits = m_batch.getHits();
+	for (UTsize i = 0; i < hits.size(); ++i)
+		hits[i].object = hits[i].collisionObject ? gkPhysicsController::castObject(hits[i].collisionObject) : 0;
+}
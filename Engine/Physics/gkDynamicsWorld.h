@@ -32,6 +32,9 @@
 #include "gkMathUtils.h"
 #include "LinearMath/btScalar.h"
 #include "gkGhost.h"
+#include "Thread/gkCriticalSection.h"
+#include "gkContactTracker.h"
+#include "gkRayBatch.h"
 
 class btDynamicsWorld;
 class btCollisionConfiguration;
@@ -45,9 +48,13 @@ class gkCharacter;
 class btTriangleMesh;
 class btCollisionShape;
 class btGhostPairCallback;
+class btThreadSupportInterface;
 class gkPhysicsDebug;
 class gkDbvt;
 class gkPhysicsConstraintProperties;
+class gkThreadPool;
+class gkShapeCache;
+class gkContactTables;
 
 class gkDynamicsWorld
 {
@@ -64,6 +71,45 @@ public:
 	typedef utArray<Listener*> Listeners;
 
 
+	// Begin, persist and end events for pairs with a contact listening
+	// controller on either side (see gkPhysicsController::_isContactListener).
+	// Manifolds are only walked while one is registered.
+	typedef gkContactTracker::Listener ContactListener;
+	typedef gkContactTracker::Pair     ContactPair;
+
+
+	// Overlap query asked by a sensor, same arguments share one result per step
+	class QueryKey
+	{
+	public:
+		enum Type
+		{
+			QK_SPHERE,
+			QK_CONE,
+		};
+
+		QueryKey() : m_type(QK_SPHERE) { memset(m_args, 0, sizeof(m_args)); }
+		QueryKey(int type, const gkScalar* args, int nargs);
+
+		UThash hash(void) const;
+
+		bool operator== (const QueryKey& v) const {return m_type == v.m_type && !memcmp(m_args, v.m_args, sizeof(m_args));}
+		bool operator!= (const QueryKey& v) const {return !(*this == v);}
+
+	private:
+		int      m_type;
+		gkScalar m_args[8];
+	};
+
+	typedef utArray<gkGameObject*> QueryResult;
+
+
+	// Ray (radius 0) or sphere sweep queued for the next batch, closest hit
+	typedef gkRayBatch::Query BatchQuery;
+	typedef gkRayBatch::Hit   BatchHit;
+	typedef gkRayBatch::Hits  BatchHits;
+
+
 protected:
 
 	gkScene*                    m_scene;
@@ -73,19 +119,46 @@ protected:
 	btGhostPairCallback*        m_ghostPairCallback;
 	btDispatcher*               m_dispatcher;
 	btConstraintSolver*         m_constraintSolver;
+	btThreadSupportInterface*   m_collisionThreads;
+	btThreadSupportInterface*   m_solverThreads;
+	gkScalar                    m_fixedStep;
+	int                         m_maxSubSteps;
 	gkPhysicsControllers        m_objects;
 	gkPhysicsDebug*             m_debug;
 	bool                        m_handleContacts;
 	gkDbvt*                     m_dbvt;
 	Listeners                   m_listeners;
+	gkContactTables*            m_contactTables;    // before m_contacts, which reports to it
+	gkContactTracker            m_contacts;
+
+	// query -> index into m_queryResults, dropped every step
+	utHashTable<QueryKey, UTsize> m_queries;
+	utArray<QueryResult*>       m_queryResults;
+	utArray<btCollisionObject*> m_queryHits;        // scratch, under m_queryLock
+	gkCriticalSection           m_queryLock;
+
+	gkRayBatch                  m_batch;
+	gkThreadPool*               m_batchPool;
+
+	gkShapeCache*               m_shapeCache;
+
+	QueryResult& beginQuery(const QueryKey& key, bool& cached);
+	void collectAabb(const gkVector3& aabbMin, const gkVector3& aabbMax, utArray<btCollisionObject*>& hits);
 
 
 	// drawing all but static wireframes
 	void localDrawObject(gkPhysicsController* phyCon);
 
+	void updateContacts(void);
+	void removeContacts(gkPhysicsController* cont);
+
 	void createInstanceImpl(void);
 	void destroyInstanceImpl(void);
 
+#ifdef OGREKIT_COMPILE_BULLET_MULTITHREADED
+	void createThreadedBackend(int threads);
+#endif
+
 	static void substepCallback(btDynamicsWorld* dyn, btScalar tick);
 	static void presubstepCallback(btDynamicsWorld *dyn, btScalar tick);
 
@@ -100,6 +173,9 @@ public:
 
 	void EnableContacts(bool enable) { m_handleContacts = enable; }
 
+	GK_INLINE gkScalar getFixedStep(void) const     {return m_fixedStep;}
+	GK_INLINE int getMaxSubSteps(void) const        {return m_maxSubSteps;}
+
 	btRigidBody* getFixedBody();
 	btTypedConstraint* createConstraint(btRigidBody* rbA, btRigidBody* rbB, const gkPhysicsConstraintProperties& props);
 
@@ -109,8 +185,12 @@ public:
 	gkGhost* createGhost(gkGameObject* state);
 	void destroyObject(gkPhysicsController* cont);
 
+	// Take a controller out of the world without destroying it (see gkScene's clone pool)
+	void suspendObject(gkPhysicsController* cont, bool v);
+
 	GK_INLINE btDynamicsWorld* getBulletWorld(void) {GK_ASSERT(m_dynamicsWorld); return m_dynamicsWorld;}
 	GK_INLINE gkScene* getScene(void)               {GK_ASSERT(m_scene); return m_scene;}
+	GK_INLINE gkShapeCache* getShapeCache(void)     {return m_shapeCache;}
 
 	void enableDebugPhysics(bool enable, bool debugAabb);
 
@@ -128,6 +208,28 @@ public:
 	
 	void addListener(Listener *listener);
 	void removeListener(Listener *listener);
+
+	void addContactListener(ContactListener* listener);
+	void removeContactListener(ContactListener* listener);
+
+	// Objects touching a sphere / a cone (apex, unit axis, height, half angle in radians).
+	// Broadphase candidates with an exact shape test, results are shared until the next step.
+	// Safe to call from logic workers while the world isn't stepping.
+	const QueryResult& querySphere(const gkVector3& center, gkScalar radius);
+	const QueryResult& queryCone(const gkVector3& apex, const gkVector3& axis, gkScalar height, gkScalar halfAngle);
+	void clearQueries(void);
+
+	// Rays and sweeps queued during logic run together once per tick, before the step.
+	// The returned index addresses getBatchHits() once the batch has run. Hits on
+	// objects destroyed or suspended since read as misses.
+	UTsize queueRay(const gkVector3& from, const gkVector3& to, gkGameObject* ignore = 0);
+	UTsize queueSweep(const gkVector3& from, const gkVector3& to, gkScalar radius, gkGameObject* ignore = 0);
+
+	// Runs everything queued so far, callers needing results this tick may flush early
+	void runBatch(void);
+
+	GK_INLINE const BatchHits& getBatchHits(void) const    {return m_batch.getHits();}
+	GK_INLINE UTsize           getQueuedCount(void) const  {return m_batch.getQueuedCount();}
 };
 
 
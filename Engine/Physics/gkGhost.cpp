@@ -105,7 +105,7 @@ void gkGhost::destroy(void)
 		if (!m_suspend)
 			dyn->removeCollisionObject(m_collisionObject);
 
-		delete m_shape;
+		destroyShape(m_shape);
 		m_shape = 0;
 
 		delete m_collisionObject;
@@ -129,23 +129,10 @@ void gkGhost::setWorldTransform(const btTransform& worldTrans)
 }
 
 
-void gkGhost::_handleManifold(btPersistentManifold* manifold)
+bool gkGhost::_isContactListener(void) const
 {
-	gkPhysicsController* colA = castController(manifold->getBody0());
-	gkPhysicsController* colB = castController(manifold->getBody1());
-
-	gkPhysicsController* collider = colB;
-
-	if (collider == this)
-	{
-		collider = colA;
-	}
-
-	m_localContacts.reserve(1);
-
-	gkContactInfo cinf;
-	cinf.collider = collider;
-	m_localContacts.push_back(cinf);
+	// ghosts always track what overlaps them
+	return true;
 }
 
 
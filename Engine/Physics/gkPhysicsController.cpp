@@ -30,6 +30,7 @@
 #include "gkEntity.h"
 #include "gkMesh.h"
 #include "gkCharacter.h"
+#include "gkShapeCache.h"
 
 #include "OgreSceneNode.h"
 #include "OgreMovableObject.h"
@@ -50,6 +51,9 @@ gkPhysicsController::gkPhysicsController(gkGameObject* object, gkDynamicsWorld*
 {
 	// initial copy from object
 	m_props = object->getProperties().m_physics;
+
+	if (m_owner && m_props.isContactListener())
+		watchContacts(true);
 }
 
 
@@ -67,6 +71,9 @@ void gkPhysicsController::destroyShape(btCollisionShape* shape)
 {
 	if (!shape) return;
 
+	if (m_owner && m_owner->getShapeCache()->release(shape))
+		return;
+
 	if (shape->isCompound())
 	{
 		btCompoundShape* compShape = static_cast<btCompoundShape*>(shape);
@@ -74,10 +81,7 @@ void gkPhysicsController::destroyShape(btCollisionShape* shape)
 		for (i = 0; i < compShape->getNumChildShapes(); i++)
 		{
 			btCollisionShape* childShape = compShape->getChildShape(i);
-			if (childShape->isCompound())
-				destroyShape(childShape);
-			else
-				delete childShape;
+			destroyShape(childShape);
 		}
 	}
 
@@ -109,43 +113,32 @@ gkPhysicsProperties& gkPhysicsController::getProperties(void)
 }
 
 
-gkContactInfo::Array& gkPhysicsController::getContacts(void)
+gkContactInfo::Table& gkPhysicsController::getContacts(void)
 {
+	if (m_owner && m_props.isContactListener())
+		watchContacts(true);
 	return m_localContacts;
 }
 
 
 gkContactInfo::Iterator gkPhysicsController::getContactIterator(void)
 {
-	return gkContactInfo::Iterator(m_localContacts);
+	return gkContactInfo::Iterator(getContacts());
 }
 
 
 
 bool gkPhysicsController::collidesWith(gkGameObject* ob, gkContactInfo* cpy)
 {
-	if (!m_localContacts.empty())
-	{
-		UTsize i, s;
-		gkContactInfo::Array::Pointer p;
-
-		i = 0;
-		s = m_localContacts.size();
-		p = m_localContacts.ptr();
+	if (m_localContacts.empty() || !ob || !ob->getPhysicsController())
+		return false;
 
-		while (i < s)
-		{
-			GK_ASSERT(p[i].collider);
+	gkContactInfo* info = m_localContacts.get(ob->getPhysicsController());
+	if (!info)
+		return false;
 
-			if (p[i].collider->getObject() == ob)
-			{
-				if (cpy) *cpy = p[i];
-				return true;
-			}
-			++i;
-		}
-	}
-	return false;
+	if (cpy) *cpy = *info;
+	return true;
 }
 
 
@@ -163,7 +156,7 @@ bool gkPhysicsController::collidesWith(const gkString& name, gkContactInfo* cpy,
 
 
 		UTsize i, s;
-		gkContactInfo::Array::Pointer p;
+		gkContactInfo::Table::Pointer p;
 
 		i = 0;
 		s = m_localContacts.size();
@@ -171,12 +164,12 @@ bool gkPhysicsController::collidesWith(const gkString& name, gkContactInfo* cpy,
 
 		while (i < s)
 		{
-			GK_ASSERT(p[i].collider);
-			gkGameObject* gobj = p[i].collider->getObject();
+			GK_ASSERT(p[i].second.collider);
+			gkGameObject* gobj = p[i].second.collider->getObject();
 
 			if (name.find(gobj->getName()) != gkString::npos)
 			{
-				if (cpy) *cpy = p[i];
+				if (cpy) *cpy = p[i].second;
 				return true;
 			}
 
@@ -209,7 +202,7 @@ bool gkPhysicsController::sensorCollides(const gkString& prop, const gkString& m
 		}
 
 		UTsize i, s;
-		gkContactInfo::Array::Pointer p;
+		gkContactInfo::Table::Pointer p;
 
 		i = 0;
 		s = m_localContacts.size();
@@ -217,8 +210,8 @@ bool gkPhysicsController::sensorCollides(const gkString& prop, const gkString& m
 
 		while (i < s)
 		{
-			GK_ASSERT(p[i].collider);
-			gkGameObject* gobj = p[i].collider->getObject();
+			GK_ASSERT(p[i].second.collider);
+			gkGameObject* gobj = p[i].second.collider->getObject();
 
 
 			if (onlyActor)
@@ -435,10 +428,24 @@ void gkPhysicsController::enableContactProcessing(bool v)
 			if (m_props.isContactListener())
 				m_props.m_mode = m_props.m_mode ^ GK_CONTACT;
 		}
+
+		watchContacts(v);
 	}
 }
 
 
+
+void gkPhysicsController::watchContacts(bool v)
+{
+	GK_ASSERT(m_owner);
+
+	if (v)
+		m_owner->addContactListener(&m_contactWatch);
+	else
+		m_owner->removeContactListener(&m_contactWatch);
+}
+
+
 gkPhysicsController* gkPhysicsController::castController(void* colObj)
 {
 	GK_ASSERT(colObj);
@@ -509,7 +516,12 @@ void gkPhysicsController::suspend(bool v)
 		}
 		else
 		{
-			if (body)
+			const gkPhysicsProperties& phy = getProperties();
+
+			// keep the collision filter given at creation
+			if (body && phy.m_colMask != -2 && phy.m_colGroupMask != -2)
+				dyn->addRigidBody(body, phy.m_colGroupMask, phy.m_colMask);
+			else if (body)
 				dyn->addRigidBody(body);
 			else if (ghost)
 			{
@@ -580,6 +592,11 @@ void gkPhysicsController::createShape(void)
 }
 
 btCollisionShape* gkPhysicsController::_createShape(void)
+{
+	return _createShape(m_object->getScale());
+}
+
+btCollisionShape* gkPhysicsController::_createShape(const gkVector3& scale)
 {
 	gkMesh* me = 0;
 	gkEntity* ent = m_object->getEntity();
@@ -592,61 +609,11 @@ btCollisionShape* gkPhysicsController::_createShape(void)
 	else
 		size *= m_props.m_radius;
 
-	btCollisionShape* shape = 0;	
-
-	switch (m_props.m_shape)
-	{
-	case SH_BOX:
-		shape = new btBoxShape(btVector3(size.x, size.y, size.z));
-		break;
-	case SH_CONE:
-		shape = new btConeShapeZ(gkMax(size.x, size.y), 2.f * size.z);
-		break;
-	case SH_CYLINDER:
-		shape = new btCylinderShapeZ(btVector3(size.x, size.y, size.z));
-		break;
-	case SH_CONVEX_TRIMESH:
-	case SH_GIMPACT_MESH:
-	case SH_BVH_MESH:
-		{
-			if (me != 0)
-			{
-				btTriangleMesh* triMesh = me->getTriMesh();
-				if (triMesh->getNumTriangles() > 0)
-				{
-					switch (m_props.m_shape)
-					{
-					case SH_CONVEX_TRIMESH:
-					case SH_GIMPACT_MESH:
-						shape = new btConvexTriangleMeshShape(triMesh);
-						break;
-					case SH_BVH_MESH:
-						shape = new btBvhTriangleMeshShape(triMesh, true);
-						break;
-					}
- 					break;
-				}
-				else
-					return 0;
-			}
-		}
-	case SH_SPHERE:
-		shape = new btSphereShape(gkMax(size.x, gkMax(size.y, size.z)));
-		break;
-	case SH_CAPSULE:
-		// For some reason, the shape is a bit bigger than the actual capsule...
-		gkScalar c_radius = gkMax(size.x, size.y);
-		shape = new btCapsuleShapeZ(c_radius-0.05, (size.z-c_radius-0.05) * 2);
-		break;
-	}
-
+	// shared with every controller using the same bounds
+	btCollisionShape* shape = m_owner->getShapeCache()->acquire(me, m_props.m_shape, size, scale, m_props.m_margin);
 	if (!shape)
 		return 0;
 
-	shape->setMargin(m_props.m_margin);
-	shape->setLocalScaling(gkMathUtils::get(m_object->getScale()));
-
-
 	if (m_props.isCompound())
 	{
 		btCompoundShape *compShape = new btCompoundShape();
@@ -655,7 +622,6 @@ btCollisionShape* gkPhysicsController::_createShape(void)
 	}
 	
 	return shape;
-	
 }
 
 
@@ -681,60 +647,41 @@ void gkPhysicsController::setTransform(const btTransform& worldTrans)
 
 
 
-void gkPhysicsController::_handleManifold(btPersistentManifold* manifold)
+bool gkPhysicsController::_isContactListener(void) const
 {
-	if (m_suspend
-			|| !m_props.isContactListener()
-			|| !m_object->isInstanced())
-		return;
+	return !m_suspend && m_props.isContactListener() && m_object->isInstanced();
+}
 
 
-	gkPhysicsController* colA = castController(manifold->getBody0());
-	gkPhysicsController* colB = castController(manifold->getBody1());
 
-	gkPhysicsController* collider = colB;
+void gkPhysicsController::_setContact(gkPhysicsController* collider, const btManifoldPoint* point)
+{
+	GK_ASSERT(collider);
 
-	if (collider == this)
+	gkContactInfo* info = m_localContacts.get(collider);
+	if (!info)
 	{
-		collider = colA;
-	}
-
-
-	if (collider->m_object->getProperties().isGhost()){
-		m_localContacts.reserve(1);
-
 		gkContactInfo cinf;
 		cinf.collider = collider;
-		m_localContacts.push_back(cinf);
-	}
-	else {
-		int nrc = manifold->getNumContacts();
+		if (point)
+			cinf.point = *point;
 
-		if (nrc)
-		{
-			m_localContacts.reserve(nrc);
+		m_localContacts.insert(collider, cinf);
+	}
+	else if (point)
+		info->point = *point;
+}
 
-			for (int j = 0; j < nrc; ++j)
-			{
-				gkContactInfo cinf;
-				btManifoldPoint& pt = manifold->getContactPoint(j);
 
-				if (pt.getDistance() < 0.f)
-				{
-					cinf.collider = collider;
-					cinf.point    = pt;
 
-					m_localContacts.push_back(cinf);
-				}
-			}
-		}
-	}
+void gkPhysicsController::_removeContact(gkPhysicsController* collider)
+{
+	m_localContacts.remove(collider);
 }
 
 
 
-void gkPhysicsController::_resetContactInfo(void)
+void gkPhysicsController::_clearContacts(void)
 {
-	if (m_props.isContactListener())
-		m_localContacts.clear(true);
+	m_localContacts.clear(true);
 }
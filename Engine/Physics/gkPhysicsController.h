@@ -33,6 +33,7 @@
 
 
 #include "gkSerialize.h"
+#include "gkContactTracker.h"
 
 class btDynamicsWorld;
 class btTriangleMesh;
@@ -40,13 +41,14 @@ class gkDynamicsWorld;
 
 
 
+///One entry per touching object, keyed by the colliding controller.
 struct gkContactInfo
 {
 	gkPhysicsController* collider;
 	btManifoldPoint      point;
 
-	typedef utArray<gkContactInfo> Array;
-	typedef utArrayIterator<Array> Iterator;
+	typedef utHashTable<utPointerHashKey, gkContactInfo> Table;
+	typedef utHashTableIterator<Table> Iterator;
 };
 
 
@@ -74,7 +76,12 @@ public:
 
 	void enableContactProcessing(bool v);
 
-	gkContactInfo::Array&    getContacts(void);
+	// Contact tables are only filled while the world has a contact listener.
+	// Controllers with contact processing watch from the start, and asking
+	// for the table watches too (properties changed after creation).
+	void watchContacts(bool v);
+
+	gkContactInfo::Table&    getContacts(void);
 	gkContactInfo::Iterator  getContactIterator(void);
 
 
@@ -115,11 +122,15 @@ public:
 	virtual void create(void)  {}
 	virtual void destroy(void) {}
 
-	virtual void _handleManifold(btPersistentManifold* manifold);
-	void _resetContactInfo(void);
+	// Contact set maintenance, driven by gkDynamicsWorld contact events.
+	virtual bool _isContactListener(void) const;
+	void _setContact(gkPhysicsController* collider, const btManifoldPoint* point);
+	void _removeContact(gkPhysicsController* collider);
+	void _clearContacts(void);
 	bool _markDbvt(bool v);
 	
 	btCollisionShape* _createShape(void);
+	btCollisionShape* _createShape(const gkVector3& scale);
 
 protected:
 
@@ -129,7 +140,7 @@ protected:
 	void createShape(void);
 	void destroyShape(btCollisionShape* shape);
 
-	gkContactInfo::Array m_localContacts;
+	gkContactInfo::Table m_localContacts;
 
 	gkDynamicsWorld* m_owner;
 	gkGameObject* m_object;
@@ -141,6 +152,8 @@ protected:
 	bool m_dbvtMark;
 
 	gkPhysicsProperties m_props;
+
+	gkContactTracker::Listener m_contactWatch;
 };
 
 #endif//_gkPhysicsController_h_
@@ -0,0 +1,218 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "gkRayBatch.h"
+#include "Thread/gkThreadPool.h"
+#include "btBulletCollisionCommon.h"
+#include "BulletCollision/BroadphaseCollision/btDbvtBroadphase.h"
+
+
+
+// Leaves of the broadphase tree touched by one batched query, narrowphase runs
+// straight on the shape so nothing shared with the world is written.
+class gkBatchLeafCallback : public btDbvt::ICollide
+{
+public:
+	const btCollisionObject*                         m_ignore;
+	btTransform                                      m_from, m_to;
+	const btConvexShape*                             m_cast;
+	btCollisionWorld::ClosestRayResultCallback*      m_ray;
+	btCollisionWorld::ClosestConvexResultCallback*   m_sweep;
+
+	void Process(const btDbvtNode* leaf)
+	{
+		btBroadphaseProxy* proxy = static_cast<btBroadphaseProxy*>(leaf->data);
+		btCollisionObject* colObj = static_cast<btCollisionObject*>(proxy->m_clientObject);
+
+		if (colObj == m_ignore)
+			return;
+
+		if (m_sweep)
+		{
+			if (m_sweep->needsCollision(proxy))
+				btCollisionWorld::objectQuerySingle(m_cast, m_from, m_to, colObj, colObj->getCollisionShape(), colObj->getWorldTransform(), *m_sweep, 0);
+		}
+		else if (m_ray->needsCollision(proxy))
+			btCollisionWorld::rayTestSingle(m_from, m_to, colObj, colObj->getCollisionShape(), colObj->getWorldTransform(), *m_ray);
+	}
+};
+
+
+
+void gkRayBatch::runRange(btDbvtBroadphase* broadphase, const Query* queries, Hit* hits, UTsize count)
+{
+	for (UTsize i = 0; i < count; ++i)
+	{
+		const Query& q = queries[i];
+		Hit& hit = hits[i];
+
+		const btVector3 from = gkMathUtils::get(q.from), to = gkMathUtils::get(q.to);
+
+		gkBatchLeafCallback cb;
+		cb.m_ignore = q.ignore;
+		cb.m_from.setIdentity();
+		cb.m_from.setOrigin(from);
+		cb.m_to.setIdentity();
+		cb.m_to.setOrigin(to);
+		cb.m_cast  = 0;
+		cb.m_ray   = 0;
+		cb.m_sweep = 0;
+
+		hit.object          = 0;
+		hit.collisionObject = 0;
+		hit.point           = q.to;
+		hit.normal          = gkVector3::ZERO;
+		hit.fraction        = 1.f;
+
+		// btDbvt::rayTest and collideTV keep their stacks local, safe to share between workers
+		if (q.radius > 0.f)
+		{
+			btSphereShape sphere(q.radius);
+			btCollisionWorld::ClosestConvexResultCallback result(from, to);
+			cb.m_cast  = &sphere;
+			cb.m_sweep = &result;
+
+			const btVector3 ext(q.radius, q.radius, q.radius);
+			btVector3 aabbMin = from, aabbMax = from;
+			aabbMin.setMin(to);
+			aabbMax.setMax(to);
+
+			const btDbvtVolume volume = btDbvtVolume::FromMM(aabbMin - ext, aabbMax + ext);
+			broadphase->m_sets[0].collideTV(broadphase->m_sets[0].m_root, volume, cb);
+			broadphase->m_sets[1].collideTV(broadphase->m_sets[1].m_root, volume, cb);
+
+			if (result.hasHit())
+			{
+				hit.collisionObject = result.m_hitCollisionObject;
+				hit.point           = gkVector3(result.m_hitPointWorld);
+				hit.normal          = gkVector3(result.m_hitNormalWorld);
+				hit.fraction        = result.m_closestHitFraction;
+			}
+		}
+		else
+		{
+			btCollisionWorld::ClosestRayResultCallback result(from, to);
+			cb.m_ray = &result;
+
+			btDbvt::rayTest(broadphase->m_sets[0].m_root, from, to, cb);
+			btDbvt::rayTest(broadphase->m_sets[1].m_root, from, to, cb);
+
+			if (result.hasHit())
+			{
+				hit.collisionObject = result.m_collisionObject;
+				hit.point           = gkVector3(result.m_hitPointWorld);
+				hit.normal          = gkVector3(result.m_hitNormalWorld);
+				hit.fraction        = result.m_closestHitFraction;
+			}
+		}
+	}
+}
+
+
+
+class gkBatchCall : public gkCall
+{
+public:
+	gkBatchCall(btDbvtBroadphase* broadphase, const gkRayBatch::Query* queries, gkRayBatch::Hit* hits, UTsize count)
+		:	m_broadphase(broadphase), m_queries(queries), m_hits(hits), m_count(count)
+	{
+	}
+
+	void run() { gkRayBatch::runRange(m_broadphase, m_queries, m_hits, m_count); }
+
+private:
+	btDbvtBroadphase*                   m_broadphase;
+	const gkRayBatch::Query*  m_queries;
+	gkRayBatch::Hit*          m_hits;
+	UTsize                              m_count;
+};
+
+
+
+UTsize gkRayBatch::queue(const gkVector3& from, const gkVector3& to, gkScalar radius, const btCollisionObject* ignore)
+{
+	Query q;
+	q.from   = from;
+	q.to     = to;
+	q.radius = radius;
+	q.ignore = ignore;
+
+	m_queries.push_back(q);
+	return m_queries.size() - 1;
+}
+
+
+
+void gkRayBatch::run(btDbvtBroadphase* broadphase, gkThreadPool* pool)
+{
+	const UTsize count = m_queries.size();
+	if (count == 0)
+		return;
+
+	m_hits.resize(count);
+
+	if (pool && count > CHUNK)
+	{
+		for (UTsize i = 0; i < count; i += CHUNK)
+		{
+			const UTsize n = gkMin(CHUNK, count - i);
+			pool->enqueue(gkPtrRef<gkCall>(new gkBatchCall(broadphase, m_queries.ptr() + i, m_hits.ptr() + i, n)));
+		}
+		pool->wait();
+	}
+	else
+		runRange(broadphase, m_queries.ptr(), m_hits.ptr(), count);
+
+	m_queries.clear(true);
+}
+
+
+
+void gkRayBatch::invalidate(const btCollisionObject* colObj)
+{
+	if (!colObj)
+		return;
+
+	UTsize i;
+	for (i = 0; i < m_queries.size(); ++i)
+	{
+		if (m_queries[i].ignore == colObj)
+			m_queries[i].ignore = 0;
+	}
+
+	for (i = 0; i < m_hits.size(); ++i)
+	{
+		Hit& hit = m_hits[i];
+		if (hit.collisionObject == colObj)
+		{
+			hit.object          = 0;
+			hit.collisionObject = 0;
+			hit.point           = Ogre::Vector3::ZERO;
+			hit.normal          = Ogre::Vector3::ZERO;
+			hit.fraction        = 1.f;
+		}
+	}
+}
@@ -0,0 +1,88 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _gkRayBatch_h_
+#define _gkRayBatch_h_
+
+#include "gkCommon.h"
+#include "gkMathUtils.h"
+
+class btCollisionObject;
+class btDbvtBroadphase;
+class gkThreadPool;
+
+
+// Rays (radius 0) and sphere sweeps run together against a broadphase tree,
+// split over a thread pool when there are enough of them.
+class gkRayBatch
+{
+public:
+
+	struct Query
+	{
+		gkVector3                from, to;
+		gkScalar                 radius;
+		const btCollisionObject* ignore;
+	};
+
+	// Closest hit of a query, collisionObject is 0 on a miss. object is filled
+	// in by the owner, see gkDynamicsWorld::runBatch.
+	struct Hit
+	{
+		gkGameObject*            object;
+		const btCollisionObject* collisionObject;
+		gkVector3                point;
+		gkVector3                normal;
+		gkScalar                 fraction;
+	};
+
+	typedef utArray<Query> Queries;
+	typedef utArray<Hit>   Hits;
+
+	UTsize queue(const gkVector3& from, const gkVector3& to, gkScalar radius, const btCollisionObject* ignore);
+
+	// Hits stay until the next run that has queries
+	void run(btDbvtBroadphase* broadphase, gkThreadPool* pool);
+
+	// A collision object going away, its hits read as misses from now on
+	// and queued queries stop ignoring it.
+	void invalidate(const btCollisionObject* colObj);
+
+	GK_INLINE Hits&       getHits(void)              {return m_hits;}
+	GK_INLINE const Hits& getHits(void) const        {return m_hits;}
+	GK_INLINE UTsize      getQueuedCount(void) const {return m_queries.size();}
+
+	// below this many queries the pool is left asleep
+	static const UTsize CHUNK = 64;
+
+	static void runRange(btDbvtBroadphase* broadphase, const Query* queries, Hit* hits, UTsize count);
+
+private:
+	Queries m_queries;
+	Hits    m_hits;
+};
+
+#endif//_gkRayBatch_h_
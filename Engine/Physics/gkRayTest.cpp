@@ -45,6 +45,41 @@ gkRayTest::~gkRayTest()
 {
 }
 
+
+
+// btCollisionWorld::rayTest walks the broadphase with a stack kept in the tree,
+// the static walk keeps it local so sensors may cast rays from logic workers.
+class gkRayLeafCallback : public btDbvt::ICollide
+{
+public:
+	gkRayLeafCallback(const btVector3& from, const btVector3& to, btCollisionWorld::RayResultCallback& result)
+		:	m_result(result)
+	{
+		m_from.setIdentity();
+		m_from.setOrigin(from);
+		m_to.setIdentity();
+		m_to.setOrigin(to);
+	}
+
+	void Process(const btDbvtNode* leaf)
+	{
+		// terminate further ray tests, once the closestHitFraction reached zero
+		if (m_result.m_closestHitFraction == btScalar(0.))
+			return;
+
+		btBroadphaseProxy* proxy = static_cast<btBroadphaseProxy*>(leaf->data);
+		btCollisionObject* colObj = static_cast<btCollisionObject*>(proxy->m_clientObject);
+
+		if (m_result.needsCollision(proxy))
+			btCollisionWorld::rayTestSingle(m_from, m_to, colObj, colObj->getCollisionShape(), colObj->getWorldTransform(), m_result);
+	}
+
+private:
+	btTransform                             m_from, m_to;
+	btCollisionWorld::RayResultCallback&    m_result;
+};
+
+
 bool gkRayTest::collides(const Ogre::Ray& ray)
 {
 	gkVector3 from = ray.getOrigin();
@@ -70,7 +105,12 @@ bool gkRayTest::collides(const gkVector3& from, const gkVector3& to,
 
 	GK_ASSERT(pWorld);
 
-	pWorld->rayTest(rayFrom, rayTo, rayCallback);
+	// both backends use a btDbvtBroadphase, see gkDynamicsWorld::createInstanceImpl
+	btDbvtBroadphase* broadphase = static_cast<btDbvtBroadphase*>(pWorld->getBroadphase());
+
+	gkRayLeafCallback leaves(rayFrom, rayTo, rayCallback);
+	btDbvt::rayTest(broadphase->m_sets[0].m_root, rayFrom, rayTo, leaves);
+	btDbvt::rayTest(broadphase->m_sets[1].m_root, rayFrom, rayTo, leaves);
 
 	if (rayCallback.hasHit())
 	{
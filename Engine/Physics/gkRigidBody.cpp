@@ -145,6 +145,22 @@ void gkRigidBody::create(void)
 		dyn->addRigidBody(m_body);
 }
 
+void gkRigidBody::resetMotion(void)
+{
+	if (m_suspend || !m_body)
+		return;
+
+	btTransform worldTrans = m_object->getTransformState().toTransform();
+
+	m_body->setWorldTransform(worldTrans);
+	m_body->setInterpolationWorldTransform(worldTrans);
+	m_body->setLinearVelocity(btVector3(0, 0, 0));
+	m_body->setAngularVelocity(btVector3(0, 0, 0));
+	m_body->setInterpolationLinearVelocity(btVector3(0, 0, 0));
+	m_body->setInterpolationAngularVelocity(btVector3(0, 0, 0));
+	m_body->clearForces();
+}
+
 void gkRigidBody::removeConstaints(void)
 {
 	btDynamicsWorld* dyn = getOwner();
@@ -173,7 +189,7 @@ void gkRigidBody::destroy(void)
 		if (!m_suspend)
 			dyn->removeRigidBody(m_body);
 
-		delete m_shape;
+		destroyShape(m_shape);
 		m_shape = 0;
 
 		delete m_body;
@@ -82,6 +82,9 @@ public:
 
 	void recalLocalInertia(void);
 
+	// Move the body to the object's transform and drop all motion
+	void resetMotion(void);
+
 private:
 
 	void getWorldTransform(btTransform& worldTrans) const;
@@ -0,0 +1,390 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "gkShapeCache.h"
+#include "gkMesh.h"
+#include "gkEngine.h"
+#include "gkUserDefs.h"
+#include "gkPath.h"
+#include "gkLogger.h"
+#include "btBulletDynamicsCommon.h"
+#include "BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h"
+#include "BulletCollision/CollisionShapes/btShapeHull.h"
+#include <stdio.h>
+#include <ctype.h>
+
+
+#define GK_BVH_FILE_ID      0x56424B47 // GKBV
+#define GK_BVH_FILE_VERSION 1
+
+
+// Serialized BVHs hold raw nodes, they only load on the same
+// scalar / pointer size and triangle data they were built from.
+struct gkBvhFileHeader
+{
+	UTuint32 id;
+	UTuint32 version;
+	UTuint32 scalarSize;
+	UTuint32 pointerSize;
+	UTuint32 hash;
+	UTuint32 triangles;
+	UTuint32 size;
+};
+
+
+
+class gkTriangleHashCallback : public btInternalTriangleIndexCallback
+{
+public:
+	UThash   m_hash;
+	UTuint32 m_count;
+
+	gkTriangleHashCallback() : m_hash(2166136261u), m_count(0) {}
+
+	void internalProcessTriangleIndex(btVector3* triangle, int partId, int triangleIndex)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			btScalar co[3] = {triangle[i].x(), triangle[i].y(), triangle[i].z()};
+
+			const unsigned char* p = reinterpret_cast<const unsigned char*>(co);
+			for (size_t b = 0; b < sizeof(co); ++b)
+				m_hash = (m_hash ^ p[b]) * 16777619u;
+		}
+		++m_count;
+	}
+};
+
+
+
+static gkString gkBvhFileName(gkMesh* mesh, UThash hash)
+{
+	gkString name = mesh->getName();
+	for (size_t i = 0; i < name.size(); ++i)
+	{
+		if (!isalnum((unsigned char)name[i]))
+			name[i] = '_';
+	}
+
+	gkPath path(gkEngine::getSingleton().getUserDefs().bvhCachePath);
+	path.append(utStringFormat("%s_%08x.bvh", name.c_str(), (unsigned int)hash));
+	return path.getPath();
+}
+
+
+
+gkShapeCache::Key::Key(gkMesh* mesh, int type, const gkVector3& size, const gkVector3& scale, gkScalar margin)
+	:	m_mesh(mesh), m_type(type)
+{
+	m_args[0] = size.x;
+	m_args[1] = size.y;
+	m_args[2] = size.z;
+	m_args[3] = scale.x;
+	m_args[4] = scale.y;
+	m_args[5] = scale.z;
+	m_args[6] = margin;
+}
+
+
+
+UThash gkShapeCache::Key::hash(void) const
+{
+	// FNV-1a over the mesh and raw arguments
+	UThash h = (2166136261u ^ utPointerHashKey(m_mesh).hash()) * 16777619u;
+	h = (h ^ (UThash)m_type) * 16777619u;
+
+	const unsigned char* p = reinterpret_cast<const unsigned char*>(m_args);
+	for (size_t i = 0; i < sizeof(m_args); ++i)
+		h = (h ^ p[i]) * 16777619u;
+	return h;
+}
+
+
+
+gkShapeCache::gkShapeCache()
+{
+}
+
+
+
+gkShapeCache::~gkShapeCache()
+{
+	GK_ASSERT(m_entries.empty() && "Collision shapes still in use");
+
+	// scaled shapes first, they reference their base
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		Entries::Iterator iter = m_entries.iterator();
+		while (iter.hasMoreElements())
+		{
+			Entry* entry = iter.getNext().second;
+			if ((entry->base != 0) == (pass == 0))
+			{
+				delete entry->shape;
+				entry->shape = 0;
+			}
+		}
+	}
+
+	Entries::Iterator iter = m_entries.iterator();
+	while (iter.hasMoreElements())
+	{
+		Entry* entry = iter.getNext().second;
+		if (entry->buffer)
+			btAlignedFree(entry->buffer);
+		delete entry;
+	}
+}
+
+
+
+btCollisionShape* gkShapeCache::acquire(gkMesh* mesh, int type, const gkVector3& size, const gkVector3& scale, gkScalar margin)
+{
+	// mesh bounds without a mesh fall back to a sphere
+	if (type == SH_CONVEX_TRIMESH || type == SH_GIMPACT_MESH || type == SH_BVH_MESH)
+	{
+		if (!mesh)
+			type = SH_SPHERE;
+		else if (mesh->getTriMesh()->getNumTriangles() == 0)
+			return 0;
+	}
+	else
+		mesh = 0;
+
+	Entry* entry = acquireEntry(mesh, type, mesh ? gkVector3::ZERO : size, scale, margin);
+	return entry ? entry->shape : 0;
+}
+
+
+
+bool gkShapeCache::release(btCollisionShape* shape)
+{
+	Entry** entry = m_shapes.get(shape);
+	if (!entry)
+		return false;
+
+	releaseEntry(*entry);
+	return true;
+}
+
+
+
+gkShapeCache::Entry* gkShapeCache::acquireEntry(gkMesh* mesh, int type, const gkVector3& size, const gkVector3& scale, gkScalar margin)
+{
+	Key key(mesh, type, size, scale, margin);
+
+	Entry** found = m_entries.get(key);
+	if (found)
+	{
+		(*found)->refs++;
+		return *found;
+	}
+
+	btCollisionShape* shape = 0;
+	Entry* base = 0;
+	void* buffer = 0;
+
+	if (mesh && scale != gkVector3::UNIT_SCALE)
+	{
+		base = acquireEntry(mesh, type, size, gkVector3::UNIT_SCALE, margin);
+		if (!base)
+			return 0;
+
+		if (type == SH_BVH_MESH)
+			shape = new btScaledBvhTriangleMeshShape(static_cast<btBvhTriangleMeshShape*>(base->shape), gkMathUtils::get(scale));
+		else
+		{
+			btConvexHullShape* hull = static_cast<btConvexHullShape*>(base->shape);
+			shape = new btConvexHullShape((const btScalar*)hull->getUnscaledPoints(), hull->getNumPoints());
+			shape->setMargin(margin);
+			shape->setLocalScaling(gkMathUtils::get(scale));
+		}
+	}
+	else
+	{
+		switch (type)
+		{
+		case SH_BOX:
+			shape = new btBoxShape(btVector3(size.x, size.y, size.z));
+			break;
+		case SH_CONE:
+			shape = new btConeShapeZ(gkMax(size.x, size.y), 2.f * size.z);
+			break;
+		case SH_CYLINDER:
+			shape = new btCylinderShapeZ(btVector3(size.x, size.y, size.z));
+			break;
+		case SH_CONVEX_TRIMESH:
+		case SH_GIMPACT_MESH:
+			shape = createHull(mesh->getTriMesh());
+			break;
+		case SH_BVH_MESH:
+			shape = createBvh(mesh, mesh->getTriMesh(), buffer);
+			break;
+		case SH_SPHERE:
+			shape = new btSphereShape(gkMax(size.x, gkMax(size.y, size.z)));
+			break;
+		case SH_CAPSULE:
+			{
+				// For some reason, the shape is a bit bigger than the actual capsule...
+				gkScalar c_radius = gkMax(size.x, size.y);
+				shape = new btCapsuleShapeZ(c_radius-0.05, (size.z-c_radius-0.05) * 2);
+			}
+			break;
+		}
+
+		if (!shape)
+			return 0;
+
+		shape->setMargin(margin);
+		if (!mesh)
+			shape->setLocalScaling(gkMathUtils::get(scale));
+	}
+
+	Entry* entry  = new Entry;
+	entry->key    = key;
+	entry->shape  = shape;
+	entry->base   = base;
+	entry->buffer = buffer;
+	entry->refs   = 1;
+
+	m_entries.insert(key, entry);
+	m_shapes.insert(shape, entry);
+	return entry;
+}
+
+
+
+void gkShapeCache::releaseEntry(Entry* entry)
+{
+	GK_ASSERT(entry && entry->refs > 0);
+	if (--entry->refs > 0)
+		return;
+
+	m_entries.remove(entry->key);
+	m_shapes.remove(entry->shape);
+
+	delete entry->shape;
+	if (entry->buffer)
+		btAlignedFree(entry->buffer);
+
+	if (entry->base)
+		releaseEntry(entry->base);
+
+	delete entry;
+}
+
+
+
+btCollisionShape* gkShapeCache::createHull(btTriangleMesh* triMesh)
+{
+	// reduce the mesh to a hull of at most a few dozen points
+	btConvexTriangleMeshShape tmp(triMesh);
+	btShapeHull hull(&tmp);
+
+	if (!hull.buildHull(tmp.getMargin()) || hull.numVertices() < 4)
+		return new btConvexTriangleMeshShape(triMesh);
+
+	return new btConvexHullShape((const btScalar*)hull.getVertexPointer(), hull.numVertices());
+}
+
+
+
+btCollisionShape* gkShapeCache::createBvh(gkMesh* mesh, btTriangleMesh* triMesh, void*& buffer)
+{
+	const gkString& dir = gkEngine::getSingleton().getUserDefs().bvhCachePath;
+	if (dir.empty())
+		return new btBvhTriangleMeshShape(triMesh, true);
+
+
+	btVector3 aabbMin(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT), aabbMax(-aabbMin);
+	gkTriangleHashCallback triHash;
+	triMesh->InternalProcessAllTriangles(&triHash, aabbMin, aabbMax);
+
+	gkBvhFileHeader header;
+	header.id          = GK_BVH_FILE_ID;
+	header.version     = GK_BVH_FILE_VERSION;
+	header.scalarSize  = sizeof(btScalar);
+	header.pointerSize = sizeof(void*);
+	header.hash        = triHash.m_hash;
+	header.triangles   = triHash.m_count;
+	header.size        = 0;
+
+	gkString fname = gkBvhFileName(mesh, triHash.m_hash);
+
+	FILE* fp = fopen(fname.c_str(), "rb");
+	if (fp)
+	{
+		gkBvhFileHeader disk;
+		btOptimizedBvh* bvh = 0;
+
+		if (fread(&disk, sizeof(disk), 1, fp) == 1 && disk.size > 0)
+		{
+			header.size = disk.size;
+			if (!memcmp(&disk, &header, sizeof(header)))
+			{
+				buffer = btAlignedAlloc(disk.size, 16);
+				if (fread(buffer, disk.size, 1, fp) == 1)
+					bvh = btOptimizedBvh::deSerializeInPlace(buffer, disk.size, false);
+			}
+		}
+		fclose(fp);
+
+		if (bvh)
+		{
+			btBvhTriangleMeshShape* shape = new btBvhTriangleMeshShape(triMesh, true, false);
+			shape->setOptimizedBvh(bvh);
+			return shape;
+		}
+
+		if (buffer)
+			btAlignedFree(buffer);
+		buffer = 0;
+		gkLogger::write("ShapeCache: ignoring stale BVH file " + fname);
+	}
+
+
+	btBvhTriangleMeshShape* shape = new btBvhTriangleMeshShape(triMesh, true);
+	btOptimizedBvh* bvh = shape->getOptimizedBvh();
+
+	header.size = bvh->calculateSerializeBufferSize();
+	void* data = btAlignedAlloc(header.size, 16);
+
+	if (bvh->serializeInPlace(data, header.size, false))
+	{
+		fp = fopen(fname.c_str(), "wb");
+		if (fp)
+		{
+			fwrite(&header, sizeof(header), 1, fp);
+			fwrite(data, header.size, 1, fp);
+			fclose(fp);
+		}
+		else
+			gkLogger::write("ShapeCache: can't write BVH file " + fname);
+	}
+
+	btAlignedFree(data);
+	return shape;
+}
@@ -0,0 +1,96 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _gkShapeCache_h_
+#define _gkShapeCache_h_
+
+#include "gkCommon.h"
+#include "gkMathUtils.h"
+
+class btCollisionShape;
+class btTriangleMesh;
+
+
+// Collision shapes shared by every controller with the same mesh, bounds
+// type, scale and margin. Mesh shapes are built once at unit scale, scaled
+// copies wrap them (btScaledBvhTriangleMeshShape) or copy the simplified hull.
+class gkShapeCache
+{
+public:
+	gkShapeCache();
+	~gkShapeCache();
+
+	// Shared shape, 0 when a mesh bounds has no collision faces.
+	// Every acquired shape must be given back with release.
+	btCollisionShape* acquire(gkMesh* mesh, int type, const gkVector3& size, const gkVector3& scale, gkScalar margin);
+
+	// False when the shape was not created by the cache
+	bool release(btCollisionShape* shape);
+
+	UTsize getShapeCount(void) const {return m_entries.size();}
+
+private:
+
+	class Key
+	{
+	public:
+		Key() : m_mesh(0), m_type(0) { memset(m_args, 0, sizeof(m_args)); }
+		Key(gkMesh* mesh, int type, const gkVector3& size, const gkVector3& scale, gkScalar margin);
+
+		UThash hash(void) const;
+
+		bool operator== (const Key& v) const {return m_mesh == v.m_mesh && m_type == v.m_type && !memcmp(m_args, v.m_args, sizeof(m_args));}
+		bool operator!= (const Key& v) const {return !(*this == v);}
+
+	private:
+		gkMesh*  m_mesh;
+		int      m_type;
+		gkScalar m_args[7];
+	};
+
+	struct Entry
+	{
+		Key               key;
+		btCollisionShape* shape;
+		Entry*            base;    // unit scale shape this one wraps / copies
+		void*             buffer;  // in place BVH loaded from disk
+		int               refs;
+	};
+
+	typedef utHashTable<Key, Entry*>              Entries;
+	typedef utHashTable<utPointerHashKey, Entry*> ShapeEntries;
+
+	Entries      m_entries;
+	ShapeEntries m_shapes;
+
+	Entry* acquireEntry(gkMesh* mesh, int type, const gkVector3& size, const gkVector3& scale, gkScalar margin);
+	void releaseEntry(Entry* entry);
+
+	btCollisionShape* createBvh(gkMesh* mesh, btTriangleMesh* triMesh, void*& buffer);
+	btCollisionShape* createHull(btTriangleMesh* triMesh);
+};
+
+#endif//_gkShapeCache_h_
@@ -30,6 +30,7 @@
 #include "gkCam2ViewportRay.h"
 #include "gkMesh.h"
 #include "External/Ogre/gkOgreMaterialLoader.h"
+#include "gkProfiler.h"
 
 
 gsProperty::gsProperty(gkVariable* var) : m_prop(var), m_creator(false)
@@ -1270,6 +1271,52 @@ gsArray<gsGameObject, gkGameObject> &gsScene::getObjectList(void)
 }
 
 
+#ifdef OGREKIT_COMPILE_OPENSTEER
+static void gsSteeringAgentsInScene(gkScene* scene, const gkSteeringObject::NEIGHBORS& agents, gsArray<gsGameObject, gkGameObject>& out)
+{
+	// the grid is shared by every scene
+	for (UTsize i = 0; i < agents.size(); ++i)
+	{
+		gkGameObject* obj = agents[i]->getObject();
+		if (obj->getOwner() == scene)
+			out.push(obj);
+	}
+}
+#endif
+
+
+gsArray<gsGameObject, gkGameObject> &gsScene::getSteeringNeighbors(const gsVector3& center, float radius)
+{
+	m_objectCache.clear();
+
+#ifdef OGREKIT_COMPILE_OPENSTEER
+	if (m_object)
+	{
+		gkSteeringObject::NEIGHBORS agents;
+		gkSteeringObject::getNeighbors(center, radius, agents);
+		gsSteeringAgentsInScene(cast<gkScene>(), agents, m_objectCache);
+	}
+#endif
+	return m_objectCache;
+}
+
+
+gsArray<gsGameObject, gkGameObject> &gsScene::getSteeringNeighborsInCorridor(const gsVector3& from, const gsVector3& to, float halfWidth)
+{
+	m_objectCache.clear();
+
+#ifdef OGREKIT_COMPILE_OPENSTEER
+	if (m_object)
+	{
+		gkSteeringObject::NEIGHBORS agents;
+		gkSteeringObject::getNeighborsInCorridor(from, to, halfWidth, agents);
+		gsSteeringAgentsInScene(cast<gkScene>(), agents, m_objectCache);
+	}
+#endif
+	return m_objectCache;
+}
+
+
 
 
 gsGameObject::gsGameObject()
@@ -1850,7 +1897,10 @@ bool gsGameObject::hasContacts()
 	{
 		gkPhysicsController* ob = get()->getPhysicsController();
 		if (ob)
+		{
+			ob->watchContacts(true);
 			return !ob->getContacts().empty();
+		}
 	}
 	return false;
 }
@@ -1863,7 +1913,10 @@ bool gsGameObject::hasContact(const gkString& object)
 	{
 		gkPhysicsController* ob = get()->getPhysicsController();
 		if (ob)
+		{
+			ob->watchContacts(true);
 			return ob->collidesWith(object);
+		}
 	}
 	return false;
 }
@@ -2237,6 +2290,31 @@ void gsDebugPrint(const char* str)
 	gkDebugScreen::printTo(str);
 }
 
+void gsProfileBegin(const gkString& zone)
+{
+	gkProfiler::getSingleton().begin(zone);
+}
+
+void gsProfileEnd()
+{
+	gkProfiler::getSingleton().end();
+}
+
+void gsProfileCapture(bool capture)
+{
+	gkProfiler::getSingleton().setCapture(capture);
+}
+
+bool gsProfileExport(const gkString& fileName)
+{
+	return gkProfiler::getSingleton().exportTrace(fileName);
+}
+
+gkString gsProfileReport()
+{
+	return gkProfiler::getSingleton().getReport();
+}
+
 void sendMessage(const char* from,const char* to,const char* subject,const char* body){
 	gkMessageManager::getSingletonPtr()->sendMessage(from,to,subject,body);
 }
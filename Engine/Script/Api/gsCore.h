@@ -393,6 +393,10 @@ public:
 
 	gsArray<gsGameObject, gkGameObject> &getObjectList(void);
 
+	// steering agents of this scene touching the sphere, or the capsule from -> to
+	gsArray<gsGameObject, gkGameObject> &getSteeringNeighbors(const gsVector3& center, float radius);
+	gsArray<gsGameObject, gkGameObject> &getSteeringNeighborsInCorridor(const gsVector3& from, const gsVector3& to, float halfWidth);
+
 	gkDynamicsWorld* getDynamicsWorld(void);
 
 	gkCamera* getMainCamera(void);
@@ -711,6 +715,13 @@ extern void gsDebugPrint(const char* str);
 
 extern bool gsSetCompositorChain(gsCompositorOp op, const gkString& compositorName);
 
+// gkProfiler zones, every ProfileBegin needs a matching ProfileEnd
+extern void gsProfileBegin(const gkString& zone);
+extern void gsProfileEnd();
+extern void gsProfileCapture(bool capture);
+extern bool gsProfileExport(const gkString& fileName);
+extern gkString gsProfileReport();
+
 extern void import(const gkString& scriptName);
 
 extern gkString getPlatform();
@@ -129,6 +129,12 @@ GS_SCRIPT_NAME(DebugPrint)
 
 GS_SCRIPT_NAME(SetCompositorChain)
 
+GS_SCRIPT_NAME(ProfileBegin)
+GS_SCRIPT_NAME(ProfileEnd)
+GS_SCRIPT_NAME(ProfileCapture)
+GS_SCRIPT_NAME(ProfileExport)
+GS_SCRIPT_NAME(ProfileReport)
+
 %rename(OGRE_RS_GL)       GS_RS_GL;
 %rename(OGRE_RS_GLES)     GS_RS_GLES;
 %rename(OGRE_RS_D3D9)     GS_RS_D3D9;
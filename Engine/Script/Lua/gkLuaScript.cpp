@@ -29,6 +29,7 @@
 #include "gkLuaUtils.h"
 #include "gkDebugScreen.h"
 #include "gkLogger.h"
+#include "gkProfiler.h"
 
 
 
@@ -40,7 +41,8 @@ gkLuaScript::gkLuaScript(gkResourceManager *creator, const gkResourceName &name,
 		m_compiled(false), 
 		m_isInvalid(false),
 		m_lastRetBoolValue(false),
-		m_lastRetStrValue("")
+		m_lastRetStrValue(""),
+		m_profileZone(gkProfiler::registerZone(getName()))
 {
 }
 
@@ -119,6 +121,8 @@ bool gkLuaScript::execute(void)
 	if (m_isInvalid)
 		return false;
 
+	GK_PROFILE_ZONE(m_profileZone);
+
 	m_lastRetBoolValue = false;
 	m_lastRetStrValue = "";
 
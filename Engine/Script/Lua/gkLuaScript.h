@@ -42,6 +42,7 @@ protected:
 
 	bool			m_lastRetBoolValue;
 	gkString		m_lastRetStrValue;
+	UTsize			m_profileZone;
 
 	void compile(void);
 
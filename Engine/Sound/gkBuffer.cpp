@@ -28,10 +28,11 @@
 #include "gkSoundStream.h"
 #include "gkSound.h"
 #include "gkSoundManager.h"
+#include "gkStreamer.h"
 
 
 
-gkBuffer::gkBuffer(gkSource* obj)
+gkBuffer::gkBuffer(gkSource* obj, gkStreamer* streamer)
 	:   m_sound(obj),
 	    m_stream(obj->getStream()),
 	    m_loop(false),
@@ -44,7 +45,10 @@ gkBuffer::gkBuffer(gkSource* obj)
 	    m_do3D(false),
 	    m_pos(0),
 	    m_eos(false),
-	    m_doUpdateProperties(false)
+	    m_doUpdateProperties(false),
+	    m_streamer(streamer),
+	    m_shared(0),
+	    m_sharedLen(0)
 {
 	if (m_stream != 0)
 	{
@@ -132,11 +136,20 @@ void gkBuffer::doProperties(void)
 }
 
 
+void gkBuffer::wake(void)
+{
+	if (m_streamer)
+		m_streamer->wake();
+}
+
+
 void gkBuffer::suspend(bool v)
 {
 	if (!m_ok) return;
 
 	m_doSuspend = m_suspend != v;
+	if (m_doSuspend)
+		wake();
 }
 
 
@@ -155,6 +168,7 @@ void gkBuffer::setPosition(const gkVector3& v)
 
 	m_props.m_position = v;
 	m_do3D = true;
+	wake();
 }
 
 
@@ -164,6 +178,7 @@ void gkBuffer::setDirection(const gkVector3& v)
 
 	m_props.m_direction = v;
 	m_do3D = true;
+	wake();
 }
 
 
@@ -174,6 +189,7 @@ void gkBuffer::setVelocity(const gkVector3& v)
 
 	m_props.m_velocity = v;
 	m_do3D = true;
+	wake();
 }
 
 
@@ -186,16 +202,28 @@ bool gkBuffer::initialize(void)
 
 	alGetError();
 
-	alGenBuffers(GK_SND_SAMPLES, m_buffer);
-	if (alErrorThrow("opening buffers"))
+	// short sounds played before share one decoded buffer
+	if (m_streamer && m_sound)
+		m_shared = m_streamer->getCache().acquire(m_sound->getCreator(), m_sharedLen);
+
+	if (!m_shared)
 	{
-		m_ok = false;
-		return false;
+		alGenBuffers(GK_SND_SAMPLES, m_buffer);
+		if (alErrorThrow("opening buffers"))
+		{
+			m_ok = false;
+			return false;
+		}
 	}
 
 	alGenSources(1, &m_source);
 	if (alErrorThrow("opening source"))
 	{
+		if (m_shared)
+		{
+			m_streamer->getCache().release(m_shared);
+			m_shared = 0;
+		}
 		m_ok = false;
 		return false;
 	}
@@ -211,6 +239,20 @@ void gkBuffer::queue(bool play)
 	if (!m_ok)
 		return;
 
+	if (m_shared)
+	{
+		alSourcei(m_source, AL_BUFFER, m_shared);
+		m_ok = !alErrorThrow("attach cached buffer");
+		if (play && m_ok)
+		{
+			alSourcePlay(m_source);
+			m_ok = !alErrorThrow("source playback");
+			doProperties();
+		}
+		m_initial = false;
+		return;
+	}
+
 	// queue initial buffers
 	int blk = 0;
 	for (blk = 0; blk < GK_SND_SAMPLES; ++blk)
@@ -253,14 +295,28 @@ void gkBuffer::finalize(void)
 		m_sound = 0;
 	}
 
-	if (!m_ok || !m_isInit)
+	if (!m_isInit)
 		return;
 
-	reset();
-	alDeleteBuffers(GK_SND_SAMPLES, m_buffer);
-	alErrorThrow("closing buffers");
+	if (m_ok)
+		reset();
+
+	// source goes first, the shared buffer may not be attached when deleted
 	alDeleteSources(1, &m_source);
 	alErrorThrow("closing sources");
+
+	if (m_shared)
+	{
+		if (m_streamer)
+			m_streamer->getCache().release(m_shared);
+		m_shared = 0;
+	}
+	else
+	{
+		alDeleteBuffers(GK_SND_SAMPLES, m_buffer);
+		alErrorThrow("closing buffers");
+	}
+	m_isInit = false;
 }
 
 
@@ -268,6 +324,7 @@ void gkBuffer::finalize(void)
 void gkBuffer::setProperties(const gkSoundProperties& props)
 {
 	m_props = props;
+	wake();
 }
 
 
@@ -287,6 +344,17 @@ void gkBuffer::reset(void)
 		m_ok = !alErrorThrow("Stop playback");
 	}
 
+	if (m_shared)
+	{
+		alSourcei(m_source, AL_BUFFER, 0);
+		m_ok = !alErrorThrow("reset:detach cached buffer");
+
+		m_pos = 0;
+		m_eos = false;
+		m_initial = true;
+		return;
+	}
+
 	alGetSourcei(m_source, AL_BUFFERS_QUEUED, &nr);
 	if (nr > GK_SND_SAMPLES)
 		printf("More Queued that expected!\n");
@@ -361,6 +429,22 @@ bool gkBuffer::stream(void)
 	if (m_exit)
 		return false;
 
+	if (m_shared)
+	{
+		// whole sound is attached, only watch for the end
+		if (!alIsPlaying(m_source))
+		{
+			if (m_loop)
+			{
+				reset();
+				return false;
+			}
+			else
+				m_exit = true;
+		}
+		return true;
+	}
+
 	alGetSourcei(m_source, AL_BUFFERS_PROCESSED, &nr);
 	if (nr <= 0)
 		return false;
@@ -417,3 +501,36 @@ bool gkBuffer::stream(void)
 
 	return true;
 }
+
+
+
+UTsize gkBuffer::getWakeDelay(void)
+{
+	if (!m_isInit || m_initial || m_exit || !m_ok || m_doSuspend || m_do3D || m_doUpdateProperties)
+		return 0;
+
+	if (m_suspend)
+		return UT_NPOS;
+
+	if (!alIsPlaying(m_source))
+		return 0;
+
+	ALint offset = 0;
+	alGetSourcei(m_source, AL_BYTE_OFFSET, &offset);
+	if (offset < 0)
+		offset = 0;
+
+	// bytes left in the block being played, or in the whole sound when shared
+	UTsize left;
+	if (m_shared)
+		left = m_sharedLen > (UTsize)offset ? m_sharedLen - offset : 0;
+	else
+		left = m_bps - ((UTsize)offset % m_bps);
+
+	gkScalar pitch = m_props.m_pitch > 0 ? m_props.m_pitch : 1.f;
+	gkScalar rate  = (gkScalar)(m_smp * alGetFrameSize(m_fmt)) * pitch;
+	if (rate <= 0)
+		return 0;
+
+	return (UTsize)((gkScalar)left * 1000.f / rate) + 1;
+}
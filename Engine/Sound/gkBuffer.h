@@ -31,6 +31,8 @@
 #include "gkSoundUtil.h"
 #include "gkSound.h"
 
+class gkStreamer;
+
 class gkBuffer
 {
 public:
@@ -55,6 +57,11 @@ public:
 	bool isValid(void) const       {return m_ok;}
 	bool isLooped(void) const      {return m_loop;}
 	bool isInitialized(void) const {return m_isInit;}
+	bool isShared(void) const      {return m_shared != 0;}
+
+	///Milliseconds until the playing block drains, UT_NPOS when only
+	///a command can give this buffer more work.
+	UTsize getWakeDelay(void);
 
 
 private:
@@ -63,7 +70,7 @@ private:
 	friend class gkStreamer;
 
 
-	gkBuffer(gkSource* obj);
+	gkBuffer(gkSource* obj, gkStreamer* streamer);
 	~gkBuffer();
 
 	void queue(bool play = false);
@@ -72,6 +79,7 @@ private:
 	void doSuspend(void);
 	void do3D(void);
 	void doProperties(void);
+	void wake(void);
 
 	const char* read(UTsize len, UTsize& br);
 
@@ -88,6 +96,10 @@ private:
 	UTsize              m_pos;
 	bool                m_eos;
 	int                 m_fmt, m_smp, m_bps;
+
+	gkStreamer*         m_streamer;
+	ALuint              m_shared;       // cached PCM, in place of m_buffer
+	UTsize              m_sharedLen;
 };
 
 
@@ -197,7 +197,13 @@ bool gkOgg::eos(void)
 void gkOgg::seek(UTsize pos, int way)
 {
 	m_eos = false;
-	ov_pcm_seek(&m_stream, pos * ov_pcm_total(&m_stream, -1));
+	if (!m_inf)
+		return;
+
+	// pos is a byte offset into the decoded 16 bit PCM
+	ogg_int64_t sample = (ogg_int64_t)(pos / (m_inf->channels * 2));
+	if (ov_pcm_tell(&m_stream) != sample)
+		ov_pcm_seek(&m_stream, sample);
 }
 
 
@@ -223,3 +229,16 @@ int gkOgg::getBitsPerSecond(void)  const
 {
 	return OV_FIXED_BUF;
 }
+
+
+
+UTsize gkOgg::getLength(void) const
+{
+	if (!m_inf)
+		return UT_NPOS;
+
+	ogg_int64_t samples = ov_pcm_total(const_cast<OggVorbis_File*>(&m_stream), -1);
+	if (samples <= 0)
+		return UT_NPOS;
+	return (UTsize)samples * m_inf->channels * 2;
+}
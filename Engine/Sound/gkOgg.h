@@ -68,6 +68,7 @@ public:
 	int             getFormat(void)     const;
 	int             getSampleRate(void) const;
 	int             getBitsPerSecond(void)  const;
+	UTsize          getLength(void)         const;
 };
 
 #endif//_gkOgg_h_
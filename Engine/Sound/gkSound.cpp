@@ -157,12 +157,11 @@ bool gkSound::load(void* handle, UTsize len)
 
 void gkSound::stopPlayback(void)
 {
-	gkSoundManager& mgr = gkSoundManager::getSingleton();
 	for (UTsize i = 0; i < m_sources.size(); ++i)
 	{
 		m_sources[i]->stop();
 		GK_ASSERT(!m_sources[i]->isBound());
-		mgr.notifySourceDestroyed(m_sources[i]);
+		gkSoundManager::getSingleton().notifySourceDestroyed(m_sources[i]);
 	}
 	m_sources.clear();
 }
@@ -0,0 +1,275 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "gkSoundCache.h"
+#include "gkSoundStream.h"
+#include "gkSound.h"
+
+
+// largest single sound worth keeping decoded
+#define GK_SND_CACHE_MAX_SOUND (1024 * 1024)
+
+
+
+gkSoundCache::gkSoundCache(UTsize budget)
+	:   m_budget(budget),
+	    m_size(0),
+	    m_clock(0)
+{
+}
+
+
+gkSoundCache::~gkSoundCache()
+{
+	clear();
+}
+
+
+
+gkSoundCache::Entry* gkSoundCache::find(gkSound* sound)
+{
+	for (UTsize i = 0; i < m_entries.size(); ++i)
+	{
+		if (m_entries[i]->sound == sound)
+			return m_entries[i];
+	}
+	return 0;
+}
+
+
+
+void gkSoundCache::destroy(UTsize i)
+{
+	Entry* ent = m_entries[i];
+
+	alDeleteBuffers(1, &ent->buffer);
+	alErrorThrow("closing cached buffer");
+
+	m_size -= ent->len;
+	m_entries.erase(i);
+	delete ent;
+}
+
+
+
+bool gkSoundCache::evict(UTsize len)
+{
+	while (m_size + len > m_budget)
+	{
+		// oldest entry not attached to a source
+		UTsize lru = UT_NPOS;
+		for (UTsize i = 0; i < m_entries.size(); ++i)
+		{
+			Entry* ent = m_entries[i];
+			if (ent->refs == 0 && (lru == UT_NPOS || ent->lastUse < m_entries[lru]->lastUse))
+				lru = i;
+		}
+
+		if (lru == UT_NPOS)
+			return false;
+		destroy(lru);
+	}
+	return true;
+}
+
+
+
+ALuint gkSoundCache::decode(gkSoundStream* stream, UTsize& len)
+{
+	m_pcm.resize(len);
+
+	UTsize pos = 0, br = 0;
+	UTsize blk = (UTsize)stream->getBitsPerSecond();
+	while (pos < len)
+	{
+		UTsize want = len - pos;
+		if (want > blk)
+			want = blk;
+
+		const char* db = stream->read(pos, want, br);
+		if (!db || br == 0)
+			break;
+
+		memcpy(m_pcm.ptr() + pos, db, br);
+		pos += br;
+	}
+
+	int fmt = stream->getFormat();
+	pos -= pos % alGetFrameSize(fmt);
+	if (pos == 0)
+		return 0;
+
+	alGetError();
+
+	ALuint buffer = 0;
+	alGenBuffers(1, &buffer);
+	if (alErrorThrow("opening cached buffer"))
+		return 0;
+
+	alBufferData(buffer, fmt, m_pcm.ptr(), (ALsizei)pos, stream->getSampleRate());
+	if (alErrorThrow("filling cached buffer"))
+	{
+		alDeleteBuffers(1, &buffer);
+		return 0;
+	}
+
+	// scratch is only needed while filling
+	m_pcm.resize(0);
+	len = pos;
+	return buffer;
+}
+
+
+
+ALuint gkSoundCache::acquire(gkSound* sound, UTsize& len)
+{
+	gkCriticalSection::Lock lock(m_cs);
+
+	gkSoundStream* stream = sound ? sound->getStream() : 0;
+	if (!stream || m_budget == 0)
+		return 0;
+
+	Entry* ent = find(sound);
+	if (ent && ent->stream != stream)
+	{
+		// sound was reloaded
+		forget(sound);
+		ent = 0;
+	}
+
+	if (!ent)
+	{
+		UTsize total = stream->getLength();
+		UTsize limit = gkMin<UTsize>(GK_SND_CACHE_MAX_SOUND, m_budget / 4);
+		if (total == UT_NPOS || total == 0 || total > limit)
+			return 0;
+
+		// one shot sounds keep streaming
+		int* plays = m_plays.get(sound);
+		if (!plays)
+		{
+			m_plays.insert(sound, 1);
+			return 0;
+		}
+		if (++(*plays) < 2)
+			return 0;
+
+		if (!evict(total))
+			return 0;
+
+		UTsize decoded = total;
+		ALuint buffer = decode(stream, decoded);
+		if (buffer == 0)
+			return 0;
+
+		ent = new Entry;
+		ent->sound   = sound;
+		ent->stream  = stream;
+		ent->buffer  = buffer;
+		ent->len     = decoded;
+		ent->refs    = 0;
+		ent->lastUse = 0;
+
+		m_entries.push_back(ent);
+		m_size += decoded;
+	}
+
+	ent->refs++;
+	ent->lastUse = ++m_clock;
+	len = ent->len;
+	return ent->buffer;
+}
+
+
+
+void gkSoundCache::release(ALuint buffer)
+{
+	gkCriticalSection::Lock lock(m_cs);
+
+	for (UTsize i = 0; i < m_entries.size(); ++i)
+	{
+		Entry* ent = m_entries[i];
+		if (ent->buffer == buffer)
+		{
+			--ent->refs;
+
+			// orphans go once the last source lets go
+			if (ent->refs <= 0 && !ent->sound)
+				destroy(i);
+			return;
+		}
+	}
+}
+
+
+
+void gkSoundCache::releaseSound(gkSound* sound)
+{
+	gkCriticalSection::Lock lock(m_cs);
+	forget(sound);
+}
+
+
+
+void gkSoundCache::forget(gkSound* sound)
+{
+	m_plays.remove(sound);
+
+	UTsize i = 0;
+	while (i < m_entries.size())
+	{
+		Entry* ent = m_entries[i];
+		if (ent->sound == sound)
+		{
+			if (ent->refs > 0)
+			{
+				ent->sound  = 0;
+				ent->stream = 0;
+			}
+			else
+			{
+				destroy(i);
+				continue;
+			}
+		}
+		++i;
+	}
+}
+
+
+
+void gkSoundCache::clear(void)
+{
+	gkCriticalSection::Lock lock(m_cs);
+
+	while (!m_entries.empty())
+		destroy(m_entries.size() - 1);
+
+	m_entries.clear(true);
+	m_plays.clear();
+	m_pcm.clear(true);
+	m_size = 0;
+}
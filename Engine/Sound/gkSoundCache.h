@@ -0,0 +1,88 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _gkSoundCache_h_
+#define _gkSoundCache_h_
+
+#include "gkCommon.h"
+#include "gkSoundUtil.h"
+#include "Thread/gkCriticalSection.h"
+
+class gkSound;
+class gkSoundStream;
+
+
+///Fully decoded PCM of short, frequently played sounds. Every playback of
+///a cached sound shares one OpenAL buffer instead of streaming its own copy.
+///Entries are evicted least recently used first once over budget.
+class gkSoundCache
+{
+public:
+	gkSoundCache(UTsize budget);
+	~gkSoundCache();
+
+	///Shared buffer holding the decoded sound, or 0 when it should be streamed.
+	///Sounds are decoded on their second playback.
+	ALuint acquire(gkSound* sound, UTsize& len);
+	void   release(ALuint buffer);
+
+	///Forget a sound that is about to be destroyed or reloaded.
+	void   releaseSound(gkSound* sound);
+	void   clear(void);
+
+	UTsize getBudget(void) const {return m_budget;}
+	UTsize getSize(void)   const {return m_size;}
+
+private:
+
+	struct Entry
+	{
+		gkSound*       sound;
+		gkSoundStream* stream;
+		ALuint         buffer;
+		UTsize         len;
+		int            refs;
+		UTuint32       lastUse;
+	};
+
+	typedef utArray<Entry*> Entries;
+	typedef utHashTable<utPointerHashKey, int> PlayCounts;
+
+	Entry* find(gkSound* sound);
+	void   destroy(UTsize i);
+	void   forget(gkSound* sound);
+	bool   evict(UTsize len);
+	ALuint decode(gkSoundStream* stream, UTsize& len);
+
+	gkCriticalSection m_cs;
+	Entries           m_entries;
+	PlayCounts        m_plays;
+	utArray<char>     m_pcm;
+	UTsize            m_budget, m_size;
+	UTuint32          m_clock;
+};
+
+#endif//_gkSoundCache_h_
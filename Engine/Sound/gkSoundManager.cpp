@@ -511,6 +511,9 @@ void gkSoundManager::notifyResourceDestroyedImpl(gkResource* res)
 	gkSound* ob = (gkSound*)res;
 	// Force stop.
 	removePlayback(ob);
+
+	if (m_stream)
+		m_stream->releaseSound(ob);
 }
 
 
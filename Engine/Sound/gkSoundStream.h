@@ -45,6 +45,9 @@ public:
 	virtual int         getFormat(void)         const = 0;
 	virtual int         getSampleRate(void)     const = 0;
 	virtual int         getBitsPerSecond(void)  const = 0;
+
+	///Size of the decoded PCM in bytes, UT_NPOS when unknown.
+	virtual UTsize      getLength(void)         const { return UT_NPOS; }
 };
 
 
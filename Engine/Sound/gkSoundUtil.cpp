@@ -136,3 +136,16 @@ int alReadMagic(const char* file)
 	fclose(fp);
 	return result;
 }
+
+
+int alGetFrameSize(int fmt)
+{
+	switch (fmt)
+	{
+	case AL_FORMAT_MONO8:    return 1;
+	case AL_FORMAT_MONO16:   return 2;
+	case AL_FORMAT_STEREO8:  return 2;
+	case AL_FORMAT_STEREO16: return 4;
+	}
+	return 1;
+}
@@ -47,6 +47,7 @@ enum gkBufType
 
 extern int alGetBufType(const char* magic);
 extern int alReadMagic(const char* file);
+extern int alGetFrameSize(int fmt);
 
 #define GK_SND_SAMPLES 3
 
@@ -27,6 +27,13 @@
 #include "gkStreamer.h"
 #include "gkSound.h"
 #include "gkBuffer.h"
+#include "gkEngine.h"
+#include "gkUserDefs.h"
+
+
+// bounds for the idle wait between buffer passes, in milliseconds
+#define GK_STREAM_MIN_WAIT  5
+#define GK_STREAM_MAX_WAIT  250
 
 
 
@@ -37,7 +44,9 @@ gkStreamer::gkStreamer(const gkString& name)
 	    m_stop(true),
 	    m_finish(false),
 	    m_wantsQSync(false),
-	    m_wantsSQSync(false)
+	    m_wantsSQSync(false),
+	    m_wakePending(false),
+	    m_cache((UTsize)gkEngine::getSingleton().getUserDefs().soundCacheSize * 1024)
 {
 }
 
@@ -61,6 +70,41 @@ void gkStreamer::exit(void)
 		delete m_thread;
 		m_thread = 0;
 	}
+
+	// no source references a cached buffer past this point
+	m_cache.clear();
+}
+
+
+void gkStreamer::releaseSound(gkSound* snd)
+{
+	m_cache.releaseSound(snd);
+}
+
+
+
+void gkStreamer::wake(void)
+{
+	// one pending signal is enough for any number of requests
+	gkCriticalSection::Lock lock(m_wakeCs);
+	if (!m_wakePending)
+	{
+		m_wakePending = true;
+		m_wake.signal();
+	}
+}
+
+
+
+void gkStreamer::sleep(UTsize delay)
+{
+	if (delay == UT_NPOS)
+		m_wake.wait();
+	else
+		m_wake.wait((unsigned int)gkClamp<UTsize>(delay, GK_STREAM_MIN_WAIT, GK_STREAM_MAX_WAIT));
+
+	gkCriticalSection::Lock lock(m_wakeCs);
+	m_wakePending = false;
 }
 
 
@@ -70,6 +114,7 @@ void gkStreamer::stopAllSounds(void)
 	if (!m_updateBuffers.empty())
 	{
 		m_finish = true;
+		wake();
 
 		// Block until loop is finished.
 		m_fsync.wait();
@@ -90,6 +135,7 @@ void gkStreamer::stop(void)
 	if (isRunning())
 	{
 		m_finish = m_stop = true;
+		wake();
 
 		// Block until loop is finished.
 		m_fsync.wait();
@@ -138,13 +184,15 @@ void gkStreamer::playSound(gkSource* snd)
 	if (snd && !snd->isBound())
 	{
 		m_wantsQSync = true;
+		wake();
 
 		// Assert a queue update is not in progress.
 		// Stop all traffic.
 		m_qsync.wait();
 
 		// Add to queue.
-		m_queueBuffers.push_back(new gkBuffer(snd));
+		m_queueBuffers.push_back(new gkBuffer(snd, this));
+		wake();
 	}
 }
 
@@ -155,6 +203,7 @@ void gkStreamer::stopSound(gkSource* snd)
 	if (snd && snd->isBound())
 	{
 		m_wantsSQSync = true;
+		wake();
 
 		// Assert a queue update is not in progress.
 		// Stop all traffic.
@@ -162,6 +211,7 @@ void gkStreamer::stopSound(gkSource* snd)
 
 		// Add to queue.
 		m_queueSources.push_back(snd);
+		wake();
 	}
 
 }
@@ -324,12 +374,15 @@ void gkStreamer::run(void)
 {
 	/// Main sound workload.
 	/// \note This is designed to be a long running background thread.
+	/// Between passes it sleeps until the earliest block drains or a command wakes it.
 
 	while (isRunning())
 	{
 		// catch any exceptions
 		try
 		{
+			UTsize delay = UT_NPOS;
+
 			processBuffers();
 
 			if (!m_updateBuffers.empty())
@@ -352,6 +405,12 @@ void gkStreamer::run(void)
 					// Local remove
 					if (!buf->isValid() || buf->isDone())
 						m_finishedBuffers.push_back(buf);
+					else
+					{
+						UTsize next = buf->getWakeDelay();
+						if (next < delay)
+							delay = next;
+					}
 				}
 
 
@@ -377,6 +436,8 @@ void gkStreamer::run(void)
 					m_fsync.signal();
 				}
 			}
+			else
+				sleep(delay);
 		}
 
 		catch (...)
@@ -29,6 +29,7 @@
 
 #include "gkCommon.h"
 #include "gkSoundUtil.h"
+#include "gkSoundCache.h"
 
 #include "Thread/gkCriticalSection.h"
 #include "Thread/gkThread.h"
@@ -57,6 +58,12 @@ public:
 	bool isRunning(void);
 	bool isEmpty(void);
 
+	///Schedule a pass over the buffers, from any thread.
+	void wake(void);
+
+	gkSoundCache& getCache(void) {return m_cache;}
+	void releaseSound(gkSound* snd);
+
 	void stop(void);
 	void start(void);
 	void exit(void);
@@ -81,6 +88,7 @@ private:
 	void freeBuffers(Buffers& bufs);
 	void finishBuffers(void);
 	void processBuffers(void);
+	void sleep(UTsize delay);
 
 	Buffers m_queueBuffers;
 	Buffers m_updateBuffers, m_finishedBuffers;
@@ -88,6 +96,13 @@ private:
 
 	bool m_wantsQSync, m_wantsSQSync;
 	gkSyncObj m_fsync, m_sqsync, m_qsync;
+
+	// Idle until a command arrives or a block is about to drain.
+	gkSyncObj           m_wake;
+	gkCriticalSection   m_wakeCs;
+	bool                m_wakePending;
+
+	gkSoundCache        m_cache;
 };
 
 
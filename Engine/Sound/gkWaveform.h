@@ -76,6 +76,7 @@ public:
 	int             getFormat(void)         const;
 	int             getSampleRate(void)     const { return m_header.m_samplesPerSec; }
 	int             getBitsPerSecond(void)  const;
+	UTsize          getLength(void)         const { return m_totalLen > 0 ? (UTsize)m_totalLen : UT_NPOS; }
 };
 
 #endif//_gkWaveform_h_
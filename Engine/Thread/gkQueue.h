@@ -72,7 +72,8 @@ private:
 
 template< typename T >
 gkQueue<T>::gkQueue(const gkString& name)
-	: m_name(name)
+	: m_petitionToFinish(false),
+	  m_name(name)
 {
 }
 
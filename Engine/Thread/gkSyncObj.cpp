@@ -29,11 +29,15 @@
 
 #ifdef WIN32
 #include <process.h>
+#else
+#include <errno.h>
+#include <time.h>
 #endif
 
 #ifdef OGREKIT_USE_COCOA
 
 #include <Foundation/NSLock.h>
+#include <Foundation/NSDate.h>
 
 class gkSyncObjPrivate
 {
@@ -53,6 +57,13 @@ m_syncObj = [[NSConditionLock alloc] initWithCondition: GK_NO_DATA];
 [m_syncObj lockWhenCondition: GK_HAS_DATA];
 [m_syncObj unlockWithCondition: GK_NO_DATA];
 	}
+	bool wait(unsigned int milliseconds)
+	{
+		if (![m_syncObj lockWhenCondition: GK_HAS_DATA beforeDate: [NSDate dateWithTimeIntervalSinceNow: milliseconds / 1000.0]])
+			return false;
+[m_syncObj unlockWithCondition: GK_NO_DATA];
+		return true;
+	}
 	void signal()
 	{
 		[m_syncObj lock];
@@ -137,6 +148,39 @@ bool gkSyncObj::wait()
 	return ok;
 }
 
+bool gkSyncObj::wait(unsigned int milliseconds)
+{
+	bool ok = true;
+
+#ifdef OGREKIT_USE_COCOA
+
+	ok = m_syncObj->wait(milliseconds);
+
+#elif WIN32
+	ok = WaitForSingleObject(m_syncObj, milliseconds) != WAIT_TIMEOUT;
+#elif __APPLE__
+	OSStatus result = MPWaitOnSemaphore (m_syncObj, milliseconds * kDurationMillisecond);
+	ok = result == 0;
+#else
+	timespec ts;
+	clock_gettime(CLOCK_REALTIME, &ts);
+	ts.tv_sec  += milliseconds / 1000;
+	ts.tv_nsec += (long)(milliseconds % 1000) * 1000000L;
+	if (ts.tv_nsec >= 1000000000L)
+	{
+		ts.tv_sec  += 1;
+		ts.tv_nsec -= 1000000000L;
+	}
+
+	int result;
+	while ((result = sem_timedwait(&m_syncObj, &ts)) == -1 && errno == EINTR)
+		;
+	ok = result == 0;
+#endif
+
+	return ok;
+}
+
 bool gkSyncObj::signal()
 {
 #ifdef OGREKIT_USE_COCOA
@@ -54,6 +54,9 @@ public:
 
 	bool wait();
 
+	///Returns false when not signalled within the given time.
+	bool wait(unsigned int milliseconds);
+
 	bool signal();
 
 private:
@@ -27,9 +27,12 @@
 #include "gkCommon.h"
 #include "gkThread.h"
 #include "gkLogger.h"
+#include "gkProfiler.h"
 
 #ifdef WIN32
 #include <process.h>
+#else
+#include <unistd.h>
 #endif
 
 #ifdef WIN32
@@ -49,6 +52,8 @@ void* gkThread::task(void* p)
 	gkThread* pThread = static_cast<gkThread*>(p);
 
 	pThread->run();
+
+	return 0;
 }
 #endif
 
@@ -124,9 +129,22 @@ void gkThread::join()
 	m_syncObj.wait();
 }
 
+void gkThread::sleep(unsigned long milliseconds)
+{
+#ifdef WIN32
+	Sleep((DWORD)milliseconds);
+#else
+	usleep((useconds_t)milliseconds * 1000);
+#endif
+}
+
 void gkThread::run()
 {
 	m_call->run();
 
+	// pools come and go with scenes, don't keep their zone trees around
+	if (gkProfiler::getSingletonPtr())
+		gkProfiler::getSingleton().releaseThread();
+
 	m_syncObj.signal();
 }
@@ -57,6 +57,8 @@ public:
 
 	void join();
 
+	static void sleep(unsigned long milliseconds);
+
 private:
 
 #ifdef WIN32
@@ -0,0 +1,144 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "gkThreadPool.h"
+#include "gkLogger.h"
+#include "gkProfiler.h"
+
+#ifndef WIN32
+#include <unistd.h>
+#endif
+
+
+
+gkThreadPool::gkThreadPool(const gkString& name, UTsize workers)
+	: m_name(name),
+	  m_queue(name),
+	  m_pending(0),
+	  m_finished(0)
+{
+	if (workers < 1)
+		workers = 1;
+
+	for (UTsize i = 0; i < workers; ++i)
+	{
+		Worker* worker = new Worker(this);
+		m_workers.push_back(worker);
+		m_threads.push_back(new gkThread(worker));
+	}
+}
+
+
+
+gkThreadPool::~gkThreadPool()
+{
+	wait();
+
+	UTsize i;
+	for (i = 0; i < m_threads.size(); ++i)
+		m_queue.petitionToFinish();
+
+	for (i = 0; i < m_threads.size(); ++i)
+	{
+		m_threads[i]->join();
+		delete m_threads[i];
+		delete m_workers[i];
+	}
+
+	m_threads.clear();
+	m_workers.clear();
+}
+
+
+
+void gkThreadPool::enqueue(gkPtrRef<gkCall> call)
+{
+	++m_pending;
+	m_queue.push(call);
+}
+
+
+
+void gkThreadPool::wait()
+{
+	// The count decides, signals only wake us. The Cocoa sync object is
+	// binary and merges signals from calls finishing close together.
+	for (;;)
+	{
+		{
+			gkCriticalSection::Lock guard(m_cs);
+			if (m_finished >= m_pending)
+			{
+				m_pending = m_finished = 0;
+				return;
+			}
+		}
+		m_done.wait();
+	}
+}
+
+
+
+void gkThreadPool::Worker::run()
+{
+	gkPtrRef<gkCall> pCall;
+
+	if (gkProfiler::getSingletonPtr())
+		gkProfiler::getSingleton().setThreadName(m_pool->m_name);
+
+	while (m_pool->m_queue.pop(pCall))
+	{
+		try
+		{
+			pCall->run();
+		}
+		catch (...) // catch all the exceptions.
+		{
+			gkLogMessage(m_pool->m_name.c_str() << " call error.");
+		}
+
+		pCall = gkPtrRef<gkCall>(0);
+		{
+			gkCriticalSection::Lock guard(m_pool->m_cs);
+			++m_pool->m_finished;
+		}
+		m_pool->m_done.signal();
+	}
+}
+
+
+
+UTsize gkThreadPool::getHardwareThreads()
+{
+#ifdef WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwNumberOfProcessors > 0 ? (UTsize)info.dwNumberOfProcessors : 1;
+#else
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 0 ? (UTsize)count : 1;
+#endif
+}
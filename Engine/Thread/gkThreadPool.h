@@ -0,0 +1,86 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _gkThreadPool_h_
+#define _gkThreadPool_h_
+
+#include "gkNonCopyable.h"
+#include "gkThread.h"
+#include "gkQueue.h"
+#include "gkSyncObj.h"
+#include "gkCriticalSection.h"
+#include "gkPtrRef.h"
+
+///Fixed set of worker threads sharing one call queue.
+///Calls are pushed with enqueue() and wait() blocks until every call
+///enqueued so far has finished. enqueue() and wait() must be used from
+///a single (owner) thread.
+class gkThreadPool : gkNonCopyable
+{
+public:
+
+	gkThreadPool(const gkString& name, UTsize workers);
+
+	~gkThreadPool();
+
+	void enqueue(gkPtrRef<gkCall> call);
+
+	void wait();
+
+	GK_INLINE UTsize getWorkerCount() const { return m_workers.size(); }
+
+	///Number of hardware threads, at least one.
+	static UTsize getHardwareThreads();
+
+private:
+
+	class Worker : public gkCall
+	{
+	public:
+		Worker(gkThreadPool* pool) : m_pool(pool) {}
+
+		void run();
+
+	private:
+		gkThreadPool* m_pool;
+	};
+
+	gkString m_name;
+
+	utArray<gkThread*> m_threads;
+
+	utArray<Worker*> m_workers;
+
+	gkQueue<gkPtrRef<gkCall> > m_queue;
+
+	gkSyncObj m_done;
+
+	gkCriticalSection m_cs;
+
+	UTsize m_pending, m_finished;
+};
+
+#endif//_gkThreadPool_h_
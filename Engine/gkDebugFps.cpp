@@ -31,7 +31,7 @@
 #include "gkEngine.h"
 #include "gkScene.h"
 #include "gkDynamicsWorld.h"
-#include "gkStats.h"
+#include "gkProfiler.h"
 
 #include "OgreOverlayManager.h"
 #include "OgreOverlayElement.h"
@@ -165,17 +165,19 @@ void gkDebugFps::draw(void)
 	if (wo) dbvtVal = wo->getDBVTInfo();
 
 
-	float swap = gkStats::getSingleton().getLastTotalMicroSeconds() / 1000.0f;
-	float render = gkStats::getSingleton().getLastRenderMicroSeconds() / 1000.0f;
-	float phys = gkStats::getSingleton().getLastPhysicsMicroSeconds() / 1000.0f;
-	float logicb = gkStats::getSingleton().getLastLogicBricksMicroSeconds() / 1000.0f;
-	float logicn = gkStats::getSingleton().getLastLogicNodesMicroSeconds() / 1000.0f;
-	float sound = gkStats::getSingleton().getLastSoundMicroSeconds() / 1000.0f;
-	float dbvt = gkStats::getSingleton().getLastDbvtMicroSeconds() / 1000.0f;
-	float bufswaplod = gkStats::getSingleton().getLastBufSwapLodMicroSeconds() / 1000.0f;
-	float animations = gkStats::getSingleton().getLastAnimationsMicroSeconds() / 1000.0f;
+	gkProfiler& prof = gkProfiler::getSingleton();
+
+	float swap = prof.getLastTotalMicroSeconds() / 1000.0f;
+	float render = prof.getLastMicroSeconds("Render") / 1000.0f;
+	float phys = prof.getLastMicroSeconds("Physics") / 1000.0f;
+	float logicb = prof.getLastMicroSeconds("LogicBricks") / 1000.0f;
+	float logicn = prof.getLastMicroSeconds("LogicNodes") / 1000.0f;
+	float sound = prof.getLastMicroSeconds("Sound") / 1000.0f;
+	float dbvt = prof.getLastMicroSeconds("Dbvt") / 1000.0f;
+	float bufswaplod = prof.getLastMicroSeconds("BufSwapLod") / 1000.0f;
+	float animations = prof.getLastMicroSeconds("Animations") / 1000.0f;
 #ifdef OGREKIT_USE_PROCESSMANAGER
-	float process = gkStats::getSingleton().getLastProcessMicroSeconds() / 1000.0f;
+	float process = prof.getLastMicroSeconds("Process") / 1000.0f;
 #endif
 
 	gkString vals = "";
@@ -237,26 +237,12 @@ void gkDebugScreen::printTo(const gkString& buf)
 
 void dsPrintf(const char* fmt, ...)
 {
-	if (gConsole == 0)
+	if (gConsole == 0 || !gkLogger::isEnabled(GK_LOG_INFO, GK_LOG_SCREEN))
 		return;
 
-	static char buf[513];
-
+	// queued with the log, shown on the next tick
 	va_list lst;
 	va_start(lst, fmt);
-	int size = vsnprintf(buf, 512, fmt, lst);
+	gkLogger::writev(GK_LOG_INFO, GK_LOG_SCREEN, fmt, lst);
 	va_end(lst);
-
-
-	if (size < 0)
-	{
-		buf[512] = 0;
-		size = 512;
-	}
-
-	if (size > 0)
-	{
-		buf[size] = 0;
-		gConsole->printTo(buf);
-	}
 }
@@ -43,7 +43,7 @@
 #include "gkDebugProperty.h"
 #include "gkTickState.h"
 #include "gkDebugFps.h"
-#include "gkStats.h"
+#include "gkProfiler.h"
 #include "gkMessageManager.h"
 #include "gkMeshManager.h"
 #include "gkSkeletonManager.h"
@@ -53,6 +53,8 @@
 #include "gkAnimationManager.h"
 #include "gkParticleManager.h"
 #include "gkHUDManager.h"
+#include "Thread/gkThread.h"
+#include "Thread/gkThreadPool.h"
 
 #ifdef OGREKIT_USE_NNODE
 #include "gkNodeManager.h"
@@ -86,6 +88,7 @@
 #include "OgreStringConverter.h"
 #include "OgreFrameListener.h"
 #include "OgreOverlayManager.h"
+#include "OgreDefaultHardwareBufferManager.h"
 
 // temporary hack for keeping compatibility with ogre18 due to the android-version
 #ifndef BUILD_OGRE18
@@ -107,6 +110,34 @@
 gkScalar gkEngine::m_tickRate = ENGINE_TICKS_PER_SECOND;
 
 
+
+// zones spanning several frame listener callbacks
+static const gkProfiler::ZoneId gkRenderZone     = gkProfiler::registerZone("Render");
+static const gkProfiler::ZoneId gkBufSwapLodZone = gkProfiler::registerZone("BufSwapLod");
+
+
+
+// Steps one scene's physics world on a worker
+class gkScenePhysicsCall : public gkCall
+{
+public:
+	gkScenePhysicsCall(gkScene* scene, gkScalar delta)
+		:	m_scene(scene), m_delta(delta)
+	{
+	}
+
+	void run()
+	{
+		gkProfileScope scope(m_scene->getProfileZone());
+		m_scene->updatePhysics(m_delta);
+	}
+
+private:
+	gkScene*	m_scene;
+	gkScalar	m_delta;
+};
+
+
 class gkOgreEnginePrivate : public Ogre::FrameListener, public gkTickState
 {
 public:
@@ -120,8 +151,14 @@ public:
 		        debugFps(0),
 				archive_factory(0),
 				timer(0),
-				root(0)
-
+				ticks(0),
+				scenePool(0),
+				sensorPool(0),
+				root(0),
+				bufferManager(0)
+#ifndef BUILD_OGRE18
+				, overlaySystem(0)
+#endif
 	{
 		timer = new btClock();
 		timer->reset();
@@ -144,6 +181,13 @@ public:
 	void beginTickImpl(void);
 	void endTickImpl(void);
 
+	// headless main loop step
+	bool stepHeadless(void);
+
+	// update all scenes, scene local stages on the worker pool
+	void updateScenesConcurrent(gkScalar delta);
+	void runScenePhysics(gkScalar delta);
+
 
 	bool frameStarted(const Ogre::FrameEvent& evt);
 	bool frameRenderingQueued(const Ogre::FrameEvent& evt);
@@ -161,6 +205,12 @@ public:
 	
 	btClock*					timer;
 	unsigned long				curTime;
+	unsigned long				ticks;				// ticks since initializeStepLoop
+	gkThreadPool*				scenePool;			// optional concurrent scene updates
+	gkThreadPool*				sensorPool;			// shared by the logic managers, see getSensorPool
+
+	// software vertex / index buffers when running headless
+	Ogre::HardwareBufferManager* bufferManager;
 
 	gkBlendArchiveFactory*		archive_factory;
 
@@ -200,6 +250,13 @@ gkEngine::~gkEngine()
 	// persistent throughout
 	gkLogger::disable();
 
+	// created on demand, also without initialize
+	if (m_private)
+	{
+		delete m_private->sensorPool;
+		m_private->sensorPool = 0;
+	}
+
 	if (!m_ownsDefs)
 	{
 		delete m_defs;
@@ -214,6 +271,9 @@ void gkEngine::initialize()
 	if (m_initialized) return;
 
 	gkUserDefs& defs = getUserDefs();
+	gkLogger::setLevel(defs.logLevel);
+	gkLogger::setCategories(defs.logCategories);
+	gkLogger::setAsync(defs.logAsync);
 	gkLogger::enable(defs.log, defs.verbose);
 
 	if (defs.rendersystem == OGRE_RS_UNKNOWN)
@@ -222,28 +282,41 @@ void gkEngine::initialize()
 		return;
 	}
 
+	m_tickRate = gkScalar(defs.tickRate);
+	m_private->initialize(defs.tickRate);
+
 	Ogre::Root* root = new Ogre::Root("", "");
 	m_private->root = root;
-	m_private->plugin_factory->createRenderSystem(root, defs.rendersystem);
-	m_private->plugin_factory->createParticleSystem(root);
 	m_private->archive_factory->addArchiveFactory();
 
-#ifndef BUILD_OGRE18
-	m_private->overlaySystem = new Ogre::OverlaySystem();
-#endif
-	const Ogre::RenderSystemList& renderers = root->getAvailableRenderers();
-	if (renderers.empty())
+	if (defs.headless)
 	{
-		gkPrintf("No rendersystems present\n");
-		return;
+		// No render system, meshes are kept in system memory
+		// so physics shapes and animations can still use them.
+		m_private->bufferManager = new Ogre::DefaultHardwareBufferManager();
 	}
+	else
+	{
+		m_private->plugin_factory->createRenderSystem(root, defs.rendersystem);
+		m_private->plugin_factory->createParticleSystem(root);
 
-	root->setRenderSystem(renderers[0]);
+#ifndef BUILD_OGRE18
+		m_private->overlaySystem = new Ogre::OverlaySystem();
+#endif
+		const Ogre::RenderSystemList& renderers = root->getAvailableRenderers();
+		if (renderers.empty())
+		{
+			gkPrintf("No rendersystems present\n");
+			return;
+		}
+
+		root->setRenderSystem(renderers[0]);
 #if defined(_MSC_VER) && defined(OGRE_BUILD_RENDERSYSTEM_GLES2)
-	renderers[0]->setConfigOption("RTT Preferred Mode", "Copy"); //angleproject gles2
+		renderers[0]->setConfigOption("RTT Preferred Mode", "Copy"); //angleproject gles2
 #endif
 
-	root->initialise(false);
+		root->initialise(false);
+	}
 
 	m_private->windowsystem = new gkWindowSystem();
 
@@ -292,10 +365,13 @@ void gkEngine::initialize()
 		loadResources(defs.resources);
 
 #ifdef OGREKIT_USE_RTSHADER_SYSTEM	
-	defs.hasFixedCapability = renderers[0]->getCapabilities()->hasCapability(Ogre::RSC_FIXED_FUNCTION);
+	if (!defs.headless)
+	{
+		defs.hasFixedCapability = root->getRenderSystem()->getCapabilities()->hasCapability(Ogre::RSC_FIXED_FUNCTION);
 
-	gkResourceGroupManager::getSingleton().initRTShaderSystem(
-		m_private->plugin_factory->getShaderLanguage(), defs.shaderCachePath, defs.hasFixedCapability);
+		gkResourceGroupManager::getSingleton().initRTShaderSystem(
+			m_private->plugin_factory->getShaderLanguage(), defs.shaderCachePath, defs.hasFixedCapability);
+	}
 #endif
 
 	// create the builtin resource group
@@ -303,27 +379,33 @@ void gkEngine::initialize()
 
 	gkResourceGroupManager::getSingleton().initialiseAllResourceGroups();
 
+	if (!defs.headless)
+	{
 #ifdef OGREKIT_USE_PARTICLE
-	gkParticleManager::getSingleton().initialize();
+		gkParticleManager::getSingleton().initialize();
 #endif
 
 #ifdef OGREKIT_USE_COMPOSITOR
-	gkCompositorManager::getSingleton().initialize();
+		gkCompositorManager::getSingleton().initialize();
 #endif
 
-	// debug info
-	m_private->debug = new gkDebugScreen();
-	m_private->debug->initialize();
+		// debug info
+		m_private->debug = new gkDebugScreen();
+		m_private->debug->initialize();
 
-	m_private->debugPage = new gkDebugPropertyPage();
-	m_private->debugPage->initialize();
+		m_private->debugPage = new gkDebugPropertyPage();
+		m_private->debugPage->initialize();
 
-	m_private->debugFps = new gkDebugFps();
-	m_private->debugFps->initialize();
-	m_private->debugFps->show(defs.debugFps);
+		m_private->debugFps = new gkDebugFps();
+		m_private->debugFps->initialize();
+		m_private->debugFps->show(defs.debugFps);
+	}
 
 	// statistics and profiling
-	new gkStats();
+	gkProfiler* profiler = new gkProfiler();
+	if (!defs.profileTrace.empty())
+		profiler->setCapture(true);
+	profiler->setDetailed(defs.profileBricks);
 
 	m_initialized = true;
 }
@@ -333,6 +415,9 @@ void gkEngine::initialize()
 
 void gkEngine::initializeWindow(void)
 {
+	if (getUserDefs().headless)
+		return;
+
 	if (m_private->windowsystem && !m_window)
 	{
 		gkWindowSystem* sys = m_private->windowsystem;
@@ -354,6 +439,13 @@ void gkEngine::finalize()
 	gkSoundManager::getSingleton().stopAllSounds();
 #endif	
 
+	// kept across step loops, workers are idle between ticks
+	delete m_private->scenePool;
+	m_private->scenePool = 0;
+
+	delete m_private->sensorPool;
+	m_private->sensorPool = 0;
+
 	gkResourceManager* tmgr;
 
 #ifdef OGREKIT_USE_NNODE
@@ -421,7 +513,9 @@ void gkEngine::finalize()
 	delete gkResourceGroupManager::getSingletonPtr();
 
 
-	delete gkStats::getSingletonPtr();
+	if (!m_defs->profileTrace.empty())
+		gkProfiler::getSingleton().exportTrace(m_defs->profileTrace);
+	delete gkProfiler::getSingletonPtr();
 	delete m_private->debugFps;
 	delete m_private->debugPage;
 	delete m_private->debug;
@@ -429,7 +523,9 @@ void gkEngine::finalize()
 	delete m_private->overlaySystem;
 #endif
 	delete m_private->root;
+	delete m_private->bufferManager;
 	delete m_private;
+	m_private = 0;
 
 	m_initialized = false;
 }
@@ -567,7 +663,8 @@ void gkEngine::registerActiveScene(gkScene* scene)
 		{
 			m_private->curScene = scene;
 #ifndef BUILD_OGRE18
-			scene->getManager()->addRenderQueueListener(m_private->overlaySystem);
+			if (m_private->overlaySystem)
+				scene->getManager()->addRenderQueueListener(m_private->overlaySystem);
 #endif
 		}
 	}
@@ -584,7 +681,8 @@ void gkEngine::unregisterActiveScene(gkScene* scene)
 			m_private->curScene = m_private->scenes.at(0);
 
 #ifndef BUILD_OGRE18
-			m_private->curScene->getManager()->addRenderQueueListener(m_private->overlaySystem);
+			if (m_private->overlaySystem)
+				m_private->curScene->getManager()->addRenderQueueListener(m_private->overlaySystem);
 #endif
 		}
 		else
@@ -595,6 +693,21 @@ void gkEngine::unregisterActiveScene(gkScene* scene)
 
 
 
+gkThreadPool* gkEngine::getSensorPool(void)
+{
+	GK_ASSERT(m_private && m_defs);
+
+	if (!m_private->sensorPool && m_defs->logicThreads != 0)
+	{
+		UTsize workers = m_defs->logicThreads > 0 ? (UTsize)m_defs->logicThreads : gkThreadPool::getHardwareThreads();
+		if (workers > 1)
+			m_private->sensorPool = new gkThreadPool("LogicSensors", workers);
+	}
+	return m_private->sensorPool;
+}
+
+
+
 gkScene* gkEngine::getActiveScene(void)
 {
 	GK_ASSERT(m_private);
@@ -650,10 +763,20 @@ bool gkEngine::initializeStepLoop(void)
 
 
 	// setup timer
-	m_private->root->clearEventTimes();
-	m_private->root->getRenderSystem()->_initRenderTargets();
-	m_private->root->addFrameListener(m_private);
+	if (!m_defs->headless)
+	{
+		m_private->root->clearEventTimes();
+		m_private->root->getRenderSystem()->_initRenderTargets();
+		m_private->root->addFrameListener(m_private);
+	}
 	m_private->reset();
+	m_private->ticks = 0;
+
+	if (m_defs->sceneThreads != 0 && !m_private->scenePool)
+	{
+		UTsize workers = m_defs->sceneThreads > 0 ? (UTsize)m_defs->sceneThreads : gkThreadPool::getHardwareThreads();
+		m_private->scenePool = new gkThreadPool("SceneUpdate", workers);
+	}
 
 	m_running = true;
 
@@ -665,19 +788,27 @@ bool gkEngine::stepOneFrame(void)
 {
 	m_private->curTime = m_private->timer->getTimeMilliseconds();
 
+	if (m_defs->headless)
+		return m_private->stepHeadless();
+
 	gkWindowSystem* sys = m_private->windowsystem;
 	sys->process();
 
 	if (!m_private->root->renderOneFrame())
 		return false;
 
+	if (m_defs->maxTicks > 0 && m_private->ticks >= (unsigned long)m_defs->maxTicks)
+		return false;
+
 	return !sys->exitRequest();
 }
 
 
 void gkEngine::finalizeStepLoop(void)
 {
-	m_private->root->removeFrameListener(m_private);
+	if (!m_defs->headless)
+		m_private->root->removeFrameListener(m_private);
+
 	m_running = false;
 }
 
@@ -688,7 +819,7 @@ unsigned long gkEngine::getCurTime()
 
 bool gkOgreEnginePrivate::frameStarted(const Ogre::FrameEvent& evt)
 {
-	gkStats::getSingleton().startClock();
+	gkProfiler::getSingleton().begin(gkRenderZone);
 
 	return true;
 }
@@ -697,13 +828,13 @@ bool gkOgreEnginePrivate::frameStarted(const Ogre::FrameEvent& evt)
 
 bool gkOgreEnginePrivate::frameRenderingQueued(const Ogre::FrameEvent& evt)
 {
-	gkStats::getSingleton().stopRenderClock();
+	gkProfiler::getSingleton().end();
 
 	if (!scenes.empty())
 		tick();
 
-	// restart the clock to mesure time for swapping buffer and updatind scenemanager LOD
-	gkStats::getSingleton().startClock();
+	// mesure time for swapping buffer and updatind scenemanager LOD
+	gkProfiler::getSingleton().begin(gkBufSwapLodZone);
 
 	return !scenes.empty();
 }
@@ -713,8 +844,8 @@ bool gkOgreEnginePrivate::frameRenderingQueued(const Ogre::FrameEvent& evt)
 
 bool gkOgreEnginePrivate::frameEnded(const Ogre::FrameEvent& evt)
 {
-	gkStats::getSingleton().stopBufSwapLodClock();
-	gkStats::getSingleton().nextFrame();
+	gkProfiler::getSingleton().end();
+	gkProfiler::getSingleton().nextFrame();
 
 	return true;
 }
@@ -722,6 +853,35 @@ bool gkOgreEnginePrivate::frameEnded(const Ogre::FrameEvent& evt)
 
 
 
+bool gkOgreEnginePrivate::stepHeadless(void)
+{
+	if (scenes.empty())
+		return false;
+
+	if (engine->m_defs->fastStep)
+		tickFixed();
+	else
+	{
+		// wait for the next tick instead of spinning, there is no
+		// buffer swap to throttle the loop
+		unsigned long wait = getTimeToNextTick();
+		if (wait > 0)
+			gkThread::sleep(wait);
+
+		tick();
+	}
+
+	gkProfiler::getSingleton().nextFrame();
+
+	if (engine->m_defs->maxTicks > 0 && ticks >= (unsigned long)engine->m_defs->maxTicks)
+		return false;
+
+	return !scenes.empty() && !windowsystem->exitRequest();
+}
+
+
+
+
 void gkOgreEnginePrivate::beginTickImpl(void)
 {
 	GK_ASSERT(!scenes.empty());
@@ -751,17 +911,30 @@ void gkOgreEnginePrivate::tickImpl(gkScalar dt)
 	// Proccess one full game tick
 	GK_ASSERT(windowsystem && !scenes.empty() && engine);
 
+	GK_PROFILE("Tick");
+
+	++ticks;
+
+	gkMessageManager::getSingleton().beginTick();
+
+	// brick debug text queued by the log writer
+	gkLogger::dispatchScreen();
 
 	// dispatch inputs
 	windowsystem->dispatch();
 
 	// update main scene
-	gkSceneArray::Iterator siter1(scenes);
-	while (siter1.hasMoreElements())
+	if (scenePool && scenes.size() > 1)
+		updateScenesConcurrent(dt);
+	else
 	{
-		gkScene* scene = siter1.getNext();
-		curScene = scene;
-		scene->update(dt);
+		gkSceneArray::Iterator siter1(scenes);
+		while (siter1.hasMoreElements())
+		{
+			gkScene* scene = siter1.getNext();
+			curScene = scene;
+			scene->update(dt);
+		}
 	}
 
 	// update callbacks
@@ -781,4 +954,60 @@ void gkOgreEnginePrivate::tickImpl(gkScalar dt)
 
 
 
+void gkOgreEnginePrivate::updateScenesConcurrent(gkScalar dt)
+{
+	gkSceneArray::Iterator siter0(scenes);
+	while (siter0.hasMoreElements())
+		siter0.getNext()->updateNavigation();
+
+	// physics worlds are per scene
+	{
+		GK_PROFILE("Physics");
+		runScenePhysics(dt);
+	}
+
+	// bricks, scripts and nodes share global managers
+	gkSceneArray::Iterator siter1(scenes);
+	while (siter1.hasMoreElements())
+	{
+		gkScene* scene = siter1.getNext();
+		curScene = scene;
+		scene->updateLogic(dt);
+	}
+
+	// skeletons and meshes are shared between scenes, and the Ogre
+	// SharedPtr counts of animation data are not atomic
+	{
+		GK_PROFILE("Animations");
+		gkSceneArray::Iterator iter(scenes);
+		while (iter.hasMoreElements())
+			iter.getNext()->updateAnimations(dt);
+	}
+
+	gkSceneArray::Iterator siter2(scenes);
+	while (siter2.hasMoreElements())
+	{
+		gkScene* scene = siter2.getNext();
+		curScene = scene;
+		scene->updateFinish(dt);
+	}
+}
+
+
+
+
+void gkOgreEnginePrivate::runScenePhysics(gkScalar dt)
+{
+	GK_ASSERT(scenePool);
+
+	gkSceneArray::Iterator iter(scenes);
+	while (iter.hasMoreElements())
+		scenePool->enqueue(gkPtrRef<gkCall>(new gkScenePhysicsCall(iter.getNext(), dt)));
+
+	// barrier, every scene finished stepping
+	scenePool->wait();
+}
+
+
+
 UT_IMPLEMENT_SINGLETON(gkEngine);
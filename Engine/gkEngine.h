@@ -31,6 +31,8 @@
 #include "gkMathUtils.h"
 #include "utSingleton.h"
 
+class gkThreadPool;
+
 class gkEngine : public utSingleton<gkEngine>
 {
 public:
@@ -85,6 +87,9 @@ public:
 	void addListener(Listener* listener);
 	void removeListener(Listener* listener);
 
+	///Workers querying the logic brick sensors of every scene, 0 when serial.
+	gkThreadPool* getSensorPool(void);
+
 private:
 
 	class Private;
@@ -57,8 +57,13 @@ void gkEntity::createInstanceImpl(void)
 {
 	gkGameObject::createInstanceImpl();
 
-	GK_ASSERT(!m_entity);
-
+	if (m_entity)
+	{
+		// reused from the clone pool, still attached to the kept node
+		GK_ASSERT(m_parked);
+		m_node->setVisible(!m_baseProps.isInvisible(), false);
+		return;
+	}
 
 	if (!m_entityProps->m_mesh)
 		return;
@@ -66,12 +71,18 @@ void gkEntity::createInstanceImpl(void)
 	if (m_skeleton)
 		m_skeleton->createInstance();
 
+	// nothing is drawn, keep only the scene node
+	if (gkEngine::getSingleton().getUserDefs().headless)
+		return;
+
 	Ogre::SceneManager* manager = m_scene->getManager();
 	m_entity = manager->createEntity(m_name.getName(), m_entityProps->m_mesh->getResourceName().getName(), 
 		m_name.getGroup().empty() ? Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME : m_name.getGroup());
 
 
 	m_entity->setCastShadows(m_entityProps->m_casts);
+	if (m_entityProps->m_lodBias != 1.f)
+		m_entity->setMeshLodBias(m_entityProps->m_lodBias);
 	m_node->attachObject(m_entity);
 
 	if (m_skeleton)
@@ -90,7 +101,8 @@ void gkEntity::createInstanceImpl(void)
 
 void gkEntity::destroyInstanceImpl(void)
 {
-	if (m_entity)
+	// the clone pool keeps the entity on the parked node
+	if (m_entity && !m_parked)
 	{
 
 		Ogre::SceneManager* manager = m_scene->getManager();
@@ -110,9 +122,9 @@ void gkEntity::destroyInstanceImpl(void)
 		{
 			m_skeleton->destroyInstance();
 		}
-	}
 
-	m_entity = 0;
+		m_entity = 0;
+	}
 
 
 	gkGameObject::destroyInstanceImpl();
@@ -150,6 +162,44 @@ void gkEntity::_destroyAsStaticGeometry(void)
 }
 
 
+bool gkEntity::_canPark(void)
+{
+	// poses and material overrides are not undone on reuse
+	return !m_skeleton && m_materialNameCache.empty() && gkGameObject::_canPark();
+}
+
+
+bool gkEntity::_resetFromClone(gkGameObject* from, const gkString& name)
+{
+	// the kept Ogre entity is bound to the mesh, which can change on the source
+	gkEntity* ent = from->getEntity();
+	if (!ent || ent->getMesh() != getMesh())
+		return false;
+
+	if (!gkGameObject::_resetFromClone(from, name))
+		return false;
+
+	*m_entityProps = *ent->m_entityProps;
+	return true;
+}
+
+
+void gkEntity::_destroyParked(void)
+{
+	if (m_entity && !m_scene->isBeingDestroyed())
+	{
+		if (m_node)
+			m_node->detachObject(m_entity);
+
+		m_scene->getManager()->destroyEntity(m_entity);
+	}
+
+	m_entity = 0;
+
+	gkGameObject::_destroyParked();
+}
+
+
 gkGameObject* gkEntity::clone(const gkString& name)
 {
 	gkEntity* cl = new gkEntity(getInstanceCreator(), name, -1);
@@ -52,6 +52,10 @@ public:
 	// Remove only the entity but keep the rest.
 	void _destroyAsStaticGeometry(void);
 
+	bool _canPark(void);
+	bool _resetFromClone(gkGameObject* from, const gkString& name);
+	void _destroyParked(void);
+
 	void setMaterialName(const gkString& matName);
 
 protected:
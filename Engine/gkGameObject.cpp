@@ -68,6 +68,8 @@ gkGameObject::gkGameObject(gkInstancedManager* creator, const gkResourceName& na
 	     m_state(0), m_activeLayer(true),
 	     m_layer(0xFFFFFFFF),
 	     m_isClone(false),
+	     m_cloneSource(0),
+	     m_parked(false),
 	     m_flags(0),
 	     m_actionBlender(0),
 	     m_cloneToScene(0),
@@ -141,6 +143,7 @@ void gkGameObject::cloneImpl(gkGameObject* clob)
 	clob->m_activeLayer = m_activeLayer;
 	clob->m_baseProps = m_baseProps;
 	clob->m_isClone = true;
+	clob->m_cloneSource = m_isClone ? m_cloneSource : this;
 	clob->m_scene = m_scene;
 
 	// clone variables
@@ -184,6 +187,15 @@ void gkGameObject::createInstanceImpl(void)
 	Ogre::SceneManager* manager = m_scene->getManager();
 	Ogre::SceneNode* parentNode = 0;
 
+	if (m_parked && m_node)
+	{
+		// reused from the clone pool, parked clones have no parent or children
+		manager->getRootSceneNode()->addChild(m_node);
+		applyTransformState(m_baseProps.m_transform);
+		m_node->setInitialState();
+		return;
+	}
+
 
 	if (!m_scene->isBeingCreated())
 	{
@@ -239,6 +251,7 @@ void gkGameObject::postCreateInstanceImpl(void)
 {
 	// tell scene
 	m_scene->notifyInstanceCreated(this);
+	m_parked = false;
 
 	sendNotification(Notifier::INSTANCE_CREATED);
 }
@@ -272,7 +285,13 @@ void gkGameObject::destroyInstanceImpl(void)
 	Ogre::SceneManager* manager = m_scene->getManager();
 
 
-	if (!m_scene->isBeingDestroyed())
+	if (m_parked)
+	{
+		// the clone pool keeps the node, only leave the scene graph
+		if (m_node && m_node->getParentSceneNode())
+			m_node->getParentSceneNode()->removeChild(m_node);
+	}
+	else if (!m_scene->isBeingDestroyed())
 	{
 		if (m_node)
 		{
@@ -293,7 +312,8 @@ void gkGameObject::destroyInstanceImpl(void)
 		}
 	}
 
-	m_node = 0;
+	if (!m_parked)
+		m_node = 0;
 
 	m_scene->removeAnimationUpdate(this);
 
@@ -309,6 +329,107 @@ void gkGameObject::destroyInstanceImpl(void)
 
 
 
+bool gkGameObject::_canPark(void)
+{
+	// other types keep per instance state that is rebuilt on creation
+	if (m_type != GK_OBJECT && m_type != GK_ENTITY)
+		return false;
+
+	if (!m_isClone || !m_cloneSource || !m_node || m_parent || !m_children.empty() || m_groupID || m_group)
+		return false;
+
+	if (isStaticGeometry())
+		return false;
+
+	// attached trees, listeners and constraints are not rebuilt on reuse
+	if (m_logic || !m_events.empty() || m_scene->getConstraintManager()->hasConstraints(this))
+		return false;
+
+	const gkPhysicsProperties& phy = m_baseProps.m_physics;
+	return !phy.isStatic() && phy.m_type != GK_CHARACTER && !phy.isLinkedToOther() && !phy.isCompound();
+}
+
+
+
+bool gkGameObject::_resetFromClone(gkGameObject* from, const gkString& name)
+{
+	GK_ASSERT(from && !isInstanced());
+
+	// must end up as from->clone(name) would, else the caller makes a real clone
+	if (m_type != from->m_type || m_variables.size() != from->m_variables.size())
+		return false;
+
+	if (from->m_scene && from->m_scene->getConstraintManager()->hasConstraints(from))
+		return false;
+
+	utHashTableIterator<VariableMap> iter(from->m_variables);
+	while (iter.hasMoreElements())
+	{
+		if (!m_variables.get(iter.getNext().first))
+			return false;
+	}
+
+
+	m_name = gkResourceName(name);
+	m_activeLayer = from->m_activeLayer;
+	m_baseProps = from->m_baseProps;
+	m_layer = 0xFFFFFFFF;
+	m_state = 0;
+	m_flags = 0;
+
+	utHashTableIterator<VariableMap> vars(from->m_variables);
+	while (vars.hasMoreElements())
+	{
+		gkVariable* ovar = vars.getNext().second;
+		gkVariable* nvar = *m_variables.get(ovar->getName());
+
+		*nvar = *ovar;
+		nvar->setDebug(false);
+	}
+
+
+	// sensor ticks, delays and actuator state come from the copied bricks
+	if (m_bricks)
+	{
+		m_bricks->getLogicManager()->destroy(m_bricks);
+		m_bricks = 0;
+	}
+
+	if (from->m_bricks)
+		m_bricks = from->m_bricks->clone(this);
+
+
+	// players are added on demand, a fresh clone has none
+	if (m_actionBlender)
+	{
+		delete m_actionBlender;
+		m_actionBlender = 0;
+	}
+
+	Animations::Iterator it = m_actions.iterator();
+	while (it.hasMoreElements())
+		delete it.getNext().second;
+	m_actions.clear();
+
+	return true;
+}
+
+
+
+void gkGameObject::_destroyParked(void)
+{
+	GK_ASSERT(!isInstanced());
+
+	if (m_node && !m_scene->isBeingDestroyed())
+		m_scene->getManager()->destroySceneNode(m_node);
+
+	m_node = 0;
+	m_parked = false;
+}
+
+
+
+
 bool gkGameObject::hasSensorMaterial(const gkString& name, bool onlyFirst)
 {
 	gkEntity* ent = getEntity();
@@ -90,6 +90,17 @@ public:
 	GK_INLINE gkGameObjectProperties&   getProperties(void)  {return m_baseProps;}
 	GK_INLINE bool                      isClone(void)        {return m_isClone;}
 
+	// Clone pool support. A parked clone keeps its node, movable and physics
+	// controller across destroyInstance so the scene can hand it out again.
+	GK_INLINE gkGameObject*             getCloneSource(void)              {return m_cloneSource;}
+	GK_INLINE void                      _setCloneSource(gkGameObject* v)  {m_cloneSource = v;}
+	GK_INLINE bool                      isParked(void)                    {return m_parked;}
+	GK_INLINE void                      _setParked(bool v)                {m_parked = v;}
+
+	virtual bool _canPark(void);
+	virtual bool _resetFromClone(gkGameObject* from, const gkString& name);
+	virtual void _destroyParked(void);
+
 
 	bool hasSensorMaterial(const gkString& name, bool onlyFirst = true);
 
@@ -352,6 +363,8 @@ protected:
 	bool                        m_activeLayer;
 	int                         m_layer;
 	bool                        m_isClone;
+	gkGameObject*               m_cloneSource;  // first non clone object up the clone chain
+	bool                        m_parked;       // instance kept by the scene clone pool
 	int                         m_flags;
 	LifeSpan                    m_life;
 
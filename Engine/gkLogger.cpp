@@ -27,6 +27,10 @@
 #include "gkLogger.h"
 #include "OgreLogManager.h"
 #include "OgreLog.h"
+#include "Thread/gkCriticalSection.h"
+#include "Thread/gkThread.h"
+#include <signal.h>
+#include <exception>
 
 
 #ifdef _MSC_VER
@@ -35,52 +39,578 @@
 # define gkvsnprintf    vsnprintf
 #endif
 
+#if UT_COMPILER == UT_COMPILER_MSVC
+# define GK_LOG_THREAD_LOCAL        __declspec(thread)
+# define GK_LOG_BARRIER()           MemoryBarrier()
+# define GK_LOG_NEXT_SERIAL(x)      ((UTuint32)InterlockedIncrement((volatile LONG*)&(x)))
+# define GK_LOG_EXIT_CALLBACK       WINAPI
+typedef DWORD gkLogExitKey;
+#else
+# include <pthread.h>
+# define GK_LOG_THREAD_LOCAL        __thread
+# define GK_LOG_BARRIER()           __sync_synchronize()
+# define GK_LOG_NEXT_SERIAL(x)      __sync_add_and_fetch(&(x), 1)
+# define GK_LOG_EXIT_CALLBACK
+typedef pthread_key_t gkLogExitKey;
+#endif
+
 
 
 #define GK_BUFSIZE (0xFFFF)
 
-static char GK_ConsoleBuffer[GK_BUFSIZE+1];
+#define GK_LOG_RING_SIZE    (1 << 17)                   // bytes queued per producer thread
+#define GK_LOG_WAKE_SIZE    (GK_LOG_RING_SIZE >> 1)     // fill level that wakes the writer early
+#define GK_LOG_RECORD_MAX   (GK_LOG_RING_SIZE >> 2)     // longer records are written in place
+#define GK_LOG_WRITER_WAIT  20                          // ms between writer passes
+
+// record flags
+#define GK_LOG_REC_PRINTF   (1 << 0)    // gkPrintf, always reaches a low detail log
+#define GK_LOG_REC_FORCE    (1 << 1)    // gkLogger::write(msg, true)
+#define GK_LOG_REC_QUIET    (1 << 2)    // no console fallback without a log
+
+
+int gkLogger::m_level       = GK_LOG_DEBUG;
+int gkLogger::m_categories  = GK_LOG_ALL;
+
+
 static Ogre::Log* gLog = 0;
 
+// owns the sinks, held by whoever writes records out
+static gkCriticalSection gLogLock;
 
-void gkPrintf(const char* fmt, ...)
+
+
+struct gkLogHeader
 {
-	va_list lst;
-	va_start(lst, fmt);
-	int size = gkvsnprintf(GK_ConsoleBuffer, GK_BUFSIZE, fmt, lst);
-	va_end(lst);
+	UTuint32 serial;
+	UTuint32 size;
+	UTuint8  level;
+	UTuint8  category;
+	UTuint8  flags;
+	UTuint8  pad;
+};
+
+
+
+// Single producer, single consumer byte ring. Head and tail only grow, the
+// owning thread moves the head and the writer moves the tail.
+class gkLogRing
+{
+public:
+	gkLogRing() : m_head(0), m_tail(0) {}
 
-	if (size < 0)
+	volatile UTsize m_head;
+	volatile UTsize m_tail;
+
+	char m_data[GK_LOG_RING_SIZE];
+	char m_scratch[GK_BUFSIZE + 1];     // formatting buffer of the owning thread
+
+	void copyIn(UTsize pos, const void* src, UTsize len)
 	{
-		GK_ConsoleBuffer[GK_BUFSIZE] = 0;
-		size = GK_BUFSIZE;
+		UTsize at = pos & (GK_LOG_RING_SIZE - 1), first = GK_LOG_RING_SIZE - at;
+		if (first > len)
+			first = len;
+		memcpy(m_data + at, src, first);
+		memcpy(m_data, (const char*)src + first, len - first);
 	}
 
-	if (size > 0)
+	void copyOut(UTsize pos, void* dst, UTsize len) const
+	{
+		UTsize at = pos & (GK_LOG_RING_SIZE - 1), first = GK_LOG_RING_SIZE - at;
+		if (first > len)
+			first = len;
+		memcpy(dst, m_data + at, first);
+		memcpy((char*)dst + first, m_data, len - first);
+	}
+};
+
+
+
+struct gkLogEntry
+{
+	gkLogHeader header;
+	UTsize      text;
+};
+
+
+
+class gkLogWriter : public gkCall
+{
+public:
+	gkLogWriter() : m_running(true) {}
+
+	void run(void);
+
+	volatile bool m_running;
+};
+
+
+
+struct gkLogState
+{
+	gkLogState() : m_hasExitKey(false), m_writer(0), m_thread(0), m_async(true), m_serial(0) {}
+	~gkLogState()
+	{
+		for (UTsize i = 0; i < m_rings.size(); ++i)
+			delete m_rings[i];
+	}
+
+	gkCriticalSection   m_ringLock;
+	utArray<gkLogRing*> m_rings;
+	utArray<gkLogRing*> m_freeRings;    // of finished threads, in m_rings too
+	gkLogExitKey        m_exitKey;      // hands the ring back when its thread exits
+	bool                m_hasExitKey;
+
+	gkLogWriter*        m_writer;
+	gkThread*           m_thread;
+	gkSyncObj           m_wake;
+	bool                m_async;
+	volatile UTuint32   m_serial;
+
+	// writer side, under gLogLock
+	utArray<gkLogRing*> m_drainRings;
+	utArray<gkLogEntry> m_entries;
+	utArray<UTsize>     m_ringEnd, m_cursor;
+	utArray<char>       m_text;
+
+	gkCriticalSection   m_screenLock;
+	gkString            m_screen;
+};
+
+
+static gkLogState& gkLogGetState(void)
+{
+	static gkLogState state;
+	return state;
+}
+
+
+static GK_LOG_THREAD_LOCAL gkLogRing* gkLogThreadRing = 0;
+
+// set while this thread holds gLogLock, a crash handler must not wait on it
+static GK_LOG_THREAD_LOCAL bool gkLogThreadWriting = false;
+
+
+class gkLogSinkLock
+{
+public:
+	gkLogSinkLock() : m_lock(gLogLock) { gkLogThreadWriting = true; }
+	~gkLogSinkLock() { gkLogThreadWriting = false; }
+
+private:
+	gkCriticalSection::Lock m_lock;
+};
+
+
+// Runs on the exiting thread. Records it left are still written, the next
+// thread to log takes over the ring after them.
+static void GK_LOG_EXIT_CALLBACK gkLogReleaseRing(void* ring)
+{
+	if (!ring)
+		return;
+
+	gkLogState& st = gkLogGetState();
+	gkCriticalSection::Lock lock(st.m_ringLock);
+	st.m_freeRings.push_back(static_cast<gkLogRing*>(ring));
+}
+
+
+
+static gkLogRing* gkLogGetRing(void)
+{
+	if (gkLogThreadRing)
+		return gkLogThreadRing;
+
+	gkLogState& st = gkLogGetState();
+	gkLogRing* ring;
+	{
+		gkCriticalSection::Lock lock(st.m_ringLock);
+
+		// the writer scans every ring, keep them to the most threads alive at once
+		if (!st.m_freeRings.empty())
+		{
+			ring = st.m_freeRings.back();
+			st.m_freeRings.pop_back();
+		}
+		else
+		{
+			ring = new gkLogRing();
+			st.m_rings.push_back(ring);
+		}
+
+		if (!st.m_hasExitKey)
+		{
+#if UT_COMPILER == UT_COMPILER_MSVC
+			st.m_exitKey = FlsAlloc(gkLogReleaseRing);
+			st.m_hasExitKey = st.m_exitKey != FLS_OUT_OF_INDEXES;
+#else
+			st.m_hasExitKey = pthread_key_create(&st.m_exitKey, gkLogReleaseRing) == 0;
+#endif
+		}
+	}
+
+	if (st.m_hasExitKey)
+	{
+#if UT_COMPILER == UT_COMPILER_MSVC
+		FlsSetValue(st.m_exitKey, ring);
+#else
+		pthread_setspecific(st.m_exitKey, ring);
+#endif
+	}
+
+	gkLogThreadRing = ring;
+	return ring;
+}
+
+
+
+static Ogre::LogMessageLevel gkLogOgreLevel(int level)
+{
+	if (level <= GK_LOG_DEBUG)
+		return Ogre::LML_TRIVIAL;
+	if (level >= GK_LOG_ERROR)
+		return Ogre::LML_CRITICAL;
+	return Ogre::LML_NORMAL;
+}
+
+
+static void gkLogConsole(const char* text, UTsize size)
+{
+	if (size == 0 || text[size-1] != '\n')
+		printf("%s\n", text);
+	else
+		printf("%s", text);
+}
+
+
+// write one record to its sinks, text is null terminated
+static void gkLogOutput(const gkLogHeader& hdr, char* text)
+{
+	UTsize size = hdr.size;
+
+	if (hdr.category & GK_LOG_SCREEN)
+	{
+		// overlays belong to the render thread, records may come from any
+		// thread even without a writer
+		gkLogState& st = gkLogGetState();
+		gkCriticalSection::Lock lock(st.m_screenLock);
+		st.m_screen.append(text, size);
+		return;
+	}
+
+	if (hdr.flags & GK_LOG_REC_FORCE)
+	{
+		if (gLog && gLog->getLogDetail() == Ogre::LL_LOW)
+		{
+			gkLogConsole(text, size);
+			return;
+		}
+		else if (!gLog)
+			printf("%s", text);
+	}
+
+	if (gLog != 0)
 	{
 		// out to log stream so user def flags work
-		GK_ConsoleBuffer[size] = 0;
-		if (gLog != 0)
+		if (hdr.flags & GK_LOG_REC_PRINTF)
 		{
-			if (GK_ConsoleBuffer[size-1] == '\n')
-				GK_ConsoleBuffer[--size] = 0;
-			gLog->logMessage(GK_ConsoleBuffer, Ogre::LML_CRITICAL);
+			if (size > 0 && text[size-1] == '\n')
+				text[--size] = 0;
+			gLog->logMessage(text, Ogre::LML_CRITICAL);
 		}
 		else
+			gLog->logMessage(text, gkLogOgreLevel(hdr.level));
+	}
+	else if (!(hdr.flags & (GK_LOG_REC_FORCE | GK_LOG_REC_QUIET)))
+		gkLogConsole(text, size);
+}
+
+
+
+// Empty every ring and write the records in the order they were pushed.
+// Each ring is already ordered, so this merges them by serial.
+static void gkLogDrainLocked(void)
+{
+	gkLogState& st = gkLogGetState();
+
+	{
+		gkCriticalSection::Lock lock(st.m_ringLock);
+		st.m_drainRings.resize(0);
+		for (UTsize i = 0; i < st.m_rings.size(); ++i)
+			st.m_drainRings.push_back(st.m_rings[i]);
+	}
+
+	UTsize nrings = st.m_drainRings.size();
+	st.m_entries.resize(0);
+	st.m_text.resize(0);
+	st.m_ringEnd.resize(0);
+	st.m_cursor.resize(0);
+
+	for (UTsize r = 0; r < nrings; ++r)
+	{
+		gkLogRing* ring = st.m_drainRings[r];
+
+		UTsize head = ring->m_head;
+		GK_LOG_BARRIER();
+
+		st.m_cursor.push_back(st.m_entries.size());
+
+		UTsize pos = ring->m_tail;
+		while (pos != head)
+		{
+			gkLogEntry ent;
+			ring->copyOut(pos, &ent.header, sizeof(gkLogHeader));
+			pos += sizeof(gkLogHeader);
+
+			ent.text = st.m_text.size();
+			st.m_text.resize(ent.text + ent.header.size + 1);
+			ring->copyOut(pos, st.m_text.ptr() + ent.text, ent.header.size);
+			st.m_text[ent.text + ent.header.size] = 0;
+			pos += ent.header.size;
+
+			st.m_entries.push_back(ent);
+		}
+
+		GK_LOG_BARRIER();
+		ring->m_tail = head;
+
+		st.m_ringEnd.push_back(st.m_entries.size());
+	}
+
+	for (;;)
+	{
+		UTsize best = UT_NPOS;
+		for (UTsize r = 0; r < nrings; ++r)
+		{
+			if (st.m_cursor[r] == st.m_ringEnd[r])
+				continue;
+
+			if (best == UT_NPOS ||
+			        (int)(st.m_entries[st.m_cursor[r]].header.serial - st.m_entries[st.m_cursor[best]].header.serial) < 0)
+				best = r;
+		}
+
+		if (best == UT_NPOS)
+			break;
+
+		gkLogEntry& ent = st.m_entries[st.m_cursor[best]++];
+		gkLogOutput(ent.header, st.m_text.ptr() + ent.text);
+	}
+
+	// keep capacity, release a burst
+	if (st.m_text.capacity() > GK_LOG_RING_SIZE * 4)
+		st.m_text.clear(true);
+}
+
+
+
+void gkLogWriter::run(void)
+{
+	gkLogState& st = gkLogGetState();
+
+	while (m_running)
+	{
+		st.m_wake.wait(GK_LOG_WRITER_WAIT);
+
+		gkLogSinkLock guard;
+		gkLogDrainLocked();
+	}
+
+	gkLogSinkLock guard;
+	gkLogDrainLocked();
+}
+
+
+
+static void gkLogStartWriter(void)
+{
+	gkLogState& st = gkLogGetState();
+	if (!st.m_thread)
+	{
+		st.m_writer = new gkLogWriter();
+		st.m_thread = new gkThread(st.m_writer);
+	}
+}
+
+
+static void gkLogStopWriter(void)
+{
+	gkLogState& st = gkLogGetState();
+	if (st.m_thread)
+	{
+		st.m_writer->m_running = false;
+		st.m_wake.signal();
+		st.m_thread->join();
+
+		delete st.m_thread;
+		delete st.m_writer;
+		st.m_thread = 0;
+		st.m_writer = 0;
+	}
+}
+
+
+
+// Last chance for queued records when the process goes down.
+static void gkLogFlushFatal(void)
+{
+	if (!gkLogThreadWriting)
+		gkLogger::flush();
+}
+
+
+static void gkLogFatalSignal(int sig)
+{
+	gkLogFlushFatal();
+
+	signal(sig, SIG_DFL);
+	raise(sig);
+}
+
+
+static std::terminate_handler gkLogPrevTerminate = 0;
+
+static void gkLogTerminate(void)
+{
+	gkLogFlushFatal();
+
+	if (gkLogPrevTerminate)
+		gkLogPrevTerminate();
+	abort();
+}
+
+
+static void gkLogInstallFatalHandlers(void)
+{
+	static bool installed = false;
+	if (installed)
+		return;
+	installed = true;
+
+	gkLogPrevTerminate = std::set_terminate(gkLogTerminate);
+
+	signal(SIGABRT, gkLogFatalSignal);
+	signal(SIGSEGV, gkLogFatalSignal);
+	signal(SIGFPE,  gkLogFatalSignal);
+	signal(SIGILL,  gkLogFatalSignal);
+}
+
+
+
+// Queue a formatted record, or write it here when there is no writer
+// thread or it does not fit. text is null terminated.
+static void gkLogPush(gkLogRing* ring, int level, int category, int flags, const char* text, UTsize size)
+{
+	gkLogState& st = gkLogGetState();
+
+	gkLogHeader hdr;
+	hdr.serial   = GK_LOG_NEXT_SERIAL(st.m_serial);
+	hdr.size     = (UTuint32)size;
+	hdr.level    = (UTuint8)level;
+	hdr.category = (UTuint8)category;
+	hdr.flags    = (UTuint8)flags;
+	hdr.pad      = 0;
+
+	UTsize need = sizeof(gkLogHeader) + size;
+
+	if (st.m_thread && size <= GK_LOG_RECORD_MAX)
+	{
+		for (;;)
 		{
-			if (GK_ConsoleBuffer[size-1] != '\n')
-				printf("%s\n", GK_ConsoleBuffer);
-			else
-				printf("%s", GK_ConsoleBuffer);
+			UTsize tail = ring->m_tail;
+			GK_LOG_BARRIER();
+
+			if (GK_LOG_RING_SIZE - (ring->m_head - tail) >= need)
+				break;
+
+			// full, the writer is behind
+			st.m_wake.signal();
+			gkThread::sleep(1);
+
+			if (!st.m_thread)
+				break;
 		}
+
+		if (st.m_thread)
+		{
+			UTsize head = ring->m_head;
+			ring->copyIn(head, &hdr, sizeof(gkLogHeader));
+			ring->copyIn(head + sizeof(gkLogHeader), text, size);
+
+			GK_LOG_BARRIER();
+			ring->m_head = head + need;
+
+			if (level >= GK_LOG_ERROR || ring->m_head - ring->m_tail >= GK_LOG_WAKE_SIZE)
+				st.m_wake.signal();
+			return;
+		}
+	}
+
+	// synchronous, after whatever is still queued
+	gkLogSinkLock guard;
+	gkLogDrainLocked();
+
+	// only gkPrintf records are edited, those live in the scratch buffer
+	gkLogOutput(hdr, const_cast<char*>(text));
+}
+
+
+
+static void gkLogFormat(int level, int category, int flags, const char* fmt, va_list lst)
+{
+	gkLogRing* ring = gkLogGetRing();
+
+	int size = gkvsnprintf(ring->m_scratch, GK_BUFSIZE, fmt, lst);
+
+	if (size < 0 || size > GK_BUFSIZE)
+	{
+		ring->m_scratch[GK_BUFSIZE] = 0;
+		size = GK_BUFSIZE;
 	}
+
+	if (size > 0)
+	{
+		ring->m_scratch[size] = 0;
+		gkLogPush(ring, level, category, flags, ring->m_scratch, (UTsize)size);
+	}
+}
+
+
+
+void gkPrintf(const char* fmt, ...)
+{
+	// not level filtered, engine errors go through here and always reached the log
+	va_list lst;
+	va_start(lst, fmt);
+	gkLogFormat(GK_LOG_INFO, GK_LOG_CORE, GK_LOG_REC_PRINTF, fmt, lst);
+	va_end(lst);
+}
+
+
+
+void gkLogger::writef(int level, int category, const char* fmt, ...)
+{
+	va_list lst;
+	va_start(lst, fmt);
+	gkLogFormat(level, category, 0, fmt, lst);
+	va_end(lst);
+}
+
+
+
+void gkLogger::writev(int level, int category, const char* fmt, va_list lst)
+{
+	gkLogFormat(level, category, 0, fmt, lst);
 }
 
 
+
 void gkLogger::enable(const gkString& name, bool verbose)
 {
 	if (!gLog)
 	{
+		gkLogSinkLock guard;
+
 		Ogre::LogManager* mgr = Ogre::LogManager::getSingletonPtr();
 		if (!mgr)
 			mgr = new Ogre::LogManager();
@@ -91,14 +621,24 @@ void gkLogger::enable(const gkString& name, bool verbose)
 			gLog->setLogDetail(Ogre::LL_LOW);
 
 	}
+
+	if (gkLogGetState().m_async)
+		gkLogStartWriter();
+
+	gkLogInstallFatalHandlers();
 }
 
 
 
 void gkLogger::disable()
 {
+	gkLogStopWriter();
+
 	if (gLog)
 	{
+		gkLogSinkLock guard;
+		gkLogDrainLocked();
+
 		Ogre::LogManager::getSingleton().destroyLog(gLog);
 		gLog = 0;
 		delete Ogre::LogManager::getSingletonPtr();
@@ -107,25 +647,64 @@ void gkLogger::disable()
 
 
 
-void gkLogger::write(const gkString& msg, bool force)
+void gkLogger::setAsync(bool v)
 {
-	if (force)
+	gkLogState& st = gkLogGetState();
+	st.m_async = v;
+
+	if (!v)
+		gkLogStopWriter();
+	else if (gLog)
+		gkLogStartWriter();
+}
+
+
+bool gkLogger::isAsync(void)
+{
+	return gkLogGetState().m_thread != 0;
+}
+
+
+
+void gkLogger::flush(void)
+{
+	gkLogSinkLock guard;
+	gkLogDrainLocked();
+}
+
+
+
+void gkLogger::dispatchScreen(void)
+{
+	gkLogState& st = gkLogGetState();
+
+	gkString text;
 	{
-		if (gLog && gLog->getLogDetail() == Ogre::LL_LOW)
-		{
-			if (msg[msg.size()-1] != '\n')
-				printf("%s\n", msg.c_str());
-			else
-				printf("%s", msg.c_str());
+		gkCriticalSection::Lock lock(st.m_screenLock);
+		if (st.m_screen.empty())
 			return;
-		}
-		else
-		{
-			if (!gLog)
-				printf("%s", msg.c_str());
-		}
+		text.swap(st.m_screen);
 	}
 
-	if (gLog != 0)
-		gLog->logMessage(msg);
+	gkDebugScreen::printTo(text);
+}
+
+
+
+void gkLogger::write(const gkString& msg, bool force)
+{
+	// forced messages bypass the level filter like gkPrintf
+	if (msg.empty() || (!force && !isEnabled(GK_LOG_INFO, GK_LOG_CORE)))
+		return;
+
+	gkLogPush(gkLogGetRing(), GK_LOG_INFO, GK_LOG_CORE, force ? GK_LOG_REC_FORCE : GK_LOG_REC_QUIET, msg.c_str(), msg.size());
+}
+
+
+
+UTsize gkLogger::getQueueCount(void)
+{
+	gkLogState& st = gkLogGetState();
+	gkCriticalSection::Lock lock(st.m_ringLock);
+	return st.m_rings.size();
 }
@@ -30,20 +30,84 @@
 #include "gkString.h"
 #include "gkCommon.h"
 #include "gkDebugScreen.h"
+#include <stdarg.h>
 
 
+enum gkLogLevel
+{
+	GK_LOG_DEBUG,
+	GK_LOG_INFO,
+	GK_LOG_WARNING,
+	GK_LOG_ERROR,
+	GK_LOG_CRITICAL,
+};
+
+
+enum gkLogCategory
+{
+	GK_LOG_CORE     = (1 << 0),
+	GK_LOG_LOGIC    = (1 << 1),
+	GK_LOG_PHYSICS  = (1 << 2),
+	GK_LOG_SOUND    = (1 << 3),
+	GK_LOG_LOADER   = (1 << 4),
+	GK_LOG_SCRIPT   = (1 << 5),
+	GK_LOG_SCREEN   = (1 << 6),     // shown on the debug screen instead of the log
+	GK_LOG_ALL      = 0xFF,
+};
 
+
+///Records are formatted on the calling thread, pushed to a ring owned by that
+///thread and written to the log, console and debug screen by a background writer.
+///Queued records are flushed when the process aborts or crashes.
 class gkLogger
 {
 public:
 	static void enable(const gkString& name, bool verbose);
 	static void disable();
+	///Forced messages bypass the level filter.
 	static void write(const gkString& msg, bool force = false);
+
+	static void writef(int level, int category, const char* fmt, ...);
+	static void writev(int level, int category, const char* fmt, va_list lst);
+
+	///Write on the calling thread when off. Switching off flushes pending records.
+	static void setAsync(bool v);
+	static bool isAsync(void);
+
+	///Block until every record pushed so far is written.
+	static void flush(void);
+
+	///Show pending debug screen text, call from the render thread. Screen
+	///records are only ever shown from here, sync mode included.
+	static void dispatchScreen(void);
+
+	///Per thread record queues, a finished thread's queue goes to the next new one.
+	static UTsize getQueueCount(void);
+
+	static void setLevel(int level)             {m_level = level;}
+	static void setCategories(int categories)   {m_categories = categories;}
+	static int  getLevel(void)                  {return m_level;}
+	static int  getCategories(void)             {return m_categories;}
+
+	GK_INLINE static bool isEnabled(int level, int category)
+	{
+		return level >= m_level && (category & m_categories) == category;
+	}
+
+private:
+	static int m_level, m_categories;
 };
 
-// printf style logging
+// printf style logging, bypasses the level filter
 extern void gkPrintf(const char* fmt, ...);
 
+// filtered logging, arguments are not evaluated when filtered out
+#define gkLogf(level, category, ...)                            \
+	do {                                                        \
+		if (gkLogger::isEnabled(level, category))               \
+			gkLogger::writef(level, category, __VA_ARGS__);     \
+	} while (0)
+
 
 
 // std::cout style logging
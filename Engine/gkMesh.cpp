@@ -229,7 +229,8 @@ gkMesh::gkMesh(gkResourceManager* creator, const gkResourceName& name, const gkR
 	    m_triMesh(0),
 	    m_skeleton(0),
 		m_vertexCount(0),
-		m_triFaceCount(0)
+		m_triFaceCount(0),
+		m_lodReduction(0.5f)
 {
 	m_meshLoader = new gkMeshLoader(this);
 }
@@ -463,3 +464,22 @@ void gkMesh::reload()
 }
 
 
+
+void gkMesh::setLodLevels(const LodDistances& distances, gkScalar reduction)
+{
+	// Ogre wants the levels by increasing distance
+	m_lodDistances.clear();
+	for (UTsize i = 0; i < distances.size(); ++i)
+	{
+		if (distances[i] <= 0.f)
+			continue;
+
+		UTsize pos = m_lodDistances.size();
+		m_lodDistances.push_back(distances[i]);
+		for (; pos > 0 && m_lodDistances[pos - 1] > distances[i]; --pos)
+			m_lodDistances[pos] = m_lodDistances[pos - 1];
+		m_lodDistances[pos] = distances[i];
+	}
+
+	m_lodReduction = gkClamp<gkScalar>(reduction, 0.05f, 0.95f);
+}
@@ -177,6 +177,7 @@ public:
 	typedef utArray<gkSubMesh*>             SubMeshArray;
 	typedef utArrayIterator<SubMeshArray>   SubMeshIterator;
 	typedef utArray<gkVertexGroup*>         VertexGroups;
+	typedef utArray<gkScalar>               LodDistances;
 	SubMeshArray         m_submeshes;
 
 private:
@@ -191,6 +192,9 @@ private:
 	UTsize               m_vertexCount;
 	UTsize               m_triFaceCount;
 
+	LodDistances         m_lodDistances;
+	gkScalar             m_lodReduction;
+
 public:
 
 	gkMesh(gkResourceManager* creator, const gkResourceName& name, const gkResourceHandle& handle);
@@ -225,6 +229,13 @@ public:
 	gkTriFace getMeshTriFace(UTsize n);
 	
 	void reload();
+
+
+	// Reduced levels built when the mesh is loaded, each starting at the given camera
+	// distance and keeping 'reduction' of the previous level's triangles.
+	void                 setLodLevels(const LodDistances& distances, gkScalar reduction = 0.5f);
+	const LodDistances&  getLodDistances(void) const   {return m_lodDistances;}
+	gkScalar             getLodReduction(void) const   {return m_lodReduction;}
 };
 
 #endif//_gkMesh_h_
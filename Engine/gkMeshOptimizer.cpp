@@ -0,0 +1,581 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "gkMeshOptimizer.h"
+#include <stdlib.h>
+
+
+// Scoring from "Linear-Speed Vertex Cache Optimisation", Tom Forsyth
+static const gkScalar gkCacheDecayPower    = 1.5f;
+static const gkScalar gkLastTriScore       = 0.75f;
+static const gkScalar gkValenceBoostScale  = 2.0f;
+static const gkScalar gkValenceBoostPower  = 0.5f;
+
+
+
+static gkScalar gkVertexScore(int cachePos, int liveTris)
+{
+	if (liveTris == 0)
+		return -1.f;
+
+	gkScalar score = 0.f;
+	if (cachePos >= 0)
+	{
+		if (cachePos < 3)
+			score = gkLastTriScore;
+		else
+		{
+			const gkScalar scale = 1.f / (gkMeshOptimizer::CACHE_SIZE - 3);
+			score = Ogre::Math::Pow(1.f - (cachePos - 3) * scale, gkCacheDecayPower);
+		}
+	}
+
+	return score + gkValenceBoostScale * Ogre::Math::Pow((gkScalar)liveTris, -gkValenceBoostPower);
+}
+
+
+
+void gkMeshOptimizer::optimizeVertexCache(unsigned int* indices, UTsize indexCount, UTsize vertexCount)
+{
+	const UTsize triCount = indexCount / 3;
+	if (triCount < 2 || vertexCount == 0)
+		return;
+
+	// triangles using each vertex, packed per vertex
+	utArray<int> liveTris, adjOffset, adjTris, cachePos;
+	utArray<gkScalar> vertScore;
+
+	liveTris.resize(vertexCount, 0);
+	for (UTsize i = 0; i < triCount * 3; ++i)
+		liveTris[indices[i]]++;
+
+	adjOffset.resize(vertexCount + 1, 0);
+	for (UTsize v = 0; v < vertexCount; ++v)
+		adjOffset[v + 1] = adjOffset[v] + liveTris[v];
+
+	adjTris.resize(triCount * 3);
+	{
+		utArray<int> fill;
+		fill.resize(vertexCount, 0);
+		for (UTsize t = 0; t < triCount; ++t)
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				const unsigned int v = indices[t * 3 + k];
+				adjTris[adjOffset[v] + fill[v]++] = (int)t;
+			}
+		}
+	}
+
+	cachePos.resize(vertexCount, -1);
+	vertScore.resize(vertexCount);
+	for (UTsize v = 0; v < vertexCount; ++v)
+		vertScore[v] = gkVertexScore(-1, liveTris[v]);
+
+	utArray<gkScalar> triScore;
+	utArray<bool> triAdded;
+	triScore.resize(triCount);
+	triAdded.resize(triCount, false);
+
+	int bestTri = -1;
+	gkScalar bestScore = -1.f;
+	for (UTsize t = 0; t < triCount; ++t)
+	{
+		triScore[t] = vertScore[indices[t * 3]] + vertScore[indices[t * 3 + 1]] + vertScore[indices[t * 3 + 2]];
+		if (triScore[t] > bestScore)
+		{
+			bestScore = triScore[t];
+			bestTri = (int)t;
+		}
+	}
+
+	// LRU cache, three spare slots for the incoming triangle
+	int cache[CACHE_SIZE + 3], cacheCount = 0;
+
+	utArray<unsigned int> out;
+	out.resize(triCount * 3);
+
+	UTsize emitted = 0, cursor = 0;
+	while (emitted < triCount)
+	{
+		if (bestTri < 0)
+		{
+			// nothing touches the cache anymore, continue with the next unused triangle
+			while (triAdded[cursor])
+				++cursor;
+			bestTri = (int)cursor;
+		}
+
+		const unsigned int* tri = indices + bestTri * 3;
+		triAdded[bestTri] = true;
+		out[emitted * 3]     = tri[0];
+		out[emitted * 3 + 1] = tri[1];
+		out[emitted * 3 + 2] = tri[2];
+		++emitted;
+
+		int next[CACHE_SIZE + 3], nextCount = 0;
+		for (int k = 0; k < 3; ++k)
+		{
+			const unsigned int v = tri[k];
+			next[nextCount++] = (int)v;
+
+			// drop the triangle from the vertex' live list
+			int* adj = adjTris.ptr() + adjOffset[v];
+			const int live = liveTris[v];
+			for (int a = 0; a < live; ++a)
+			{
+				if (adj[a] == bestTri)
+				{
+					adj[a] = adj[live - 1];
+					break;
+				}
+			}
+			liveTris[v]--;
+		}
+
+		for (int c = 0; c < cacheCount; ++c)
+		{
+			const int v = cache[c];
+			if (v != (int)tri[0] && v != (int)tri[1] && v != (int)tri[2])
+				next[nextCount++] = v;
+		}
+
+		// rescore what is (or just fell out of) the cache
+		for (int c = 0; c < nextCount; ++c)
+		{
+			const int v = next[c];
+			cachePos[v] = c < CACHE_SIZE ? c : -1;
+
+			const gkScalar score = gkVertexScore(cachePos[v], liveTris[v]);
+			const gkScalar diff = score - vertScore[v];
+			vertScore[v] = score;
+
+			const int* adj = adjTris.ptr() + adjOffset[v];
+			for (int a = 0; a < liveTris[v]; ++a)
+				triScore[adj[a]] += diff;
+		}
+
+		cacheCount = gkMin(nextCount, (int)CACHE_SIZE);
+		memcpy(cache, next, cacheCount * sizeof(int));
+
+		bestTri = -1;
+		bestScore = -1.f;
+		for (int c = 0; c < cacheCount; ++c)
+		{
+			const int v = cache[c];
+			const int* adj = adjTris.ptr() + adjOffset[v];
+			for (int a = 0; a < liveTris[v]; ++a)
+			{
+				const int t = adj[a];
+				if (triScore[t] > bestScore)
+				{
+					bestScore = triScore[t];
+					bestTri = t;
+				}
+			}
+		}
+	}
+
+	memcpy(indices, out.ptr(), triCount * 3 * sizeof(unsigned int));
+}
+
+
+
+void gkMeshOptimizer::optimizeVertexFetch(unsigned int* indices, UTsize indexCount, UTsize vertexCount, Remap& remap)
+{
+	remap.resize(vertexCount);
+	for (UTsize v = 0; v < vertexCount; ++v)
+		remap[v] = UT_NPOS;
+
+	unsigned int next = 0;
+	for (UTsize i = 0; i < indexCount; ++i)
+	{
+		unsigned int& v = indices[i];
+		if (remap[v] == UT_NPOS)
+			remap[v] = next++;
+		v = remap[v];
+	}
+
+	for (UTsize v = 0; v < vertexCount; ++v)
+	{
+		if (remap[v] == UT_NPOS)
+			remap[v] = next++;
+	}
+}
+
+
+
+gkScalar gkMeshOptimizer::getACMR(const unsigned int* indices, UTsize indexCount, UTsize vertexCount, int cacheSize)
+{
+	const UTsize triCount = indexCount / 3;
+	if (triCount == 0)
+		return 0.f;
+
+	// FIFO, a vertex is in the cache while its timestamp is recent enough
+	utArray<UTsize> stamp;
+	stamp.resize(vertexCount, 0);
+
+	UTsize misses = 0;
+	for (UTsize i = 0; i < triCount * 3; ++i)
+	{
+		const unsigned int v = indices[i];
+		if (stamp[v] == 0 || misses - stamp[v] >= (UTsize)cacheSize)
+			stamp[v] = ++misses;
+	}
+
+	return (gkScalar)misses / (gkScalar)triCount;
+}
+
+
+
+
+// Plane error quadric, symmetric 4x4 stored as its upper triangle
+class gkQuadric
+{
+public:
+	double a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+
+	gkQuadric() : a2(0), ab(0), ac(0), ad(0), b2(0), bc(0), bd(0), c2(0), cd(0), d2(0) {}
+
+	void addPlane(double a, double b, double c, double d, double w)
+	{
+		a2 += a * a * w; ab += a * b * w; ac += a * c * w; ad += a * d * w;
+		b2 += b * b * w; bc += b * c * w; bd += b * d * w;
+		c2 += c * c * w; cd += c * d * w;
+		d2 += d * d * w;
+	}
+
+	void add(const gkQuadric& o)
+	{
+		a2 += o.a2; ab += o.ab; ac += o.ac; ad += o.ad;
+		b2 += o.b2; bc += o.bc; bd += o.bd;
+		c2 += o.c2; cd += o.cd;
+		d2 += o.d2;
+	}
+
+	double error(const gkVector3& v) const
+	{
+		const double x = v.x, y = v.y, z = v.z;
+		return x * x * a2 + 2 * x * y * ab + 2 * x * z * ac + 2 * x * ad
+		       + y * y * b2 + 2 * y * z * bc + 2 * y * bd
+		       + z * z * c2 + 2 * z * cd
+		       + d2;
+	}
+};
+
+
+
+// Welds vertices split only by their attributes
+class gkPositionKey
+{
+public:
+	gkPositionKey() {}
+	gkPositionKey(const gkVector3& v) : m_pos(v) {}
+
+	UThash hash(void) const
+	{
+		const unsigned char* p = reinterpret_cast<const unsigned char*>(&m_pos.x);
+		UThash h = 2166136261u;
+		for (size_t i = 0; i < sizeof(gkScalar) * 3; ++i)
+			h = (h ^ p[i]) * 16777619u;
+		return h;
+	}
+
+	bool operator== (const gkPositionKey& v) const {return m_pos == v.m_pos;}
+	bool operator!= (const gkPositionKey& v) const {return m_pos != v.m_pos;}
+
+private:
+	gkVector3 m_pos;
+};
+
+
+
+class gkEdgeKey
+{
+public:
+	gkEdgeKey() : m_a(0), m_b(0) {}
+	gkEdgeKey(unsigned int a, unsigned int b) : m_a(gkMin(a, b)), m_b(gkMax(a, b)) {}
+
+	UThash hash(void) const                     {return (UThash)(m_a * 2654435761u) ^ (UThash)m_b;}
+	bool operator== (const gkEdgeKey& v) const  {return m_a == v.m_a && m_b == v.m_b;}
+	bool operator!= (const gkEdgeKey& v) const  {return !(*this == v);}
+
+private:
+	unsigned int m_a, m_b;
+};
+
+
+
+struct gkCollapse
+{
+	unsigned int from, to;
+	double       cost;
+};
+
+
+
+static int gkCollapseCmp(const void* a, const void* b)
+{
+	const double ca = static_cast<const gkCollapse*>(a)->cost, cb = static_cast<const gkCollapse*>(b)->cost;
+	return ca < cb ? -1 : (ca > cb ? 1 : 0);
+}
+
+
+
+UTsize gkMeshOptimizer::simplify(unsigned int* dest, const unsigned int* indices, UTsize indexCount,
+                                 const gkVector3* positions, UTsize vertexCount, UTsize targetIndexCount)
+{
+	UTsize count = (indexCount / 3) * 3;
+	if (dest != indices)
+		memcpy(dest, indices, count * sizeof(unsigned int));
+
+	if (count <= targetIndexCount || vertexCount == 0)
+		return count;
+
+
+	// one id per distinct position
+	utArray<unsigned int> posId;
+	utArray<int> posUsers;
+	posId.resize(vertexCount);
+	{
+		utHashTable<gkPositionKey, unsigned int> weld;
+		for (UTsize v = 0; v < vertexCount; ++v)
+		{
+			const gkPositionKey key(positions[v]);
+			UTsize pos = weld.find(key);
+			if (pos == UT_NPOS)
+			{
+				posId[v] = (unsigned int)posUsers.size();
+				weld.insert(key, posId[v]);
+				posUsers.push_back(1);
+			}
+			else
+			{
+				posId[v] = weld.at(pos);
+				posUsers[posId[v]]++;
+			}
+		}
+	}
+
+	// seams and open borders keep their place
+	utArray<bool> locked;
+	locked.resize(vertexCount, false);
+	{
+		utHashTable<gkEdgeKey, int> edges;
+		for (UTsize i = 0; i < count; i += 3)
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				const gkEdgeKey key(posId[dest[i + k]], posId[dest[i + (k + 1) % 3]]);
+				UTsize pos = edges.find(key);
+				if (pos == UT_NPOS)
+					edges.insert(key, 1);
+				else
+					edges.at(pos)++;
+			}
+		}
+
+		for (UTsize i = 0; i < count; i += 3)
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				const unsigned int a = dest[i + k], b = dest[i + (k + 1) % 3];
+				if (*edges.get(gkEdgeKey(posId[a], posId[b])) != 2)
+					locked[a] = locked[b] = true;
+			}
+		}
+
+		for (UTsize v = 0; v < vertexCount; ++v)
+		{
+			if (posUsers[posId[v]] > 1)
+				locked[v] = true;
+		}
+	}
+
+
+	utArray<gkQuadric> quadrics;
+	quadrics.resize(vertexCount);
+	for (UTsize i = 0; i < count; i += 3)
+	{
+		const gkVector3& p0 = positions[dest[i]], &p1 = positions[dest[i + 1]], &p2 = positions[dest[i + 2]];
+		gkVector3 n = (p1 - p0).crossProduct(p2 - p0);
+		const gkScalar area = n.normalise();
+		if (area <= 0.f)
+			continue;
+
+		gkQuadric q;
+		q.addPlane(n.x, n.y, n.z, -n.dotProduct(p0), area);
+		quadrics[dest[i]].add(q);
+		quadrics[dest[i + 1]].add(q);
+		quadrics[dest[i + 2]].add(q);
+	}
+
+
+	utArray<int> adjOffset, adjTris, fill;
+	utArray<unsigned int> remap;
+	utArray<bool> touched;
+	utArray<gkCollapse> collapses;
+
+	adjOffset.resize(vertexCount + 1);
+	fill.resize(vertexCount);
+	remap.resize(vertexCount);
+	touched.resize(vertexCount);
+
+	while (count > targetIndexCount)
+	{
+		// triangles around each vertex
+		for (UTsize v = 0; v <= vertexCount; ++v)
+			adjOffset[v] = 0;
+		for (UTsize i = 0; i < count; ++i)
+			adjOffset[dest[i] + 1]++;
+		for (UTsize v = 0; v < vertexCount; ++v)
+		{
+			adjOffset[v + 1] += adjOffset[v];
+			fill[v] = 0;
+		}
+		adjTris.resize(count);
+		for (UTsize i = 0; i < count; ++i)
+			adjTris[adjOffset[dest[i]] + fill[dest[i]]++] = (int)(i / 3);
+
+
+		// cheapest neighbour to move each free vertex onto
+		collapses.clear(true);
+		for (UTsize v = 0; v < vertexCount; ++v)
+		{
+			remap[v] = (unsigned int)v;
+			touched[v] = false;
+
+			if (locked[v])
+				continue;
+
+			gkCollapse best;
+			best.from = (unsigned int)v;
+			best.to   = UT_NPOS;
+			best.cost = 0;
+
+			for (int a = adjOffset[v]; a < adjOffset[v + 1]; ++a)
+			{
+				const unsigned int* tri = dest + adjTris[a] * 3;
+				for (int k = 0; k < 3; ++k)
+				{
+					const unsigned int to = tri[k];
+					if (to == v)
+						continue;
+
+					gkQuadric q = quadrics[v];
+					q.add(quadrics[to]);
+					const double cost = q.error(positions[to]);
+					if (best.to == UT_NPOS || cost < best.cost)
+					{
+						best.to   = to;
+						best.cost = cost;
+					}
+				}
+			}
+
+			if (best.to != UT_NPOS)
+				collapses.push_back(best);
+		}
+
+		if (collapses.empty())
+			break;
+
+		qsort(collapses.ptr(), collapses.size(), sizeof(gkCollapse), gkCollapseCmp);
+
+
+		UTsize removed = 0, applied = 0;
+		const UTsize wanted = (count - targetIndexCount) / 3;
+
+		for (UTsize c = 0; c < collapses.size() && removed < wanted; ++c)
+		{
+			const unsigned int from = collapses[c].from, to = collapses[c].to;
+			if (touched[from] || touched[to])
+				continue;
+
+			// interior edges only, and no triangle may flip over
+			int shared = 0;
+			bool flips = false;
+			for (int a = adjOffset[from]; a < adjOffset[from + 1] && !flips; ++a)
+			{
+				const unsigned int* tri = dest + adjTris[a] * 3;
+				if (tri[0] == to || tri[1] == to || tri[2] == to)
+				{
+					++shared;
+					continue;
+				}
+
+				gkVector3 p[3], q[3];
+				for (int k = 0; k < 3; ++k)
+				{
+					p[k] = positions[tri[k]];
+					q[k] = tri[k] == from ? positions[to] : p[k];
+				}
+
+				// slivers count as flipped, their normal is noise
+				gkVector3 n0 = (p[1] - p[0]).crossProduct(p[2] - p[0]);
+				gkVector3 n1 = (q[1] - q[0]).crossProduct(q[2] - q[0]);
+				n0.normalise();
+				if (n1.normalise() <= 0.f || n0.dotProduct(n1) < 0.25f)
+					flips = true;
+			}
+
+			// never below the target
+			if (flips || shared != 2 || removed + shared > wanted)
+				continue;
+
+			remap[from] = to;
+			quadrics[to].add(quadrics[from]);
+			removed += shared;
+			++applied;
+
+			for (int a = adjOffset[from]; a < adjOffset[from + 1]; ++a)
+			{
+				const unsigned int* tri = dest + adjTris[a] * 3;
+				touched[tri[0]] = touched[tri[1]] = touched[tri[2]] = true;
+			}
+		}
+
+		if (applied == 0)
+			break;
+
+
+		// move collapsed corners and drop what became degenerate
+		UTsize write = 0;
+		for (UTsize i = 0; i < count; i += 3)
+		{
+			const unsigned int a = remap[dest[i]], b = remap[dest[i + 1]], c = remap[dest[i + 2]];
+			if (a == b || b == c || a == c)
+				continue;
+
+			dest[write++] = a;
+			dest[write++] = b;
+			dest[write++] = c;
+		}
+		count = write;
+	}
+
+	return count;
+}
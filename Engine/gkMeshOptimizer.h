@@ -0,0 +1,60 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _gkMeshOptimizer_h_
+#define _gkMeshOptimizer_h_
+
+#include "gkMathUtils.h"
+
+
+///Reorders triangle lists for the GPU vertex caches.
+class gkMeshOptimizer
+{
+public:
+	typedef utArray<unsigned int> Remap;
+
+	///Simulated post transform cache size used by the ordering.
+	static const int CACHE_SIZE = 32;
+
+	///Reorders whole triangles in place so recently used vertices get reused
+	///(Forsyth's linear-speed vertex cache optimisation).
+	static void optimizeVertexCache(unsigned int* indices, UTsize indexCount, UTsize vertexCount);
+
+	///Renumbers vertices in order of first use and rewrites the indices.
+	///remap[old] = new, unreferenced vertices are moved to the end.
+	static void optimizeVertexFetch(unsigned int* indices, UTsize indexCount, UTsize vertexCount, Remap& remap);
+
+	///Edge collapse decimation down to (not below) targetIndexCount indices. Vertices are
+	///only moved onto their neighbours so the result indexes the same vertex buffer.
+	///Borders and attribute seams are kept. Returns the index count written to dest.
+	static UTsize simplify(unsigned int* dest, const unsigned int* indices, UTsize indexCount,
+	                       const gkVector3* positions, UTsize vertexCount, UTsize targetIndexCount);
+
+	///Average transformed vertices per triangle with a FIFO cache of cacheSize.
+	static gkScalar getACMR(const unsigned int* indices, UTsize indexCount, UTsize vertexCount, int cacheSize);
+};
+
+#endif//_gkMeshOptimizer_h_
@@ -24,68 +24,395 @@
   3. This notice may not be removed or altered from any source distribution.
 -------------------------------------------------------------------------------
 */
-
 #include "gkMessageManager.h"
 
 
-gkMessageManager::Message& gkMessageManager::Message::operator = (const Message& m)
+const gkString& gkMessageManager::Message::getFrom(void) const
+{
+	return gkMessageManager::getSingleton().getName(m_from);
+}
+
+
+const gkString& gkMessageManager::Message::getTo(void) const
+{
+	return gkMessageManager::getSingleton().getName(m_to);
+}
+
+
+const gkString& gkMessageManager::Message::getSubject(void) const
+{
+	return gkMessageManager::getSingleton().getName(m_subject);
+}
+
+
+const char* gkMessageManager::Message::getBody(void) const
+{
+	return gkMessageManager::getSingleton().getBody(*this);
+}
+
+
+UTsize gkMessageManager::Message::getBodyLength(void) const
+{
+	return gkMessageManager::getSingleton().isLive(*this) ? m_bodyLen : 0;
+}
+
+
+gkMessageManager::GenericMessageListener::GenericMessageListener(const gkString& fromfilter, const gkString& tofilter, const gkString& subjectfilter)
+{
+	// empty filters need no manager, listeners may exist before the engine
+	if (!fromfilter.empty() || !tofilter.empty() || !subjectfilter.empty())
+	{
+		gkMessageManager& mgr = gkMessageManager::getSingleton();
+		m_fromId    = mgr.intern(fromfilter);
+		m_toId      = mgr.intern(tofilter);
+		m_subjectId = mgr.intern(subjectfilter);
+	}
+}
+
+
+void gkMessageManager::GenericMessageListener::setAcceptEmptyTo(bool accept)
+{
+	gkMessageManager* mgr = gkMessageManager::getSingletonPtr();
+	bool registered = mgr && mgr->hasListener(this);
+
+	if (registered) mgr->removeListener(this);
+	m_acceptEmptyTo = accept;
+	if (registered) mgr->addListener(this);
+}
+
+
+// a registered listener is indexed under its filters
+static void gkMessageListenerSetFilter(gkMessageManager::MessageListener* listener, gkMessageManager::Id& filter, const gkString& v)
+{
+	gkMessageManager& mgr = gkMessageManager::getSingleton();
+	bool registered = mgr.hasListener(listener);
+
+	if (registered) mgr.removeListener(listener);
+	filter = mgr.intern(v);
+	if (registered) mgr.addListener(listener);
+}
+
+
+void gkMessageManager::GenericMessageListener::setFromFilter(const gkString& v)
+{
+	gkMessageListenerSetFilter(this, m_fromId, v);
+}
+
+
+void gkMessageManager::GenericMessageListener::setToFilter(const gkString& v)
+{
+	gkMessageListenerSetFilter(this, m_toId, v);
+}
+
+
+void gkMessageManager::GenericMessageListener::setSubjectFilter(const gkString& v)
+{
+	gkMessageListenerSetFilter(this, m_subjectId, v);
+}
+
+
+const gkString& gkMessageManager::GenericMessageListener::getFromFilter(void) const
 {
-	m_from = m.m_from;
-	m_to = m.m_to;
-	m_subject = m.m_subject;
-	m_body = m.m_body;
-	return *this;
+	return gkMessageManager::getSingleton().getName(m_fromId);
+}
+
+
+const gkString& gkMessageManager::GenericMessageListener::getToFilter(void) const
+{
+	return gkMessageManager::getSingleton().getName(m_toId);
+}
+
+
+const gkString& gkMessageManager::GenericMessageListener::getSubjectFilter(void) const
+{
+	return gkMessageManager::getSingleton().getName(m_subjectId);
 }
 
 
 void gkMessageManager::GenericMessageListener::handleMessage(gkMessageManager::Message* message)
 {
-	if (!m_fromFilter.empty() && m_fromFilter.compare(message->m_from) != 0) return;
-	if ((!m_toFilter.empty() && m_toFilter.compare(message->m_to) != 0)
-			&& (m_acceptEmptyTo && !message->m_to.empty())) return;
-	if (!m_subjectFilter.empty() && m_subjectFilter.compare(message->m_subject) != 0) return;
+	gkMessageManager::getSingleton().retain(*message);
+	m_messages.push_back(*message);
+}
 
-	Message m = *message;
 
-	m_messages.push_back(m);
+void gkMessageManager::GenericMessageListener::emptyMessages()
+{
+	gkMessageManager* mgr = gkMessageManager::getSingletonPtr();
+	if (mgr)
+	{
+		for (UTsize i = 0; i < m_messages.size(); ++i)
+			mgr->release(m_messages[i]);
+	}
+	m_messages.resize(0);
+}
+
+
+void gkMessageManager::GenericMessageListener::takeMessages(utArray<Message>& out)
+{
+	for (UTsize i = 0; i < m_messages.size(); ++i)
+		out.push_back(m_messages[i]);
+	m_messages.resize(0);
 }
 
 
 gkMessageManager::gkMessageManager()
+	:	m_tick(1)
 {
+	m_names.push_back(new gkString());
+	m_topics.push_back(new Topic());
 
+	Arena* arena = new Arena();
+	arena->m_tick = m_tick;
+	arena->m_refs = 0;
+	m_arenas.push_back(arena);
+}
+
+
+gkMessageManager::~gkMessageManager()
+{
+	UTsize i;
+	for (i = 0; i < m_names.size(); ++i)
+	{
+		delete m_names[i];
+		delete m_topics[i];
+	}
+
+	for (i = 0; i < m_arenas.size(); ++i)
+		delete m_arenas[i];
+	for (i = 0; i < m_free.size(); ++i)
+		delete m_free[i];
+}
+
+
+gkMessageManager::Id gkMessageManager::intern(const gkString& name)
+{
+	if (name.empty())
+		return 0;
+
+	gkCriticalSection::Lock guard(m_nameLock);
+
+	Id* found = m_ids.get(utCharHashKey(name.c_str()));
+	if (found)
+		return *found;
+
+	// heap strings keep the hash keys valid as the table grows
+	gkString* str = new gkString(name);
+	Id id = (Id)m_names.size();
+
+	m_names.push_back(str);
+	m_topics.push_back(new Topic());
+	m_ids.insert(utCharHashKey(str->c_str()), id);
+	return id;
+}
+
+
+const gkString& gkMessageManager::getName(Id id) const
+{
+	// the strings themselves never move
+	gkCriticalSection::Lock guard(m_nameLock);
+	return id < m_names.size() ? *m_names[id] : *m_names[0];
+}
+
+
+gkMessageManager::Topic* gkMessageManager::getTopic(Id id) const
+{
+	gkCriticalSection::Lock guard(m_nameLock);
+	return m_topics[id];
+}
+
+
+gkMessageManager::Arena* gkMessageManager::findArena(UTuint32 tick) const
+{
+	// a handful at most, recent ones are asked for the most
+	for (UTsize i = m_arenas.size(); i > 0; --i)
+	{
+		if (m_arenas[i - 1]->m_tick == tick)
+			return m_arenas[i - 1];
+	}
+	return 0;
+}
+
+
+const char* gkMessageManager::getBody(const Message& message) const
+{
+	Arena* arena = message.m_bodyLen ? findArena(message.m_tick) : 0;
+	if (!arena)
+		return "";
+
+	return arena->m_data.ptr() + message.m_body;
+}
+
+
+void gkMessageManager::retain(const Message& message)
+{
+	Arena* arena = findArena(message.m_tick);
+	if (arena)
+	{
+		gkCriticalSection::Lock guard(m_refLock);
+		++arena->m_refs;
+	}
+}
+
+
+void gkMessageManager::release(const Message& message)
+{
+	Arena* arena = findArena(message.m_tick);
+	if (arena)
+	{
+		gkCriticalSection::Lock guard(m_refLock);
+		GK_ASSERT(arena->m_refs > 0);
+		--arena->m_refs;
+	}
+}
+
+
+void gkMessageManager::indexListener(MessageListener* listener)
+{
+	// a recipient filter without m_acceptEmptyTo takes anything, see deliver
+	if (listener->m_subjectId)
+		getTopic(listener->m_subjectId)->m_subject.push_back(listener);
+	else if (listener->m_toId && listener->m_acceptEmptyTo)
+	{
+		getTopic(listener->m_toId)->m_to.push_back(listener);
+		m_emptyTo.push_back(listener);
+	}
+	else
+		m_any.push_back(listener);
+}
+
+
+void gkMessageManager::unindexListener(MessageListener* listener)
+{
+	if (listener->m_subjectId)
+		getTopic(listener->m_subjectId)->m_subject.erase(listener);
+	else if (listener->m_toId && listener->m_acceptEmptyTo)
+	{
+		getTopic(listener->m_toId)->m_to.erase(listener);
+		m_emptyTo.erase(listener);
+	}
+	else
+		m_any.erase(listener);
 }
 
 
 void gkMessageManager::addListener(MessageListener* listener)
 {
 	if ( m_listeners.find(listener) == UT_NPOS)
+	{
 		m_listeners.push_back(listener);
+		indexListener(listener);
+	}
 }
 
 
 void gkMessageManager::removeListener(MessageListener* listener)
 {
-	m_listeners.erase(listener);
+	if (m_listeners.find(listener) != UT_NPOS)
+	{
+		m_listeners.erase(listener);
+		unindexListener(listener);
+	}
+}
+
+
+void gkMessageManager::deliver(Listeners& listeners, Message* message)
+{
+	for (UTsize i = 0; i < listeners.size(); ++i)
+	{
+		MessageListener* listener = listeners[i];
+
+		if (listener->m_fromId && listener->m_fromId != message->m_from)
+			continue;
+		// the string filters' rule: only a recipient filter accepting
+		// empty recipients turns messages to someone else away
+		if (listener->m_toId && listener->m_toId != message->m_to && listener->m_acceptEmptyTo && message->m_to)
+			continue;
+		if (listener->m_subjectId && listener->m_subjectId != message->m_subject)
+			continue;
+
+		listener->handleMessage(message);
+	}
+}
+
+
+void gkMessageManager::sendMessage(const gkString& from, const gkString& to, const gkString& subject, const gkString& body)
+{
+	sendMessage(intern(from), intern(to), intern(subject), body.c_str(), body.size());
 }
 
 
-void gkMessageManager::sendMessage(gkString from, gkString to, gkString subject, gkString body)
+void gkMessageManager::sendMessage(Id from, Id to, Id subject, const char* body, UTsize len)
 {
-	Message* m = new Message();
-	m->m_from = from;
-	m->m_to = to;
-	m->m_subject = subject;
-	m->m_body = body;
+	utArray<char>& arena = m_arenas.back()->m_data;
+
+	Message m;
+	m.m_from    = from;
+	m.m_to      = to;
+	m.m_subject = subject;
+	m.m_tick    = m_tick;
+	m.m_body    = (UTuint32)arena.size();
+	m.m_bodyLen = (UTuint32)len;
+
+	if (len > 0)
+	{
+		UTsize need = arena.size() + len + 1;
+		if (need > arena.capacity())
+			arena.reserve(need > arena.capacity() * 2 ? need : arena.capacity() * 2);
+
+		arena.resize(need);
+		memcpy(arena.ptr() + m.m_body, body, len);
+		arena[need - 1] = 0;
+	}
+
+	// listeners keep copies of the ids, handlers may send and grow the arena
+	if (subject)
+		deliver(getTopic(subject)->m_subject, &m);
+
+	if (to)
+		deliver(getTopic(to)->m_to, &m);
+	else
+		deliver(m_emptyTo, &m);
+
+	deliver(m_any, &m);
+}
+
+
+void gkMessageManager::beginTick(void)
+{
+	++m_tick;
+
+	gkCriticalSection::Lock guard(m_refLock);
+
+	// bodies outlive their tick by one for listeners reading them in
+	// place, then stay as long as a retained copy refers to them
+	UTsize i, live = 0;
+	for (i = 0; i < m_arenas.size(); ++i)
+	{
+		Arena* arena = m_arenas[i];
+		if (arena->m_tick + 1 < m_tick && arena->m_refs == 0)
+		{
+			// keeps the capacity, nothing is allocated in steady state
+			arena->m_data.resize(0);
+			m_free.push_back(arena);
+		}
+		else
+			m_arenas[live++] = arena;
+	}
+	m_arenas.resize(live);
 
-	utArrayIterator<utArray<MessageListener*> > iter(m_listeners);
-	while (iter.hasMoreElements())
+	Arena* arena;
+	if (!m_free.empty())
 	{
-		iter.peekNext()->handleMessage(m);
-		iter.getNext();
+		arena = m_free.back();
+		m_free.pop_back();
 	}
+	else
+		arena = new Arena();
 
-	delete m;
+	arena->m_tick = m_tick;
+	arena->m_refs = 0;
+	m_arenas.push_back(arena);
 }
 
 UT_IMPLEMENT_SINGLETON(gkMessageManager);
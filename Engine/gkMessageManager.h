@@ -24,30 +24,50 @@
   3. This notice may not be removed or altered from any source distribution.
 -------------------------------------------------------------------------------
 */
-
 #ifndef _gkMessageManager_h_
 #define _gkMessageManager_h_
 
 #include "gkCommon.h"
 #include "utSingleton.h"
+#include "Thread/gkCriticalSection.h"
 
 class gkMessageManager : public utSingleton<gkMessageManager>
 {
 public:
 
+	// Interned from / to / subject name, 0 is the empty name
+	typedef UTuint32 Id;
+
+	// Bodies live in a per tick arena, names and body resolve through
+	// the manager. Copies are plain ids, the body stays readable during
+	// the tick it was sent in and the one after, or for as long as a
+	// retained copy refers to it (see retain / release).
 	struct Message
 	{
-		gkString m_from;
-		gkString m_to;
-		gkString m_subject;
-		gkString m_body;
-
-		Message& operator = (const Message& m);
+		Id       m_from;
+		Id       m_to;
+		Id       m_subject;
+		UTuint32 m_tick;
+		UTuint32 m_body;
+		UTuint32 m_bodyLen;
+
+		const gkString& getFrom(void) const;
+		const gkString& getTo(void) const;
+		const gkString& getSubject(void) const;
+		const char*     getBody(void) const;
+		UTsize          getBodyLength(void) const;
 	};
 
+	// Only sees messages passing its filters, a 0 filter accepts any.
+	// As before the ids, a recipient filter only applies together with
+	// m_acceptEmptyTo, which then also lets messages without a recipient
+	// through. Without it the listener takes messages to anyone.
 	struct    MessageListener
 	{
-		MessageListener() {}
+		Id   m_fromId, m_toId, m_subjectId;
+		bool m_acceptEmptyTo;
+
+		MessageListener() : m_fromId(0), m_toId(0), m_subjectId(0), m_acceptEmptyTo(false) {}
 		virtual ~MessageListener() {}
 
 		virtual void handleMessage(gkMessageManager::Message* message) = 0;
@@ -55,32 +75,95 @@ public:
 
 	struct GenericMessageListener : public MessageListener
 	{
-		gkString m_fromFilter, m_toFilter, m_subjectFilter;
-		bool m_acceptEmptyTo;
 		utArray<Message> m_messages;
 
-		GenericMessageListener(gkString fromfilter = "", gkString tofilter = "", gkString subjectfilter = "")
-			:    m_fromFilter(fromfilter), m_toFilter(tofilter), m_subjectFilter(subjectfilter), m_acceptEmptyTo(false) {}
+		GenericMessageListener(const gkString& fromfilter = "", const gkString& tofilter = "", const gkString& subjectfilter = "");
+		~GenericMessageListener() {emptyMessages();}
 
-		void setAcceptEmptyTo(bool accept){this->m_acceptEmptyTo=accept;}
+		void setAcceptEmptyTo(bool accept);
 		bool isAcceptingEmptyTo(){return this->m_acceptEmptyTo;}
 
-		~GenericMessageListener() {m_messages.clear();}
+		// Filters by name, set ones re-index a registered listener
+		void setFromFilter(const gkString& v);
+		void setToFilter(const gkString& v);
+		void setSubjectFilter(const gkString& v);
 
+		const gkString& getFromFilter(void) const;
+		const gkString& getToFilter(void) const;
+		const gkString& getSubjectFilter(void) const;
+
+		// Keeps a retained copy, its body stays until emptyMessages / takeMessages
 		void handleMessage(gkMessageManager::Message* message);
-		void emptyMessages() {m_messages.clear();}
+		void emptyMessages();
+
+		// Moves the retained copies to out, the caller releases them
+		void takeMessages(utArray<Message>& out);
 	};
 
 private:
-	utArray<MessageListener*> m_listeners;
+	typedef utArray<MessageListener*> Listeners;
+
+	// listeners indexed by the name they filter on
+	struct Topic
+	{
+		Listeners m_subject;
+		Listeners m_to;
+	};
+
+	// names are interned from logic workers too (scripts, sensors)
+	utArray<gkString*>               m_names;
+	utHashTable<utCharHashKey, Id>   m_ids;
+	utArray<Topic*>                  m_topics;
+	mutable gkCriticalSection        m_nameLock;
+
+	Listeners m_listeners;
+	Listeners m_emptyTo;   // to-indexed listeners also taking messages without a recipient
+	Listeners m_any;       // no subject or recipient filter
+
+	// 0 terminated bodies sent during one tick
+	struct Arena
+	{
+		utArray<char> m_data;
+		UTuint32      m_tick;
+		UTsize        m_refs;   // retained copies
+	};
+
+	utArray<Arena*>   m_arenas;   // live ones, the last takes this tick's bodies
+	utArray<Arena*>   m_free;     // recycled with their capacity
+	UTuint32          m_tick;
+	gkCriticalSection m_refLock;  // sensors release copies from logic workers
+
+	Arena* findArena(UTuint32 tick) const;
+	Topic* getTopic(Id id) const;
+
+	void indexListener(MessageListener* listener);
+	void unindexListener(MessageListener* listener);
+	void deliver(Listeners& listeners, Message* message);
 
 public:
 	gkMessageManager();
-	virtual ~gkMessageManager() {}
+	virtual ~gkMessageManager();
+
+	// Thread safe, names are never dropped
+	Id intern(const gkString& name);
+	const gkString& getName(Id id) const;
 
 	void addListener(MessageListener* listener);
 	void removeListener(MessageListener* listener);
-	void sendMessage(gkString from, gkString to, gkString subject, gkString body);
+	bool hasListener(MessageListener* listener) {return m_listeners.find(listener) != UT_NPOS;}
+
+	void sendMessage(const gkString& from, const gkString& to, const gkString& subject, const gkString& body);
+	void sendMessage(Id from, Id to, Id subject, const char* body, UTsize len);
+
+	// Starts a new arena, drops bodies older than the last tick no copy retains
+	void beginTick(void);
+
+	// A retained copy keeps its body readable until it is released
+	void retain(const Message& message);
+	void release(const Message& message);
+
+	GK_INLINE bool isLive(const Message& message) const {return findArena(message.m_tick) != 0;}
+	const char* getBody(const Message& message) const;
 
 	UT_DECLARE_SINGLETON(gkMessageManager);
 };
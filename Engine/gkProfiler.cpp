@@ -0,0 +1,482 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "gkProfiler.h"
+#include "gkLogger.h"
+#include "OgreTimer.h"
+#include <stdio.h>
+
+
+#if UT_COMPILER == UT_COMPILER_MSVC
+# define GK_PROFILER_THREAD_LOCAL __declspec(thread)
+#else
+# define GK_PROFILER_THREAD_LOCAL __thread
+#endif
+
+// Upper bound of recorded events per thread while capturing (~16MB).
+#define GK_PROFILER_MAX_TRACE (1 << 20)
+
+
+static GK_PROFILER_THREAD_LOCAL void*  gkProfilerThreadState  = 0;
+static GK_PROFILER_THREAD_LOCAL UTsize gkProfilerThreadSerial = 0;
+static UTsize gkProfilerSerial = 0;
+
+
+// zone names are shared by every profiler instance, ids stay valid
+// for the cached statics of GK_PROFILE
+static gkCriticalSection& gkProfilerZoneLock(void)
+{
+	static gkCriticalSection cs;
+	return cs;
+}
+
+static utArray<gkString>& gkProfilerZoneNames(void)
+{
+	static utArray<gkString> names;
+	return names;
+}
+
+static utHashTable<gkHashedString, gkProfiler::ZoneId>& gkProfilerZoneMap(void)
+{
+	static utHashTable<gkHashedString, gkProfiler::ZoneId> zones;
+	return zones;
+}
+
+
+
+gkProfiler::gkProfiler(UTsize window)
+	:	m_clock(0),
+		m_serial(++gkProfilerSerial),
+		m_threadCount(0),
+		m_window(window > 0 ? window : 1),
+		m_cursor(0),
+		m_frames(0),
+		m_enabled(true),
+		m_enabledNext(true),
+		m_capture(false),
+		m_detailed(false),
+		m_frameStart(0),
+		m_lastTotal(0)
+{
+	m_clock = new Ogre::Timer();
+
+	setThreadName("Main");
+}
+
+
+
+gkProfiler::~gkProfiler()
+{
+	UTsize i;
+	for (i = 0; i < m_threads.size(); ++i)
+		delete m_threads[i];
+	m_threads.clear();
+
+	delete m_clock;
+}
+
+
+
+gkProfiler::ZoneId gkProfiler::registerZone(const gkString& name)
+{
+	gkCriticalSection::Lock lock(gkProfilerZoneLock());
+
+	utHashTable<gkHashedString, ZoneId>& zones = gkProfilerZoneMap();
+
+	ZoneId* zone = zones.get(name);
+	if (zone)
+		return *zone;
+
+	utArray<gkString>& names = gkProfilerZoneNames();
+
+	ZoneId id = names.size();
+	names.push_back(name);
+	zones.insert(name, id);
+	return id;
+}
+
+
+
+gkString gkProfiler::getZoneName(ZoneId zone)
+{
+	gkCriticalSection::Lock lock(gkProfilerZoneLock());
+
+	utArray<gkString>& names = gkProfilerZoneNames();
+	return zone < names.size() ? names[zone] : gkString("");
+}
+
+
+
+gkProfiler::ThreadState* gkProfiler::getThreadState(void)
+{
+	if (gkProfilerThreadSerial == m_serial)
+		return static_cast<ThreadState*>(gkProfilerThreadState);
+
+	ThreadState* state = new ThreadState();
+	state->current = createNode(state, UT_NPOS, UT_NPOS);
+
+	{
+		gkCriticalSection::Lock lock(m_cs);
+		state->index = m_threadCount++;
+		state->name  = "Thread " + Ogre::StringConverter::toString(state->index);
+		m_threads.push_back(state);
+	}
+
+	gkProfilerThreadState  = state;
+	gkProfilerThreadSerial = m_serial;
+	return state;
+}
+
+
+
+UTsize gkProfiler::createNode(ThreadState* state, ZoneId zone, UTsize parent)
+{
+	UTsize index = state->nodes.size();
+
+	state->nodes.push_back(Node());
+
+	Node& node     = state->nodes.back();
+	node.zone      = zone;
+	node.parent    = parent;
+	node.start     = 0;
+	node.frame     = 0;
+	node.calls     = 0;
+	node.last      = 0;
+	node.lastCalls = 0;
+	node.samples   = 0;
+	node.history.resize(m_window, 0);
+
+	if (parent != UT_NPOS)
+	{
+		state->nodes[parent].children.push_back(index);
+		state->lookup.insert(NodeKey(parent, zone), index);
+	}
+	return index;
+}
+
+
+
+void gkProfiler::begin(ZoneId zone)
+{
+	if (!m_enabled)
+		return;
+
+	ThreadState* state = getThreadState();
+
+	UTsize* found = state->lookup.get(NodeKey(state->current, zone));
+	UTsize child  = found ? *found : createNode(state, zone, state->current);
+
+	state->current = child;
+	state->nodes[child].start = m_clock->getMicroseconds();
+}
+
+
+
+void gkProfiler::end(void)
+{
+	if (!m_enabled)
+		return;
+
+	unsigned long now = m_clock->getMicroseconds();
+
+	ThreadState* state = getThreadState();
+
+	Node& node = state->nodes[state->current];
+	if (node.parent == UT_NPOS)
+	{
+		// unbalanced end
+		return;
+	}
+
+	unsigned long duration = now - node.start;
+	node.frame += duration;
+	node.calls++;
+
+	if (m_capture && state->trace.size() < GK_PROFILER_MAX_TRACE)
+	{
+		TraceEvent ev;
+		ev.zone     = node.zone;
+		ev.start    = node.start;
+		ev.duration = duration;
+		state->trace.push_back(ev);
+	}
+
+	state->current = node.parent;
+}
+
+
+
+void gkProfiler::setThreadName(const gkString& name)
+{
+	ThreadState* state = getThreadState();
+
+	gkCriticalSection::Lock lock(m_cs);
+	state->name = name;
+}
+
+
+
+void gkProfiler::releaseThread(void)
+{
+	if (gkProfilerThreadSerial != m_serial)
+		return;
+
+	ThreadState* state = static_cast<ThreadState*>(gkProfilerThreadState);
+
+	{
+		gkCriticalSection::Lock lock(m_cs);
+		m_threads.erase(m_threads.find(state));
+	}
+
+	delete state;
+
+	gkProfilerThreadState  = 0;
+	gkProfilerThreadSerial = 0;
+}
+
+
+
+void gkProfiler::nextFrame(void)
+{
+	gkCriticalSection::Lock lock(m_cs);
+
+	UTsize i, j;
+	for (i = 0; i < m_threads.size(); ++i)
+	{
+		ThreadState* state = m_threads[i];
+
+		for (j = 0; j < state->nodes.size(); ++j)
+		{
+			Node& node = state->nodes[j];
+
+			node.history[m_cursor] = node.frame;
+			if (node.samples < m_window)
+				++node.samples;
+
+			node.last      = node.frame;
+			node.lastCalls = node.calls;
+			node.frame     = 0;
+			node.calls     = 0;
+		}
+	}
+
+	m_cursor = (m_cursor + 1) % m_window;
+	++m_frames;
+
+	unsigned long now = m_clock->getMicroseconds();
+	m_lastTotal  = now - m_frameStart;
+	m_frameStart = now;
+
+	m_enabled = m_enabledNext;
+}
+
+
+
+void gkProfiler::setCapture(bool v)
+{
+	gkCriticalSection::Lock lock(m_cs);
+
+	if (v && !m_capture)
+	{
+		for (UTsize i = 0; i < m_threads.size(); ++i)
+			m_threads[i]->trace.clear();
+	}
+	m_capture = v;
+}
+
+
+
+static void gkProfilerWriteJsonString(FILE* fp, const gkString& str)
+{
+	fputc('"', fp);
+	for (UTsize i = 0; i < str.size(); ++i)
+	{
+		char c = str[i];
+		if (c == '"' || c == '\\')
+			fputc('\\', fp);
+		if ((unsigned char)c >= 0x20)
+			fputc(c, fp);
+	}
+	fputc('"', fp);
+}
+
+
+
+bool gkProfiler::exportTrace(const gkString& fileName)
+{
+	FILE* fp = fopen(fileName.c_str(), "wb");
+	if (!fp)
+	{
+		gkPrintf("Profiler: cannot write trace '%s'.\n", fileName.c_str());
+		return false;
+	}
+
+	gkCriticalSection::Lock lock(m_cs);
+
+	fprintf(fp, "{\"traceEvents\":[\n");
+
+	bool first = true;
+	UTsize i, j;
+	for (i = 0; i < m_threads.size(); ++i)
+	{
+		const ThreadState* state = m_threads[i];
+
+		fprintf(fp, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+		        first ? "" : ",\n", (unsigned int)state->index);
+		gkProfilerWriteJsonString(fp, state->name);
+		fprintf(fp, "}}");
+		first = false;
+
+		for (j = 0; j < state->trace.size(); ++j)
+		{
+			const TraceEvent& ev = state->trace[j];
+
+			fprintf(fp, ",\n{\"name\":");
+			gkProfilerWriteJsonString(fp, getZoneName(ev.zone));
+			fprintf(fp, ",\"cat\":\"gk\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%lu,\"dur\":%lu}",
+			        (unsigned int)state->index, ev.start, ev.duration);
+		}
+	}
+
+	fprintf(fp, "\n],\"displayTimeUnit\":\"ms\"}\n");
+	fclose(fp);
+	return true;
+}
+
+
+
+unsigned long gkProfiler::getLastMicroSeconds(const gkString& name)
+{
+	ZoneId zone = registerZone(name);
+
+	gkCriticalSection::Lock lock(m_cs);
+
+	unsigned long total = 0;
+
+	UTsize i, j;
+	for (i = 0; i < m_threads.size(); ++i)
+	{
+		const ThreadState* state = m_threads[i];
+		for (j = 0; j < state->nodes.size(); ++j)
+		{
+			if (state->nodes[j].zone == zone)
+				total += state->nodes[j].last;
+		}
+	}
+	return total;
+}
+
+
+
+void gkProfiler::collectStats(const ThreadState* state, UTsize index, int depth, StatsArray& out) const
+{
+	const Node& node = state->nodes[index];
+
+	if (node.zone != UT_NPOS)
+	{
+		Stats st;
+		st.name   = getZoneName(node.zone);
+		st.thread = state->index;
+		st.depth  = depth;
+		st.calls  = node.lastCalls;
+		st.last   = node.last;
+		st.min    = 0;
+		st.avg    = 0;
+		st.max    = 0;
+
+		if (node.samples > 0)
+		{
+			unsigned long sum = 0;
+			st.min = (unsigned long)-1;
+
+			// walk back from the newest sample
+			for (UTsize k = 0; k < node.samples; ++k)
+			{
+				unsigned long v = node.history[(m_cursor + m_window - 1 - k) % m_window];
+				sum += v;
+				if (v < st.min) st.min = v;
+				if (v > st.max) st.max = v;
+			}
+			st.avg = sum / node.samples;
+		}
+
+		out.push_back(st);
+		++depth;
+	}
+
+	for (UTsize i = 0; i < node.children.size(); ++i)
+		collectStats(state, node.children[i], depth, out);
+}
+
+
+
+void gkProfiler::getStats(StatsArray& out)
+{
+	out.clear();
+
+	gkCriticalSection::Lock lock(m_cs);
+
+	for (UTsize i = 0; i < m_threads.size(); ++i)
+		collectStats(m_threads[i], 0, 0, out);
+}
+
+
+
+gkString gkProfiler::getReport(void)
+{
+	StatsArray stats;
+	getStats(stats);
+
+	gkString report = "Zone                                      calls    last     min     avg     max (us)\n";
+
+	UTsize thread = UT_NPOS;
+	for (UTsize i = 0; i < stats.size(); ++i)
+	{
+		const Stats& st = stats[i];
+
+		if (st.thread != thread)
+		{
+			thread = st.thread;
+
+			gkCriticalSection::Lock lock(m_cs);
+			for (UTsize j = 0; j < m_threads.size(); ++j)
+			{
+				if (m_threads[j]->index == thread)
+					report += "[" + m_threads[j]->name + "]\n";
+			}
+		}
+
+		char buf[256];
+		gkString name = gkString(st.depth * 2, ' ') + st.name;
+		sprintf(buf, "%-40.40s %7u %7lu %7lu %7lu %7lu\n", name.c_str(),
+		        (unsigned int)st.calls, st.last, st.min, st.avg, st.max);
+		report += buf;
+	}
+	return report;
+}
+
+
+UT_IMPLEMENT_SINGLETON(gkProfiler);
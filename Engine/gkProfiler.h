@@ -0,0 +1,219 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _gkProfiler_h_
+#define _gkProfiler_h_
+
+#include "gkCommon.h"
+#include "utSingleton.h"
+#include "Thread/gkCriticalSection.h"
+
+namespace Ogre
+{
+class Timer;
+}
+
+
+///Nestable per-frame profiler.
+///
+///Zones are timed with begin() / end() pairs (or a GK_PROFILE scope) from
+///any thread. Each thread keeps its own zone tree, so the same zone name
+///appears once per call path. nextFrame() rolls the frame totals into a
+///window of the last frames, from which min / avg / max are reported.
+///While capturing, every zone instance is also recorded and can be
+///exported as Chrome trace-event JSON (chrome://tracing).
+class gkProfiler : public utSingleton<gkProfiler>
+{
+public:
+	typedef UTsize ZoneId;
+
+	struct Stats
+	{
+		gkString        name;
+		UTsize          thread;
+		int             depth;
+		UTsize          calls;      // calls last frame
+		unsigned long   last;       // microseconds, last frame
+		unsigned long   min;        // microseconds over the window
+		unsigned long   avg;
+		unsigned long   max;
+	};
+
+	typedef utArray<Stats> StatsArray;
+
+private:
+
+	struct Node
+	{
+		ZoneId                  zone;
+		UTsize                  parent;
+		utArray<UTsize>         children;
+		unsigned long           start;
+		unsigned long           frame;
+		UTsize                  calls;
+		unsigned long           last;
+		UTsize                  lastCalls;
+		UTsize                  samples;
+		utArray<unsigned long>  history;
+	};
+
+	// child of parent timing zone, one per call path
+	class NodeKey
+	{
+	public:
+		NodeKey() : m_parent(0), m_zone(0) {}
+		NodeKey(UTsize parent, ZoneId zone) : m_parent(parent), m_zone(zone) {}
+
+		GK_INLINE UThash hash(void) const { return ((UThash)m_parent * 0x8DA6B343) ^ ((UThash)m_zone * 0xD8163841); }
+
+		GK_INLINE bool operator== (const NodeKey& v) const { return m_parent == v.m_parent && m_zone == v.m_zone; }
+		GK_INLINE bool operator!= (const NodeKey& v) const { return !(*this == v); }
+
+		UTsize m_parent;
+		ZoneId m_zone;
+	};
+
+	struct TraceEvent
+	{
+		ZoneId          zone;
+		unsigned long   start;
+		unsigned long   duration;
+	};
+
+	struct ThreadState
+	{
+		UTsize              index;
+		gkString            name;
+		utArray<Node>       nodes;
+		utHashTable<NodeKey, UTsize> lookup;
+		UTsize              current;
+		utArray<TraceEvent> trace;
+	};
+
+	Ogre::Timer*            m_clock;
+	utArray<ThreadState*>   m_threads;
+	gkCriticalSection       m_cs;
+	UTsize                  m_serial;
+	UTsize                  m_threadCount;
+	UTsize                  m_window;
+	UTsize                  m_cursor;
+	UTsize                  m_frames;
+	bool                    m_enabled;
+	bool                    m_enabledNext;
+	bool                    m_capture;
+	bool                    m_detailed;
+	unsigned long           m_frameStart;
+	unsigned long           m_lastTotal;
+
+	ThreadState* getThreadState(void);
+	UTsize       createNode(ThreadState* state, ZoneId zone, UTsize parent);
+	void         collectStats(const ThreadState* state, UTsize node, int depth, StatsArray& out) const;
+
+public:
+
+	gkProfiler(UTsize window = 120);
+	~gkProfiler();
+
+	// Interned process wide, the same name always maps to the same zone.
+	static ZoneId registerZone(const gkString& name);
+	static gkString getZoneName(ZoneId zone);
+
+	void begin(ZoneId zone);
+	void begin(const gkString& name) { begin(registerZone(name)); }
+	void end(void);
+
+	// Names the calling thread in reports and traces.
+	void setThreadName(const gkString& name);
+
+	// Drops the calling thread's zones and trace, call before the thread exits.
+	void releaseThread(void);
+
+	// Closes the frame, call from the main thread while workers are idle.
+	void nextFrame(void);
+
+	// Takes effect on the next frame so open zones stay balanced.
+	void setEnabled(bool v)     { m_enabledNext = v; }
+	bool isEnabled(void) const  { return m_enabled; }
+
+	// Fine grained zones, one per authored logic brick. Off by default.
+	void setDetailed(bool v)     { m_detailed = v; }
+	bool isDetailed(void) const  { return m_detailed; }
+
+	// Record every zone instance for exportTrace.
+	void setCapture(bool v);
+	bool isCapturing(void) const { return m_capture; }
+	bool exportTrace(const gkString& fileName);
+
+	// Summed over every call path and thread.
+	unsigned long getLastMicroSeconds(const gkString& name);
+	unsigned long getLastTotalMicroSeconds(void) const { return m_lastTotal; }
+
+	void getStats(StatsArray& out);
+	gkString getReport(void);
+
+	UT_DECLARE_SINGLETON(gkProfiler);
+};
+
+
+class gkProfileScope
+{
+private:
+	gkProfiler* m_profiler;
+
+public:
+	// UT_NPOS times nothing
+	gkProfileScope(gkProfiler::ZoneId zone)
+		:	m_profiler(zone != UT_NPOS ? gkProfiler::getSingletonPtr() : 0)
+	{
+		if (m_profiler) m_profiler->begin(zone);
+	}
+
+	gkProfileScope(const gkString& name)
+		:	m_profiler(gkProfiler::getSingletonPtr())
+	{
+		if (m_profiler) m_profiler->begin(name);
+	}
+
+	~gkProfileScope()
+	{
+		if (m_profiler) m_profiler->end();
+	}
+};
+
+
+#define GK_PROFILE_CAT(a, b)    a##b
+#define GK_PROFILE_NAME(a, b)   GK_PROFILE_CAT(a, b)
+
+// Times the enclosing scope, name must be a constant string.
+#define GK_PROFILE(name) \
+	static const gkProfiler::ZoneId GK_PROFILE_NAME(gkProfileZone_, __LINE__) = gkProfiler::registerZone(name); \
+	gkProfileScope GK_PROFILE_NAME(gkProfileScope_, __LINE__)(GK_PROFILE_NAME(gkProfileZone_, __LINE__))
+
+// Times the enclosing scope with a zone id, for names built at runtime.
+#define GK_PROFILE_ZONE(zone) \
+	gkProfileScope GK_PROFILE_NAME(gkProfileScope_, __LINE__)(zone)
+
+#endif//_gkProfiler_h_
@@ -33,7 +33,7 @@ class gkResource
 {
 protected:
 	gkResourceManager*		m_creator;
-	const gkResourceName	m_name;	
+	gkResourceName			m_name;	// only renamed while not registered by name
 	const gkResourceHandle	m_resourceHandle;	
 
 	friend class gkResourceManager;
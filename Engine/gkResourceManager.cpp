@@ -48,22 +48,18 @@ gkResourceManager::~gkResourceManager()
 
 gkResource* gkResourceManager::getByName(const gkResourceName& name)
 {
-	gkResource* obCan = 0;
-	Resources::Iterator iter = m_resources.iterator();
-	while (iter.hasMoreElements())
-	{
-		gkResource* ob = iter.peekNextValue();
-		if (ob->getResourceName().isNameEqual(name))
-		{
-			if (ob->getResourceName().isGroupEqual(name))
-				return ob;
-			else if (name.isGroupEmpty())
-				obCan = ob;
-		}
+	UTsize pos;
+	if ((pos = m_byName.find(name)) != UT_NPOS)
+		return m_byName.at(pos);
 
-		iter.next();
+	// a name without group matches any group
+	if (name.isGroupEmpty() && (pos = m_byNameAnyGroup.find(name.name)) != UT_NPOS)
+	{
+		const NamedResources& named = m_byNameAnyGroup.at(pos);
+		if (!named.empty())
+			return named[named.size() - 1];
 	}
-	return obCan;
+	return 0;
 }
 
 
@@ -97,6 +93,7 @@ gkResource* gkResourceManager::create(const gkResourceName& name)
 	notifyResourceCreated(ob);
 
 	m_resources.insert(ob->getResourceHandle(), ob);
+	indexResource(ob);
 	return ob;
 }
 
@@ -112,6 +109,7 @@ void gkResourceManager::destroy(const gkResourceHandle& handle)
 
 
 		notifyResourceDestroyed(res);
+		unindexResource(res);
 		m_resources.remove(handle);
 		delete res;
 	}
@@ -126,6 +124,7 @@ void gkResourceManager::destroy(const gkResourceName& name)
 		res->notifyResourceDestroying();
 
 		notifyResourceDestroyed(res);
+		unindexResource(res);
 		m_resources.remove(res->getResourceHandle());
 		delete res;
 	}
@@ -155,6 +154,7 @@ void gkResourceManager::destroyGroup(const gkResourceNameString& group)
 		{
 			ob->notifyResourceDestroying();
 			notifyResourceDestroyed(ob);
+			unindexResource(ob);
 
 			delete ob;
 		}
@@ -185,6 +185,46 @@ void gkResourceManager::destroyAll(void)
 	}
 
 	m_resources.clear();
+	m_byName.clear();
+	m_byNameAnyGroup.clear();
+}
+
+
+
+void gkResourceManager::indexResource(gkResource* res)
+{
+	const gkResourceName& name = res->getResourceName();
+
+	m_byName.insert(name, res);
+
+	UTsize pos = m_byNameAnyGroup.find(name.name);
+	if (pos == UT_NPOS)
+	{
+		m_byNameAnyGroup.insert(name.name, NamedResources());
+		pos = m_byNameAnyGroup.find(name.name);
+	}
+	m_byNameAnyGroup.at(pos).push_back(res);
+}
+
+
+void gkResourceManager::unindexResource(gkResource* res)
+{
+	const gkResourceName& name = res->getResourceName();
+
+	m_byName.remove(name);
+
+	UTsize pos = m_byNameAnyGroup.find(name.name);
+	if (pos != UT_NPOS)
+	{
+		NamedResources& named = m_byNameAnyGroup.at(pos);
+
+		UTsize idx = named.find(res);
+		if (idx != UT_NPOS)
+			named.erase(idx);
+
+		if (named.empty())
+			m_byNameAnyGroup.remove(name.name);
+	}
 }
 
 
@@ -38,6 +38,27 @@ public:
 	typedef Resources::Iterator ResourceIterator;
 
 
+	// (name, group) key of the name index
+	class NameKey
+	{
+	public:
+		NameKey() {}
+		NameKey(const gkResourceName& name) : m_name(name.name), m_group(name.group) {}
+
+		GK_INLINE UThash hash(void) const { return (m_name.hash() * 0x01000193) ^ m_group.hash(); }
+
+		GK_INLINE bool operator== (const NameKey& v) const { return m_name == v.m_name && m_group == v.m_group; }
+		GK_INLINE bool operator!= (const NameKey& v) const { return !(*this == v); }
+
+	protected:
+		gkResourceNameString m_name, m_group;
+	};
+
+	typedef utHashTable<NameKey, gkResource*>                     NameIndex;
+	typedef utArray<gkResource*>                                   NamedResources;
+	typedef utHashTable<gkResourceNameString, NamedResources>      GrouplessIndex;
+
+
 
 	///Resource managment events
 	class ResourceListener
@@ -107,6 +128,9 @@ protected:
 	virtual void notifyResourceCreatedImpl(gkResource* res) {}
 	virtual void notifyResourceDestroyedImpl(gkResource* res) {}
 
+	void indexResource(gkResource* res);
+	void unindexResource(gkResource* res);
+
 	Resources m_resources;
 	Listeners m_listeners;
 	gkString  m_managerType, m_resourceType;
@@ -114,6 +138,10 @@ protected:
 
 private:
 	gkResourceHandle m_resourceHandles;
+
+	// getByName lookups, exact and by name alone for group-less names
+	NameIndex        m_byName;
+	GrouplessIndex   m_byNameAnyGroup;
 };
 
 
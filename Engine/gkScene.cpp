@@ -52,7 +52,7 @@
 #include "gkDebugger.h"
 #include "gkMeshManager.h"
 #include "Thread/gkActiveObject.h"
-#include "gkStats.h"
+#include "gkProfiler.h"
 #include "gkUtils.h"
 
 #include "gkConstraintManager.h"
@@ -115,10 +115,15 @@ gkScene::gkScene(gkInstancedManager* creator, const gkResourceName& name, const
 		 m_blendFile(0),
 	     m_renderToViewport(true),
 	     m_zorder(0),
-	     m_logicBrickManager(0)
+	     m_logicBrickManager(0),
+	     m_profileZone(gkProfiler::registerZone(getName()))
 #ifdef OGREKIT_USE_PROCESSMANAGER
 		,m_processManager(0)
 #endif
+#ifdef OGREKIT_COMPILE_RECAST
+		,m_navTilesBusy(false)
+		,m_tiledNavMeshFresh(false)
+#endif
 {
 	m_logicBrickManager = new gkLogicManager();
 }
@@ -401,6 +406,7 @@ void gkScene::_eraseObject(gkGameObject* gobj)
 	}
 
 	gobj->destroyInstance();
+	destroyClonePool(gobj);
 	gobj->setOwner(0);
 
 	if (m_constraintManager)
@@ -488,6 +494,7 @@ void gkScene::destroyObject(gkGameObject* gobj)
 
 
 	gobj->destroyInstance();
+	destroyClonePool(gobj);
 	m_objects.remove(name);
 	gkGameObjectManager::getSingleton().destroy(gobj);
 	//delete gobj;
@@ -765,7 +772,9 @@ void gkScene::_postCreatePhysicsObject(gkGameObject* obj)
 		btCompoundShape* compShape = static_cast<btCompoundShape*>(parentCont->getShape());
 		
 		gkPhysicsController cont(obj, m_physicsWorld);
-		btCollisionShape *shape = cont._createShape();
+		btCollisionShape *shape = cont._createShape(obj->getWorldScale());
+		if (!shape)
+			return;
 		
 		gkMatrix4 m;
 		if (obj->getParent() != parent)
@@ -773,7 +782,6 @@ void gkScene::_postCreatePhysicsObject(gkGameObject* obj)
 		else
 			m = obj->getTransform();
 
-		shape->setLocalScaling(gkMathUtils::get(obj->getWorldScale()));
 		compShape->addChildShape(gkMathUtils::get(m), shape);
 
 		gkRigidBody* body = static_cast<gkRigidBody*>(parent->getPhysicsController());
@@ -807,6 +815,13 @@ void gkScene::_destroyPhysicsObject(gkGameObject* obj)
 	{
 		gkPhysicsController* phyCon = obj->getPhysicsController();
 
+		if (obj->isParked() && !isBeingDestroyed())
+		{
+			// keep body and shape for the next cloneObject
+			m_physicsWorld->suspendObject(phyCon, true);
+			return;
+		}
+
 		obj->attachRigidBody(0);
 		obj->attachCharacter(0);
 		obj->attachGhost(0);
@@ -1022,7 +1037,10 @@ void gkScene::createInstanceImpl(void)
 	Ogre::RTShader::ShaderGenerator::getSingleton().addSceneManager(m_manager);
 #endif
 
-	m_skybox  = gkMaterialLoader::loadSceneSkyMaterial(this, m_baseProps.m_material);
+	const bool headless = gkEngine::getSingleton().getUserDefs().headless;
+
+	if (!headless)
+		m_skybox  = gkMaterialLoader::loadSceneSkyMaterial(this, m_baseProps.m_material);
 
 
 
@@ -1096,9 +1114,10 @@ void gkScene::createInstanceImpl(void)
 		}
 	}
 
-	GK_ASSERT(m_viewport);
+	GK_ASSERT(m_viewport || headless);
 
-	m_viewport->getViewport()->setBackgroundColour(m_baseProps.m_material.m_horizon);
+	if (m_viewport)
+		m_viewport->getViewport()->setBackgroundColour(m_baseProps.m_material.m_horizon);
 	m_manager->setAmbientLight(m_baseProps.m_material.m_ambient);
 
 
@@ -1106,7 +1125,7 @@ void gkScene::createInstanceImpl(void)
 
 #if OGRE_NO_VIEWPORT_ORIENTATIONMODE != 0
 	const gkString& iparam = gkEngine::getSingleton().getUserDefs().viewportOrientation;
-	if (!iparam.empty())
+	if (!iparam.empty() && m_viewport)
 	{
 		int oparam = Ogre::OR_PORTRAIT;
 		if (iparam == "landscaperight") //viewport orientation is reversed.
@@ -1138,7 +1157,8 @@ void gkScene::createInstanceImpl(void)
 	}
 
 	//Enable Shadows
-	setShadows();
+	if (!headless)
+		setShadows();
 
 
 #ifdef OGREKIT_OPENAL_SOUND
@@ -1177,6 +1197,15 @@ void gkScene::destroyInstanceImpl(void)
 	if (m_navMeshData.get())
 		m_navMeshData->destroyInstances();
 
+#ifdef OGREKIT_COMPILE_RECAST
+	// a build still in flight fills the old results, nothing waits on them
+	m_tiledNavMeshResult = ASYNC_DT_RESULT();
+	m_navTilesResult = ASYNC_DT_TILES();
+	m_navTilesBusy = false;
+	m_tiledNavMesh = PDT_NAV_MESH();
+	m_tiledNavMeshFresh = false;
+#endif
+
 #ifdef OGREKIT_USE_LUA
 	// Free scripts
 	gkLuaManager::getSingleton().decompileGroup(getGroupName());
@@ -1338,7 +1367,17 @@ void gkScene::notifyInstanceCreated(gkGameObject* gobj)
 
 
 	// apply physics
-	if (!isBeingCreated())
+	if (gobj->isParked() && gobj->getPhysicsController())
+	{
+		gkPhysicsController* phyCon = gobj->getPhysicsController();
+
+		m_physicsWorld->suspendObject(phyCon, false);
+		phyCon->updateTransform();
+
+		if (gobj->getAttachedBody())
+			gobj->getAttachedBody()->resetMotion();
+	}
+	else if (!isBeingCreated())
 	{
 		_createPhysicsObject(gobj);
 		_postCreatePhysicsObject(gobj);
@@ -1434,11 +1473,126 @@ void gkScene::destroyClones(void)
 
 		m_tickClones.clear();
 	}
+
+	for (UTsize i = 0; i < m_clonePool.size(); ++i)
+	{
+		gkGameObjectArray& pool = m_clonePool.at(i);
+		for (UTsize j = 0; j < pool.size(); ++j)
+			destroyParkedClone(pool[j]);
+	}
+	m_clonePool.clear();
+
 	m_cloneCount = 0;
 }
 
 
 
+gkGameObject* gkScene::popPooledClone(gkGameObject* obj, const gkString& name)
+{
+	// clones of clones share the pool of the original object
+	gkGameObject* source = obj->isClone() ? obj->getCloneSource() : obj;
+	if (!source)
+		return 0;
+
+	UTsize pos = m_clonePool.find(source);
+	if (pos == UT_NPOS)
+		return 0;
+
+	gkGameObjectArray& pool = m_clonePool.at(pos);
+	while (!pool.empty())
+	{
+		gkGameObject* nobj = pool.back();
+		pool.pop_back();
+
+		if (nobj->_resetFromClone(obj, name))
+			return nobj;
+
+		// drifted too far from obj to pass as its clone
+		destroyParkedClone(nobj);
+	}
+	return 0;
+}
+
+
+
+bool gkScene::parkClone(gkGameObject* gobj)
+{
+	int limit = gkEngine::getSingleton().getUserDefs().clonePoolSize;
+	if (limit <= 0 || isBeingDestroyed() || !gobj->_canPark())
+		return false;
+
+	gkGameObject* source = gobj->getCloneSource();
+
+	UTsize pos = m_clonePool.find(source);
+	if (pos == UT_NPOS)
+	{
+		m_clonePool.insert(source, gkGameObjectArray());
+		pos = m_clonePool.find(source);
+	}
+
+	gkGameObjectArray& pool = m_clonePool.at(pos);
+	if ((int)pool.size() >= limit)
+		return false;
+
+
+	UTsize it;
+	if ((it = m_clones.find(gobj)) != UT_NPOS)
+		m_clones.erase(it);
+	else if ((it = m_tickClones.find(gobj)) != UT_NPOS)
+		m_tickClones.erase(it);
+	else
+		return false;
+
+	gobj->_setParked(true);
+	gobj->destroyInstance();
+
+	pool.push_back(gobj);
+	return true;
+}
+
+
+
+void gkScene::destroyParkedClone(gkGameObject* gobj)
+{
+	GK_ASSERT(gobj && gobj->isParked() && !gobj->isInstanced());
+
+	// the controller stayed suspended in the world
+	gobj->_setParked(false);
+	_destroyPhysicsObject(gobj);
+
+	gobj->_destroyParked();
+	delete gobj;
+}
+
+
+
+void gkScene::destroyClonePool(gkGameObject* source)
+{
+	UTsize pos = m_clonePool.find(source);
+	if (pos != UT_NPOS)
+	{
+		gkGameObjectArray& pool = m_clonePool.at(pos);
+		for (UTsize i = 0; i < pool.size(); ++i)
+			destroyParkedClone(pool[i]);
+
+		m_clonePool.erase(source);
+	}
+
+	// live clones must not return to a pool of a destroyed object
+	for (UTsize i = 0; i < m_clones.size(); ++i)
+	{
+		if (m_clones[i]->getCloneSource() == source)
+			m_clones[i]->_setCloneSource(0);
+	}
+	for (UTsize i = 0; i < m_tickClones.size(); ++i)
+	{
+		if (m_tickClones[i]->getCloneSource() == source)
+			m_tickClones[i]->_setCloneSource(0);
+	}
+}
+
+
+
 
 void gkScene::tickClones(void)
 {
@@ -1466,7 +1620,11 @@ void gkScene::tickClones(void)
 gkGameObject* gkScene::cloneObject(gkGameObject* obj, int lifeSpan, bool instantiate)
 {
 
-	gkGameObject* nobj = obj->clone(gkUtils::getUniqueName(obj->getName()));
+	gkString name = gkUtils::getUniqueName(obj->getName());
+
+	gkGameObject* nobj = popPooledClone(obj, name);
+	if (!nobj)
+		nobj = obj->clone(name);
 	nobj->setActiveLayer(true);
 
 	gkGameObject::LifeSpan life = {0, lifeSpan};
@@ -1509,6 +1667,9 @@ void gkScene::_unloadAndDestroy(gkGameObject* gobj)
 	if (!gobj)
 		return;
 
+	if (gobj->isClone() && parkClone(gobj))
+		return;
+
 	gobj->destroyInstance();
 
 	UTsize it;
@@ -1610,8 +1771,7 @@ void gkScene::beginFrame(void)
 	// end any objects up for removal
 	endObjects();
 
-	GK_ASSERT(m_physicsWorld);
-	m_physicsWorld->resetContacts();
+	// contacts persist between substeps, gkDynamicsWorld ends them itself
 
 #ifdef OGREKIT_OPENAL_SOUND
 
@@ -1630,31 +1790,70 @@ void gkScene::update(gkScalar tickRate)
 	if (!isInstanced())
 		return;
 
-	GK_ASSERT(m_physicsWorld);
+	updateNavigation();
 
 	// update simulation
-	if (m_updateFlags & UF_PHYSICS)
 	{
-		gkStats::getSingleton().startClock();
-		m_physicsWorld->step(tickRate);
-		gkStats::getSingleton().stopPhysicsClock();
+		GK_PROFILE("Physics");
+		updatePhysics(tickRate);
 	}
 
+	updateLogic(tickRate);
+
+	// update animations
+	{
+		GK_PROFILE("Animations");
+		updateAnimations(tickRate);
+	}
+
+	updateFinish(tickRate);
+}
+
+
+
+void gkScene::updateNavigation(void)
+{
+#ifdef OGREKIT_COMPILE_RECAST
+	// tiles built on a worker are swapped in before anything queries paths
+	applyNavigationTiles();
+#endif
+}
+
+
+
+void gkScene::updatePhysics(gkScalar tickRate)
+{
+	if (!isInstanced())
+		return;
+
+	GK_ASSERT(m_physicsWorld);
+
+	// rays and sweeps queued by the last logic update see the world it left
+	m_physicsWorld->runBatch();
+
+	if (m_updateFlags & UF_PHYSICS)
+		m_physicsWorld->step(tickRate);
+}
+
+
+
+void gkScene::updateLogic(gkScalar tickRate)
+{
+	if (!isInstanced())
+		return;
 
 	// update logic bricks
 	if (m_updateFlags & UF_LOGIC_BRICKS)
 	{
-		gkStats::getSingleton().startClock();
+		GK_PROFILE("LogicBricks");
 		m_logicBrickManager->update(tickRate);
-		gkStats::getSingleton().stopLogicBricksClock();
 	}
 
 #ifdef OGREKIT_USE_PROCESSMANAGER
 	if (m_processManager && m_updateFlags & UF_PROCESS)
 	{
-		gkStats::getSingleton().startClock();
+		GK_PROFILE("Process");
 		m_processManager->update(tickRate);
-		gkStats::getSingleton().stopProcessClock();
 	}
 #endif
 
@@ -1662,40 +1861,47 @@ void gkScene::update(gkScalar tickRate)
 	// update node trees
 	if (m_updateFlags & UF_NODE_TREES)
 	{
-		gkStats::getSingleton().startClock();
+		GK_PROFILE("LogicNodes");
 		gkNodeManager::getSingleton().update(tickRate);
-		gkStats::getSingleton().stopLogicNodesClock();
 	}
 #endif
+}
+
+
+
+void gkScene::updateAnimations(gkScalar tickRate)
+{
+	if (!isInstanced())
+		return;
 
-	// update animations
 	if (m_updateFlags & UF_ANIMATIONS)
-	{
-		gkStats::getSingleton().startClock();
 		updateObjectsAnimations(tickRate);
-		gkStats::getSingleton().stopAnimationsClock();
-	}
+}
+
+
 
+void gkScene::updateFinish(gkScalar tickRate)
+{
+	if (!isInstanced())
+		return;
 
 #ifdef OGREKIT_OPENAL_SOUND
 	// update sound manager.
 	if (m_updateFlags & UF_SOUNDS)
 	{
-		gkStats::getSingleton().startClock();
+		GK_PROFILE("Sound");
 		gkSoundManager::getSingleton().update(this);
-		gkStats::getSingleton().stopSoundClock();
 	}
 #endif
 
 	if (m_updateFlags & UF_DBVT)
 	{
-		gkStats::getSingleton().startClock();
+		GK_PROFILE("Dbvt");
 		if (m_markDBVT)
 		{
 			m_markDBVT = false;
 			m_physicsWorld->handleDbvt(m_startCam);
 		}
-		gkStats::getSingleton().stopDbvtClock();
 	}
 
 	if (m_updateFlags & UF_DEBUG)
@@ -1754,6 +1960,9 @@ bool gkScene::asyncTryToCreateNavigationMesh(gkActiveObject& activeObj, const gk
 
 	result.reset();
 
+	if (config.TILED)
+		return asyncUpdateNavigationTiles(activeObj, config, result);
+
 	if (m_navMeshData.get() && m_navMeshData->hasChanged())
 	{
 		gkPtrRef<gkCall> call(new CreateNavMeshCall(PMESHDATA(m_navMeshData->cloneData()), config, result));
@@ -1767,4 +1976,146 @@ bool gkScene::asyncTryToCreateNavigationMesh(gkActiveObject& activeObj, const gk
 
 	return false;
 }
+
+
+bool gkScene::asyncUpdateNavigationTiles(gkActiveObject& activeObj, const gkRecast::Config& config, ASYNC_DT_RESULT result)
+{
+	class CreateTiledNavMeshCall : public gkCall
+	{
+	public:
+
+		CreateTiledNavMeshCall(PMESHDATA meshData, const gkRecast::Config& config, ASYNC_DT_RESULT result)
+			: m_meshData(meshData), m_config(config), m_result(result) {}
+
+		~CreateTiledNavMeshCall() {}
+
+		void run() { m_result = gkRecast::createTiledNavMesh(m_meshData, m_config); }
+
+
+	private:
+
+		PMESHDATA m_meshData;
+
+		gkRecast::Config m_config;
+
+		ASYNC_DT_RESULT m_result;
+	};
+
+	class BuildNavTilesCall : public gkCall
+	{
+	public:
+
+		BuildNavTilesCall(PMESHDATA meshData, const gkRecast::Config& config, PDT_NAV_MESH navMesh,
+		                  const gkRecast::TILE_COORDS& tiles, ASYNC_DT_TILES result)
+			: m_meshData(meshData), m_config(config), m_navMesh(navMesh), m_tiles(tiles), m_result(result) {}
+
+		~BuildNavTilesCall() {}
+
+		void run() { m_result = gkRecast::buildTiles(m_meshData, m_config, m_navMesh, m_tiles); }
+
+
+	private:
+
+		PMESHDATA m_meshData;
+
+		gkRecast::Config m_config;
+
+		PDT_NAV_MESH m_navMesh;
+
+		gkRecast::TILE_COORDS m_tiles;
+
+		ASYNC_DT_TILES m_result;
+	};
+
+	if (!m_navMeshData.get())
+		return false;
+
+	applyNavigationTiles();
+
+	bool published = false;
+	if (m_tiledNavMeshFresh)
+	{
+		// tile updates patch this mesh in place, only new meshes are handed out
+		result = m_tiledNavMesh;
+		m_tiledNavMeshFresh = false;
+		published = true;
+	}
+
+	// one build in flight, dirty regions keep piling up meanwhile
+	if (m_navTilesBusy)
+		return published;
+
+	if (!gkRecast::hasTileLayout(m_tiledNavMesh, config))
+	{
+		if (m_tiledNavMesh.get() || m_navMeshData->hasChanged())
+		{
+			gkNavMeshData::BOUNDS dirty;
+			m_navMeshData->popDirtyBounds(dirty);
+			m_navMeshData->resetHasChanged();
+
+			gkPtrRef<gkCall> call(new CreateTiledNavMeshCall(PMESHDATA(m_navMeshData->cloneData()), config, m_tiledNavMeshResult));
+			activeObj.enqueue(call);
+
+			m_tiledNavMesh = PDT_NAV_MESH();
+			m_navTilesBusy = true;
+		}
+
+		return published;
+	}
+
+	if (!m_navMeshData->hasDirtyBounds())
+		return published;
+
+	gkNavMeshData::BOUNDS dirty;
+	m_navMeshData->popDirtyBounds(dirty);
+	m_navMeshData->resetHasChanged();
+
+	gkRecast::TILE_SET dirtyTiles;
+	for (gkNavMeshData::BOUNDS::iterator it = dirty.begin(); it != dirty.end(); ++it)
+		gkRecast::getTiles(m_tiledNavMesh, config, it->getMinimum(), it->getMaximum(), dirtyTiles);
+
+	// changes outside the tile grid
+	if (dirtyTiles.empty())
+		return published;
+
+	gkRecast::TILE_COORDS tiles(dirtyTiles.begin(), dirtyTiles.end());
+
+	// only the geometry under the dirty tiles is copied for the build
+	gkVector3 bmin, bmax, tmin, tmax;
+	gkRecast::getTileBounds(m_tiledNavMesh, config, tiles[0], bmin, bmax);
+	for (size_t i = 1; i < tiles.size(); ++i)
+	{
+		gkRecast::getTileBounds(m_tiledNavMesh, config, tiles[i], tmin, tmax);
+		bmin.makeFloor(tmin);
+		bmax.makeCeil(tmax);
+	}
+
+	gkPtrRef<gkCall> call(new BuildNavTilesCall(PMESHDATA(m_navMeshData->cloneData(bmin, bmax)), config, m_tiledNavMesh, tiles, m_navTilesResult));
+	activeObj.enqueue(call);
+
+	m_navTilesBusy = true;
+
+	return true;
+}
+
+
+void gkScene::applyNavigationTiles(void)
+{
+	if (!m_navTilesBusy)
+		return;
+
+	if (m_tiledNavMeshResult.hasResult())
+	{
+		m_tiledNavMesh = m_tiledNavMeshResult.getResult();
+		m_tiledNavMeshFresh = m_tiledNavMesh.get() != 0;
+		m_navTilesBusy = false;
+	}
+	else if (m_navTilesResult.hasResult())
+	{
+		// swapped on the main thread so path queries never see a half updated mesh
+		PDT_TILES tiles = m_navTilesResult.getResult();
+		gkRecast::replaceTiles(m_tiledNavMesh, tiles);
+		m_navTilesBusy = false;
+	}
+}
 #endif
@@ -57,6 +57,15 @@ public:
 	void update(gkScalar tickRate);
 	void beginFrame(void);
 
+	// The stages of update(), in order. updatePhysics only touches this
+	// scene and may run concurrently with other scenes' physics, the others
+	// use shared managers or resources and must run serially.
+	void updateNavigation(void);
+	void updatePhysics(gkScalar tickRate);
+	void updateLogic(gkScalar tickRate);
+	void updateAnimations(gkScalar tickRate);
+	void updateFinish(gkScalar tickRate);
+
 
 
 	GK_INLINE gkSceneProperties&        getProperties(void)    { return m_baseProps;  }
@@ -121,6 +130,10 @@ public:
 
 #ifdef OGREKIT_COMPILE_RECAST
 	typedef gkAsyncResult<PDT_NAV_MESH > ASYNC_DT_RESULT;
+	typedef gkAsyncResult<PDT_TILES > ASYNC_DT_TILES;
+
+	// With config.TILED the first call builds every tile, later calls only
+	// rebuild the tiles touched by moved, added or removed obstacles.
 	bool asyncTryToCreateNavigationMesh(gkActiveObject& activeObj, const gkRecast::Config& config, ASYNC_DT_RESULT result);
 #endif
 
@@ -218,6 +231,9 @@ public:
 	GK_INLINE UTuint32 getUpdateFlags(void)					{ return m_updateFlags;		}
 	GK_INLINE void setUpdateFlags(UTuint32 flags)			{ m_updateFlags = flags;	}
 
+	// gkProfiler zone named after the scene, for worker stages
+	GK_INLINE UTsize getProfileZone(void) const				{ return m_profileZone;		}
+
 	GK_INLINE gkBlendFile* getLoadBlendFile(void)			{ return m_blendFile;		}
 	GK_INLINE void setLoadBlendFile(gkBlendFile* blendFile)	{ m_blendFile = blendFile;	}
 
@@ -236,8 +252,22 @@ private:
 	void tickClones(void);
 	void destroyClones(void);
 	void endObjects(void);
+
+	// Ended clones parked for reuse by cloneObject, keyed by their clone source
+	gkGameObject* popPooledClone(gkGameObject* obj, const gkString& name);
+	bool parkClone(gkGameObject* obj);
+	void destroyParkedClone(gkGameObject* obj);
+	void destroyClonePool(gkGameObject* source);
+
+	typedef utHashTable<utPointerHashKey, gkGameObjectArray> ClonePool;
 	void updateObjectsAnimations(const gkScalar tick);
 
+#ifdef OGREKIT_COMPILE_RECAST
+	// Tiled navigation mesh, finished tiles are swapped in between ticks
+	bool asyncUpdateNavigationTiles(gkActiveObject& activeObj, const gkRecast::Config& config, ASYNC_DT_RESULT result);
+	void applyNavigationTiles(void);
+#endif
+
 	Ogre::SceneManager*     m_manager;
 	gkCamera*               m_startCam;
 	gkViewport*				m_viewport;
@@ -254,6 +284,7 @@ private:
 
 	gkGameObjectArray       m_clones;
 	gkGameObjectArray       m_tickClones;
+	ClonePool               m_clonePool;
 	gkGameObjectSet         m_endObjects;
 	gkGameObjectSet         m_updateAnimObjects;
 	gkPhysicsControllerSet  m_staticControllers;
@@ -279,10 +310,18 @@ private:
 	int                     m_zorder;
 
 	gkLogicManager*			m_logicBrickManager;
+	UTsize                  m_profileZone;
 
 #ifdef OGREKIT_USE_PROCESSMANAGER
 	gkProcessManager*		m_processManager;
 #endif
+#ifdef OGREKIT_COMPILE_RECAST
+	PDT_NAV_MESH            m_tiledNavMesh;
+	ASYNC_DT_RESULT         m_tiledNavMeshResult;
+	ASYNC_DT_TILES          m_navTilesResult;
+	bool                    m_navTilesBusy;
+	bool                    m_tiledNavMeshFresh;
+#endif
 };
 
 #endif//_gkSceneObject_h_
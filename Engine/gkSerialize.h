@@ -217,7 +217,8 @@ public:
 		:   m_mesh(0),
 		    m_casts(false),
 		    m_source(""),
-		    m_startPose("")
+		    m_startPose(""),
+		    m_lodBias(1.f)
 	{
 	}
 
@@ -225,6 +226,7 @@ public:
 	bool            m_casts;
 	gkString        m_source;
 	gkString        m_startPose;
+	gkScalar        m_lodBias;      // scales the mesh LOD distances, > 1 keeps detail longer
 };
 
 
@@ -628,6 +630,8 @@ public:
 	gkSceneProperties()
 		:   m_manager(MA_GENERIC),
 		    m_gravity(0.f, 0.f, -9.81f),
+		    m_physicsSubSteps(1),
+		    m_maxPhysicsSteps(5),
 		    m_material(),
 		    m_fog()
 	{
@@ -635,6 +639,8 @@ public:
 
 	int             m_manager;
 	gkVector3       m_gravity;
+	int             m_physicsSubSteps;  // physics steps per logic tick
+	int             m_maxPhysicsSteps;  // max physics steps per logic tick
 	gkSceneMaterial m_material;
 	gkFogParams     m_fog;
 };
@@ -142,3 +142,25 @@ void gkTickState::tick(void)
 
 	endTickImpl();
 }
+
+
+
+void gkTickState::tickFixed(void)
+{
+	beginTickImpl();
+	tickImpl(m_fixed);
+	endTickImpl();
+}
+
+
+
+unsigned long gkTickState::getTimeToNextTick(void)
+{
+	GK_ASSERT(m_clock);
+
+	if (!m_init)
+		return 0;
+
+	unsigned long cur = gkGetTickCount(m_clock);
+	return m_next > cur ? m_next - cur : 0;
+}
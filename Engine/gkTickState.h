@@ -61,6 +61,14 @@ public:
 	void reset(void);
 	void initialize(int rate);
 	void tick(void);
+
+	///Runs exactly one fixed step without consulting the clock.
+	void tickFixed(void);
+
+	///Milliseconds left before tick() would run the next step.
+	unsigned long getTimeToNextTick(void);
+
+	GK_INLINE gkScalar getFixedStep(void) const { return m_fixed; }
 };
 
 
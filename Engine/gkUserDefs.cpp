@@ -84,7 +84,31 @@ gkUserDefs::gkUserDefs()
 	animFps(24.f),
 	shaderCachePath(""),
 	rtss(false),
-	hasFixedCapability(true)
+	hasFixedCapability(true),
+	tickRate(60),
+	headless(false),
+	fastStep(false),
+	maxTicks(0),
+	sceneThreads(0),
+	loaderThreads(0),
+	physicsThreads(0),
+	rayThreads(0),
+	logicThreads(0),
+	physicsRate(0),
+	maxPhysicsSteps(0),
+	clonePoolSize(0),
+	physicsInterpolation(true),
+	meshOptimize(true),
+	meshPackNormals(false),
+	meshLodLevels(0),
+	meshLodDistance(50.f),
+	bvhCachePath(""),
+	soundCacheSize(0),
+	logLevel(0),
+	logCategories(0xFF),
+	logAsync(true),
+	profileTrace(""),
+	profileBricks(false)
 {
 }
 
@@ -323,6 +347,126 @@ void gkUserDefs::parseString(const gkString& key, const gkString& val)
 		shaderCachePath = val;
 		return;
 	}
+	if (KeyEq("tickrate"))
+	{
+		tickRate = gkClamp<int>(Ogre::StringConverter::parseInt(val), 1, 1000);
+		return;
+	}
+	if (KeyEq("headless"))
+	{
+		headless = Ogre::StringConverter::parseBool(val);
+		return;
+	}
+	if (KeyEq("faststep"))
+	{
+		fastStep = Ogre::StringConverter::parseBool(val);
+		return;
+	}
+	if (KeyEq("maxticks"))
+	{
+		maxTicks = gkMax<int>(0, Ogre::StringConverter::parseInt(val));
+		return;
+	}
+	if (KeyEq("scenethreads"))
+	{
+		sceneThreads = gkClamp<int>(Ogre::StringConverter::parseInt(val), -1, 64);
+		return;
+	}
+	if (KeyEq("loaderthreads"))
+	{
+		loaderThreads = gkClamp<int>(Ogre::StringConverter::parseInt(val), -1, 64);
+		return;
+	}
+	if (KeyEq("physicsthreads"))
+	{
+		physicsThreads = gkClamp<int>(Ogre::StringConverter::parseInt(val), -1, 64);
+		return;
+	}
+	if (KeyEq("raythreads"))
+	{
+		rayThreads = gkClamp<int>(Ogre::StringConverter::parseInt(val), -1, 64);
+		return;
+	}
+	if (KeyEq("logicthreads"))
+	{
+		logicThreads = gkClamp<int>(Ogre::StringConverter::parseInt(val), -1, 64);
+		return;
+	}
+	if (KeyEq("physicsrate"))
+	{
+		physicsRate = gkClamp<int>(Ogre::StringConverter::parseInt(val), 0, 1000);
+		return;
+	}
+	if (KeyEq("maxphysicssteps"))
+	{
+		maxPhysicsSteps = gkClamp<int>(Ogre::StringConverter::parseInt(val), 0, 100);
+		return;
+	}
+	if (KeyEq("clonepoolsize"))
+	{
+		clonePoolSize = gkClamp<int>(Ogre::StringConverter::parseInt(val), 0, 4096);
+		return;
+	}
+	if (KeyEq("physicsinterpolation"))
+	{
+		physicsInterpolation = Ogre::StringConverter::parseBool(val);
+		return;
+	}
+	if (KeyEq("meshoptimize"))
+	{
+		meshOptimize = Ogre::StringConverter::parseBool(val);
+		return;
+	}
+	if (KeyEq("meshpacknormals"))
+	{
+		meshPackNormals = Ogre::StringConverter::parseBool(val);
+		return;
+	}
+	if (KeyEq("meshlodlevels"))
+	{
+		meshLodLevels = gkClamp<int>(Ogre::StringConverter::parseInt(val), 0, 8);
+		return;
+	}
+	if (KeyEq("meshloddistance"))
+	{
+		meshLodDistance = gkMax<gkScalar>(Ogre::StringConverter::parseReal(val), 0.f);
+		return;
+	}
+	if (KeyEq("bvhcachepath"))
+	{
+		bvhCachePath = val;
+		return;
+	}
+	if (KeyEq("soundcachesize"))
+	{
+		soundCacheSize = gkMax<int>(Ogre::StringConverter::parseInt(val), 0);
+		return;
+	}
+	if (KeyEq("loglevel"))
+	{
+		logLevel = gkClamp<int>(Ogre::StringConverter::parseInt(val), 0, 4);
+		return;
+	}
+	if (KeyEq("logcategories"))
+	{
+		logCategories = Ogre::StringConverter::parseInt(val);
+		return;
+	}
+	if (KeyEq("logasync"))
+	{
+		logAsync = Ogre::StringConverter::parseBool(val);
+		return;
+	}
+	if (KeyEq("profiletrace"))
+	{
+		profileTrace = val;
+		return;
+	}
+	if (KeyEq("profilebricks"))
+	{
+		profileBricks = Ogre::StringConverter::parseBool(val);
+		return;
+	}
 
 #undef KeyEq
 }
@@ -79,6 +79,36 @@ public:
 	bool                    rtss;               // Enable RTShadingSystem
 	bool                    hasFixedCapability; // Renderer supports fixed-function pipeline
 
+	int                     tickRate;           // Logic / physics ticks per second
+	bool                    headless;           // Run scenes without a render system or window
+	bool                    fastStep;           // Step ticks back to back instead of following the wall clock
+	int                     maxTicks;           // Stop the main loop after this many ticks (0 = run until exit)
+	// With sceneThreads several scenes advance stage by stage instead of one
+	// after the other: every scene's physics, then every scene's logic, then
+	// animations and the rest. Logic of a scene no longer sees the finished
+	// tick of the scenes before it, only their physics. A single scene is
+	// updated as in serial mode.
+	int                     sceneThreads;       // Workers stepping scene physics concurrently (0 = serial, -1 = one per core)
+	int                     loaderThreads;      // Workers converting .blend data while loading (0 = serial, -1 = one per core)
+	int                     physicsThreads;     // Bullet narrowphase / solver threads per world (0 = single threaded, -1 = one per core)
+	int                     rayThreads;         // Workers running batched ray / sweep queries (0 = serial, -1 = one per core)
+	int                     logicThreads;       // Workers querying logic brick sensors, shared by all scenes (0 = serial, -1 = one per core)
+	int                     physicsRate;        // Fixed physics steps per second (0 = tick rate * scene substeps)
+	int                     maxPhysicsSteps;    // Max physics steps per tick before time is dropped (0 = scene setting)
+	int                     clonePoolSize;      // Ended clones kept per object for reuse by cloneObject (0 = off)
+	bool                    physicsInterpolation; // Interpolate rigid body transforms when physics runs slower than logic
+	bool                    meshOptimize;       // Reorder mesh triangles / vertices for the GPU vertex caches
+	bool                    meshPackNormals;    // Store static mesh normals as 16 bit integers (lighting must normalise them)
+	int                     meshLodLevels;      // Reduced levels generated for meshes without their own LOD settings (0 = off)
+	gkScalar                meshLodDistance;    // Camera distance of the first generated level, doubled for each further one
+	gkString                bvhCachePath;       // Directory for serialized mesh collision BVHs (empty = always rebuild)
+	int                     soundCacheSize;     // KB of decoded PCM kept for short, replayed sounds (0 = off, always stream)
+	int                     logLevel;           // Lowest gkLogLevel written (0 = debug ... 4 = critical)
+	int                     logCategories;      // gkLogCategory bits written
+	bool                    logAsync;           // Write the log from a background thread
+	gkString                profileTrace;       // Capture profiler zones and write Chrome trace JSON here on exit
+	bool                    profileBricks;      // Profile each authored logic brick, clones share their source's zone
+
 	GK_INLINE bool          isD3DRenderSystem() { return isD3DRenderSystem(rendersystem); }
 
 	static OgreRenderSystem getOgreRenderSystem(const gkString& val);
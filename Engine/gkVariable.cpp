@@ -28,11 +28,99 @@
 
 
 
+gkVariable::Value::Value()
+	:    m_type(VAR_NULL),
+	     m_string(0)
+{
+	// an unset variable reads as 0
+	memset(&m_data, 0, sizeof(m_data));
+}
+
+
+gkVariable::Value::Value(const Value& o)
+	:    m_type(o.m_type),
+	     m_data(o.m_data),
+	     m_string(o.m_string ? new gkString(*o.m_string) : 0)
+{
+}
+
+
+gkVariable::Value::~Value()
+{
+	delete m_string;
+}
+
+
+gkVariable::Value& gkVariable::Value::operator = (const Value& o)
+{
+	if (this != &o)
+	{
+		m_type = o.m_type;
+		m_data = o.m_data;
+
+		if (m_type == VAR_STRING)
+			setString(o.m_string ? *o.m_string : gkStringUtils::BLANK);
+	}
+	return *this;
+}
+
+
+void gkVariable::Value::setString(const gkString& v)
+{
+	m_type = VAR_STRING;
+
+	if (m_string)
+		*m_string = v;
+	else
+		m_string = new gkString(v);
+}
+
+
+void gkVariable::Value::fromString(int type, const gkString& v)
+{
+	switch (type)
+	{
+	case VAR_BOOL: { bool         r; gkFromString(v, r); m_type = VAR_BOOL; m_data.m_bool = r; break; }
+	case VAR_INT:  { int          r; gkFromString(v, r); m_type = VAR_INT;  m_data.m_int  = r; break; }
+	case VAR_REAL: { gkScalar     r; gkFromString(v, r); m_type = VAR_REAL; m_data.m_real = r; break; }
+	case VAR_VEC2: { gkVector2    r; gkFromString(v, r); set(VAR_VEC2, r); break; }
+	case VAR_VEC3: { gkVector3    r; gkFromString(v, r); set(VAR_VEC3, r); break; }
+	case VAR_VEC4: { gkVector4    r; gkFromString(v, r); set(VAR_VEC4, r); break; }
+	case VAR_QUAT: { gkQuaternion r; gkFromString(v, r); set(VAR_QUAT, r); break; }
+	case VAR_MAT3: { gkMatrix3    r; gkFromString(v, r); set(VAR_MAT3, r); break; }
+	case VAR_MAT4: { gkMatrix4    r; gkFromString(v, r); set(VAR_MAT4, r); break; }
+	default:
+		setString(v);
+		break;
+	}
+}
+
+
+gkString gkVariable::Value::toString(void) const
+{
+	switch (m_type)
+	{
+	case VAR_NULL:
+	case VAR_INT:  return gkToString(m_data.m_int);
+	case VAR_BOOL: return gkToString(m_data.m_bool);
+	case VAR_REAL: return gkToString(m_data.m_real);
+	case VAR_VEC2: return gkToString(get(VAR_VEC2, gkVector2::ZERO));
+	case VAR_VEC3: return gkToString(get(VAR_VEC3, gkVector3::ZERO));
+	case VAR_VEC4: return gkToString(get(VAR_VEC4, gkVector4::ZERO));
+	case VAR_QUAT: return gkToString(get(VAR_QUAT, gkQuaternion::IDENTITY));
+	case VAR_MAT3: return gkToString(get(VAR_MAT3, gkMatrix3::IDENTITY));
+	case VAR_MAT4: return gkToString(get(VAR_MAT4, gkMatrix4::IDENTITY));
+	default:
+		break;
+	}
+	return m_string ? *m_string : gkStringUtils::BLANK;
+}
+
+
+
 
 gkVariable::gkVariable()
-	:    m_value((int)0),
-	     m_type(VAR_NULL),
-	     m_name(""),
+	:    m_name(""),
 	     m_debug(false), m_lock(false)
 {
 }
@@ -40,18 +128,14 @@ gkVariable::gkVariable()
 
 
 gkVariable::gkVariable(const gkString& n, bool dbg)
-	:    m_value((int)0),
-	     m_type(VAR_NULL),
-	     m_name(n),
+	:    m_name(n),
 	     m_debug(dbg), m_lock(false)
 {
 }
 
 
 gkVariable::gkVariable(bool v, const gkString& name)
-	:    m_value((int)0),
-	     m_type(VAR_NULL),
-	     m_name(""),
+	:    m_name(""),
 	     m_debug(false), m_lock(false)
 {
 	setValue(v);
@@ -59,9 +143,7 @@ gkVariable::gkVariable(bool v, const gkString& name)
 
 
 gkVariable::gkVariable(int v, const gkString& name)
-	:    m_value((int)0),
-	     m_type(VAR_NULL),
-	     m_name(""),
+	:    m_name(""),
 	     m_debug(false), m_lock(false)
 {
 	setValue(v);
@@ -69,71 +151,55 @@ gkVariable::gkVariable(int v, const gkString& name)
 
 
 gkVariable::gkVariable(gkScalar v, const gkString& name)
-	:    m_value((int)0),
-	     m_type(VAR_NULL),
-	     m_name(""),
+	:    m_name(""),
 	     m_debug(false), m_lock(false)
 {
 	setValue(v);
 }
 
 gkVariable::gkVariable(const gkString& v, const gkString& name)
-	:    m_value((int)0),
-	     m_type(VAR_NULL),
-	     m_name(""),
+	:    m_name(""),
 	     m_debug(false), m_lock(false)
 {
 	setValue(v);
 }
 
 gkVariable::gkVariable(const gkVector2& v, const gkString& name)
-	:    m_value((int)0),
-	     m_type(VAR_NULL),
-	     m_name(""),
+	:    m_name(""),
 	     m_debug(false), m_lock(false)
 {
 	setValue(v);
 }
 
 gkVariable::gkVariable(const gkVector3& v, const gkString& name)
-	:    m_value((int)0),
-	     m_type(VAR_NULL),
-	     m_name(""),
+	:    m_name(""),
 	     m_debug(false), m_lock(false)
 {
 	setValue(v);
 }
 
 gkVariable::gkVariable(const gkVector4& v, const gkString& name)
-	:    m_value((int)0),
-	     m_type(VAR_NULL),
-	     m_name(""),
+	:    m_name(""),
 	     m_debug(false), m_lock(false)
 {
 	setValue(v);
 }
 gkVariable::gkVariable(const gkQuaternion& v, const gkString& name)
-	:    m_value((int)0),
-	     m_type(VAR_NULL),
-	     m_name(""),
+	:    m_name(""),
 	     m_debug(false), m_lock(false)
 {
 	setValue(v);
 }
 
 gkVariable::gkVariable(const gkMatrix3& v, const gkString& name)
-	:    m_value((int)0),
-	     m_type(VAR_NULL),
-	     m_name(""),
+	:    m_name(""),
 	     m_debug(false), m_lock(false)
 {
 	setValue(v);
 }
 
 gkVariable::gkVariable(const gkMatrix4& v, const gkString& name)
-	:    m_value((int)0),
-	     m_type(VAR_NULL),
-	     m_name(""),
+	:    m_name(""),
 	     m_debug(false), m_lock(false)
 {
 	setValue(v);
@@ -160,19 +226,15 @@ void gkVariable::reset(void)
 
 gkVariable* gkVariable::clone(void)
 {
-	gkVariable* v = new gkVariable(*this);
-	v->m_value = gkValue(m_value);
-	return v;
+	return new gkVariable(*this);
 }
 
 
 void gkVariable::setValue(int type, const gkString& v)
 {
+	// parsed once into the given type, comparisons and math stay typed
 	if (!m_lock)
-	{
-		m_type = type;
-		assign(v);
-	}
+		m_value.fromString(type, v);
 }
 
 
@@ -180,8 +242,8 @@ void gkVariable::setValue(gkScalar v)
 {
 	if (!m_lock)
 	{
-		m_type = VAR_REAL;
-		m_value = v;
+		m_value.m_type = VAR_REAL;
+		m_value.m_data.m_real = v;
 	}
 }
 
@@ -191,8 +253,8 @@ void gkVariable::setValue(bool v)
 {
 	if (!m_lock)
 	{
-		m_type = VAR_BOOL;
-		m_value = v;
+		m_value.m_type = VAR_BOOL;
+		m_value.m_data.m_bool = v;
 	}
 }
 
@@ -202,8 +264,8 @@ void gkVariable::setValue(int v)
 {
 	if (!m_lock)
 	{
-		m_type = VAR_INT;
-		m_value = v;
+		m_value.m_type = VAR_INT;
+		m_value.m_data.m_int = v;
 	}
 }
 
@@ -211,70 +273,49 @@ void gkVariable::setValue(int v)
 void gkVariable::setValue(const gkString& v)
 {
 	if (!m_lock)
-	{
-		m_type = VAR_STRING;
-		m_value = v;
-	}
+		m_value.setString(v);
 }
 
 
 void gkVariable::setValue(const gkVector2& v)
 {
 	if (!m_lock)
-	{
-		m_type = VAR_VEC2;
-		m_value = v;
-	}
+		m_value.set(VAR_VEC2, v);
 }
 
 
 void gkVariable::setValue(const gkVector3& v)
 {
 	if (!m_lock)
-	{
-		m_type = VAR_VEC3;
-		m_value = v;
-	}
+		m_value.set(VAR_VEC3, v);
 }
 
 
 void gkVariable::setValue(const gkVector4& v)
 {
 	if (!m_lock)
-	{
-		m_type = VAR_VEC4;
-		m_value = v;
-	}
+		m_value.set(VAR_VEC4, v);
 }
 
 
 void gkVariable::setValue(const gkQuaternion& v)
 {
 	if (!m_lock)
-	{
-		m_type = VAR_QUAT;
-		m_value = v;
-	}
+		m_value.set(VAR_QUAT, v);
 }
 
 
 void gkVariable::setValue(const gkMatrix3& v)
 {
 	if (!m_lock)
-	{
-		m_type = VAR_MAT3;
-		m_value = v;
-	}
+		m_value.set(VAR_MAT3, v);
 }
 
 
 void gkVariable::setValue(const gkMatrix4& v)
 {
 	if (!m_lock)
-	{
-		m_type = VAR_MAT4;
-		m_value = v;
-	}
+		m_value.set(VAR_MAT4, v);
 }
 
 
@@ -282,7 +323,6 @@ void gkVariable::setValue(const gkVariable& v)
 {
 	if (!m_lock)
 	{
-		m_type  = v.m_type;
 		m_value = v.m_value;
 		m_debug = v.m_debug;
 		m_name  = v.m_name;
@@ -292,14 +332,14 @@ void gkVariable::setValue(const gkVariable& v)
 
 bool gkVariable::getValueBool(void) const
 {
-	switch (m_type)
+	switch (m_value.m_type)
 	{
 	case VAR_INT:
-		return m_value.get<int>() != 0;
+		return m_value.m_data.m_int != 0;
 	case VAR_REAL:
-		return m_value.get<gkScalar>() != 0.f;
+		return m_value.m_data.m_real != 0.f;
 	case VAR_BOOL:
-		return m_value.get<bool>();
+		return m_value.m_data.m_bool;
 	default:
 		{
 			bool v;
@@ -313,14 +353,14 @@ bool gkVariable::getValueBool(void) const
 
 gkScalar gkVariable::getValueReal(void) const
 {
-	switch (m_type)
+	switch (m_value.m_type)
 	{
 	case VAR_INT:
-		return (gkScalar)m_value.get<int>();
+		return (gkScalar)m_value.m_data.m_int;
 	case VAR_REAL:
-		return m_value.get<gkScalar>();
+		return m_value.m_data.m_real;
 	case VAR_BOOL:
-		return m_value.get<bool>() ? 1.f : 0.f;
+		return m_value.m_data.m_bool ? 1.f : 0.f;
 	default:
 		{
 			gkScalar v;
@@ -335,14 +375,15 @@ gkScalar gkVariable::getValueReal(void) const
 
 int gkVariable::getValueInt(void) const
 {
-	switch (m_type)
+	switch (m_value.m_type)
 	{
+	case VAR_NULL:
 	case VAR_INT:
-		return m_value.get<int>(0);
+		return m_value.m_data.m_int;
 	case VAR_REAL:
-		return (int)m_value.get<gkScalar>(0.f);
+		return (int)m_value.m_data.m_real;
 	case VAR_BOOL:
-		return m_value.get<bool>(false) ? 1 : 0;
+		return m_value.m_data.m_bool ? 1 : 0;
 	default:
 		{
 			int v;
@@ -363,44 +404,44 @@ gkString gkVariable::getValueString(void) const
 
 gkVector2 gkVariable::getValueVector2(void) const
 {
-	return m_value.get<gkVector2>(gkVector2(0, 0));
+	return m_value.get(VAR_VEC2, gkVector2(0, 0));
 }
 
 
 gkVector3 gkVariable::getValueVector3(void) const
 {
-	return m_value.get<gkVector3>(gkVector3(0, 0, 0));
+	return m_value.get(VAR_VEC3, gkVector3(0, 0, 0));
 }
 
 
 
 gkVector4 gkVariable::getValueVector4(void) const
 {
-	return m_value.get<gkVector4>(gkVector4(0, 0, 0, 1));
+	return m_value.get(VAR_VEC4, gkVector4(0, 0, 0, 1));
 }
 
 
 gkQuaternion gkVariable::getValueQuaternion(void) const
 {
-	return m_value.get<gkQuaternion>(gkQuaternion::IDENTITY);
+	return m_value.get(VAR_QUAT, gkQuaternion::IDENTITY);
 }
 
 
 gkMatrix3 gkVariable::getValueMatrix3(void) const
 {
-	return m_value.get<gkMatrix3>(gkMatrix3::IDENTITY);
+	return m_value.get(VAR_MAT3, gkMatrix3::IDENTITY);
 }
 
 
 gkMatrix4 gkVariable::getValueMatrix4(void) const
 {
-	return m_value.get<gkMatrix4>(gkMatrix4::IDENTITY);
+	return m_value.get(VAR_MAT4, gkMatrix4::IDENTITY);
 }
 
 
 bool gkVariable::operator < (const gkVariable& o) const
 {
-	switch (m_type)
+	switch (m_value.m_type)
 	{
 	case VAR_BOOL: return (int)getValueBool()  < (int)o.getValueBool();
 	case VAR_INT:  return getValueInt()        < o.getValueInt();
@@ -416,7 +457,7 @@ bool gkVariable::operator < (const gkVariable& o) const
 
 bool gkVariable::operator > (const gkVariable& o) const
 {
-	switch (m_type)
+	switch (m_value.m_type)
 	{
 	case VAR_BOOL: return (int)getValueBool()  > (int)o.getValueBool();
 	case VAR_INT:  return getValueInt()        > o.getValueInt();
@@ -445,7 +486,7 @@ bool gkVariable::operator >= (const gkVariable& o) const
 
 bool gkVariable::operator == (const gkVariable& o) const
 {
-	switch (m_type)
+	switch (m_value.m_type)
 	{
 	case VAR_BOOL: return (int)getValueBool()  == (int)o.getValueBool();
 	case VAR_INT:  return getValueInt()        == o.getValueInt();
@@ -473,10 +514,7 @@ bool gkVariable::operator != (const gkVariable& o) const
 void gkVariable::assign(const gkString& o)
 {
 	if (!m_lock)
-	{
-		m_type  = VAR_STRING;
-		m_value = o;
-	}
+		m_value.setString(o);
 }
 
 
@@ -519,7 +557,6 @@ void gkVariable::assign(const gkVariable& nv)
 {
 	if (!m_lock)
 	{
-		m_type  = nv.m_type;
 		m_value = nv.m_value;
 	}
 }
@@ -529,7 +566,7 @@ void gkVariable::add(const gkVariable& nv)
 {
 	if (!m_lock)
 	{
-		switch (m_type)
+		switch (m_value.m_type)
 		{
 		case VAR_BOOL:  setValue(getValueBool()      != nv.getValueBool());       break;
 		case VAR_INT:   setValue(getValueInt()        + nv.getValueInt());        break;
@@ -551,7 +588,7 @@ void gkVariable::add(const gkVariable& nv)
 
 bool gkVariable::hasInverse(void)
 {
-	switch (m_type)
+	switch (m_value.m_type)
 	{
 	case VAR_BOOL:
 	case VAR_INT:
@@ -574,7 +611,7 @@ void gkVariable::inverse(const gkVariable& nv)
 {
 	if (!m_lock)
 	{
-		switch (m_type)
+		switch (m_value.m_type)
 		{
 		case VAR_BOOL:  setValue(!nv.getValueBool());            break;
 		case VAR_INT:   setValue(nv.getValueInt()  ? 0   : 1);   break;
@@ -31,6 +31,7 @@
 #include "gkValue.h"
 #include "gkCommon.h"
 #include "gkMathUtils.h"
+#include <new>
 
 
 class gkVariable
@@ -73,7 +74,7 @@ public:
 
 	gkVariable* clone(void);
 
-	GK_INLINE int   getType(void) const           { return m_type;}
+	GK_INLINE int   getType(void) const           { return m_value.m_type;}
 	GK_INLINE void  setDebug(bool v)              { m_debug = v;}
 	GK_INLINE void  setReadOnly(bool v)           { m_lock = v;}
 	GK_INLINE bool  isReadOnly(void)              { return m_lock;}
@@ -136,9 +137,55 @@ public:
 
 private:
 
-	gkValue         m_value;
-	gkValue         m_default;
-	int          m_type;
+	// Inline storage for the fixed property types. Writes never allocate,
+	// strings live out of line and keep their buffer across assignments.
+	class Value
+	{
+	public:
+		Value();
+		Value(const Value& o);
+		~Value();
+
+		Value& operator = (const Value& o);
+
+		// the math types are plain floats, constructed in place over the storage
+		template<typename T>
+		GK_INLINE void set(int type, const T& v)
+		{
+			UT_ASSERT(sizeof(T) <= sizeof(m_data));
+			m_type = type;
+			new (&m_data) T(v);
+		}
+
+		template<typename T>
+		GK_INLINE T get(int type, const T& def) const
+		{
+			if (m_type != type)
+				return def;
+
+			return *reinterpret_cast<const T*>(&m_data);
+		}
+
+		void     setString(const gkString& v);
+		void     fromString(int type, const gkString& v);
+		gkString toString(void) const;
+
+		int m_type;
+
+		union
+		{
+			bool        m_bool;
+			int         m_int;
+			gkScalar    m_real;
+			gkScalar    m_elems[16];
+		} m_data;
+
+		gkString* m_string;
+	};
+
+
+	Value        m_value;
+	Value        m_default;
 	gkString     m_name;
 	bool         m_debug, m_lock;
 };
@@ -114,13 +114,13 @@ Ogre::RenderWindow* gkWindowSystem::getMainRenderWindow(void)
 
 void gkWindowSystem::addListener(Listener* l)
 {
-	gkWindow* window = getMainWindow(); GK_ASSERT(window);	
+	gkWindow* window = getMainWindow();
 	if (window) window->addListener(l);
 }
 
 void gkWindowSystem::removeListener(Listener* l)
 {
-	gkWindow* window = getMainWindow(); GK_ASSERT(window);	
+	gkWindow* window = getMainWindow();
 	if (window) window->removeListener(l);
 }
 
@@ -150,24 +150,24 @@ void gkWindowSystem::clearStates(void)
 
 gkKeyboard* gkWindowSystem::getKeyboard(void)      
 {
-	GK_ASSERT(getMainWindow());
-	return getMainWindow()->getKeyboard();
+	gkWindow* window = getMainWindow();
+	return window ? window->getKeyboard() : &m_nullKeyboard;
 }
 
 gkMouse* gkWindowSystem::getMouse(void)            
 {
-	GK_ASSERT(getMainWindow());
-	return getMainWindow()->getMouse();
+	gkWindow* window = getMainWindow();
+	return window ? window->getMouse() : &m_nullMouse;
 }
 
 unsigned int gkWindowSystem::getNumJoysticks(void) 
 {
-	GK_ASSERT(getMainWindow());
-	return getMainWindow()->getNumJoysticks();
+	gkWindow* window = getMainWindow();
+	return window ? window->getNumJoysticks() : 0;
 }
 
 gkJoystick* gkWindowSystem::getJoystick(int index) 
 {
-	GK_ASSERT(getMainWindow());
-	return getMainWindow()->getJoystick(index);
+	gkWindow* window = getMainWindow();
+	return window ? window->getJoystick(index) : 0;
 }
@@ -58,6 +58,10 @@ protected:
 	utArray<gkWindow*>		m_windows;
 	bool					m_exit;
 
+	// idle devices handed out when there is no window (headless)
+	gkKeyboard				m_nullKeyboard;
+	gkMouse					m_nullMouse;
+
 public:
 	gkWindowSystem();
 	virtual ~gkWindowSystem();
@@ -109,7 +109,7 @@ private:
 //}
 
 void OgreKit::handleMessage(gkMessageManager::Message* message){
-	LOGI("HANDLE MSG %s ",message->m_subject.c_str());
+	LOGI("HANDLE MSG %s ",message->getSubject().c_str());
 
 	JNIEnv* env = this->GetEnv();
 
@@ -124,10 +124,10 @@ void OgreKit::handleMessage(gkMessageManager::Message* message){
     mFireString = (env)->GetStaticMethodID(ANDROID_MAIN, "fireStringMessage", "(Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;)V");
 
 //    jstring from = this->JNU_NewStringNative(env,message->m_subject.c_str());
-    jstring from = env->NewStringUTF(message->m_from.c_str());
-    jstring to = env->NewStringUTF(message->m_to.c_str());
-    jstring subject = env->NewStringUTF(message->m_subject.c_str());
-    jstring body = env->NewStringUTF(message->m_body.c_str());
+    jstring from = env->NewStringUTF(message->getFrom().c_str());
+    jstring to = env->NewStringUTF(message->getTo().c_str());
+    jstring subject = env->NewStringUTF(message->getSubject().c_str());
+    jstring body = env->NewStringUTF(message->getBody());
     env->CallStaticVoidMethod(ANDROID_MAIN,mFireString, from,to,subject,body);
 
 }
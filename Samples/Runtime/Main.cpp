@@ -107,6 +107,29 @@ int OgreKit::setup(int argc, char** argv)
 		TCLAP::ValueArg<std::string>	colourshadow_arg		("",  "colourshadow",			"Set shadow colour.", false, "", "string"); 
 		TCLAP::ValueArg<float>			fardistanceshadow_arg	("",  "fardistanceshadow",		"Set far distance shadow.", false, m_prefs.fardistanceshadow, "float"); 
 		TCLAP::ValueArg<std::string>	shaderCachePath_arg		("",  "shadercachepath",		"RTShaderSystem cache file path.", false, m_prefs.shaderCachePath, "string"); 
+		TCLAP::ValueArg<int>			tickRate_arg			("",  "tickrate",				"Set logic / physics ticks per second.", false, m_prefs.tickRate, "int");
+		TCLAP::ValueArg<bool>			headless_arg			("",  "headless",				"Run without render system and window.", false, m_prefs.headless, "bool");
+		TCLAP::ValueArg<bool>			fastStep_arg			("",  "faststep",				"Step ticks as fast as possible.", false, m_prefs.fastStep, "bool");
+		TCLAP::ValueArg<int>			maxTicks_arg			("",  "maxticks",				"Exit after n ticks (0 = never).", false, m_prefs.maxTicks, "int");
+		TCLAP::ValueArg<int>			sceneThreads_arg		("",  "scenethreads",			"Update scenes on n worker threads (0 = off, -1 = per core).", false, m_prefs.sceneThreads, "int");
+		TCLAP::ValueArg<int>			loaderThreads_arg		("",  "loaderthreads",			"Convert .blend data on n worker threads (0 = off, -1 = per core).", false, m_prefs.loaderThreads, "int");
+		TCLAP::ValueArg<int>			physicsThreads_arg		("",  "physicsthreads",			"Bullet collision / solver threads (0 = off, -1 = per core).", false, m_prefs.physicsThreads, "int");
+		TCLAP::ValueArg<int>			rayThreads_arg			("",  "raythreads",				"Run batched ray / sweep queries on n worker threads (0 = off, -1 = per core).", false, m_prefs.rayThreads, "int");
+		TCLAP::ValueArg<int>			logicThreads_arg		("",  "logicthreads",			"Query logic brick sensors on n worker threads (0 = off, -1 = per core).", false, m_prefs.logicThreads, "int");
+		TCLAP::ValueArg<int>			physicsRate_arg			("",  "physicsrate",			"Fixed physics steps per second (0 = from scene).", false, m_prefs.physicsRate, "int");
+		TCLAP::ValueArg<int>			maxPhysicsSteps_arg		("",  "maxphysicssteps",		"Max physics steps per tick (0 = from scene).", false, m_prefs.maxPhysicsSteps, "int");
+		TCLAP::ValueArg<int>			clonePoolSize_arg		("",  "clonepoolsize",			"Ended clones kept per object for reuse (0 = off).", false, m_prefs.clonePoolSize, "int");
+		TCLAP::ValueArg<bool>			physicsInterpolation_arg("",  "physicsinterpolation",	"Interpolate transforms when physics runs slower than logic.", false, m_prefs.physicsInterpolation, "bool");
+		TCLAP::ValueArg<bool>			meshOptimize_arg		("",  "meshoptimize",			"Reorder mesh triangles and vertices for the vertex caches.", false, m_prefs.meshOptimize, "bool");
+		TCLAP::ValueArg<bool>			meshPackNormals_arg		("",  "meshpacknormals",		"Store static mesh normals as 16 bit integers.", false, m_prefs.meshPackNormals, "bool");
+		TCLAP::ValueArg<int>			meshLodLevels_arg		("",  "meshlodlevels",			"Generate n reduced levels for meshes without LOD settings (0 = off).", false, m_prefs.meshLodLevels, "int");
+		TCLAP::ValueArg<float>			meshLodDistance_arg		("",  "meshloddistance",		"Camera distance of the first generated mesh level.", false, m_prefs.meshLodDistance, "float");
+		TCLAP::ValueArg<std::string>	bvhCachePath_arg		("",  "bvhcachepath",			"Directory for serialized mesh collision BVHs.", false, m_prefs.bvhCachePath, "string");
+		TCLAP::ValueArg<int>			logLevel_arg			("",  "loglevel",				"Lowest log level written (0 = debug ... 4 = critical).", false, m_prefs.logLevel, "int");
+		TCLAP::ValueArg<int>			logCategories_arg		("",  "logcategories",			"Bit mask of log categories written.", false, m_prefs.logCategories, "int");
+		TCLAP::ValueArg<bool>			logAsync_arg			("",  "logasync",				"Write the log from a background thread.", false, m_prefs.logAsync, "bool");
+		TCLAP::ValueArg<int>			soundCacheSize_arg		("",  "soundcachesize",			"KB of decoded audio kept for short, replayed sounds (0 = off).", false, m_prefs.soundCacheSize, "int");
+		TCLAP::ValueArg<std::string>	profileTrace_arg		("",  "profiletrace",			"Write a Chrome trace of the profiler zones to this file on exit.", false, m_prefs.profileTrace, "string");
 		
 
 		cmdl.add(rendersystem_arg);
@@ -140,6 +163,29 @@ int OgreKit::setup(int argc, char** argv)
 		cmdl.add(colourshadow_arg);
 		cmdl.add(fardistanceshadow_arg);
 		cmdl.add(shaderCachePath_arg);
+		cmdl.add(tickRate_arg);
+		cmdl.add(headless_arg);
+		cmdl.add(fastStep_arg);
+		cmdl.add(maxTicks_arg);
+		cmdl.add(sceneThreads_arg);
+		cmdl.add(loaderThreads_arg);
+		cmdl.add(physicsThreads_arg);
+		cmdl.add(rayThreads_arg);
+		cmdl.add(logicThreads_arg);
+		cmdl.add(physicsRate_arg);
+		cmdl.add(maxPhysicsSteps_arg);
+		cmdl.add(clonePoolSize_arg);
+		cmdl.add(physicsInterpolation_arg);
+		cmdl.add(meshOptimize_arg);
+		cmdl.add(meshPackNormals_arg);
+		cmdl.add(meshLodLevels_arg);
+		cmdl.add(meshLodDistance_arg);
+		cmdl.add(bvhCachePath_arg);
+		cmdl.add(soundCacheSize_arg);
+		cmdl.add(logLevel_arg);
+		cmdl.add(logCategories_arg);
+		cmdl.add(logAsync_arg);
+		cmdl.add(profileTrace_arg);
 
 		//input file arguments
 		
@@ -188,6 +234,29 @@ int OgreKit::setup(int argc, char** argv)
 		m_prefs.shadowtechnique			= shadowtechnique_arg.getValue();
 		m_prefs.fardistanceshadow		= fardistanceshadow_arg.getValue();	
 		m_prefs.shaderCachePath			= shaderCachePath_arg.getValue();
+		m_prefs.tickRate				= gkMax<int>(1, tickRate_arg.getValue());
+		m_prefs.headless				= headless_arg.getValue();
+		m_prefs.fastStep				= fastStep_arg.getValue();
+		m_prefs.maxTicks				= gkMax<int>(0, maxTicks_arg.getValue());
+		m_prefs.sceneThreads			= sceneThreads_arg.getValue();
+		m_prefs.loaderThreads			= loaderThreads_arg.getValue();
+		m_prefs.physicsThreads			= physicsThreads_arg.getValue();
+		m_prefs.rayThreads				= rayThreads_arg.getValue();
+		m_prefs.logicThreads			= logicThreads_arg.getValue();
+		m_prefs.physicsRate				= physicsRate_arg.getValue();
+		m_prefs.maxPhysicsSteps			= maxPhysicsSteps_arg.getValue();
+		m_prefs.clonePoolSize			= clonePoolSize_arg.getValue();
+		m_prefs.physicsInterpolation	= physicsInterpolation_arg.getValue();
+		m_prefs.meshOptimize			= meshOptimize_arg.getValue();
+		m_prefs.meshPackNormals			= meshPackNormals_arg.getValue();
+		m_prefs.meshLodLevels			= meshLodLevels_arg.getValue();
+		m_prefs.meshLodDistance			= meshLodDistance_arg.getValue();
+		m_prefs.bvhCachePath			= bvhCachePath_arg.getValue();
+		m_prefs.soundCacheSize			= soundCacheSize_arg.getValue();
+		m_prefs.logLevel				= logLevel_arg.getValue();
+		m_prefs.logCategories			= logCategories_arg.getValue();
+		m_prefs.logAsync				= logAsync_arg.getValue();
+		m_prefs.profileTrace			= profileTrace_arg.getValue();
 
 		if (colourshadow_arg.isSet())
 			m_prefs.colourshadow		= Ogre::StringConverter::parseColourValue(colourshadow_arg.getValue());
@@ -72,7 +72,8 @@ struct fbtChunk
 
 fbtFile::fbtFile(const char* uid)
 	:   m_version(-1), m_fileVersion(0), m_fileHeader(0), m_uhid(uid), m_aluhid(0),
-	    m_memory(0), m_file(0), m_curFile(0)
+	    m_memory(0), m_file(0), m_curFile(0),
+	    m_lazy(false), m_mapped(0), m_unlinked(0)
 {
 }
 
@@ -86,7 +87,7 @@ fbtFile::~fbtFile()
 	MemoryChunk* node = (MemoryChunk*)m_chunks.first, *tnd;
 	while (node)
 	{
-		if (node->m_block)
+		if (node->m_block && !(node->m_flag & MemoryChunk::BLK_MAPPED))
 		{
 			//printf("free  m_block: 0x%x\n", node->m_block);fflush(stdout);
 			fbtFree(node->m_block);
@@ -103,6 +104,7 @@ fbtFile::~fbtFile()
 		fbtFree(tnd);
 	}
 
+	delete m_mapped;
 	delete m_file;
 	delete m_memory;
 }
@@ -112,19 +114,41 @@ fbtFile::~fbtFile()
 int fbtFile::parse(const char* path, int mode)
 {
 	fbtStream* stream = 0;
+	bool mapped = false;
 
 	if (mode == PM_UNCOMPRESSED || mode == PM_COMPRESSED)
 	{
-#if FBT_USE_GZ_FILE == 1
-		if (mode == PM_COMPRESSED)
-			stream = new fbtGzStream();
-		else
-#endif
+		// Uncompressed files are mapped, chunks are then read in place.
+		fbtMappedStream* ms = new fbtMappedStream();
+		ms->open(path, fbtStream::SM_READ);
+
+		if (ms->isOpen() && ms->size() > 12)
 		{
-			stream = new fbtFileStream();
+			const char* hp = static_cast<const char*>(ms->ptr());
+			if (fbtCharNEq(hp, m_uhid, 7) || fbtCharNEq(hp, m_aluhid, 7))
+			{
+				delete m_mapped;
+				m_mapped = ms;
+				stream   = ms;
+				mapped   = true;
+			}
 		}
 
-		stream->open(path, fbtStream::SM_READ);
+		if (!stream)
+		{
+			delete ms;
+
+#if FBT_USE_GZ_FILE == 1
+			if (mode == PM_COMPRESSED)
+				stream = new fbtGzStream();
+			else
+#endif
+			{
+				stream = new fbtFileStream();
+			}
+
+			stream->open(path, fbtStream::SM_READ);
+		}
 	}
 	else
 	{
@@ -135,6 +159,7 @@ int fbtFile::parse(const char* path, int mode)
 	if (!stream->isOpen())
 	{
 		fbtPrintf("File '%s' loading failed\n", path);
+		delete stream;
 		return FS_FAILED;
 	}
 
@@ -152,7 +177,10 @@ int fbtFile::parse(const char* path, int mode)
 	}
 
 	int result = parseStreamImpl(stream);
-	delete stream;
+
+	// the mapping is released once every block is linked
+	if (!mapped)
+		delete stream;
 	return result;
 }
 
@@ -277,18 +305,36 @@ int fbtFile::parseStreamImpl(fbtStream* stream, bool suppressHeaderWarning)
 			break;
 
 
-		void* curPtr = fbtMalloc(chunk.m_len);
-		//printf("alloc curPtr: 0x%x\n", curPtr);fflush(stdout);
-		if (!curPtr)
+		void* curPtr = 0;
+
+		// the tables are swapped in place and owned by fbtBinTables, copy them
+		bool mapped = stream == m_mapped && chunk.m_code != DNA1;
+		if (mapped)
 		{
-			FBT_MALLOC_FAILED;
-			return FS_BAD_ALLOC;
-		}
+			if (stream->position() + chunk.m_len > stream->size())
+			{
+				FBT_INVALID_READ;
+				return FS_INV_READ;
+			}
 
-		if (stream->read(curPtr, chunk.m_len) <= 0)
+			curPtr = (void*)m_mapped->ptr();
+			stream->seek(chunk.m_len, SEEK_CUR);
+		}
+		else
 		{
-			FBT_INVALID_READ;
-			return FS_INV_READ;
+			curPtr = fbtMalloc(chunk.m_len);
+			//printf("alloc curPtr: 0x%x\n", curPtr);fflush(stdout);
+			if (!curPtr)
+			{
+				FBT_MALLOC_FAILED;
+				return FS_BAD_ALLOC;
+			}
+
+			if (stream->read(curPtr, chunk.m_len) <= 0)
+			{
+				FBT_INVALID_READ;
+				return FS_INV_READ;
+			}
 		}
 
 		if (chunk.m_code == DNA1)
@@ -318,7 +364,8 @@ int fbtFile::parseStreamImpl(fbtStream* stream, bool suppressHeaderWarning)
 			FBTsizeType pos;
 			if ((pos = m_map.find(chunk.m_old)) != FBT_NPOS)
 			{
-				fbtFree(curPtr);
+				if (!mapped)
+					fbtFree(curPtr);
 				curPtr = 0;
 				int result = fbtMemcmp(&m_map.at(pos)->m_chunk, &chunk, fbtChunk::BlockSize);
 				if (result != 0)
@@ -331,7 +378,8 @@ int fbtFile::parseStreamImpl(fbtStream* stream, bool suppressHeaderWarning)
 			if (m_map.find(chunk.m_old) != FBT_NPOS)
 			{
 				//printf("free  curPtr: 0x%x\n", curPtr);
-				fbtFree(curPtr);
+				if (!mapped)
+					fbtFree(curPtr);
 				curPtr = 0;
 			}
 #endif
@@ -345,6 +393,8 @@ int fbtFile::parseStreamImpl(fbtStream* stream, bool suppressHeaderWarning)
 				}
 				fbtMemset(bin, 0, sizeof(MemoryChunk));
 				bin->m_block = curPtr;
+				if (mapped)
+					bin->m_flag |= MemoryChunk::BLK_MAPPED;
 
 				Chunk* cp    = &bin->m_chunk;
 				cp->m_code   = chunk.m_code;
@@ -544,60 +594,78 @@ void castValue(FBTsize* srcPtr, FBTsize* dstPtr, FBT_PRIM_TYPE srctp, FBT_PRIM_T
 
 int fbtFile::link(void)
 {
-	fbtBinTables::OffsM::Pointer md = m_memory->m_offs.ptr();
-	fbtBinTables::OffsM::Pointer fd = m_file->m_offs.ptr();
-	FBTsizeType s2, i2, a2, n;
-	fbtStruct::Members::Pointer p2;
-	FBTsize mlen, malen, total, pi;
+	MemoryChunk* node;
+	int status;
 
-	char* dst, *src;
-	FBTsize* dstPtr, *srcPtr;
+	m_pending.clear(true);
+	m_unlinked = 0;
 
-	bool endianSwap = (m_fileHeader & FH_ENDIAN_SWAP) != 0;
-
-	static const FBThash hk = fbtCharHashKey("Link").hash();
+	for (node = (MemoryChunk*)m_chunks.first; node; node = node->m_next)
+		++m_unlinked;
 
 
-	MemoryChunk* node;
+	// Lazy files start from the roots, everything else is pulled in by
+	// resolving pointers or by linkBlocks.
 	for (node = (MemoryChunk*)m_chunks.first; node; node = node->m_next)
 	{
-		if (node->m_chunk.m_typeid > m_file->m_strcNr || !( fd[node->m_chunk.m_typeid]->m_link))
+		if (m_lazy && !isRoot(node->m_chunk))
 			continue;
 
-		fbtStruct* fs, *ms;
-		fs = fd[node->m_chunk.m_typeid];
-		ms = fs->m_link;
+		if (!(node->m_flag & MemoryChunk::BLK_LINKED) && (status = allocBlock(node)) != FS_OK)
+			return status;
+	}
 
-		node->m_newTypeId = ms->m_strcId;
+	return flushLinks();
+}
 
-		if (m_memory->m_type[ms->m_key.k16[0]].m_typeId == hk)
-		{
-			FBTsize totSize = node->m_chunk.m_len;
-			node->m_newBlock = fbtMalloc(totSize);
-			//printf("alloc1 m_newBlock: 0x%x %d\n", node->m_newBlock, totSize);fflush(stdout);
 
-			if (!node->m_newBlock)
-			{
-				FBT_MALLOC_FAILED;
-				return FS_BAD_ALLOC;
-			}
 
-			fbtMemcpy(node->m_newBlock, node->m_block, totSize);
-			continue;
-		}
+int fbtFile::linkBlocks(FBTuint32 code)
+{
+	if (!m_file)
+		return FS_FAILED;
 
+	if (m_unlinked == 0)
+		return FS_OK;
 
-		if (skip(m_memory->m_type[ms->m_key.k16[0]].m_typeId))
+	int status;
+	for (MemoryChunk* node = (MemoryChunk*)m_chunks.first; node; node = node->m_next)
+	{
+		if (node->m_flag & MemoryChunk::BLK_LINKED)
 			continue;
 
+		if ((code == 0 || node->m_chunk.m_code == code) && (status = allocBlock(node)) != FS_OK)
+			return status;
+	}
+
+	return flushLinks();
+}
+
+
 
-		FBTsize totSize = (node->m_chunk.m_nr * ms->m_len);
+int fbtFile::allocBlock(MemoryChunk* node)
+{
+	static const FBThash hk = fbtCharHashKey("Link").hash();
+
+	fbtBinTables::OffsM::Pointer fd = m_file->m_offs.ptr();
+
+	node->m_flag |= MemoryChunk::BLK_LINKED;
+	--m_unlinked;
+
+	if (node->m_chunk.m_typeid > m_file->m_strcNr || !( fd[node->m_chunk.m_typeid]->m_link))
+		return FS_OK;
 
-		node->m_chunk.m_len = totSize;
+	fbtStruct* fs, *ms;
+	fs = fd[node->m_chunk.m_typeid];
+	ms = fs->m_link;
 
+	node->m_newTypeId = ms->m_strcId;
 
+	if (m_memory->m_type[ms->m_key.k16[0]].m_typeId == hk)
+	{
+		FBTsize totSize = node->m_chunk.m_len;
 		node->m_newBlock = fbtMalloc(totSize);
-		//printf("alloc2 m_newBlock: 0x%x %d\n", node->m_newBlock, totSize);fflush(stdout);
+		//printf("alloc1 m_newBlock: 0x%x %d\n", node->m_newBlock, totSize);fflush(stdout);
 
 		if (!node->m_newBlock)
 		{
@@ -605,201 +673,272 @@ int fbtFile::link(void)
 			return FS_BAD_ALLOC;
 		}
 
+		fbtMemcpy(node->m_newBlock, node->m_block, totSize);
+		return FS_OK;
+	}
+
+
+	if (skip(m_memory->m_type[ms->m_key.k16[0]].m_typeId))
+		return FS_OK;
+
+
+	FBTsize totSize = (node->m_chunk.m_nr * ms->m_len);
 
+	node->m_chunk.m_len = totSize;
 
-		// always zero this
-		fbtMemset(node->m_newBlock, 0, totSize);
+
+	node->m_newBlock = fbtMalloc(totSize);
+	//printf("alloc2 m_newBlock: 0x%x %d\n", node->m_newBlock, totSize);fflush(stdout);
+
+	if (!node->m_newBlock)
+	{
+		FBT_MALLOC_FAILED;
+		return FS_BAD_ALLOC;
 	}
 
 
 
-	FBTuint8 mps = m_memory->m_ptr, fps = m_file->m_ptr;
+	// always zero this
+	fbtMemset(node->m_newBlock, 0, totSize);
 
-	for (node = (MemoryChunk*)m_chunks.first; node; node = node->m_next)
+	m_pending.push_back(node);
+	return FS_OK;
+}
+
+
+
+int fbtFile::flushLinks(void)
+{
+	int status = FS_OK;
+
+	// converting a block may queue the blocks it points to
+	for (FBTsizeType i = 0; i < m_pending.size(); ++i)
 	{
-		if (node->m_newTypeId > m_memory->m_strcNr)
-			continue;
+		if ((status = convertBlock(m_pending.at(i))) != FS_OK)
+			break;
+	}
 
+	m_pending.clear(true);
 
+	if (m_unlinked == 0)
+		releaseRaw();
 
-		fbtStruct* cs = md[node->m_newTypeId];
-		if (m_memory->m_type[cs->m_key.k16[0]].m_typeId == hk)
-			continue;
+	return status;
+}
 
-		if (!cs->m_link || skip(m_memory->m_type[cs->m_key.k16[0]].m_typeId) || !node->m_newBlock)
-		{
-			//printf("free  m_newBlock: 0x%x \n", node->m_newBlock);fflush(stdout);
 
-			fbtFree(node->m_newBlock);
-			node->m_newBlock = 0;
 
-			continue;
+void fbtFile::releaseRaw(void)
+{
+	for (MemoryChunk* node = (MemoryChunk*)m_chunks.first; node; node = node->m_next)
+	{
+		if (node->m_block)
+		{
+			if (!(node->m_flag & MemoryChunk::BLK_MAPPED))
+				fbtFree(node->m_block);
+			node->m_block = 0;
 		}
+	}
 
-		s2 = cs->m_members.size();
-		p2 = cs->m_members.ptr();
+	delete m_mapped;
+	m_mapped = 0;
+}
 
-		for (n = 0; n < node->m_chunk.m_nr; ++n)
-		{
-			dst = static_cast<char*>(node->m_newBlock) + (cs->m_len * n);
-			src = static_cast<char*>(node->m_block) + (cs->m_link->m_len * n);
 
 
-			for (i2 = 0; i2 < s2; ++i2)
-			{
-				fbtStruct* dstStrc = &p2[i2];
-				fbtStruct* srcStrc = dstStrc->m_link;
+int fbtFile::convertBlock(MemoryChunk* node)
+{
+	static const FBThash hk = fbtCharHashKey("Link").hash();
 
-				// If it's missing we can safely skip this block
-				if (!srcStrc)
-					continue;
+	fbtBinTables::OffsM::Pointer md = m_memory->m_offs.ptr();
+	FBTsizeType s2, i2, a2, n;
+	fbtStruct::Members::Pointer p2;
+	FBTsize mlen, malen, total, pi;
 
+	char* dst, *src;
+	FBTsize* dstPtr, *srcPtr;
+
+	bool endianSwap = (m_fileHeader & FH_ENDIAN_SWAP) != 0;
+	bool listBlock  = m_lazy && isListBlock(node->m_chunk);
+
+	FBTuint8 mps = m_memory->m_ptr, fps = m_file->m_ptr;
+
+	if (node->m_newTypeId > m_memory->m_strcNr)
+		return FS_OK;
+
+
+	fbtStruct* cs = md[node->m_newTypeId];
+	if (m_memory->m_type[cs->m_key.k16[0]].m_typeId == hk)
+		return FS_OK;
+
+	if (!cs->m_link || skip(m_memory->m_type[cs->m_key.k16[0]].m_typeId) || !node->m_newBlock)
+	{
+		//printf("free  m_newBlock: 0x%x \n", node->m_newBlock);fflush(stdout);
+
+		fbtFree(node->m_newBlock);
+		node->m_newBlock = 0;
+
+		return FS_OK;
+	}
+
+	s2 = cs->m_members.size();
+	p2 = cs->m_members.ptr();
+
+	for (n = 0; n < node->m_chunk.m_nr; ++n)
+	{
+		dst = static_cast<char*>(node->m_newBlock) + (cs->m_len * n);
+		src = static_cast<char*>(node->m_block) + (cs->m_link->m_len * n);
+
+
+		for (i2 = 0; i2 < s2; ++i2)
+		{
+			fbtStruct* dstStrc = &p2[i2];
+			fbtStruct* srcStrc = dstStrc->m_link;
+
+			// If it's missing we can safely skip this block
+			if (!srcStrc)
+				continue;
 
-				dstPtr = reinterpret_cast<FBTsize*>(dst + dstStrc->m_off);
-				srcPtr = reinterpret_cast<FBTsize*>(src + srcStrc->m_off);
 
+			dstPtr = reinterpret_cast<FBTsize*>(dst + dstStrc->m_off);
+			srcPtr = reinterpret_cast<FBTsize*>(src + srcStrc->m_off);
 
 
-				const fbtName& nameD = m_memory->m_name[dstStrc->m_key.k16[1]];
-				const fbtName& nameS = m_file->m_name[srcStrc->m_key.k16[1]];
 
+			const fbtName& nameD = m_memory->m_name[dstStrc->m_key.k16[1]];
+			const fbtName& nameS = m_file->m_name[srcStrc->m_key.k16[1]];
 
-				if (nameD.m_ptrCount > 0)
+
+			if (nameD.m_ptrCount > 0)
+			{
+				// next / prev are rebuilt by notifyData
+				if (listBlock && dstStrc->m_off < 2 * mps)
+					continue;
+
+				if ((*srcPtr))
 				{
-					if ((*srcPtr))
+					if (nameD.m_ptrCount  > 1)
 					{
-						if (nameD.m_ptrCount  > 1)
+						MemoryChunk* bin = findBlock((FBTsize)(*srcPtr));
+						if (bin)
 						{
-							MemoryChunk* bin = findBlock((FBTsize)(*srcPtr));
-							if (bin)
+							if (!(bin->m_flag & MemoryChunk::BLK_LINKED))
+								allocBlock(bin);
+
+							if (bin->m_flag & MemoryChunk::BLK_MODIFIED)
+								(*dstPtr) = (FBTsize)bin->m_newBlock;
+							else
 							{
-								if (bin->m_flag & MemoryChunk::BLK_MODIFIED)
-									(*dstPtr) = (FBTsize)bin->m_newBlock;
-								else
-								{
-									// take pointer size out of the equation
-									total = bin->m_chunk.m_len / fps;
+								// take pointer size out of the equation
+								total = bin->m_chunk.m_len / fps;
 
 
-									FBTsize* nptr = (FBTsize*)fbtMalloc(total * mps);
-									fbtMemset(nptr, 0, total * mps);
+								FBTsize* nptr = (FBTsize*)fbtMalloc(total * mps);
+								fbtMemset(nptr, 0, total * mps);
 
-									// always use 32 bit, then offset + 2 for 64 bit (Old pointers are sorted in this mannor)
-									FBTuint32* optr = (FBTuint32*)bin->m_block;
+								// always use 32 bit, then offset + 2 for 64 bit (Old pointers are sorted in this mannor)
+								FBTuint32* optr = (FBTuint32*)bin->m_block;
 
 
-									for (pi = 0; pi < total; pi++, optr += (fps == 4 ? 1 : 2))
-										nptr[pi] = (FBTsize)findPtr((FBTsize) * optr);
+								for (pi = 0; pi < total; pi++, optr += (fps == 4 ? 1 : 2))
+									nptr[pi] = (FBTsize)findPtr((FBTsize) * optr);
 
-									(*dstPtr) = (FBTsize)(nptr);
+								(*dstPtr) = (FBTsize)(nptr);
 
-									bin->m_chunk.m_len = total * mps;
-									bin->m_flag |= MemoryChunk::BLK_MODIFIED;
+								bin->m_chunk.m_len = total * mps;
+								bin->m_flag |= MemoryChunk::BLK_MODIFIED;
 
-									fbtFree(bin->m_newBlock);
-									bin->m_newBlock = nptr;
-								}
-							}
-							else
-							{
-								//fbtPrintf("**block not found @ 0x%p)\n", src);
+								fbtFree(bin->m_newBlock);
+								bin->m_newBlock = nptr;
 							}
 						}
 						else
 						{
-							malen = nameD.m_arraySize > nameS.m_arraySize ? nameS.m_arraySize : nameD.m_arraySize;
+							//fbtPrintf("**block not found @ 0x%p)\n", src);
+						}
+					}
+					else
+					{
+						malen = nameD.m_arraySize > nameS.m_arraySize ? nameS.m_arraySize : nameD.m_arraySize;
 
-							FBTsize* dptr = (FBTsize*)dstPtr;
+						FBTsize* dptr = (FBTsize*)dstPtr;
 
-							// always use 32 bit, then offset + 2 for 64 bit (Old pointers are sorted in this mannor)
-							FBTuint32* sptr = (FBTuint32*)srcPtr;
+						// always use 32 bit, then offset + 2 for 64 bit (Old pointers are sorted in this mannor)
+						FBTuint32* sptr = (FBTuint32*)srcPtr;
 
 
-							for (a2 = 0; a2 < malen; ++a2, sptr += (fps == 4 ? 1 : 2))
-								dptr[a2] = (FBTsize)findPtr((FBTsize) * sptr);
-						}
+						for (a2 = 0; a2 < malen; ++a2, sptr += (fps == 4 ? 1 : 2))
+							dptr[a2] = (FBTsize)findPtr((FBTsize) * sptr);
 					}
 				}
-				else
-				{
-					FBTsize dstElmSize = dstStrc->m_len / nameD.m_arraySize;
-					FBTsize srcElmSize = srcStrc->m_len / nameS.m_arraySize;
+			}
+			else
+			{
+				FBTsize dstElmSize = dstStrc->m_len / nameD.m_arraySize;
+				FBTsize srcElmSize = srcStrc->m_len / nameS.m_arraySize;
 
-					bool needCast = (dstStrc->m_flag & fbtStruct::NEED_CAST) != 0;
-					bool needSwap = endianSwap && srcElmSize > 1;
+				bool needCast = (dstStrc->m_flag & fbtStruct::NEED_CAST) != 0;
+				bool needSwap = endianSwap && srcElmSize > 1;
 
-					if (!needCast && !needSwap && srcStrc->m_val.k32[0] == dstStrc->m_val.k32[0]) //same type
-					{						
-						// Take the minimum length of any array.
-						mlen = fbtMin(srcStrc->m_len, dstStrc->m_len);
+				if (!needCast && !needSwap && srcStrc->m_val.k32[0] == dstStrc->m_val.k32[0]) //same type
+				{						
+					// Take the minimum length of any array.
+					mlen = fbtMin(srcStrc->m_len, dstStrc->m_len);
 
-						fbtMemcpy(dstPtr, srcPtr, mlen);
-						continue;
-					}
+					fbtMemcpy(dstPtr, srcPtr, mlen);
+					continue;
+				}
 
-					FBTbyte* dstBPtr = reinterpret_cast<FBTbyte*>(dstPtr);
-					FBTbyte* srcBPtr = reinterpret_cast<FBTbyte*>(srcPtr);
+				FBTbyte* dstBPtr = reinterpret_cast<FBTbyte*>(dstPtr);
+				FBTbyte* srcBPtr = reinterpret_cast<FBTbyte*>(srcPtr);
 
-					FBT_PRIM_TYPE stp = FBT_PRIM_UNKNOWN, dtp  = FBT_PRIM_UNKNOWN;
+				FBT_PRIM_TYPE stp = FBT_PRIM_UNKNOWN, dtp  = FBT_PRIM_UNKNOWN;
 
-					if (needCast || needSwap)
-					{
-						stp = fbtGetPrimType(srcStrc->m_val.k32[0]);
-						dtp = fbtGetPrimType(dstStrc->m_val.k32[0]);
+				if (needCast || needSwap)
+				{
+					stp = fbtGetPrimType(srcStrc->m_val.k32[0]);
+					dtp = fbtGetPrimType(dstStrc->m_val.k32[0]);
 
-						FBT_ASSERT(fbtIsNumberType(stp) && fbtIsNumberType(dtp) && stp != dtp);
-					}
+					FBT_ASSERT(fbtIsNumberType(stp) && fbtIsNumberType(dtp) && stp != dtp);
+				}
 
-					FBTsize alen = fbtMin(nameS.m_arraySize, nameD.m_arraySize);
-					FBTsize elen = fbtMin(srcElmSize, dstElmSize);
+				FBTsize alen = fbtMin(nameS.m_arraySize, nameD.m_arraySize);
+				FBTsize elen = fbtMin(srcElmSize, dstElmSize);
 
-					FBTbyte tmpBuf[8] = {0, };
-					FBTsize i;
-					for (i = 0; i < alen; i++)
+				FBTbyte tmpBuf[8] = {0, };
+				FBTsize i;
+				for (i = 0; i < alen; i++)
+				{
+					FBTbyte* tmp = srcBPtr;
+					if (needSwap)
 					{
-						FBTbyte* tmp = srcBPtr;
-						if (needSwap)
-						{
-							tmp = tmpBuf;
-							fbtMemcpy(tmpBuf, srcBPtr, srcElmSize);
-
-							if (stp == FBT_PRIM_SHORT || stp == FBT_PRIM_USHORT) 
-								fbtSwap16((FBTuint16*)tmpBuf, 1);
-							else if (stp >= FBT_PRIM_INT && stp <= FBT_PRIM_FLOAT) 
-								fbtSwap32((FBTuint32*)tmpBuf, 1);
-							else if (stp == FBT_PRIM_DOUBLE)
-								fbtSwap64((FBTuint64*)tmpBuf, 1);
-							else
-								fbtMemset(tmpBuf, 0, sizeof(tmpBuf)); //unknown type
-						}
-						
-						if (needCast)
-							castValue((FBTsize*)tmp, (FBTsize*)dstBPtr, stp, dtp, 1);
+						tmp = tmpBuf;
+						fbtMemcpy(tmpBuf, srcBPtr, srcElmSize);
+
+						if (stp == FBT_PRIM_SHORT || stp == FBT_PRIM_USHORT) 
+							fbtSwap16((FBTuint16*)tmpBuf, 1);
+						else if (stp >= FBT_PRIM_INT && stp <= FBT_PRIM_FLOAT) 
+							fbtSwap32((FBTuint32*)tmpBuf, 1);
+						else if (stp == FBT_PRIM_DOUBLE)
+							fbtSwap64((FBTuint64*)tmpBuf, 1);
 						else
-							fbtMemcpy(dstBPtr, tmp, elen);
-
-						dstBPtr += dstElmSize;
-						srcBPtr += srcElmSize;
+							fbtMemset(tmpBuf, 0, sizeof(tmpBuf)); //unknown type
 					}
+					
+					if (needCast)
+						castValue((FBTsize*)tmp, (FBTsize*)dstBPtr, stp, dtp, 1);
+					else
+						fbtMemcpy(dstBPtr, tmp, elen);
+
+					dstBPtr += dstElmSize;
+					srcBPtr += srcElmSize;
 				}
 			}
 		}
-
-		notifyData(node->m_newBlock, node->m_chunk);
-	}
-
-
-
-	for (node = (MemoryChunk*)m_chunks.first; node; node = node->m_next)
-	{
-		if (node->m_block)
-		{
-			fbtFree(node->m_block);
-			node->m_block = 0;
-		}
 	}
 
-	return fbtFile::FS_OK;
+	notifyData(node->m_newBlock, node->m_chunk);
+	return FS_OK;
 }
 
 
@@ -809,7 +948,12 @@ void* fbtFile::findPtr(const FBTsize& iptr)
 {
 	FBTsizeType i;
 	if ((i = m_map.find(iptr)) != FBT_NPOS)
-		return m_map.at(i)->m_newBlock;
+	{
+		MemoryChunk* bin = m_map.at(i);
+		if (!(bin->m_flag & MemoryChunk::BLK_LINKED))
+			allocBlock(bin);
+		return bin->m_newBlock;
+	}
 	return 0;
 }
 
@@ -823,6 +967,12 @@ fbtFile::MemoryChunk* fbtFile::findBlock(const FBTsize& iptr)
 }
 
 
+bool fbtFile::isRoot(const Chunk& id)
+{
+	return id.m_code != DATA;
+}
+
+
 
 int fbtFile::compileOffsets(void)
 {
@@ -33,6 +33,7 @@
 */
 
 class fbtStream;
+class fbtMappedStream;
 class fbtBinTables;
 
 
@@ -115,6 +116,8 @@ public:
 		enum Flag
 		{
 			BLK_MODIFIED = (1 << 0),
+			BLK_MAPPED   = (1 << 1), // m_block points into the mapped file
+			BLK_LINKED   = (1 << 2), // m_newBlock is allocated, converted or queued
 		};
 
 		MemoryChunk* m_next, *m_prev;
@@ -152,6 +155,17 @@ public:
 
 	fbtList& getChunks(void) {return m_chunks;}
 
+
+	/// Lazily linked files only convert the blocks isRoot() accepts while
+	/// parsing, every other block is converted once a pointer to it is
+	/// resolved or linkBlocks() asks for it. Set before parse().
+	void setLazyLink(bool v)        {m_lazy = v;}
+	bool isLazyLink(void) const     {return m_lazy;}
+
+	/// Convert all blocks with the chunk code (0 = every block) and
+	/// whatever they point to.
+	int linkBlocks(FBTuint32 code = 0);
+
     virtual void setIgnoreList(FBTuint32 *stripList) {}
 
 	bool _setuid(const char* uid);
@@ -188,9 +202,24 @@ protected:
 
 
 	virtual bool skip(const FBTuint32& id) {return false;}
+
+	// Blocks converted up front by lazily linked files.
+	virtual bool isRoot(const Chunk& id);
+
+	// Blocks starting with next / prev pointers that notifyData relinks,
+	// lazily linked files do not follow them.
+	virtual bool isListBlock(const Chunk& id) {return false;}
+
 	void* findPtr(const FBTsize& iptr);
 	MemoryChunk* findBlock(const FBTsize& iptr);
 
+	typedef fbtArray<MemoryChunk*> ChunkQueue;
+
+	bool             m_lazy;
+	fbtMappedStream* m_mapped;
+	ChunkQueue       m_pending;
+	FBTsizeType      m_unlinked;
+
 private:
 
 
@@ -199,6 +228,11 @@ private:
 
 	int compileOffsets(void);
 	int link(void);
+
+	int   allocBlock(MemoryChunk* node);
+	int   convertBlock(MemoryChunk* node);
+	int   flushLinks(void);
+	void  releaseRaw(void);
 };
 
 /** @}*/
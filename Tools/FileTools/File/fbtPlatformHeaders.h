@@ -40,6 +40,11 @@
 # include <windows.h>
 # include <io.h>
 #else
+# include <sys/types.h>
+# include <sys/stat.h>
+# include <sys/mman.h>
+# include <fcntl.h>
+# include <unistd.h>
 #endif
 
 #include <stdio.h>
@@ -502,3 +502,131 @@ void fbtMemoryStream::reserve(FBTsize nr)
 		m_capacity = nr;
 	}
 }
+
+
+
+fbtMappedStream::fbtMappedStream()
+	:   m_buffer(0), m_pos(0), m_size(0), m_file(0), m_mapping(0)
+{
+}
+
+
+fbtMappedStream::~fbtMappedStream()
+{
+	close();
+}
+
+
+void fbtMappedStream::open(const char* path, fbtStream::StreamMode mode)
+{
+	close();
+
+	if (!path || (mode & fbtStream::SM_WRITE))
+		return;
+
+#if FBT_PLATFORM == FBT_PLATFORM_WIN32
+
+	HANDLE fh = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+	if (fh == INVALID_HANDLE_VALUE)
+		return;
+
+	DWORD len = GetFileSize(fh, 0);
+	if (len == INVALID_FILE_SIZE || len == 0)
+	{
+		CloseHandle(fh);
+		return;
+	}
+
+	HANDLE mh = CreateFileMappingA(fh, 0, PAGE_READONLY, 0, 0, 0);
+	if (!mh)
+	{
+		CloseHandle(fh);
+		return;
+	}
+
+	void* buf = MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+	if (!buf)
+	{
+		CloseHandle(mh);
+		CloseHandle(fh);
+		return;
+	}
+
+	m_file    = fh;
+	m_mapping = mh;
+	m_buffer  = (const char*)buf;
+	m_size    = len;
+
+#else
+
+	int fd = ::open(path, O_RDONLY);
+	if (fd < 0)
+		return;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size <= 0)
+	{
+		::close(fd);
+		return;
+	}
+
+	void* buf = mmap(0, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// the mapping keeps its own reference to the file
+	::close(fd);
+
+	if (buf == MAP_FAILED)
+		return;
+
+	m_buffer  = (const char*)buf;
+	m_size    = (FBTsize)st.st_size;
+
+#endif
+
+	m_pos = 0;
+}
+
+
+void fbtMappedStream::close(void)
+{
+	if (m_buffer)
+	{
+#if FBT_PLATFORM == FBT_PLATFORM_WIN32
+		UnmapViewOfFile(m_buffer);
+		CloseHandle((HANDLE)m_mapping);
+		CloseHandle((HANDLE)m_file);
+#else
+		munmap((void*)m_buffer, m_size);
+#endif
+	}
+
+	m_buffer  = 0;
+	m_file    = 0;
+	m_mapping = 0;
+	m_size    = m_pos = 0;
+}
+
+
+FBTsize fbtMappedStream::seek(FBTint32 off, FBTint32 way)
+{
+	if (way == SEEK_SET)
+		m_pos = fbtClamp<FBTsize>(off, 0, m_size);
+	else if (way == SEEK_CUR)
+		m_pos = fbtClamp<FBTsize>(m_pos + off, 0, m_size);
+	else if (way == SEEK_END)
+		m_pos = m_size;
+	return m_pos;
+}
+
+
+FBTsize fbtMappedStream::read(void* dest, FBTsize nr) const
+{
+	if (m_pos > m_size) return 0;
+	if (!dest || !m_buffer) return 0;
+
+	if ((m_size - m_pos) < nr) nr = m_size - m_pos;
+
+	fbtMemcpy(dest, m_buffer + m_pos, nr);
+	m_pos += nr;
+	return nr;
+}
@@ -184,5 +184,39 @@ protected:
 	int              m_mode;
 };
 
+
+
+// Read only view of a whole file mapped into memory, reading
+// hands out pointers into the mapping instead of copying.
+class fbtMappedStream : public fbtStream
+{
+public:
+	fbtMappedStream();
+	~fbtMappedStream();
+
+	void open(const char* path, fbtStream::StreamMode mode);
+	void close(void);
+
+	bool     isOpen(void)    const   {return m_buffer != 0;}
+	bool     eof(void)       const   {return !m_buffer || m_pos >= m_size;}
+	FBTsize  position(void)  const   {return m_pos;}
+	FBTsize  size(void)      const   {return m_size;}
+
+	FBTsize  read(void* dest, FBTsize nr) const;
+	FBTsize  write(const void* src, FBTsize nr) {return 0;}
+
+	// memory at the current position
+	const void* ptr(void) const {return m_buffer ? m_buffer + m_pos : 0;}
+
+	FBTsize seek(FBTint32 off, FBTint32 way);
+
+protected:
+
+	const char*      m_buffer;
+	mutable FBTsize  m_pos;
+	FBTsize          m_size;
+	fbtFileHandle    m_file, m_mapping;
+};
+
 /** @}*/
 #endif//_fbtStreams_h_
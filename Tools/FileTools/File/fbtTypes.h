@@ -361,6 +361,7 @@ public:
 		if (!link)
 			return;
 
+		link->next = 0;
 		link->prev = last;
 		if (last)
 			last->next = link;
@@ -78,7 +78,7 @@ extern int bfBlenderLen;
 
 
 fbtBlend::fbtBlend()
-	:   fbtFile("BLENDER"), m_stripList(0)
+	:   fbtFile("BLENDER"), m_fg(0), m_stripList(0)
 {
 	m_aluhid = "BLENDEs"; //a stripped blend file
 }
@@ -170,6 +170,52 @@ bool fbtBlend::skip(const FBTuint32& id)
 }
 
 
+bool fbtBlend::isRoot(const Chunk& id)
+{
+	// the globals lead to the active scene, lists are linked on request
+	if (m_lazy)
+		return id.m_code == GLOB;
+	return fbtFile::isRoot(id);
+}
+
+
+bool fbtBlend::isListBlock(const Chunk& id)
+{
+	return id.m_code <= 0xFFFF;
+}
+
+
+int fbtBlend::linkList(fbtList fbtBlend::*list)
+{
+	int i = 0;
+	while (fbtData[i].m_code != 0 && fbtData[i].m_ptr != list)
+		++i;
+
+	FBTuint16 code = fbtData[i].m_code;
+	if (code == 0)
+		return FS_FAILED;
+
+	if (!m_lazy)
+		return FS_OK;
+
+	int status = linkBlocks(code);
+	if (status != FS_OK)
+		return status;
+
+	// blocks reached through pointers were added in link order
+	fbtList& lst = this->*list;
+	lst.clear();
+
+	for (MemoryChunk* node = (MemoryChunk*)m_chunks.first; node; node = node->m_next)
+	{
+		if (node->m_chunk.m_code == code && node->m_newBlock)
+			lst.push_back(node->m_newBlock);
+	}
+
+	return FS_OK;
+}
+
+
 void*   fbtBlend::getFBT(void)
 {
 	return (void*)bfBlenderFBT;
@@ -183,5 +229,11 @@ FBTsize fbtBlend::getFBTlength(void)
 int fbtBlend::save(const char *path, const int mode)
 {
 	m_version = m_fileVersion;
+
+	// everything is written, not only what was linked so far
+	int status = linkBlocks();
+	if (status != FS_OK)
+		return status;
+
 	return reflect(path, mode);
 }
@@ -70,6 +70,10 @@ public:
 	Blender::FileGlobal* m_fg;
 
 	int save(const char* path, const int mode = PM_UNCOMPRESSED);
+
+	/// Links every block of a lazily linked file that belongs to the ID list
+	/// and rebuilds it in file order. Call before walking one of the lists.
+	int linkList(fbtList fbtBlend::*list);
 	
 	void setIgnoreList(FBTuint32 *stripList) {m_stripList = stripList;}
 
@@ -77,6 +81,8 @@ protected:
 	virtual int notifyData(void* p, const Chunk& id);
 	virtual int initializeTables(fbtBinTables* tables);
 	virtual bool skip(const FBTuint32& id);
+	virtual bool isRoot(const Chunk& id);
+	virtual bool isListBlock(const Chunk& id);
 	virtual int writeData(fbtStream* stream);
 
 	FBTuint32* m_stripList;
@@ -28,13 +28,23 @@ bool parseBlendFile(const char *fname)
 
 bool parse_Ptr_PtrPtr_PtrArray(const char *fname, 
 						      int& ptrPtrCount,
-						      int& ptrArrayCount)
+						      int& ptrArrayCount,
+						      bool lazy = false)
 {
 	fbtBlend fp;
-	bool parseOk = fp.parse(fname, fbtFile::PM_READTOMEMORY) == fbtFile::FS_OK;
+	fp.setLazyLink(lazy);
+
+	bool parseOk = fp.parse(fname, lazy ? fbtFile::PM_UNCOMPRESSED : fbtFile::PM_READTOMEMORY) == fbtFile::FS_OK;
 	if (!parseOk)
 		return false;
 
+	if (lazy)
+	{
+		fp.linkList(&fbtBlend::m_text);
+		fp.linkList(&fbtBlend::m_screen);
+		fp.linkList(&fbtBlend::m_object);
+	}
+
 	for (Blender::Text* tx = (Blender::Text*)fp.m_text.first; tx; tx = (Blender::Text*)tx->id.next)
 	{
 		for (Blender::TextLine* tl = (Blender::TextLine*)tx->lines.first; tl; tl = tl->next)
@@ -128,6 +138,67 @@ TEST(TEST_CASE_NAME, parsePointer64BitLinks)
 	ASSERT_EQ(ptrArrayCount, 24);
 }
 
+TEST(TEST_CASE_NAME, parsePointerLazyLinks)
+{
+	int ptrPtrCount;
+	int ptrArrayCount;
+	EXPECT_TRUE(parse_Ptr_PtrPtr_PtrArray("TestData/le32bitLink.blend", ptrPtrCount, ptrArrayCount, true));
+
+	ASSERT_EQ(ptrPtrCount, 4);
+	ASSERT_EQ(ptrArrayCount, 24);
+
+	EXPECT_TRUE(parse_Ptr_PtrPtr_PtrArray("TestData/le64bitLink.blend", ptrPtrCount, ptrArrayCount, true));
+
+	ASSERT_EQ(ptrPtrCount, 4);
+	ASSERT_EQ(ptrArrayCount, 24);
+}
+
+std::string objectNames(fbtBlend& fp)
+{
+	std::string names;
+	for (Object* ob = (Object*)fp.m_object.first; ob; ob = (Object*)ob->id.next)
+	{
+		names += GKB_IDNAME(ob);
+		names += ob->data ? ((ID*)ob->data)->name : "-";
+		names += ob->parent ? GKB_IDNAME(ob->parent) : "-";
+		names += ";";
+	}
+	return names;
+}
+
+TEST(TEST_CASE_NAME, mappedAndLazyMatchMemory)
+{
+	const char* files[] =
+	{
+		"TestData/be32bit.blend",
+		"TestData/le32bit.blend",
+		"TestData/le32bitLink.blend",
+		"TestData/le64bitLink.blend",
+		0
+	};
+
+	for (int i = 0; files[i]; ++i)
+	{
+		fbtBlend memory, mapped, lazy;
+		lazy.setLazyLink(true);
+
+		ASSERT_EQ(memory.parse(files[i], fbtFile::PM_READTOMEMORY), fbtFile::FS_OK);
+		ASSERT_EQ(mapped.parse(files[i], fbtFile::PM_UNCOMPRESSED), fbtFile::FS_OK);
+		ASSERT_EQ(lazy.parse(files[i], fbtFile::PM_UNCOMPRESSED), fbtFile::FS_OK);
+
+		std::string expected = objectNames(memory);
+		EXPECT_FALSE(expected.empty());
+		EXPECT_EQ(expected, objectNames(mapped));
+
+		ASSERT_EQ(lazy.linkList(&fbtBlend::m_object), fbtFile::FS_OK);
+		EXPECT_EQ(expected, objectNames(lazy));
+
+		// linking the rest keeps the list intact
+		ASSERT_EQ(lazy.linkBlocks(), fbtFile::FS_OK);
+		EXPECT_EQ(expected, objectNames(lazy));
+	}
+}
+
 TEST(TEST_CASE_NAME, parseBlend32bit)
 {	
 	EXPECT_TRUE(parseBlendFile("TestData/be32bit.blend"));
@@ -0,0 +1,134 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+#include "utChainedHashTable.h"
+
+
+// Nanoseconds per operation for one pass over the key set.
+#define BENCH_NS_PER_OP(start, nr) ((clock.getTimeMicroseconds() - (start)) * 1000 / (nr))
+
+
+template<typename Table, typename Key>
+static void benchHashTable(gkBenchmark* bench, btClock& clock, const gkString& prefix,
+                           const utArray<Key>& keys, const utArray<Key>& misses, int reps)
+{
+	gkBenchResult* insertRes = bench->getResult(prefix + ".insert", "ns");
+	gkBenchResult* hitRes    = bench->getResult(prefix + ".find", "ns");
+	gkBenchResult* missRes   = bench->getResult(prefix + ".miss", "ns");
+	gkBenchResult* removeRes = bench->getResult(prefix + ".remove", "ns");
+	gkBenchResult* clearRes  = bench->getResult(prefix + ".clear");
+
+	const UTsize nr = keys.size();
+	UTsize found = 0;
+
+	Table table;
+	for (int r = 0; r < reps; ++r)
+	{
+		unsigned long start = clock.getTimeMicroseconds();
+		for (UTsize i = 0; i < nr; ++i)
+			table.insert(keys[i], (int)i);
+		insertRes->add(BENCH_NS_PER_OP(start, nr));
+
+		// lookups alternate keys so the last-key cache never hits
+		start = clock.getTimeMicroseconds();
+		for (UTsize i = 0; i < nr; ++i)
+			found += table.find(keys[(i * 7919) % nr]) != UT_NPOS;
+		hitRes->add(BENCH_NS_PER_OP(start, nr));
+
+		start = clock.getTimeMicroseconds();
+		for (UTsize i = 0; i < misses.size(); ++i)
+			found += table.find(misses[i]) != UT_NPOS;
+		missRes->add(BENCH_NS_PER_OP(start, misses.size()));
+
+		start = clock.getTimeMicroseconds();
+		for (UTsize i = 0; i < nr; i += 2)
+			table.remove(keys[i]);
+		removeRes->add(BENCH_NS_PER_OP(start, nr / 2));
+
+		start = clock.getTimeMicroseconds();
+		table.clear(true);
+		clearRes->add(clock.getTimeMicroseconds() - start);
+	}
+
+	// keep the lookups alive
+	if (found == UT_NPOS)
+		gkPrintf("%u\n", (unsigned int)found);
+}
+
+
+void gkBenchmark::benchHashTables(void)
+{
+	static const UTsize sizes[] = { 64, 4096, 131072, 0 };
+
+	int reps = gkMax(m_iterations / 10, 3);
+
+	for (int s = 0; sizes[s]; ++s)
+	{
+		const UTsize nr = sizes[s];
+		const gkString size = Ogre::StringConverter::toString((unsigned int)nr);
+
+		// sparse ints, like vertex indices in gkSubMeshIndexer
+		utArray<utIntHashKey> ints, intMisses;
+		for (UTsize i = 0; i < nr; ++i)
+		{
+			ints.push_back((int)(i * 3));
+			intMisses.push_back((int)(i * 3 + 1));
+		}
+
+		// object names, like gkScene::getObject
+		utArray<gkHashedString> names, nameMisses;
+		for (UTsize i = 0; i < nr; ++i)
+		{
+			names.push_back(gkString("Object.") + Ogre::StringConverter::toString((unsigned int)i));
+			nameMisses.push_back(gkString("Missing.") + Ogre::StringConverter::toString((unsigned int)i));
+		}
+
+		// heap addresses, like the game object sets
+		utArray<char*> blocks;
+		utArray<utPointerHashKey> ptrs, ptrMisses;
+		for (UTsize i = 0; i < nr * 2; ++i)
+		{
+			blocks.push_back(new char[32]);
+			if (i & 1)
+				ptrMisses.push_back(blocks[i]);
+			else
+				ptrs.push_back(blocks[i]);
+		}
+
+		benchHashTable<utHashTable<utIntHashKey, int> >(this, m_clock, "hash.open.int." + size, ints, intMisses, reps);
+		benchHashTable<utChainedHashTable<utIntHashKey, int> >(this, m_clock, "hash.chained.int." + size, ints, intMisses, reps);
+
+		benchHashTable<utHashTable<gkHashedString, int> >(this, m_clock, "hash.open.string." + size, names, nameMisses, reps);
+		benchHashTable<utChainedHashTable<gkHashedString, int> >(this, m_clock, "hash.chained.string." + size, names, nameMisses, reps);
+
+		benchHashTable<utHashTable<utPointerHashKey, int> >(this, m_clock, "hash.open.pointer." + size, ptrs, ptrMisses, reps);
+		benchHashTable<utChainedHashTable<utPointerHashKey, int> >(this, m_clock, "hash.chained.pointer." + size, ptrs, ptrMisses, reps);
+
+		for (UTsize i = 0; i < blocks.size(); ++i)
+			delete [] blocks[i];
+	}
+}
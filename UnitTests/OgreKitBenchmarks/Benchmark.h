@@ -0,0 +1,104 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _Benchmark_h_
+#define _Benchmark_h_
+
+#include "OgreKit.h"
+#include "LinearMath/btQuickprof.h"
+#include <algorithm>
+#include <vector>
+
+
+class gkBenchResult
+{
+public:
+	gkString                name;
+	gkString                unit;
+	utArray<unsigned long>  samples;
+
+	gkBenchResult(const gkString& n, const gkString& u = "us") : name(n), unit(u) {}
+
+	void add(unsigned long v) { samples.push_back(v); }
+
+	void summarize(unsigned long& mn, unsigned long& avg, unsigned long& med, unsigned long& mx) const
+	{
+		mn = avg = med = mx = 0;
+		if (samples.empty())
+			return;
+
+		std::vector<unsigned long> sorted(samples.ptr(), samples.ptr() + samples.size());
+		std::sort(sorted.begin(), sorted.end());
+
+		unsigned long long sum = 0;
+		for (UTsize i = 0; i < sorted.size(); ++i)
+			sum += sorted[i];
+
+		mn  = sorted.front();
+		mx  = sorted.back();
+		med = sorted[sorted.size() / 2];
+		avg = (unsigned long)(sum / sorted.size());
+	}
+};
+
+
+
+class gkBenchmark
+{
+public:
+	typedef utArray<gkBenchResult*> Results;
+
+private:
+	gkUserDefs  m_defs;
+	gkEngine*   m_engine;
+	btClock     m_clock;
+	Results     m_results;
+
+	int         m_iterations;
+	int         m_warmup;
+	int         m_bodies;
+	int         m_clones;
+
+	void runTicks(const gkString& prefix);
+	void benchSynthetic(void);
+	void benchClones(gkScene* scene, gkGameObject* source);
+	void benchBlend(const gkString& fname);
+	void benchHashTables(void);
+
+public:
+	gkBenchmark(int iterations, int warmup, int bodies, int clones);
+	~gkBenchmark();
+
+	gkBenchResult* getResult(const gkString& name, const gkString& unit = "us");
+
+	bool initialize(void);
+	void run(const utArray<gkString>& blends);
+	void print(void);
+	bool write(const gkString& fname);
+};
+
+
+#endif//_Benchmark_h_
@@ -0,0 +1,361 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Benchmark.h"
+#include "gkProfiler.h"
+#include <tclap/CmdLine.h>
+#include <cstdio>
+
+
+// Scene update phases, read back from the profiler after every tick.
+static const char* gkBenchPhases[] =
+{
+	"Tick",
+	"Physics",
+	"LogicBricks",
+	"LogicNodes",
+	"Animations",
+	"Dbvt",
+	0
+};
+
+
+
+gkBenchmark::gkBenchmark(int iterations, int warmup, int bodies, int clones)
+	:   m_engine(0),
+	    m_iterations(gkMax(iterations, 1)),
+	    m_warmup(gkMax(warmup, 0)),
+	    m_bodies(gkMax(bodies, 1)),
+	    m_clones(gkMax(clones, 1))
+{
+	// no window, ticks back to back
+	m_defs.headless       = true;
+	m_defs.fastStep       = true;
+	m_defs.disableSound   = true;
+	m_defs.verbose        = false;
+}
+
+
+gkBenchmark::~gkBenchmark()
+{
+	for (UTsize i = 0; i < m_results.size(); ++i)
+		delete m_results[i];
+
+	delete m_engine;
+}
+
+
+gkBenchResult* gkBenchmark::getResult(const gkString& name, const gkString& unit)
+{
+	for (UTsize i = 0; i < m_results.size(); ++i)
+	{
+		if (m_results[i]->name == name)
+			return m_results[i];
+	}
+
+	gkBenchResult* res = new gkBenchResult(name, unit);
+	m_results.push_back(res);
+	return res;
+}
+
+
+bool gkBenchmark::initialize(void)
+{
+	m_engine = new gkEngine(&m_defs);
+	m_engine->initialize();
+	if (!m_engine->isInitialized())
+	{
+		gkPrintf("Benchmark: engine initialization failed.\n");
+		return false;
+	}
+	return true;
+}
+
+
+void gkBenchmark::runTicks(const gkString& prefix)
+{
+	gkProfiler& profiler = gkProfiler::getSingleton();
+
+	if (!m_engine->initializeStepLoop())
+		return;
+
+	for (int i = 0; i < m_warmup; ++i)
+	{
+		if (!m_engine->stepOneFrame())
+			break;
+	}
+
+	for (int i = 0; i < m_iterations; ++i)
+	{
+		if (!m_engine->stepOneFrame())
+			break;
+
+		for (int p = 0; gkBenchPhases[p]; ++p)
+			getResult(prefix + "." + gkBenchPhases[p])->add(profiler.getLastMicroSeconds(gkBenchPhases[p]));
+	}
+
+	m_engine->finalizeStepLoop();
+}
+
+
+void gkBenchmark::benchSynthetic(void)
+{
+	gkScene* scene = gkSceneManager::getSingleton().createEmptyScene("BenchPhysics", "BenchCamera");
+	if (!scene)
+		return;
+
+	// static ground, half extents come from the radius when there is no mesh
+	gkGameObject* ground = scene->createObject("Ground");
+	gkGameObjectProperties& gprops = ground->getProperties();
+	gprops.m_transform.loc   = gkVector3(0, 0, -50);
+	gprops.m_physics.m_type  = GK_STATIC;
+	gprops.m_physics.m_shape = SH_BOX;
+	gprops.m_physics.m_radius = 50.f;
+
+
+	// stacked grid of rigid spheres and boxes
+	int side = gkMax((int)Ogre::Math::Sqrt((gkScalar)m_bodies), 1);
+	gkGameObject* first = 0;
+
+	for (int i = 0; i < m_bodies; ++i)
+	{
+		gkGameObject* body = scene->createObject("Body" + Ogre::StringConverter::toString(i));
+		if (!first)
+			first = body;
+
+		gkGameObjectProperties& props = body->getProperties();
+		props.m_transform.loc = gkVector3(
+		                            (gkScalar)(i % side) * 1.1f - side * .55f,
+		                            (gkScalar)((i / side) % side) * 1.1f - side * .55f,
+		                            1.f + (gkScalar)(i / (side * side)) * 1.1f);
+
+		props.m_physics.m_type   = GK_RIGID;
+		props.m_physics.m_shape  = (i & 1) ? SH_BOX : SH_SPHERE;
+		props.m_physics.m_mass   = 1.f;
+		props.m_physics.m_radius = .5f;
+	}
+
+	unsigned long start = m_clock.getTimeMicroseconds();
+	scene->createInstance();
+	getResult("synthetic.createInstance")->add(m_clock.getTimeMicroseconds() - start);
+
+	runTicks("synthetic");
+
+	if (first)
+		benchClones(scene, first);
+
+	start = m_clock.getTimeMicroseconds();
+	scene->destroyInstance();
+	getResult("synthetic.destroyInstance")->add(m_clock.getTimeMicroseconds() - start);
+
+	gkSceneManager::getSingleton().destroy(scene);
+}
+
+
+void gkBenchmark::benchClones(gkScene* scene, gkGameObject* source)
+{
+	gkBenchResult* cloneRes = getResult("synthetic.cloneObject");
+	gkBenchResult* endRes   = getResult("synthetic.endObject");
+
+	utArray<gkGameObject*> clones;
+	clones.reserve(m_clones);
+
+	for (int i = 0; i < m_iterations; ++i)
+	{
+		unsigned long start = m_clock.getTimeMicroseconds();
+		for (int c = 0; c < m_clones; ++c)
+			clones.push_back(scene->cloneObject(source, 0, true));
+		cloneRes->add((m_clock.getTimeMicroseconds() - start) / m_clones);
+
+		// ended objects are destroyed (or parked) by the next beginFrame,
+		// run only that instead of a whole frame
+		start = m_clock.getTimeMicroseconds();
+		for (UTsize c = 0; c < clones.size(); ++c)
+			scene->endObject(clones[c]);
+		scene->beginFrame();
+		endRes->add((m_clock.getTimeMicroseconds() - start) / m_clones);
+
+		clones.clear(true);
+	}
+}
+
+
+void gkBenchmark::benchBlend(const gkString& fname)
+{
+	gkBlendLoader& loader = gkBlendLoader::getSingleton();
+	gkString prefix = gkPath(fname).base();
+
+	for (int i = 0; i < m_iterations; ++i)
+	{
+		unsigned long start = m_clock.getTimeMicroseconds();
+		gkBlendFile* blend = loader.loadFile(fname, gkBlendLoader::LO_ONLY_ACTIVE_SCENE | gkBlendLoader::LO_IGNORE_CACHE_FILE);
+		unsigned long loaded = m_clock.getTimeMicroseconds();
+
+		if (!blend)
+		{
+			gkPrintf("Benchmark: failed to load '%s'.\n", fname.c_str());
+			return;
+		}
+		getResult(prefix + ".load")->add(loaded - start);
+
+		gkScene* scene = blend->getMainScene();
+		if (scene)
+		{
+			start = m_clock.getTimeMicroseconds();
+			scene->createInstance();
+			getResult(prefix + ".createInstance")->add(m_clock.getTimeMicroseconds() - start);
+
+			// time the update loop once, loading is what repeats
+			if (i == 0)
+				runTicks(prefix);
+
+			scene->destroyInstance();
+		}
+
+		start = m_clock.getTimeMicroseconds();
+		loader.unloadFile(blend);
+		getResult(prefix + ".unload")->add(m_clock.getTimeMicroseconds() - start);
+	}
+}
+
+
+void gkBenchmark::run(const utArray<gkString>& blends)
+{
+	benchHashTables();
+	benchSynthetic();
+
+	for (UTsize i = 0; i < blends.size(); ++i)
+		benchBlend(blends[i]);
+}
+
+
+void gkBenchmark::print(void)
+{
+	printf("%-40s %10s %10s %10s %10s %8s\n", "benchmark", "min", "avg", "median", "max", "samples");
+
+	for (UTsize i = 0; i < m_results.size(); ++i)
+	{
+		const gkBenchResult* res = m_results[i];
+
+		unsigned long mn, avg, med, mx;
+		res->summarize(mn, avg, med, mx);
+		printf("%-40s %10lu %10lu %10lu %10lu %8u\n", res->name.c_str(), mn, avg, med, mx, (unsigned int)res->samples.size());
+	}
+}
+
+
+bool gkBenchmark::write(const gkString& fname)
+{
+	FILE* fp = fopen(fname.c_str(), "wb");
+	if (!fp)
+	{
+		gkPrintf("Benchmark: can't open '%s' for writing.\n", fname.c_str());
+		return false;
+	}
+
+	fprintf(fp, "{\n\t\"iterations\": %d,\n\t\"warmup\": %d,\n\t\"bodies\": %d,\n\t\"clones\": %d,\n", m_iterations, m_warmup, m_bodies, m_clones);
+	fprintf(fp, "\t\"benchmarks\": [\n");
+
+	for (UTsize i = 0; i < m_results.size(); ++i)
+	{
+		const gkBenchResult* res = m_results[i];
+
+		unsigned long mn, avg, med, mx;
+		res->summarize(mn, avg, med, mx);
+
+		fprintf(fp, "\t\t{\"name\": \"%s\", \"unit\": \"%s\", \"samples\": %u, \"min\": %lu, \"avg\": %lu, \"median\": %lu, \"max\": %lu}%s\n",
+		        res->name.c_str(), res->unit.c_str(), (unsigned int)res->samples.size(), mn, avg, med, mx,
+		        i + 1 < m_results.size() ? "," : "");
+	}
+
+	fprintf(fp, "\t]\n}\n");
+	fclose(fp);
+	return true;
+}
+
+
+
+int main(int argc, char** argv)
+{
+	TestMemory;
+
+	int iterations = 300, warmup = 30, bodies = 512, clones = 64;
+	gkString output;
+	utArray<gkString> blends;
+
+	try
+	{
+		TCLAP::CmdLine cmdl("OgreKit scene update benchmarks", ' ', "n/a");
+		cmdl.setExceptionHandling(false);
+
+		TCLAP::ValueArg<int>         iterations_arg("i", "iterations", "Measured ticks / repetitions per benchmark", false, iterations, "int");
+		TCLAP::ValueArg<int>         warmup_arg("w", "warmup", "Ticks run before measuring", false, warmup, "int");
+		TCLAP::ValueArg<int>         bodies_arg("b", "bodies", "Rigid bodies in the synthetic scene", false, bodies, "int");
+		TCLAP::ValueArg<int>         clones_arg("c", "clones", "Objects cloned per repetition", false, clones, "int");
+		TCLAP::ValueArg<std::string> output_arg("o", "output", "Write results as JSON to this file", false, "", "string");
+		TCLAP::UnlabeledMultiArg<std::string> blends_arg("blends", ".blend files to load and update", false, "string");
+
+		cmdl.add(iterations_arg);
+		cmdl.add(warmup_arg);
+		cmdl.add(bodies_arg);
+		cmdl.add(clones_arg);
+		cmdl.add(output_arg);
+		cmdl.add(blends_arg);
+
+		cmdl.parse(argc, argv);
+
+		iterations = iterations_arg.getValue();
+		warmup     = warmup_arg.getValue();
+		bodies     = bodies_arg.getValue();
+		clones     = clones_arg.getValue();
+		output     = output_arg.getValue();
+
+		const std::vector<std::string>& files = blends_arg.getValue();
+		for (size_t i = 0; i < files.size(); ++i)
+			blends.push_back(files[i]);
+	}
+	catch (TCLAP::ArgException& e)
+	{
+		std::cerr << "error: " << e.error() << " for arg " << e.argId() << std::endl;
+		return -1;
+	}
+	catch (TCLAP::ExitException&)
+	{
+		return 0;
+	}
+
+	gkBenchmark bench(iterations, warmup, bodies, clones);
+	if (!bench.initialize())
+		return -1;
+
+	bench.run(blends);
+	bench.print();
+
+	if (!output.empty() && !bench.write(output))
+		return -1;
+
+	return 0;
+}
@@ -0,0 +1,415 @@
+/*
+-------------------------------------------------------------------------------
+    This file is part of OgreKit.
+    http://gamekit.googlecode.com/
+
+    Copyright (c) 2006-2013 Charlie C.
+
+    Contributor(s): none yet.
+-------------------------------------------------------------------------------
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _utChainedHashTable_h_
+#define _utChainedHashTable_h_
+
+#include "utTypes.h"
+
+// The chained utHashTable as it was before the switch to open addressing,
+// kept only as a baseline for the container benchmarks. Keys are compared
+// with operator== like the current table.
+
+#define _UT_CHAINED_HASH(key)   ((key.hash() & (m_capacity - 1)))
+#define _UT_CHAINED_HKHASH(key) ((hk & (m_capacity - 1)))
+// Initial table size
+#define _UT_CHAINED_INIT     32
+#define _UT_CHAINED_EXPANSE  (m_size * 2)
+
+#define _UT_CHAINED_POW2(x) \
+	--x; x |= x >> 16; x |= x >> 8; x |= x >> 4; \
+	x |= x >> 2; x |= x >> 1; ++x;
+
+#define _UT_CHAINED_IS_POW2(x) (x && !((x-1) & x))
+
+
+
+template < typename Key, typename Value>
+class utChainedHashTable
+{
+public:
+	typedef utHashEntry<Key, Value>        Entry;
+	typedef const utHashEntry<Key, Value>  ConstEntry;
+
+	typedef Entry  *EntryArray;
+	typedef UTsize *IndexArray;
+
+
+	typedef Key            KeyType;
+	typedef Value          ValueType;
+
+	typedef const Key      ConstKeyType;
+	typedef const Value    ConstValueType;
+
+	typedef Value          &ReferenceValueType;
+	typedef const Value    &ConstReferenceValueType;
+
+	typedef Key            &ReferenceKeyType;
+	typedef const Key      &ConstReferenceKeyType;
+
+	typedef EntryArray Pointer;
+	typedef const Entry *ConstPointer;
+
+
+	typedef utHashTableIterator<utChainedHashTable<Key, Value> > Iterator;
+	typedef const utHashTableIterator<utChainedHashTable<Key, Value> > ConstIterator;
+
+
+public:
+
+	utChainedHashTable()
+		:    m_size(0), m_capacity(0), m_lastPos(UT_NPOS),
+		     m_iptr(0), m_nptr(0), m_bptr(0), m_cache(0)
+	{
+	}
+
+	utChainedHashTable(UTsize capacity)
+		:    m_size(0), m_capacity(0), m_lastPos(UT_NPOS),
+		     m_iptr(0), m_nptr(0), m_bptr(0), m_cache(0)
+	{
+	}
+
+	utChainedHashTable(const utChainedHashTable &rhs)
+		:    m_size(0), m_capacity(0), m_lastPos(UT_NPOS),
+		     m_iptr(0), m_nptr(0), m_bptr(0), m_cache(0)
+	{
+		doCopy(rhs);
+	}
+
+	~utChainedHashTable() { clear(); }
+
+	utChainedHashTable<Key, Value> &operator = (const utChainedHashTable<Key, Value> &rhs)
+	{
+		if (this != &rhs)
+			doCopy(rhs);
+		return *this;
+	}
+
+	void clear(bool useCache = false)
+	{
+		if (!useCache)
+		{
+			m_size = m_capacity = 0;
+			m_lastKey = UT_NPOS;
+			m_lastPos = UT_NPOS;
+			m_cache = 0;
+
+			delete [] m_bptr;
+			delete [] m_iptr;
+			delete [] m_nptr;
+			m_bptr = 0; m_iptr = 0; m_nptr = 0;
+		}
+		else
+		{
+			++m_cache;
+			if (m_cache > _UT_CACHE_LIMIT)
+				clear(false);
+			else
+			{
+				m_size = 0;
+				m_lastKey = UT_NPOS;
+				m_lastPos = UT_NPOS;
+
+
+				UTsize i;
+
+				// Must zero 
+				for (i=0; i<m_capacity; ++i)
+				{
+					m_iptr[i] = UT_NPOS;
+					m_nptr[i] = UT_NPOS;
+				}
+			}
+		}
+
+	}
+	Value              &at(UTsize i)                    { UT_ASSERT(m_bptr && i >= 0 && i < m_size); return m_bptr[i].second; }
+	Value              &operator [](UTsize i)           { UT_ASSERT(m_bptr && i >= 0 && i < m_size); return m_bptr[i].second; }
+	const Value        &at(UTsize i)const               { UT_ASSERT(m_bptr && i >= 0 && i < m_size); return m_bptr[i].second; }
+	const Value        &operator [](UTsize i) const     { UT_ASSERT(m_bptr && i >= 0 && i < m_size); return m_bptr[i].second; }
+	Key                &keyAt(UTsize i)                 { UT_ASSERT(m_bptr && i >= 0 && i < m_size); return m_bptr[i].first; }
+	const Key          &keyAt(UTsize i)const            { UT_ASSERT(m_bptr && i >= 0 && i < m_size); return m_bptr[i].first; }
+
+
+	// Find and cache key
+	Value* get(const Key &key)
+	{
+		if (!m_bptr || m_size == 0)
+			return (Value*)0;
+
+
+		UThash hr = key.hash();
+
+		if (m_lastKey != hr)
+		{
+			UTsize i = find(key);
+			if (i == UT_NPOS) return (Value*)0;
+
+
+			UT_ASSERT(i >=0 && i < m_size);
+
+			m_lastKey = hr;
+			m_lastPos = i;
+		}
+
+		return &m_bptr[m_lastPos].second;
+	}
+
+
+	Value*         operator [](const Key &key)       { return get(key); }
+	const Value*   operator [](const Key &key) const { return get(key); }
+
+	UTsize find(const Key &key) const
+	{
+		if (m_capacity == 0 || m_capacity == UT_NPOS || m_size == 0)
+			return UT_NPOS;
+
+		UTsize hk = key.hash();
+
+		// Short cut.
+		if (m_lastPos != UT_NPOS && m_lastKey == hk)
+			return m_lastPos;
+
+
+		UThash hr = _UT_CHAINED_HKHASH(hk);
+
+		UT_ASSERT(m_bptr && m_iptr && m_nptr);
+
+		UTsize fh = m_iptr[hr];
+		while (fh != UT_NPOS && (key != m_bptr[fh].first))
+			fh = m_nptr[fh];
+
+
+		if (fh != UT_NPOS)
+		{
+			m_lastKey = hk;
+			m_lastPos = fh;
+
+			UT_ASSERT(fh >= 0  && fh < m_size);
+		}
+		return fh;
+	}
+
+
+
+	void erase(const Key &key) {remove(key);}
+
+	void remove(const Key &key)
+	{
+		UThash hash, lhash;
+		UTsize index, pindex, findex;
+
+		findex = find(key);
+		if (findex == UT_NPOS || m_capacity == 0 || m_size == 0)
+			return;
+
+		m_lastKey = UT_NPOS;
+		m_lastPos = UT_NPOS;
+		UT_ASSERT(m_bptr && m_iptr && m_nptr);
+
+
+		hash = _UT_CHAINED_HASH(key);
+
+		index  = m_iptr[hash];
+		pindex = UT_NPOS;
+		while (index != findex)
+		{
+			pindex = index;
+			index = m_nptr[index];
+		}
+
+		if (pindex != UT_NPOS)
+		{
+			UT_ASSERT(m_nptr[pindex] == findex);
+			m_nptr[pindex] = m_nptr[findex];
+		}
+		else
+			m_iptr[hash] = m_nptr[findex];
+
+		UTsize lindex = m_size - 1;
+		if (lindex == findex)
+		{
+			--m_size;
+			//m_bptr[m_size].~Entry();
+			return;
+		}
+
+		lhash = _UT_CHAINED_HASH(m_bptr[lindex].first);
+		index  = m_iptr[lhash];
+		pindex = UT_NPOS;
+		while (index != lindex)
+		{
+			pindex = index;
+			index = m_nptr[index];
+		}
+
+		if (pindex != UT_NPOS)
+		{
+			UT_ASSERT(m_nptr[pindex] == lindex);
+			m_nptr[pindex] = m_nptr[lindex];
+		}
+		else
+			m_iptr[lhash] = m_nptr[lindex];
+
+		m_bptr[findex] = m_bptr[lindex];
+		m_nptr[findex] = m_iptr[lhash];
+		m_iptr[lhash] = findex;
+
+		--m_size;
+		//m_bptr[m_size].~Entry();
+		return;
+	}
+
+	bool insert(const Key &key, const Value &val)
+	{
+		if (find(key) != UT_NPOS)
+			return false;
+
+		if (m_size == m_capacity)
+			reserve(m_size == 0 ? _UT_CHAINED_INIT : _UT_CHAINED_EXPANSE);
+
+		const UThash hr = _UT_CHAINED_HASH(key);
+
+		UT_ASSERT(m_bptr && m_iptr && m_nptr);
+		m_bptr[m_size] = Entry(key, val);
+		m_nptr[m_size] = m_iptr[hr];
+		m_iptr[hr] = m_size;
+
+		++m_size;
+		return true;
+	}
+
+
+	UT_INLINE Pointer ptr(void)             { return m_bptr; }
+	UT_INLINE ConstPointer ptr(void) const  { return m_bptr; }
+	UT_INLINE bool valid(void) const        { return m_bptr != 0;}
+
+
+	UT_INLINE UTsize size(void) const       { return m_size; }
+	UT_INLINE UTsize capacity(void) const   { return m_capacity; }
+	UT_INLINE bool empty(void) const        { return m_size == 0; }
+
+
+	Iterator        iterator(void)       { return m_bptr && m_size > 0 ? Iterator(m_bptr, m_size) : Iterator(); }
+	ConstIterator   iterator(void) const { return m_bptr && m_size > 0 ? ConstIterator(m_bptr, m_size) : ConstIterator(); }
+
+
+	void reserve(UTsize nr)
+	{
+		if (m_capacity < nr && nr != UT_NPOS)
+			rehash(nr);
+	}
+
+
+
+private:
+
+	void doCopy(const utChainedHashTable<Key, Value> &rhs)
+	{
+		if (rhs.empty())
+			clear();
+		else if (rhs.valid())
+		{			
+			reserve(rhs.m_capacity);
+
+			UTsize i, b;
+			m_size     = rhs.m_size;
+			m_capacity = rhs.m_capacity;
+
+			b = m_size > 0 ? m_size - 1 : 0;
+
+			// Zero i & n (from end of buffer)
+			for (i=b; i<m_capacity; ++i)
+				m_nptr[i] = m_iptr[i] = UT_NPOS;
+
+			for (i=0; i<m_size; ++i)
+			{
+				m_bptr[i] = rhs.m_bptr[i];
+				m_iptr[i] = rhs.m_iptr[i];
+				m_nptr[i] = rhs.m_nptr[i];
+			}
+		}
+
+	}
+
+	template<typename ArrayType>
+	void reserveType(ArrayType **old, UTsize nr, bool cpy=false)
+	{
+		UTsize i;
+		ArrayType *nar = new ArrayType[nr];
+		if ((*old)!= 0)
+		{
+			if (cpy)
+			{
+				const ArrayType *oar = (*old);
+				for (i = 0; i < m_size; i++) nar[i] = oar[i];
+			}
+			delete [](*old);
+		}
+		(*old) = nar;
+	}
+
+
+	void rehash(UTsize nr)
+	{
+		if (!_UT_CHAINED_IS_POW2(nr))
+		{
+			_UT_CHAINED_POW2(nr);
+		}
+
+		reserveType<Entry>(&m_bptr, nr, true);
+		reserveType<UTsize>(&m_iptr, nr);
+		reserveType<UTsize>(&m_nptr, nr);
+
+		m_capacity = nr;
+		UT_ASSERT(m_bptr && m_iptr && m_nptr);
+
+
+		UTsize i, h;
+		for (i=0; i<m_capacity; ++i)
+			m_iptr[i] = m_nptr[i] = UT_NPOS;
+
+		for (i = 0; i < m_size; i++)
+		{
+			h = _UT_CHAINED_HASH(m_bptr[i].first);
+			m_nptr[i] = m_iptr[h];
+			m_iptr[h] = i;
+		}
+	}
+
+
+
+	UTsize m_size, m_capacity;
+	mutable UTsize m_lastPos;
+	mutable UTsize m_lastKey;
+
+	IndexArray m_iptr;
+	IndexArray m_nptr;
+	EntryArray m_bptr;
+	UTsize m_cache;
+};
+
+#endif//_utChainedHashTable_h_
@@ -0,0 +1,198 @@
+#include "StdAfx.h"
+#include "Loaders/Blender2/Converters/gkAnimationConverter.h"
+#include "Thread/gkThreadPool.h"
+
+#define TEST_CASE_NAME testGkAnimationLoader
+
+#define ANIMATION_LOADER_ACTIONS 32
+
+
+// A 2.5 action, object location and euler rotation plus a bone's location,
+// keyed on frames 11, 21 and 41
+class gkAnimationLoaderTestAction
+{
+public:
+	enum
+	{
+		CURVES = 5,
+		KEYS   = 3
+	};
+
+	gkAnimationLoaderTestAction(const gkString& name)
+	{
+		static const char* paths[CURVES] = { "location", "location", "location", "rotation_euler", "pose.bones[\"Arm\"].location" };
+		static const int   index[CURVES] = { 0, 1, 2, 2, 1 };
+		static const float frames[KEYS]  = { 11, 21, 41 };
+
+		memset(&m_action, 0, sizeof(m_action));
+		memset(m_curves, 0, sizeof(m_curves));
+		memset(m_keys, 0, sizeof(m_keys));
+
+		// skipped by GKB_IDNAME
+		sprintf(m_action.id.name, "AC%s", name.c_str());
+
+		for (int i = 0; i < CURVES; ++i)
+		{
+			Blender::FCurve& fc = m_curves[i];
+			fc.rna_path    = const_cast<char*>(paths[i]);
+			fc.array_index = index[i];
+			fc.bezt        = m_keys[i];
+			fc.totvert     = KEYS;
+			fc.prev        = i > 0 ? &m_curves[i - 1] : 0;
+			fc.next        = i < CURVES - 1 ? &m_curves[i + 1] : 0;
+
+			for (int k = 0; k < KEYS; ++k)
+			{
+				Blender::BezTriple& bt = m_keys[i][k];
+				bt.ipo = 1; // linear
+				for (int h = 0; h < 3; ++h)
+				{
+					bt.vec[h][0] = frames[k] + gkScalar(h - 1);
+					bt.vec[h][1] = gkScalar(i * 10 + k);
+				}
+			}
+		}
+
+		m_action.curves.first = &m_curves[0];
+		m_action.curves.last  = &m_curves[CURVES - 1];
+	}
+
+	Blender::bAction   m_action;
+	Blender::FCurve    m_curves[CURVES];
+	Blender::BezTriple m_keys[CURVES][KEYS];
+};
+
+
+// what a loader worker runs for each action
+class gkAnimationLoaderTestCall : public gkCall
+{
+public:
+	gkAnimationLoaderTestCall(gkKeyedAnimation* act, Blender::bAction* action, gkScalar start)
+		:	m_act(act), m_action(action), m_start(start)
+	{
+	}
+
+	void run() { gkAnimationLoader::convertActionChannels(m_act, m_action, false, m_start, 25); }
+
+private:
+	gkKeyedAnimation* m_act;
+	Blender::bAction* m_action;
+	gkScalar          m_start;
+};
+
+
+static void gkAnimationLoaderTestCompare(gkKeyedAnimation* a, gkKeyedAnimation* b)
+{
+	ASSERT_EQ(a->getNumChannels(), b->getNumChannels());
+
+	for (int i = 0; i < a->getNumChannels(); ++i)
+	{
+		akAnimationChannel* ca = a->getChannels()[i];
+		akAnimationChannel* cb = b->getChannels()[i];
+
+		EXPECT_EQ(ca->getName(), cb->getName());
+		ASSERT_EQ(ca->getNumSplines(), cb->getNumSplines());
+
+		for (int s = 0; s < ca->getNumSplines(); ++s)
+		{
+			const akBezierSpline* sa = ca->getSplines()[s];
+			const akBezierSpline* sb = cb->getSplines()[s];
+
+			EXPECT_EQ(sa->getCode(), sb->getCode());
+			ASSERT_EQ(sa->getNumVerts(), sb->getNumVerts());
+			EXPECT_EQ(memcmp(sa->getVerts(), sb->getVerts(), sizeof(akBezierVertex) * sa->getNumVerts()), 0);
+		}
+	}
+}
+
+
+TEST(TEST_CASE_NAME, testCreateAction)
+{
+	gkAnimationManager mgr;
+	gkAnimationLoader loader("AnimationLoader");
+	gkAnimationLoaderTestAction action("Walk");
+
+	// the resource is timed but empty until the channels are converted
+	gkScalar start = 0;
+	gkKeyedAnimation* act = loader.createAction(&action.m_action, false, 25, start);
+	ASSERT_TRUE(act != 0);
+	EXPECT_EQ(act->getName(), gkString("Walk"));
+	EXPECT_FLOAT_EQ(start, 11);
+	EXPECT_FLOAT_EQ(act->getLength(), gkScalar(30) / 25);
+	EXPECT_EQ(act->getNumChannels(), 0);
+
+	gkAnimationLoader::convertActionChannels(act, &action.m_action, false, start, 25);
+
+	// the object's curves share a channel, the bone gets its own
+	ASSERT_EQ(act->getNumChannels(), 2);
+
+	akAnimationChannel* object = act->getChannel("GKMainObjectChannel");
+	ASSERT_TRUE(object != 0);
+	ASSERT_EQ(object->getNumSplines(), 4);
+	EXPECT_EQ(object->getSplines()[0]->getCode(), (int)gkTransformChannel::SC_LOC_X);
+	EXPECT_EQ(object->getSplines()[3]->getCode(), (int)gkTransformChannel::SC_ROT_EULER_Z);
+
+	akAnimationChannel* bone = act->getChannel("Arm");
+	ASSERT_TRUE(bone != 0);
+	ASSERT_EQ(bone->getNumSplines(), 1);
+	EXPECT_EQ(bone->getSplines()[0]->getCode(), (int)gkTransformChannel::SC_LOC_Y);
+
+	// keys in seconds from the first frame
+	const akBezierSpline* spline = object->getSplines()[1];
+	ASSERT_EQ(spline->getNumVerts(), 3);
+	EXPECT_EQ(spline->getInterpolationMethod(), akBezierSpline::BEZ_LINEAR);
+	EXPECT_FLOAT_EQ(spline->getVerts()[0].cp[0], 0);
+	EXPECT_FLOAT_EQ(spline->getVerts()[2].cp[0], gkScalar(30) / 25);
+	EXPECT_FLOAT_EQ(spline->getVerts()[2].h1[0], gkScalar(29) / 25);
+	EXPECT_FLOAT_EQ(spline->getVerts()[2].cp[1], 12);
+
+	// the serial path gives the same
+	gkAnimationLoaderTestAction again("Run");
+	loader.convertAction(&again.m_action, false, 25);
+	gkKeyedAnimation* run = mgr.getKeyedAnimation(gkResourceName("Run", "AnimationLoader"));
+	ASSERT_TRUE(run != 0);
+	EXPECT_FLOAT_EQ(run->getLength(), act->getLength());
+	gkAnimationLoaderTestCompare(act, run);
+}
+
+
+TEST(TEST_CASE_NAME, testChannelsOnPool)
+{
+	gkAnimationManager mgr;
+	gkAnimationLoader serial("Serial"), pooled("Pooled");
+
+	utArray<gkAnimationLoaderTestAction*> actions;
+	for (int i = 0; i < ANIMATION_LOADER_ACTIONS; ++i)
+		actions.push_back(new gkAnimationLoaderTestAction("Action" + Ogre::StringConverter::toString(i)));
+
+	for (int i = 0; i < ANIMATION_LOADER_ACTIONS; ++i)
+		serial.convertAction(&actions[i]->m_action, false, 25);
+
+	// resources are made up front, only the curves are converted concurrently
+	utArray<gkKeyedAnimation*> acts;
+	{
+		gkThreadPool pool("AnimationLoader", 4);
+
+		for (int i = 0; i < ANIMATION_LOADER_ACTIONS; ++i)
+		{
+			gkScalar start = 0;
+			gkKeyedAnimation* act = pooled.createAction(&actions[i]->m_action, false, 25, start);
+			ASSERT_TRUE(act != 0);
+			acts.push_back(act);
+
+			pool.enqueue(gkPtrRef<gkCall>(new gkAnimationLoaderTestCall(act, &actions[i]->m_action, start)));
+		}
+		pool.wait();
+	}
+
+	for (int i = 0; i < ANIMATION_LOADER_ACTIONS; ++i)
+	{
+		gkKeyedAnimation* act = mgr.getKeyedAnimation(gkResourceName(acts[i]->getName(), "Serial"));
+		ASSERT_TRUE(act != 0);
+		EXPECT_EQ(acts[i]->getNumChannels(), 2);
+		gkAnimationLoaderTestCompare(act, acts[i]);
+	}
+
+	for (UTsize i = 0; i < actions.size(); ++i)
+		delete actions[i];
+}
@@ -0,0 +1,116 @@
+#include "StdAfx.h"
+
+#define TEST_CASE_NAME testGkClonePool
+
+class gkTestObjectManager : public gkInstancedManager
+{
+public:
+	gkTestObjectManager() : gkInstancedManager("TestObjectManager", "TestObject") {}
+
+	gkResource* createImpl(const gkResourceName& name, const gkResourceHandle& handle)
+	{
+		return new gkGameObject(this, name, handle);
+	}
+};
+
+// delay 1, duration 2, no repeat: false, true, true, false ...
+static gkGameObject* gkClonePoolTestSource(gkTestObjectManager& mgr, gkLogicManager& logic)
+{
+	gkGameObject* source = new gkGameObject(&mgr, gkResourceName("Source"), -1);
+	source->createVariable("score", false)->setValue(5);
+
+	gkLogicLink* link = logic.createLink();
+	link->setObject(source);
+	link->setState(1);
+	source->attachLogic(link);
+
+	gkDelaySensor* delay = new gkDelaySensor(source, link, "Delay");
+	delay->setDelay(1);
+	delay->setDuration(2);
+	link->push(delay);
+	return source;
+}
+
+static gkDelaySensor* gkClonePoolTestDelay(gkGameObject* obj)
+{
+	return static_cast<gkDelaySensor*>(obj->getLogicBricks()->findSensor("Delay"));
+}
+
+TEST(TEST_CASE_NAME, testReuseWithState)
+{
+	gkTestObjectManager mgr;
+	gkLogicManager logic;
+	gkGameObject* source = gkClonePoolTestSource(mgr, logic);
+
+	// a clone that ran for a while
+	gkGameObject* reused = source->clone("Source/1");
+	reused->getVariable("score")->setValue(12);
+	reused->getLogicBricks()->setState(4);
+	reused->setFlags(GK_IMMOVABLE);
+
+	gkDelaySensor* old = gkClonePoolTestDelay(reused);
+	for (int i = 0; i < 3; ++i)
+		old->query();
+
+	EXPECT_TRUE(reused->_resetFromClone(source, "Source/2"));
+
+	gkGameObject* fresh = source->clone("Source/3");
+
+	EXPECT_EQ(reused->getName(), gkString("Source/2"));
+	EXPECT_TRUE(reused->isClone());
+	EXPECT_EQ(reused->getCloneSource(), source);
+	EXPECT_EQ(reused->getFlags(), fresh->getFlags());
+	EXPECT_EQ(reused->getVariable("score")->getValueInt(), 5);
+	EXPECT_EQ(reused->getLogicBricks()->getState(), fresh->getLogicBricks()->getState());
+	EXPECT_EQ(reused->getLogicBricks()->getObject(), reused);
+
+	// the delay counts from the start again, like the fresh clone's
+	gkDelaySensor* a = gkClonePoolTestDelay(reused);
+	gkDelaySensor* b = gkClonePoolTestDelay(fresh);
+	ASSERT_TRUE(a && b);
+	for (int i = 0; i < 5; ++i)
+		EXPECT_EQ(a->query(), b->query());
+
+	delete fresh;
+	delete reused;
+	delete source;
+}
+
+TEST(TEST_CASE_NAME, testCloneOfClone)
+{
+	gkTestObjectManager mgr;
+	gkLogicManager logic;
+	gkGameObject* source = gkClonePoolTestSource(mgr, logic);
+
+	gkGameObject* parent = source->clone("Source/1");
+	parent->getVariable("score")->setValue(7);
+
+	// pooled under the original object, copied from the clone
+	gkGameObject* child = parent->clone("Source/1/1");
+	EXPECT_EQ(child->getCloneSource(), source);
+
+	gkGameObject* reused = source->clone("Source/2");
+	EXPECT_TRUE(reused->_resetFromClone(parent, "Source/1/2"));
+	EXPECT_EQ(reused->getVariable("score")->getValueInt(), 7);
+
+	delete reused;
+	delete child;
+	delete parent;
+	delete source;
+}
+
+TEST(TEST_CASE_NAME, testFallback)
+{
+	gkTestObjectManager mgr;
+	gkLogicManager logic;
+	gkGameObject* source = gkClonePoolTestSource(mgr, logic);
+
+	// variables added at runtime can't be matched, the caller clones instead
+	gkGameObject* reused = source->clone("Source/1");
+	reused->createVariable("extra", false);
+	EXPECT_FALSE(reused->_resetFromClone(source, "Source/2"));
+	EXPECT_EQ(reused->getName(), gkString("Source/1"));
+
+	delete reused;
+	delete source;
+}
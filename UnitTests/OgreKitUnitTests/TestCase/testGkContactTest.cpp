@@ -0,0 +1,90 @@
+#include "StdAfx.h"
+
+#define TEST_CASE_NAME testGkContactTest
+
+// radar sensor cone, tip at apex, opening along axis
+static btTransform makeCone(btConeShapeZ& cone, const btVector3& apex, const btVector3& axis, btScalar height)
+{
+	cone.setMargin(0);
+	btTransform trans;
+	trans.setIdentity();
+	trans.setOrigin(apex + axis * (height * btScalar(0.5)));
+	trans.setRotation(shortestArcQuat(btVector3(0, 0, 1), -axis));
+	return trans;
+}
+
+TEST(TEST_CASE_NAME, testLargeMesh)
+{
+	// 400 x 400 ground at z = 0, its bounds contain any nearby cone
+	btTriangleMesh mesh;
+	const btScalar e = 200;
+	mesh.addTriangle(btVector3(-e, -e, 0), btVector3(e, -e, 0), btVector3(e, e, 0));
+	mesh.addTriangle(btVector3(-e, -e, 0), btVector3(e, e, 0), btVector3(-e, e, 0));
+	btBvhTriangleMeshShape ground(&mesh, true);
+
+	btCollisionObject level;
+	level.setCollisionShape(&ground);
+
+	const btScalar height = 10, halfAngle = 0.3f;
+	btConeShapeZ cone(height * btTan(halfAngle), height);
+
+	// looking along the ground, the base stays ~1.9 above it
+	btTransform trans = makeCone(cone, btVector3(0, 0, 5), btVector3(1, 0, 0), height);
+	EXPECT_FALSE(gkShapeOverlapTest::test(&cone, trans, &level));
+
+	// looking down at it
+	trans = makeCone(cone, btVector3(0, 0, 5), btVector3(0, 0, -1), height);
+	EXPECT_TRUE(gkShapeOverlapTest::test(&cone, trans, &level));
+
+	// a ground moved below the cone's reach
+	btTransform low;
+	low.setIdentity();
+	low.setOrigin(btVector3(0, 0, -6));
+	level.setWorldTransform(low);
+	EXPECT_FALSE(gkShapeOverlapTest::test(&cone, trans, &level));
+}
+
+TEST(TEST_CASE_NAME, testSphere)
+{
+	btSphereShape ball(1);
+	btCollisionObject ob;
+	ob.setCollisionShape(&ball);
+
+	btSphereShape query(0.8f);
+	btTransform trans;
+	trans.setIdentity();
+
+	// inside the ball's bounds corner, outside the ball
+	trans.setOrigin(btVector3(1.5f, 1.5f, 0));
+	EXPECT_FALSE(gkShapeOverlapTest::test(&query, trans, &ob));
+
+	trans.setOrigin(btVector3(1.7f, 0, 0));
+	EXPECT_TRUE(gkShapeOverlapTest::test(&query, trans, &ob));
+
+	// fully inside
+	trans.setOrigin(btVector3(0, 0, 0));
+	EXPECT_TRUE(gkShapeOverlapTest::test(&query, trans, &ob));
+}
+
+TEST(TEST_CASE_NAME, testCompound)
+{
+	btBoxShape box(btVector3(1, 1, 1));
+	btCompoundShape compound;
+
+	btTransform child;
+	child.setIdentity();
+	child.setOrigin(btVector3(10, 0, 0));
+	compound.addChildShape(child, &box);
+
+	btCollisionObject ob;
+	ob.setCollisionShape(&compound);
+
+	btSphereShape query(0.5f);
+	btTransform trans;
+	trans.setIdentity();
+
+	EXPECT_FALSE(gkShapeOverlapTest::test(&query, trans, &ob));
+
+	trans.setOrigin(btVector3(8.7f, 0, 0));
+	EXPECT_TRUE(gkShapeOverlapTest::test(&query, trans, &ob));
+}
@@ -0,0 +1,270 @@
+#include "StdAfx.h"
+
+#define TEST_CASE_NAME testGkContactTracker
+
+// the tracker never dereferences controllers
+static gkPhysicsController* fakeController(int i)
+{
+	return reinterpret_cast<gkPhysicsController*>((size_t)(i + 1) * 16);
+}
+
+class ContactCounter : public gkContactTracker::Listener
+{
+public:
+	int m_begin, m_persist, m_end, m_removed;
+
+	ContactCounter() : m_begin(0), m_persist(0), m_end(0), m_removed(0) {}
+
+	void contactBegin(gkPhysicsController* a, gkPhysicsController* b)   {++m_begin;}
+	void contactPersist(gkPhysicsController* a, gkPhysicsController* b) {++m_persist;}
+	void contactEnd(gkPhysicsController* a, gkPhysicsController* b)     {++m_end;}
+	void contactRemoved(gkPhysicsController* cont)                      {++m_removed;}
+};
+
+TEST(TEST_CASE_NAME, testEvents)
+{
+	ContactCounter tables, counter;
+	gkContactTracker tracker(&tables);
+
+	EXPECT_FALSE(tracker.isListening());
+	tracker.addListener(&counter);
+	EXPECT_TRUE(tracker.isListening());
+
+	gkPhysicsController* a = fakeController(0);
+	gkPhysicsController* b = fakeController(1);
+	gkPhysicsController* c = fakeController(2);
+
+	// two manifolds of one pair, in either order, report once
+	tracker.beginSubstep();
+	tracker.touch(a, b);
+	tracker.touch(b, a);
+	tracker.touch(a, c);
+	tracker.endSubstep();
+
+	EXPECT_EQ(counter.m_begin, 2);
+	EXPECT_EQ(counter.m_persist, 0);
+	EXPECT_EQ(tracker.getPairCount(), 2u);
+	EXPECT_TRUE(tracker.isTouching(b, a));
+
+	tracker.beginSubstep();
+	tracker.touch(b, a);
+	tracker.endSubstep();
+
+	EXPECT_EQ(counter.m_persist, 1);
+	EXPECT_EQ(counter.m_end, 1);
+	EXPECT_EQ(tables.m_end, 1);
+	EXPECT_FALSE(tracker.isTouching(a, c));
+
+	tracker.beginSubstep();
+	tracker.touch(a, c);
+	tracker.touch(b, c);
+	tracker.endSubstep();
+	EXPECT_EQ(counter.m_begin, 4);
+	EXPECT_EQ(counter.m_end, 2);
+
+	// c leaves the world
+	tracker.remove(c);
+	EXPECT_EQ(counter.m_end, 4);
+	EXPECT_EQ(counter.m_removed, 1);
+	EXPECT_EQ(tracker.getPairCount(), 0u);
+
+	tracker.beginSubstep();
+	tracker.touch(a, b);
+	tracker.endSubstep();
+	tracker.reset();
+	EXPECT_EQ(counter.m_end, 5);
+	EXPECT_EQ(tables.m_end, 5);
+	EXPECT_EQ(tables.m_begin, 0);
+}
+
+TEST(TEST_CASE_NAME, testLifetime)
+{
+	ContactCounter* counter = new ContactCounter();
+	ContactCounter kept;
+
+	{
+		gkContactTracker tracker;
+		tracker.addListener(counter);
+		tracker.addListener(&kept);
+		tracker.addListener(&kept);
+
+		// copies are not registered
+		ContactCounter copy(kept);
+		EXPECT_TRUE(copy.getTracker() == 0);
+
+		delete counter;
+		EXPECT_TRUE(tracker.isListening());
+
+		tracker.beginSubstep();
+		tracker.touch(fakeController(0), fakeController(1));
+		tracker.endSubstep();
+		EXPECT_EQ(kept.m_begin, 1);
+
+		tracker.removeListener(&kept);
+		EXPECT_FALSE(tracker.isListening());
+
+		tracker.addListener(&kept);
+		EXPECT_TRUE(kept.getTracker() == &tracker);
+	}
+
+	// the tracker went first
+	EXPECT_TRUE(kept.getTracker() == 0);
+}
+
+
+// instanced without a scene node
+class gkContactTrackerTestObject : public gkGameObject
+{
+public:
+	gkContactTrackerTestObject(gkInstancedManager* creator, const gkResourceName& name)
+		:    gkGameObject(creator, name, -1)
+	{
+	}
+
+private:
+	void createInstanceImpl(void) {}
+	void destroyInstanceImpl(void) {}
+	void postCreateInstanceImpl(void) {}
+	void postDestroyInstanceImpl(void) {}
+};
+
+
+class gkContactTrackerTestManager : public gkInstancedManager
+{
+public:
+	gkContactTrackerTestManager() : gkInstancedManager("TestObjectManager", "TestObject") {}
+
+	gkResource* createImpl(const gkResourceName& name, const gkResourceHandle& handle)
+	{
+		return new gkContactTrackerTestObject(this, name);
+	}
+};
+
+
+// A bare scene with overlapping boxes, nothing listens to its contacts
+class gkContactTrackerTestWorld
+{
+public:
+	gkContactTrackerTestWorld(const gkString& name)
+		:    m_box(btVector3(1, 1, 1))
+	{
+		m_scene = new gkScene(&m_mgr, gkResourceName(name), -1);
+		m_world = m_scene->getDynamicsWorld();
+	}
+
+	~gkContactTrackerTestWorld()
+	{
+		// the tracker still refers to touching controllers
+		m_world->resetContacts();
+
+		for (UTsize i = 0; i < m_collisionObjects.size(); ++i)
+		{
+			m_world->getBulletWorld()->removeCollisionObject(m_collisionObjects[i]);
+			delete m_collisionObjects[i];
+			delete m_controllers[i];
+		}
+
+		for (UTsize i = 0; i < m_objects.size(); ++i)
+			delete m_objects[i];
+
+		// not instanced, nothing else owns these
+		delete m_world;
+		delete m_scene->getLogicBrickManager();
+		delete m_scene;
+	}
+
+	gkPhysicsController* add(const gkString& name, gkScalar x, bool contacts)
+	{
+		gkGameObject* obj = new gkContactTrackerTestObject(&m_mgr, gkResourceName(name));
+		if (contacts)
+			obj->getProperties().m_physics.m_mode |= GK_CONTACT;
+		obj->setOwner(m_scene);
+		obj->createInstance();
+
+		gkPhysicsController* cont = new gkPhysicsController(obj, m_world);
+		btCollisionObject* col = new btCollisionObject();
+		btTransform trans;
+		trans.setIdentity();
+		trans.setOrigin(btVector3(x, 0, 0));
+		col->setCollisionShape(&m_box);
+		col->setWorldTransform(trans);
+		col->setUserPointer(cont);
+		m_world->getBulletWorld()->addCollisionObject(col);
+
+		m_objects.push_back(obj);
+		m_controllers.push_back(cont);
+		m_collisionObjects.push_back(col);
+		return cont;
+	}
+
+	void step(void)
+	{
+		m_world->step(gkScalar(1.0) / gkScalar(60.0));
+	}
+
+	gkContactTrackerTestManager     m_mgr;
+	gkScene*                        m_scene;
+	gkDynamicsWorld*                m_world;
+	btBoxShape                      m_box;
+	utArray<gkGameObject*>          m_objects;
+	utArray<gkPhysicsController*>   m_controllers;
+	utArray<btCollisionObject*>     m_collisionObjects;
+};
+
+
+TEST(TEST_CASE_NAME, testTablesWithoutListener)
+{
+	gkUserDefs defs;
+	gkEngine engine(&defs);
+	gkContactTrackerTestWorld world("Tables");
+
+	// contact processing from the start, like a .blend actor
+	gkPhysicsController* actor = world.add("Actor", 0, true);
+	gkPhysicsController* other = world.add("Other", 1.5f, false);
+
+	world.step();
+	ASSERT_EQ(actor->getContacts().size(), 1U);
+	EXPECT_TRUE(actor->getContacts().at(0).collider == other);
+	EXPECT_TRUE(actor->collidesWith("Other"));
+	EXPECT_TRUE(other->getContacts().empty());
+
+	// switched on through the properties, the table follows once asked for
+	other->getProperties().m_mode |= GK_CONTACT;
+	EXPECT_TRUE(other->getContacts().empty());
+
+	world.step();
+	ASSERT_EQ(other->getContacts().size(), 1U);
+	EXPECT_TRUE(other->getContacts().at(0).collider == actor);
+
+	// and ends when they separate
+	world.m_collisionObjects[1]->getWorldTransform().setOrigin(btVector3(10, 0, 0));
+	world.step();
+	EXPECT_TRUE(actor->getContacts().empty());
+	EXPECT_TRUE(other->getContacts().empty());
+}
+
+
+TEST(TEST_CASE_NAME, testTablesPerWorld)
+{
+	gkUserDefs defs;
+	gkEngine engine(&defs);
+	gkContactTrackerTestWorld first("First"), second("Second");
+
+	gkPhysicsController* a = first.add("A", 0, true);
+	first.add("B", 1.5f, true);
+	gkPhysicsController* c = second.add("C", 0, true);
+	second.add("D", 1.5f, true);
+
+	first.step();
+	second.step();
+	EXPECT_EQ(a->getContacts().size(), 1U);
+	EXPECT_EQ(c->getContacts().size(), 1U);
+
+	// ending one world's contacts leaves the other's tables alone
+	first.m_world->resetContacts();
+	EXPECT_TRUE(a->getContacts().empty());
+	EXPECT_EQ(c->getContacts().size(), 1U);
+
+	second.step();
+	EXPECT_EQ(c->getContacts().size(), 1U);
+}
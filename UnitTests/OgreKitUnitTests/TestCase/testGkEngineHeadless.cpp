@@ -0,0 +1,128 @@
+#include "StdAfx.h"
+
+#define TEST_CASE_NAME testGkEngineHeadless
+
+
+// what every tick left behind
+class gkEngineHeadlessTestListener : public gkEngine::Listener
+{
+public:
+	gkEngineHeadlessTestListener() : m_ticks(0), m_ball(0) {}
+
+	void tick(gkScalar rate)
+	{
+		++m_ticks;
+		if (m_ball)
+			m_heights.push_back(m_ball->getPosition().z);
+	}
+
+	int                 m_ticks;
+	gkGameObject*       m_ball;
+	utArray<gkScalar>   m_heights;
+};
+
+
+// a headless engine with one scene, a ball falls onto a static box
+static void gkEngineHeadlessTestRun(gkUserDefs& defs, gkEngineHeadlessTestListener& listener)
+{
+	defs.headless = true;
+
+	gkEngine engine(&defs);
+	engine.initialize();
+	ASSERT_TRUE(engine.isInitialized());
+
+	gkScene* scene = gkSceneManager::getSingleton().createEmptyScene("Headless");
+	ASSERT_TRUE(scene != 0);
+
+	gkGameObject* ground = scene->createObject("Ground");
+	ground->getProperties().m_physics.m_type  = GK_STATIC;
+	ground->getProperties().m_physics.m_shape = SH_BOX;
+	ground->getProperties().m_physics.m_radius = 4;
+
+	gkGameObject* ball = scene->createObject("Ball");
+	ball->getProperties().m_transform.loc = gkVector3(0, 0, 8);
+	ball->getProperties().m_physics.m_type = GK_RIGID;
+	ball->getProperties().m_physics.m_mass = 1;
+	ball->getProperties().m_physics.m_restitution = 0.5f;
+
+	scene->createInstance();
+	listener.m_ball = ball;
+
+	engine.addListener(&listener);
+	engine.run();
+	engine.removeListener(&listener);
+
+	listener.m_ball = 0;
+	engine.finalize();
+}
+
+
+TEST(TEST_CASE_NAME, testSingleSceneThreads)
+{
+	gkEngineHeadlessTestListener serial, threaded;
+
+	{
+		gkUserDefs defs;
+		defs.fastStep = true;
+		defs.maxTicks = 120;
+		defs.sceneThreads = 0;
+		gkEngineHeadlessTestRun(defs, serial);
+	}
+
+	{
+		gkUserDefs defs;
+		defs.fastStep = true;
+		defs.maxTicks = 120;
+		defs.sceneThreads = 2;
+		gkEngineHeadlessTestRun(defs, threaded);
+	}
+
+	// a single scene doesn't go through the staged update
+	ASSERT_EQ(serial.m_ticks, 120);
+	ASSERT_EQ(threaded.m_ticks, serial.m_ticks);
+	ASSERT_EQ(threaded.m_heights.size(), serial.m_heights.size());
+
+	for (UTsize i = 0; i < serial.m_heights.size(); ++i)
+		EXPECT_EQ(serial.m_heights[i], threaded.m_heights[i]) << "tick " << i;
+
+	// fell and came to rest on the box
+	EXPECT_LT(serial.m_heights.back(), gkScalar(8));
+	EXPECT_GT(serial.m_heights.back(), gkScalar(4));
+}
+
+
+TEST(TEST_CASE_NAME, testMaxTicks)
+{
+	gkEngineHeadlessTestListener listener;
+
+	gkUserDefs defs;
+	defs.fastStep = true;
+	defs.maxTicks = 250;
+
+	btClock clock;
+	gkEngineHeadlessTestRun(defs, listener);
+
+	// back to back, far quicker than the 4 seconds they simulate
+	EXPECT_EQ(listener.m_ticks, 250);
+	EXPECT_EQ(listener.m_heights.size(), 250U);
+	EXPECT_LT(clock.getTimeMilliseconds(), 4000U);
+}
+
+
+TEST(TEST_CASE_NAME, testPacedTicks)
+{
+	gkEngineHeadlessTestListener listener;
+
+	gkUserDefs defs;
+	defs.fastStep = false;
+	defs.tickRate = 100;
+	defs.maxTicks = 20;
+
+	btClock clock;
+	gkEngineHeadlessTestRun(defs, listener);
+
+	// follows the wall clock, a late step may catch up a few ticks at once
+	EXPECT_GE(listener.m_ticks, 20);
+	EXPECT_LE(listener.m_ticks, 40);
+	EXPECT_GE(clock.getTimeMilliseconds(), 150U);
+}
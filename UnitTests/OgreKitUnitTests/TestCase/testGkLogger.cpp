@@ -0,0 +1,231 @@
+#include "StdAfx.h"
+
+#define TEST_CASE_NAME testGkLogger
+
+#define LOG_FILE    "testGkLogger.log"
+#define LOG_THREADS 4
+#define LOG_LINES   2000
+
+
+class gkLoggerTestCall : public gkCall
+{
+public:
+	gkLoggerTestCall(int id) : m_id(id) {}
+
+	void run(void)
+	{
+		for (int i = 0; i < LOG_LINES; ++i)
+			gkPrintf("thread %i line %i", m_id, i);
+	}
+
+	int m_id;
+};
+
+
+static int gkLoggerTestEvaluated = 0;
+
+static int gkLoggerTestArg(void)
+{
+	return ++gkLoggerTestEvaluated;
+}
+
+
+TEST(TEST_CASE_NAME, testThreads)
+{
+	gkLogger::setAsync(true);
+	gkLogger::enable(LOG_FILE, true);
+	EXPECT_TRUE(gkLogger::isAsync());
+
+	gkLoggerTestCall* calls[LOG_THREADS];
+	gkThread* threads[LOG_THREADS];
+
+	for (int t = 0; t < LOG_THREADS; ++t)
+	{
+		calls[t] = new gkLoggerTestCall(t);
+		threads[t] = new gkThread(calls[t]);
+	}
+
+	for (int t = 0; t < LOG_THREADS; ++t)
+	{
+		threads[t]->join();
+		delete threads[t];
+		delete calls[t];
+	}
+
+	gkLogger::disable();
+
+	FILE* fp = fopen(LOG_FILE, "r");
+	ASSERT_TRUE(fp != 0);
+
+	// every line arrives once, in order per thread
+	int next[LOG_THREADS] = {0};
+	char line[256];
+	while (fgets(line, sizeof(line), fp))
+	{
+		const char* msg = strstr(line, "thread ");
+		int id, nr;
+		if (msg && sscanf(msg, "thread %i line %i", &id, &nr) == 2)
+		{
+			ASSERT_TRUE(id >= 0 && id < LOG_THREADS);
+			EXPECT_EQ(next[id], nr);
+			next[id] = nr + 1;
+		}
+	}
+	fclose(fp);
+	remove(LOG_FILE);
+
+	for (int t = 0; t < LOG_THREADS; ++t)
+		EXPECT_EQ(next[t], LOG_LINES);
+}
+
+
+TEST(TEST_CASE_NAME, testFilter)
+{
+	gkLoggerTestEvaluated = 0;
+
+	gkLogger::setLevel(GK_LOG_ERROR);
+	gkLogf(GK_LOG_INFO, GK_LOG_CORE, "%i", gkLoggerTestArg());
+	EXPECT_EQ(gkLoggerTestEvaluated, 0);
+
+	gkLogger::setLevel(GK_LOG_DEBUG);
+	gkLogger::setCategories(GK_LOG_ALL & ~GK_LOG_PHYSICS);
+	gkLogf(GK_LOG_ERROR, GK_LOG_PHYSICS, "%i", gkLoggerTestArg());
+	EXPECT_EQ(gkLoggerTestEvaluated, 0);
+	EXPECT_FALSE(gkLogger::isEnabled(GK_LOG_INFO, GK_LOG_LOGIC | GK_LOG_PHYSICS));
+	EXPECT_TRUE(gkLogger::isEnabled(GK_LOG_INFO, GK_LOG_LOGIC | GK_LOG_SCREEN));
+
+	gkLogger::setCategories(GK_LOG_ALL);
+	gkLogf(GK_LOG_DEBUG, GK_LOG_PHYSICS, "%i", gkLoggerTestArg());
+	EXPECT_EQ(gkLoggerTestEvaluated, 1);
+}
+
+
+static int gkLoggerTestFind(const char* first, const char* second)
+{
+	FILE* fp = fopen(LOG_FILE, "r");
+	if (!fp)
+		return -1;
+
+	int found = 0;
+	char line[256];
+	while (fgets(line, sizeof(line), fp))
+	{
+		if (strstr(line, first) && found == 0)
+			found = 1;
+		else if (strstr(line, second) && found == 1)
+			found = 2;
+	}
+	fclose(fp);
+	return found;
+}
+
+
+TEST(TEST_CASE_NAME, testSync)
+{
+	gkLogger::setAsync(false);
+	gkLogger::enable(LOG_FILE, true);
+	EXPECT_FALSE(gkLogger::isAsync());
+
+	gkPrintf("sync line");
+	EXPECT_EQ(gkLoggerTestFind("sync line", "sync line"), 1);
+
+	// no writer, already on disk before disable
+	gkLogger::setAsync(true);
+	EXPECT_TRUE(gkLogger::isAsync());
+	gkPrintf("async line");
+	gkLogger::flush();
+
+	EXPECT_EQ(gkLoggerTestFind("sync line", "async line"), 2);
+
+	gkLogger::disable();
+	EXPECT_FALSE(gkLogger::isAsync());
+	remove(LOG_FILE);
+}
+
+
+TEST(TEST_CASE_NAME, testPrintfLevel)
+{
+	gkLogger::setAsync(false);
+	gkLogger::enable(LOG_FILE, true);
+
+	// engine errors come through gkPrintf, a quieter log keeps them
+	gkLogger::setLevel(GK_LOG_ERROR);
+	gkPrintf("printf line");
+	gkLogf(GK_LOG_INFO, GK_LOG_CORE, "filtered line");
+	gkLogf(GK_LOG_ERROR, GK_LOG_CORE, "error line");
+	gkLogger::setLevel(GK_LOG_DEBUG);
+
+	EXPECT_EQ(gkLoggerTestFind("printf line", "error line"), 2);
+	EXPECT_EQ(gkLoggerTestFind("filtered line", "filtered line"), 0);
+
+	gkLogger::disable();
+	gkLogger::setAsync(true);
+	remove(LOG_FILE);
+}
+
+
+TEST(TEST_CASE_NAME, testQueueReuse)
+{
+	gkLogger::setAsync(true);
+	gkLogger::enable(LOG_FILE, false);
+
+	// one thread at a time, each takes over the last one's queue
+	gkLogger::flush();
+	UTsize before = gkLogger::getQueueCount();
+
+	for (int t = 0; t < 8; ++t)
+	{
+		gkLoggerTestCall call(t);
+		gkThread thread(&call);
+		thread.join();
+
+		// join returns before the thread is gone, give it time to exit
+		gkThread::sleep(20);
+	}
+
+	EXPECT_LE(gkLogger::getQueueCount(), before + 2);
+
+	gkLogger::disable();
+	remove(LOG_FILE);
+}
+
+
+TEST(TEST_CASE_NAME, testForcedWrite)
+{
+	gkLogger::setAsync(false);
+	gkLogger::enable(LOG_FILE, true);
+
+	gkLogger::setLevel(GK_LOG_ERROR);
+	gkLogger::write("quiet line");
+	gkLogger::write("forced line", true);
+	gkLogger::setLevel(GK_LOG_DEBUG);
+
+	EXPECT_EQ(gkLoggerTestFind("forced line", "forced line"), 1);
+	EXPECT_EQ(gkLoggerTestFind("quiet line", "quiet line"), 0);
+
+	gkLogger::disable();
+	gkLogger::setAsync(true);
+	remove(LOG_FILE);
+}
+
+
+static void gkLoggerTestAbort(void)
+{
+	gkLogger::setAsync(true);
+	gkLogger::enable(LOG_FILE, true);
+
+	// still queued when the process goes down
+	gkPrintf("last line");
+	abort();
+}
+
+
+TEST(TEST_CASE_NAME, testFatalFlush)
+{
+	::testing::FLAGS_gtest_death_test_style = "threadsafe";
+
+	remove(LOG_FILE);
+	EXPECT_DEATH(gkLoggerTestAbort(), "");
+	EXPECT_EQ(gkLoggerTestFind("last line", "last line"), 1);
+	remove(LOG_FILE);
+}
@@ -0,0 +1,241 @@
+#include "StdAfx.h"
+
+#define TEST_CASE_NAME testGkLogicSensors
+
+// several chunks of concurrent sensors, see gkLogicManager::querySensors
+#define SENSOR_AGENTS 150
+
+
+// instanced without a scene node, transforms come from the properties
+class gkLogicSensorsTestObject : public gkGameObject
+{
+public:
+	gkLogicSensorsTestObject(gkInstancedManager* creator, const gkResourceName& name)
+		:    gkGameObject(creator, name, -1)
+	{
+	}
+
+private:
+	void createInstanceImpl(void) {}
+	void destroyInstanceImpl(void) {}
+	void postCreateInstanceImpl(void) {}
+	void postDestroyInstanceImpl(void) {}
+};
+
+
+class gkLogicSensorsTestManager : public gkInstancedManager
+{
+public:
+	gkLogicSensorsTestManager() : gkInstancedManager("TestObjectManager", "TestObject") {}
+
+	gkResource* createImpl(const gkResourceName& name, const gkResourceHandle& handle)
+	{
+		return new gkLogicSensorsTestObject(this, name);
+	}
+};
+
+
+// A bare scene, agents above a row of boxes cast a ray down and test a counter.
+// Every other box carries the "Hit" property the rays look for.
+class gkLogicSensorsTestScene
+{
+public:
+	gkLogicSensorsTestScene()
+		:    m_box(btVector3(1, 1, 1))
+	{
+		m_scene = new gkScene(&m_mgr, gkResourceName("LogicSensors"), -1);
+		m_world = m_scene->getDynamicsWorld();
+
+		gkLogicManager* lmgr = m_scene->getLogicBrickManager();
+
+		for (int i = 0; i < SENSOR_AGENTS; ++i)
+		{
+			gkString nr = Ogre::StringConverter::toString(i);
+
+			gkGameObject* target = create("Target" + nr, gkVector3(gkScalar(i * 4), 0, 0));
+			if ((i % 2) == 0)
+				target->createVariable("Hit", false);
+
+			gkPhysicsController* cont = new gkPhysicsController(target, m_world);
+			btCollisionObject* col = new btCollisionObject();
+			btTransform trans;
+			trans.setIdentity();
+			trans.setOrigin(btVector3(btScalar(i * 4), 0, 0));
+			col->setCollisionShape(&m_box);
+			col->setWorldTransform(trans);
+			col->setUserPointer(cont);
+			m_world->getBulletWorld()->addCollisionObject(col);
+
+			m_controllers.push_back(cont);
+			m_collisionObjects.push_back(col);
+
+			gkGameObject* agent = create("Agent" + nr, gkVector3(gkScalar(i * 4), 0, 5));
+			agent->createVariable("Count", false)->setValue(i % 3);
+
+			gkLogicLink* link = lmgr->createLink();
+			link->setState(1);
+			link->setObject(agent);
+			agent->attachLogic(link);
+
+			gkRaySensor* ray = new gkRaySensor(agent, link, "Ray");
+			ray->setAxis(gkRaySensor::RA_ZNEG);
+			ray->setRange(10);
+			ray->setProperty("Hit");
+			ray->setMask(1);
+			link->push(ray);
+
+			gkPropertySensor* prop = new gkPropertySensor(agent, link, "Count");
+			prop->setType(gkPropertySensor::PS_EQUAL);
+			prop->setProperty("Count");
+			prop->setValue("1");
+			prop->setMask(1);
+			link->push(prop);
+
+			gkLogicOpController* op = new gkLogicOpController(agent, link, "And");
+			op->setOp(gkLogicOpController::OP_AND);
+			op->setMask(1);
+			link->push(op);
+
+			ray->link(op);
+			prop->link(op);
+
+			m_rays.push_back(ray);
+			m_props.push_back(prop);
+		}
+		m_world->getBulletWorld()->updateAabbs();
+	}
+
+	~gkLogicSensorsTestScene()
+	{
+		for (UTsize i = 0; i < m_objects.size(); ++i)
+			delete m_objects[i];
+
+		for (UTsize i = 0; i < m_collisionObjects.size(); ++i)
+		{
+			m_world->getBulletWorld()->removeCollisionObject(m_collisionObjects[i]);
+			delete m_collisionObjects[i];
+			delete m_controllers[i];
+		}
+
+		// not instanced, nothing else owns these
+		delete m_world;
+		delete m_scene->getLogicBrickManager();
+		delete m_scene;
+	}
+
+	void tick(void)
+	{
+		m_scene->getLogicBrickManager()->update(0);
+	}
+
+	void setCount(int i, int v)
+	{
+		m_rays[i]->getObject()->getVariable("Count")->setValue(v);
+	}
+
+	gkGameObject* create(const gkString& name, const gkVector3& pos)
+	{
+		gkGameObject* obj = new gkLogicSensorsTestObject(&m_mgr, gkResourceName(name));
+		obj->getProperties().m_transform.loc = pos;
+		obj->setOwner(m_scene);
+		obj->createInstance();
+		m_objects.push_back(obj);
+		return obj;
+	}
+
+	gkLogicSensorsTestManager       m_mgr;
+	gkScene*                        m_scene;
+	gkDynamicsWorld*                m_world;
+	btBoxShape                      m_box;
+	utArray<gkGameObject*>          m_objects;
+	utArray<gkPhysicsController*>   m_controllers;
+	utArray<btCollisionObject*>     m_collisionObjects;
+	utArray<gkLogicSensor*>         m_rays, m_props;
+};
+
+
+typedef utArray<bool> gkLogicSensorsTestResults;
+
+// two ticks, the counters change in between
+static void gkLogicSensorsTestRun(gkLogicSensorsTestResults& results)
+{
+	gkLogicSensorsTestScene scene;
+
+	scene.tick();
+	for (int i = 0; i < SENSOR_AGENTS; ++i)
+	{
+		results.push_back(scene.m_rays[i]->isPositive());
+		results.push_back(scene.m_props[i]->isPositive());
+	}
+
+	for (int i = 0; i < SENSOR_AGENTS; i += 5)
+		scene.setCount(i, 1);
+
+	scene.tick();
+	for (int i = 0; i < SENSOR_AGENTS; ++i)
+	{
+		results.push_back(scene.m_rays[i]->isPositive());
+		results.push_back(scene.m_props[i]->isPositive());
+	}
+}
+
+
+TEST(TEST_CASE_NAME, testConcurrentMatchesSerial)
+{
+	gkUserDefs defs;
+	gkEngine engine(&defs);
+
+	gkLogicSensorsTestResults serial, concurrent;
+
+	defs.logicThreads = 0;
+	gkLogicSensorsTestRun(serial);
+	EXPECT_TRUE(engine.getSensorPool() == 0);
+
+	defs.logicThreads = 4;
+	gkLogicSensorsTestRun(concurrent);
+	ASSERT_TRUE(engine.getSensorPool() != 0);
+	EXPECT_EQ(engine.getSensorPool()->getWorkerCount(), 4U);
+
+	ASSERT_EQ(serial.size(), (UTsize)SENSOR_AGENTS * 4);
+	ASSERT_EQ(concurrent.size(), serial.size());
+
+	for (UTsize i = 0; i < serial.size(); ++i)
+		EXPECT_EQ(serial[i], concurrent[i]) << "result " << i;
+
+	// and both are what the scene says
+	for (int i = 0; i < SENSOR_AGENTS; ++i)
+	{
+		const UTsize first = i * 2, second = SENSOR_AGENTS * 2 + i * 2;
+		EXPECT_EQ(serial[first], (i % 2) == 0);
+		EXPECT_EQ(serial[first + 1], (i % 3) == 1);
+		EXPECT_EQ(serial[second], (i % 2) == 0);
+		EXPECT_EQ(serial[second + 1], (i % 3) == 1 || (i % 5) == 0);
+	}
+}
+
+
+TEST(TEST_CASE_NAME, testSharedPool)
+{
+	gkUserDefs defs;
+
+	// a single worker isn't worth a pool
+	{
+		defs.logicThreads = 1;
+		gkEngine engine(&defs);
+		EXPECT_TRUE(engine.getSensorPool() == 0);
+	}
+
+	defs.logicThreads = 2;
+	gkEngine engine(&defs);
+
+	// one pool for every scene's logic manager
+	gkThreadPool* pool = engine.getSensorPool();
+	ASSERT_TRUE(pool != 0);
+
+	gkLogicSensorsTestResults first, second;
+	gkLogicSensorsTestRun(first);
+	gkLogicSensorsTestRun(second);
+
+	EXPECT_TRUE(engine.getSensorPool() == pool);
+	EXPECT_EQ(first.size(), second.size());
+}
@@ -0,0 +1,185 @@
+#include "StdAfx.h"
+
+#define TEST_CASE_NAME testGkLogicTree
+
+typedef utArray<int> gkLogicTreeTestLog;
+
+
+// writes its value every tick, like an input node
+class gkLogicTreeTestSource : public gkLogicNode
+{
+public:
+	enum
+	{
+		VALUE
+	};
+
+	DECLARE_SOCKET_TYPE(VALUE, int);
+
+	gkLogicTreeTestSource(gkLogicTree* parent, size_t id)
+		: gkLogicNode(parent, id), m_value(0), m_runs(0), m_log(0)
+	{
+		ADD_OSOCK(VALUE, 0);
+	}
+
+	void update(gkScalar tick)
+	{
+		++m_runs;
+		if (m_log) m_log->push_back(-1);
+
+		SET_SOCKET_VALUE(VALUE, m_value);
+	}
+
+	int m_value, m_runs;
+	gkLogicTreeTestLog* m_log;
+};
+
+
+template<bool PURE>
+class gkLogicTreeTestAdd : public gkLogicNode
+{
+public:
+	enum
+	{
+		A,
+		B,
+		RESULT
+	};
+
+	DECLARE_SOCKET_TYPE(A, int);
+	DECLARE_SOCKET_TYPE(B, int);
+	DECLARE_SOCKET_TYPE(RESULT, int);
+
+	gkLogicTreeTestAdd(gkLogicTree* parent, size_t id)
+		: gkLogicNode(parent, id), m_id(0), m_runs(0), m_log(0)
+	{
+		ADD_ISOCK(A, 0);
+		ADD_ISOCK(B, 0);
+		ADD_OSOCK(RESULT, 0);
+
+		if (PURE)
+			setPure();
+	}
+
+	void update(gkScalar tick)
+	{
+		++m_runs;
+		if (m_log) m_log->push_back(m_id);
+
+		SET_SOCKET_VALUE(RESULT, GET_SOCKET_VALUE(A) + GET_SOCKET_VALUE(B));
+	}
+
+	int m_id, m_runs;
+	gkLogicTreeTestLog* m_log;
+};
+
+typedef gkLogicTreeTestAdd<true>  gkLogicTreeTestPure;
+typedef gkLogicTreeTestAdd<false> gkLogicTreeTestImpure;
+
+
+// source -> left, right -> join, created in reverse so only the plan orders them
+class gkLogicTreeTestDiamond
+{
+public:
+	gkLogicTreeTestDiamond()
+		: m_tree(0, gkResourceName("Diamond"), 0)
+	{
+		m_join   = m_tree.createNode<gkLogicTreeTestPure>();
+		m_right  = m_tree.createNode<gkLogicTreeTestPure>();
+		m_left   = m_tree.createNode<gkLogicTreeTestPure>();
+		m_source = m_tree.createNode<gkLogicTreeTestSource>();
+
+		m_left->m_id  = 1;
+		m_right->m_id = 2;
+		m_join->m_id  = 3;
+
+		m_source->m_log = m_left->m_log = m_right->m_log = m_join->m_log = &m_log;
+
+		m_left->getA()->link(m_source->getVALUE());
+		m_right->getA()->link(m_source->getVALUE());
+		m_join->getA()->link(m_left->getRESULT());
+		m_join->getB()->link(m_right->getRESULT());
+	}
+
+	gkLogicTree             m_tree;
+	gkLogicTreeTestSource*  m_source;
+	gkLogicTreeTestPure*    m_left, *m_right, *m_join;
+	gkLogicTreeTestLog      m_log;
+};
+
+
+TEST(TEST_CASE_NAME, testPlanOrder)
+{
+	gkLogicTreeTestDiamond d;
+	d.m_source->m_value = 2;
+	d.m_tree.execute(0);
+
+	ASSERT_EQ(d.m_log.size(), 4U);
+	EXPECT_EQ(d.m_log[0], -1);
+	EXPECT_TRUE((d.m_log[1] == 1 && d.m_log[2] == 2) || (d.m_log[1] == 2 && d.m_log[2] == 1));
+	EXPECT_EQ(d.m_log[3], 3);
+
+	EXPECT_EQ(d.m_join->getRESULT()->getValue(), 4);
+}
+
+
+TEST(TEST_CASE_NAME, testPureSkipped)
+{
+	gkLogicTreeTestDiamond d;
+	d.m_source->m_value = 2;
+	d.m_tree.execute(0);
+
+	// the source writes the same value again
+	for (int i = 0; i < 3; ++i)
+		d.m_tree.execute(0);
+
+	EXPECT_EQ(d.m_source->m_runs, 4);
+	EXPECT_EQ(d.m_left->m_runs, 1);
+	EXPECT_EQ(d.m_right->m_runs, 1);
+	EXPECT_EQ(d.m_join->m_runs, 1);
+	EXPECT_EQ(d.m_join->getRESULT()->getValue(), 4);
+}
+
+
+TEST(TEST_CASE_NAME, testPureRerunsOnChange)
+{
+	gkLogicTreeTestDiamond d;
+	d.m_source->m_value = 2;
+	d.m_tree.execute(0);
+	d.m_tree.execute(0);
+
+	d.m_source->m_value = 5;
+	d.m_tree.execute(0);
+
+	EXPECT_EQ(d.m_left->m_runs, 2);
+	EXPECT_EQ(d.m_right->m_runs, 2);
+	EXPECT_EQ(d.m_join->m_runs, 2);
+	EXPECT_EQ(d.m_join->getRESULT()->getValue(), 10);
+
+	// a change on one branch only still reaches the join
+	d.m_right->getB()->setValue(1);
+	d.m_tree.execute(0);
+
+	EXPECT_EQ(d.m_left->m_runs, 2);
+	EXPECT_EQ(d.m_right->m_runs, 3);
+	EXPECT_EQ(d.m_join->m_runs, 3);
+	EXPECT_EQ(d.m_join->getRESULT()->getValue(), 11);
+}
+
+
+TEST(TEST_CASE_NAME, testImpureAlwaysRuns)
+{
+	gkLogicTree tree(0, gkResourceName("Impure"), 0);
+
+	gkLogicTreeTestSource* source = tree.createNode<gkLogicTreeTestSource>();
+	gkLogicTreeTestImpure* node = tree.createNode<gkLogicTreeTestImpure>();
+	node->getA()->link(source->getVALUE());
+
+	source->m_value = 3;
+	for (int i = 0; i < 4; ++i)
+		tree.execute(0);
+
+	EXPECT_FALSE(node->isPure());
+	EXPECT_EQ(node->m_runs, 4);
+	EXPECT_EQ(node->getRESULT()->getValue(), 3);
+}
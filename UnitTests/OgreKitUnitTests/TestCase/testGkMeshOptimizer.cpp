@@ -0,0 +1,171 @@
+#include "StdAfx.h"
+
+#define TEST_CASE_NAME testGkMeshOptimizer
+
+// side x side quad grid, rows emitted in a cache unfriendly column order
+static void makeGrid(int side, utArray<unsigned int>& indices)
+{
+	for (int x = 0; x < side; ++x)
+	{
+		for (int y = 0; y < side; ++y)
+		{
+			unsigned int a = y * (side + 1) + x, b = a + 1, c = a + side + 1, d = c + 1;
+			indices.push_back(a); indices.push_back(b); indices.push_back(c);
+			indices.push_back(b); indices.push_back(d); indices.push_back(c);
+		}
+	}
+}
+
+static bool triGreater(const UTuint64& a, const UTuint64& b)
+{
+	return a > b;
+}
+
+static void sortedTriangles(const utArray<unsigned int>& indices, const gkMeshOptimizer::Remap* remap, utArray<UTuint64>& out)
+{
+	out.clear();
+	for (UTsize i = 0; i < indices.size(); i += 3)
+	{
+		unsigned int v[3] = {indices[i], indices[i + 1], indices[i + 2]};
+		if (remap)
+		{
+			// back to the original numbering
+			for (int k = 0; k < 3; ++k)
+			{
+				for (UTsize o = 0; o < remap->size(); ++o)
+				{
+					if ((*remap)[o] == v[k])
+					{
+						v[k] = (unsigned int)o;
+						break;
+					}
+				}
+			}
+		}
+
+		// rotate the smallest index first, winding is kept
+		int s = v[0] < v[1] ? (v[0] < v[2] ? 0 : 2) : (v[1] < v[2] ? 1 : 2);
+		out.push_back(((UTuint64)v[s] << 42) | ((UTuint64)v[(s + 1) % 3] << 21) | v[(s + 2) % 3]);
+	}
+
+	out.sort(triGreater);
+}
+
+TEST(TEST_CASE_NAME, testVertexCache)
+{
+	const int side = 40;
+	const UTsize vertexCount = (side + 1) * (side + 1);
+
+	utArray<unsigned int> indices;
+	makeGrid(side, indices);
+	utArray<unsigned int> original = indices;
+
+	gkScalar before = gkMeshOptimizer::getACMR(indices.ptr(), indices.size(), vertexCount, 16);
+	gkMeshOptimizer::optimizeVertexCache(indices.ptr(), indices.size(), vertexCount);
+	gkScalar after = gkMeshOptimizer::getACMR(indices.ptr(), indices.size(), vertexCount, 16);
+
+	EXPECT_LT(after, before);
+	EXPECT_LT(after, 0.8f);
+
+	utArray<UTuint64> a, b;
+	sortedTriangles(original, 0, a);
+	sortedTriangles(indices, 0, b);
+	ASSERT_EQ(a.size(), b.size());
+	for (UTsize i = 0; i < a.size(); ++i)
+		EXPECT_EQ(a[i], b[i]);
+}
+
+TEST(TEST_CASE_NAME, testVertexFetch)
+{
+	const int side = 8;
+	const UTsize vertexCount = (side + 1) * (side + 1) + 2;
+
+	utArray<unsigned int> indices;
+	makeGrid(side, indices);
+	utArray<unsigned int> original = indices;
+
+	gkMeshOptimizer::Remap remap;
+	gkMeshOptimizer::optimizeVertexFetch(indices.ptr(), indices.size(), vertexCount, remap);
+
+	ASSERT_EQ(remap.size(), vertexCount);
+
+	// first use order
+	unsigned int next = 0;
+	for (UTsize i = 0; i < indices.size(); ++i)
+	{
+		EXPECT_LE(indices[i], next);
+		if (indices[i] == next)
+			++next;
+	}
+
+	// unreferenced vertices go last, every slot is used once
+	EXPECT_EQ(remap[vertexCount - 2], vertexCount - 2);
+	EXPECT_EQ(remap[vertexCount - 1], vertexCount - 1);
+
+	utArray<UTuint64> a, b;
+	sortedTriangles(original, 0, a);
+	sortedTriangles(indices, &remap, b);
+	for (UTsize i = 0; i < a.size(); ++i)
+		EXPECT_EQ(a[i], b[i]);
+}
+
+TEST(TEST_CASE_NAME, testSimplify)
+{
+	// closed uv sphere, rings x segments plus the poles
+	const int rings = 32, segments = 64;
+
+	utArray<gkVector3> positions;
+	utArray<unsigned int> indices;
+
+	positions.push_back(gkVector3(0, 0, 1));
+	for (int i = 1; i < rings; ++i)
+	{
+		for (int j = 0; j < segments; ++j)
+		{
+			gkScalar th = gkPi * i / rings, ph = 2.f * gkPi * j / segments;
+			positions.push_back(gkVector3(gkMath::Sin(th) * gkMath::Cos(ph), gkMath::Sin(th) * gkMath::Sin(ph), gkMath::Cos(th)));
+		}
+	}
+	positions.push_back(gkVector3(0, 0, -1));
+
+	const unsigned int south = positions.size() - 1, last = 1 + (rings - 2) * segments;
+	for (int j = 0; j < segments; ++j)
+	{
+		indices.push_back(0); indices.push_back(1 + j); indices.push_back(1 + (j + 1) % segments);
+		indices.push_back(south); indices.push_back(last + (j + 1) % segments); indices.push_back(last + j);
+	}
+	for (int i = 0; i < rings - 2; ++i)
+	{
+		for (int j = 0; j < segments; ++j)
+		{
+			unsigned int a = 1 + i * segments + j, b = 1 + i * segments + (j + 1) % segments, c = a + segments, d = b + segments;
+			indices.push_back(a); indices.push_back(c); indices.push_back(b);
+			indices.push_back(b); indices.push_back(c); indices.push_back(d);
+		}
+	}
+
+	utArray<unsigned int> lod;
+	lod.resize(indices.size());
+
+	UTsize target = indices.size() / 12 * 3;
+	UTsize count = gkMeshOptimizer::simplify(lod.ptr(), indices.ptr(), indices.size(), positions.ptr(), positions.size(), target);
+
+	EXPECT_GE(count, target);
+	EXPECT_LE(count, target + 6);
+	EXPECT_EQ(count % 3, (UTsize)0);
+
+	for (UTsize i = 0; i < count; i += 3)
+	{
+		EXPECT_LT(lod[i], positions.size());
+		EXPECT_TRUE(lod[i] != lod[i + 1] && lod[i + 1] != lod[i + 2] && lod[i] != lod[i + 2]);
+
+		// still close to the surface and facing out
+		const gkVector3& p0 = positions[lod[i]], &p1 = positions[lod[i + 1]], &p2 = positions[lod[i + 2]];
+		gkVector3 c = (p0 + p1 + p2) / 3.f;
+		EXPECT_GT(c.length(), 0.9f);
+		EXPECT_GT((p1 - p0).crossProduct(p2 - p0).dotProduct(c), 0.f);
+	}
+
+	// nothing left to remove
+	EXPECT_EQ(gkMeshOptimizer::simplify(lod.ptr(), indices.ptr(), indices.size(), positions.ptr(), positions.size(), indices.size()), indices.size());
+}
@@ -0,0 +1,230 @@
+#include "StdAfx.h"
+
+#define TEST_CASE_NAME testGkMessageManager
+
+TEST(TEST_CASE_NAME, testIntern)
+{
+	gkMessageManager mgr;
+
+	EXPECT_EQ(mgr.intern(""), 0u);
+
+	gkMessageManager::Id a = mgr.intern("Player");
+	gkMessageManager::Id b = mgr.intern("Enemy");
+
+	EXPECT_NE(a, 0u);
+	EXPECT_NE(a, b);
+	EXPECT_EQ(mgr.intern("Player"), a);
+	EXPECT_EQ(mgr.getName(a), "Player");
+	EXPECT_EQ(mgr.getName(b), "Enemy");
+	EXPECT_EQ(mgr.getName(0), "");
+}
+
+TEST(TEST_CASE_NAME, testFilters)
+{
+	gkMessageManager mgr;
+
+	gkMessageManager::GenericMessageListener any;
+	gkMessageManager::GenericMessageListener toPlayer("", "Player", "");
+	gkMessageManager::GenericMessageListener player("", "Player", "");
+	gkMessageManager::GenericMessageListener hit("", "", "hit");
+	player.setAcceptEmptyTo(true);
+	gkMessageManager::GenericMessageListener playerHit("", "Player", "hit");
+	playerHit.setAcceptEmptyTo(true);
+
+	mgr.addListener(&any);
+	mgr.addListener(&toPlayer);
+	mgr.addListener(&player);
+	mgr.addListener(&hit);
+	mgr.addListener(&playerHit);
+
+	mgr.sendMessage("Enemy", "Player", "hit", "10");
+	mgr.sendMessage("Enemy", "", "hit", "5");
+	mgr.sendMessage("Enemy", "Enemy", "hit", "1");
+	mgr.sendMessage("Enemy", "Player", "heal", "2");
+
+	EXPECT_EQ(any.m_messages.size(), 4u);
+	// a recipient filter only applies along with accepting empty recipients
+	EXPECT_EQ(toPlayer.m_messages.size(), 4u);
+	EXPECT_EQ(player.m_messages.size(), 3u);
+	EXPECT_EQ(player.getToFilter(), "Player");
+	EXPECT_EQ(hit.m_messages.size(), 3u);
+	ASSERT_EQ(playerHit.m_messages.size(), 2u);
+
+	EXPECT_EQ(playerHit.m_messages[0].getFrom(), "Enemy");
+	EXPECT_EQ(playerHit.m_messages[0].getTo(), "Player");
+	EXPECT_EQ(playerHit.m_messages[0].getSubject(), "hit");
+	EXPECT_STREQ(playerHit.m_messages[0].getBody(), "10");
+	EXPECT_STREQ(playerHit.m_messages[1].getBody(), "5");
+
+	// re-indexed under the new subject
+	hit.setSubjectFilter("heal");
+	hit.emptyMessages();
+	mgr.sendMessage("Enemy", "Player", "heal", "3");
+	mgr.sendMessage("Enemy", "Player", "hit", "4");
+	EXPECT_EQ(hit.m_messages.size(), 1u);
+
+	mgr.removeListener(&any);
+	any.emptyMessages();
+	mgr.sendMessage("Enemy", "Player", "hit", "4");
+	EXPECT_EQ(any.m_messages.size(), 0u);
+
+	mgr.removeListener(&toPlayer);
+	mgr.removeListener(&player);
+	mgr.removeListener(&hit);
+	mgr.removeListener(&playerHit);
+}
+
+TEST(TEST_CASE_NAME, testStringFilters)
+{
+	gkMessageManager mgr;
+
+	// a message sensor's listener, then moved to another owner
+	gkMessageManager::GenericMessageListener listener("", "Player", "");
+	listener.setAcceptEmptyTo(true);
+	mgr.addListener(&listener);
+
+	listener.setToFilter("Enemy");
+	listener.setFromFilter("Player");
+	EXPECT_EQ(listener.getToFilter(), "Enemy");
+	EXPECT_EQ(listener.getFromFilter(), "Player");
+	EXPECT_EQ(listener.getSubjectFilter(), "");
+
+	mgr.sendMessage("Player", "Player", "hit", "");
+	mgr.sendMessage("Player", "Enemy", "hit", "");
+	mgr.sendMessage("Player", "", "hit", "");
+	mgr.sendMessage("Enemy", "Enemy", "hit", "");
+
+	ASSERT_EQ(listener.m_messages.size(), 2u);
+	EXPECT_EQ(listener.m_messages[0].getTo(), "Enemy");
+	EXPECT_EQ(listener.m_messages[1].getTo(), "");
+
+	mgr.removeListener(&listener);
+}
+
+
+class gkMessageManagerTestIntern : public gkCall
+{
+public:
+	gkMessageManagerTestIntern(gkMessageManager* mgr, int offset) : m_mgr(mgr), m_offset(offset) {}
+
+	void run(void)
+	{
+		for (int i = 0; i < 2000; ++i)
+		{
+			gkString name = utStringFormat("Object%i", (i + m_offset) % 500);
+			m_ids.push_back(m_mgr->intern(name));
+		}
+	}
+
+	gkMessageManager*            m_mgr;
+	int                          m_offset;
+	utArray<gkMessageManager::Id> m_ids;
+};
+
+
+TEST(TEST_CASE_NAME, testConcurrentIntern)
+{
+	gkMessageManager mgr;
+
+	gkMessageManagerTestIntern a(&mgr, 0), b(&mgr, 250);
+	gkThread* ta = new gkThread(&a);
+	gkThread* tb = new gkThread(&b);
+	ta->join();
+	tb->join();
+	delete ta;
+	delete tb;
+
+	// one id per name, whichever thread saw it first
+	for (int i = 0; i < 2000; ++i)
+	{
+		EXPECT_EQ(mgr.getName(a.m_ids[i]), utStringFormat("Object%i", i % 500));
+		EXPECT_EQ(mgr.getName(b.m_ids[i]), utStringFormat("Object%i", (i + 250) % 500));
+		EXPECT_EQ(mgr.intern(mgr.getName(a.m_ids[i])), a.m_ids[i]);
+	}
+	EXPECT_EQ(a.m_ids[250], b.m_ids[0]);
+}
+
+
+TEST(TEST_CASE_NAME, testArena)
+{
+	gkMessageManager mgr;
+
+	gkMessageManager::GenericMessageListener listener;
+	mgr.addListener(&listener);
+
+	mgr.sendMessage("A", "B", "old", "first");
+	mgr.beginTick();
+	mgr.sendMessage("A", "B", "new", "second");
+
+	// plain copies, not retained by anyone once the listener lets go
+	ASSERT_EQ(listener.m_messages.size(), 2u);
+	utArray<gkMessageManager::Message> copies = listener.m_messages;
+	listener.emptyMessages();
+
+	EXPECT_TRUE(mgr.isLive(copies[0]));
+	EXPECT_STREQ(copies[0].getBody(), "first");
+	EXPECT_STREQ(copies[1].getBody(), "second");
+
+	// two ticks later the first body is gone, names stay
+	mgr.beginTick();
+	EXPECT_FALSE(mgr.isLive(copies[0]));
+	EXPECT_STREQ(copies[0].getBody(), "");
+	EXPECT_EQ(copies[0].getSubject(), "old");
+	EXPECT_STREQ(copies[1].getBody(), "second");
+
+	for (int i = 0; i < 1000; ++i)
+		mgr.sendMessage("A", "", "spam", utStringFormat("body%i", i));
+	EXPECT_STREQ(copies[1].getBody(), "second");
+	EXPECT_STREQ(listener.m_messages.back().getBody(), "body999");
+
+	mgr.removeListener(&listener);
+}
+
+TEST(TEST_CASE_NAME, testSensorFrequency)
+{
+	gkMessageManager mgr;
+
+	// a message sensor with frequency 4, queried every fifth tick
+	gkMessageManager::GenericMessageListener listener("", "Player", "");
+	listener.setAcceptEmptyTo(true);
+	mgr.addListener(&listener);
+
+	utArray<gkMessageManager::Message> queried;
+
+	for (int round = 0; round < 3; ++round)
+	{
+		for (int tick = 0; tick < 5; ++tick)
+		{
+			mgr.beginTick();
+			mgr.sendMessage("Enemy", "Player", "hit", utStringFormat("%i.%i", round, tick));
+			mgr.sendMessage("Enemy", "Enemy", "hit", "not for the player");
+		}
+
+		// what the sensor held since its last query is released now
+		for (UTsize i = 0; i < queried.size(); ++i)
+			mgr.release(queried[i]);
+		queried.resize(0);
+		listener.takeMessages(queried);
+
+		ASSERT_EQ(queried.size(), 5u);
+		for (int tick = 0; tick < 5; ++tick)
+		{
+			EXPECT_TRUE(mgr.isLive(queried[tick]));
+			EXPECT_STREQ(queried[tick].getBody(), utStringFormat("%i.%i", round, tick).c_str());
+		}
+	}
+
+	// still readable by the Logic script run after the query
+	mgr.beginTick();
+	mgr.beginTick();
+	EXPECT_STREQ(queried[0].getBody(), "2.0");
+
+	for (UTsize i = 0; i < queried.size(); ++i)
+		mgr.release(queried[i]);
+
+	mgr.beginTick();
+	mgr.beginTick();
+	EXPECT_FALSE(mgr.isLive(queried[0]));
+
+	mgr.removeListener(&listener);
+}
@@ -0,0 +1,194 @@
+#include "StdAfx.h"
+
+#define TEST_CASE_NAME testGkPhysicsSubsteps
+
+
+class gkPhysicsSubstepsTestManager : public gkInstancedManager
+{
+public:
+	gkPhysicsSubstepsTestManager() : gkInstancedManager("TestObjectManager", "TestObject") {}
+
+	gkResource* createImpl(const gkResourceName& name, const gkResourceHandle& handle)
+	{
+		return 0;
+	}
+};
+
+
+// A bare scene, one sphere falls freely. Every physics step is counted and
+// the sphere's height after it recorded.
+class gkPhysicsSubstepsTestWorld : public gkDynamicsWorld::Listener
+{
+public:
+	gkPhysicsSubstepsTestWorld()
+		:    m_sphere(1),
+		     m_state(btTransform(btQuaternion::getIdentity(), btVector3(0, 0, 10))),
+		     m_steps(0)
+	{
+		m_scene = new gkScene(&m_mgr, gkResourceName("PhysicsSubsteps"), -1);
+		m_world = m_scene->getDynamicsWorld();
+
+		btVector3 inertia(0, 0, 0);
+		m_sphere.calculateLocalInertia(1, inertia);
+
+		m_body = new btRigidBody(1, &m_state, &m_sphere, inertia);
+		m_body->setActivationState(DISABLE_DEACTIVATION);
+		m_world->getBulletWorld()->addRigidBody(m_body);
+		m_world->addListener(this);
+
+		m_heights.push_back(getBodyZ());
+	}
+
+	~gkPhysicsSubstepsTestWorld()
+	{
+		m_world->removeListener(this);
+		m_world->getBulletWorld()->removeRigidBody(m_body);
+		delete m_body;
+
+		// not instanced, nothing else owns these
+		delete m_world;
+		delete m_scene->getLogicBrickManager();
+		delete m_scene;
+	}
+
+	void presubtick(gkScalar rate) {}
+
+	void subtick(gkScalar rate)
+	{
+		++m_steps;
+		m_heights.push_back(getBodyZ());
+	}
+
+	// steps taken by one tick
+	int step(gkScalar tick)
+	{
+		int steps = m_steps;
+		m_world->step(tick);
+		return m_steps - steps;
+	}
+
+	gkScalar getBodyZ(void)
+	{
+		return m_body->getWorldTransform().getOrigin().z();
+	}
+
+	// what the scene node would be given
+	gkScalar getStateZ(void)
+	{
+		btTransform trans;
+		m_state.getWorldTransform(trans);
+		return trans.getOrigin().z();
+	}
+
+	gkPhysicsSubstepsTestManager m_mgr;
+	gkScene*                     m_scene;
+	gkDynamicsWorld*             m_world;
+	btSphereShape                m_sphere;
+	btDefaultMotionState         m_state;
+	btRigidBody*                 m_body;
+	int                          m_steps;
+	utArray<gkScalar>            m_heights;
+};
+
+
+TEST(TEST_CASE_NAME, testFixedStep)
+{
+	gkUserDefs defs;
+	gkEngine engine(&defs);
+
+	// the scene settings, one step per tick
+	{
+		gkPhysicsSubstepsTestWorld world;
+		EXPECT_FLOAT_EQ(world.m_world->getFixedStep(), gkEngine::getStepRate());
+		EXPECT_EQ(world.m_world->getMaxSubSteps(), world.m_scene->getProperties().m_maxPhysicsSteps);
+	}
+
+	// the user defs win
+	defs.physicsRate = 240;
+	defs.maxPhysicsSteps = 7;
+	{
+		gkPhysicsSubstepsTestWorld world;
+		EXPECT_FLOAT_EQ(world.m_world->getFixedStep(), gkScalar(1.0) / gkScalar(240));
+		EXPECT_EQ(world.m_world->getMaxSubSteps(), 7);
+	}
+}
+
+
+TEST(TEST_CASE_NAME, testSubstepClamp)
+{
+	gkUserDefs defs;
+	gkEngine engine(&defs);
+
+	defs.physicsRate = 120;
+	defs.maxPhysicsSteps = 3;
+	gkPhysicsSubstepsTestWorld world;
+
+	const gkScalar fixed = world.m_world->getFixedStep();
+
+	// a regular tick, as many steps as fit
+	EXPECT_EQ(world.step(fixed * gkScalar(2.5)), 2);
+
+	// a stalled tick is capped, the time past the cap is dropped
+	EXPECT_EQ(world.step(gkScalar(1.0)), 3);
+	EXPECT_EQ(world.step(fixed * gkScalar(0.25)), 0);
+
+	// a tick shorter than one step still accumulates rather than stepping
+	// by its own length every time
+	int steps = 0;
+	for (int i = 0; i < 4; ++i)
+		steps += world.step(fixed * gkScalar(0.2));
+	EXPECT_EQ(steps, 1);
+}
+
+
+TEST(TEST_CASE_NAME, testInterpolation)
+{
+	gkUserDefs defs;
+	gkEngine engine(&defs);
+
+	// two logic ticks per physics step
+	defs.physicsRate = int(gkEngine::getTickRate()) / 2;
+	defs.physicsInterpolation = true;
+	gkPhysicsSubstepsTestWorld world;
+
+	const gkScalar tick = gkEngine::getStepRate();
+
+	// prime with a few steps so the sphere has some speed
+	for (int i = 0; i < 8; ++i)
+		world.step(tick);
+
+	for (int i = 0; i < 8; ++i)
+	{
+		int steps = world.step(tick);
+		ASSERT_LE(steps, 1);
+
+		const UTsize last = world.m_heights.size() - 1;
+		const gkScalar cur = world.m_heights[last], prev = world.m_heights[last - 1];
+
+		// blended between the last two steps by the time left over
+		gkScalar fraction = steps ? gkScalar(0) : gkScalar(0.5);
+		EXPECT_NEAR(world.getStateZ(), prev + (cur - prev) * fraction, 1e-4f) << "tick " << i;
+
+		// never ahead of the body
+		EXPECT_GE(world.getStateZ(), world.getBodyZ()) << "tick " << i;
+	}
+}
+
+
+TEST(TEST_CASE_NAME, testExtrapolation)
+{
+	gkUserDefs defs;
+	gkEngine engine(&defs);
+
+	defs.physicsRate = int(gkEngine::getTickRate()) / 2;
+	defs.physicsInterpolation = false;
+	gkPhysicsSubstepsTestWorld world;
+
+	const gkScalar tick = gkEngine::getStepRate();
+	for (int i = 0; i < 8; ++i)
+		world.step(tick);
+
+	// half a step left over, bullet predicts past the falling body
+	ASSERT_EQ(world.step(tick), 0);
+	EXPECT_LT(world.getStateZ(), world.getBodyZ());
+}
@@ -0,0 +1,146 @@
+#include "StdAfx.h"
+
+#define TEST_CASE_NAME testGkPhysicsThreads
+
+#ifdef OGREKIT_COMPILE_BULLET_MULTITHREADED
+
+#include "BulletMultiThreaded/SpuGatheringCollisionDispatcher.h"
+
+
+class gkPhysicsThreadsTestManager : public gkInstancedManager
+{
+public:
+	gkPhysicsThreadsTestManager() : gkInstancedManager("TestObjectManager", "TestObject") {}
+
+	gkResource* createImpl(const gkResourceName& name, const gkResourceHandle& handle)
+	{
+		return 0;
+	}
+};
+
+
+// A bare scene, a row of spheres drops onto a static box
+class gkPhysicsThreadsTestWorld
+{
+public:
+	gkPhysicsThreadsTestWorld()
+		:    m_ground(btVector3(50, 50, 1)),
+		     m_sphere(1)
+	{
+		m_scene = new gkScene(&m_mgr, gkResourceName("PhysicsThreads"), -1);
+		m_world = m_scene->getDynamicsWorld();
+
+		add(&m_ground, 0, btVector3(0, 0, -1));
+		for (int i = 0; i < 16; ++i)
+			add(&m_sphere, 1, btVector3(btScalar(i * 3 - 24), 0, btScalar(2 + i % 4)));
+	}
+
+	~gkPhysicsThreadsTestWorld()
+	{
+		for (UTsize i = 0; i < m_bodies.size(); ++i)
+		{
+			m_world->getBulletWorld()->removeRigidBody(m_bodies[i]);
+			delete m_bodies[i];
+		}
+
+		// not instanced, nothing else owns these
+		delete m_world;
+		delete m_scene->getLogicBrickManager();
+		delete m_scene;
+	}
+
+	void add(btCollisionShape* shape, btScalar mass, const btVector3& pos)
+	{
+		btVector3 inertia(0, 0, 0);
+		if (mass > 0)
+			shape->calculateLocalInertia(mass, inertia);
+
+		btRigidBody* body = new btRigidBody(mass, 0, shape, inertia);
+		btTransform trans;
+		trans.setIdentity();
+		trans.setOrigin(pos);
+		body->setWorldTransform(trans);
+		m_world->getBulletWorld()->addRigidBody(body);
+		m_bodies.push_back(body);
+	}
+
+	void run(int ticks)
+	{
+		for (int i = 0; i < ticks; ++i)
+			m_world->step(gkEngine::getStepRate());
+	}
+
+	bool isThreaded(void)
+	{
+		return dynamic_cast<SpuGatheringCollisionDispatcher*>(m_world->getBulletWorld()->getDispatcher()) != 0;
+	}
+
+	gkPhysicsThreadsTestManager m_mgr;
+	gkScene*                    m_scene;
+	gkDynamicsWorld*            m_world;
+	btBoxShape                  m_ground;
+	btSphereShape               m_sphere;
+	utArray<btRigidBody*>       m_bodies;
+};
+
+
+TEST(TEST_CASE_NAME, testBackend)
+{
+	gkUserDefs defs;
+	gkEngine engine(&defs);
+
+	defs.physicsThreads = 0;
+	{
+		gkPhysicsThreadsTestWorld world;
+		EXPECT_FALSE(world.isThreaded());
+	}
+
+	// a single thread isn't worth the threaded backend
+	defs.physicsThreads = 1;
+	{
+		gkPhysicsThreadsTestWorld world;
+		EXPECT_FALSE(world.isThreaded());
+	}
+
+	defs.physicsThreads = 2;
+	{
+		gkPhysicsThreadsTestWorld world;
+		EXPECT_TRUE(world.isThreaded());
+	}
+}
+
+
+TEST(TEST_CASE_NAME, testMatchesSerial)
+{
+	gkUserDefs defs;
+	gkEngine engine(&defs);
+
+	defs.physicsThreads = 0;
+	gkPhysicsThreadsTestWorld serial;
+
+	defs.physicsThreads = 2;
+	gkPhysicsThreadsTestWorld threaded;
+
+	// same solver settings on both backends
+	const btContactSolverInfo& a = serial.m_world->getBulletWorld()->getSolverInfo();
+	const btContactSolverInfo& b = threaded.m_world->getBulletWorld()->getSolverInfo();
+	EXPECT_EQ(a.m_numIterations, b.m_numIterations);
+	EXPECT_EQ(a.m_solverMode, b.m_solverMode);
+
+	serial.run(180);
+	threaded.run(180);
+
+	// every sphere came to rest on the box, wherever the solvers differ
+	for (UTsize i = 1; i < serial.m_bodies.size(); ++i)
+	{
+		const btVector3& p = serial.m_bodies[i]->getWorldTransform().getOrigin();
+		const btVector3& q = threaded.m_bodies[i]->getWorldTransform().getOrigin();
+
+		EXPECT_NEAR(p.z(), 1, 0.05f) << "sphere " << i;
+		EXPECT_NEAR(q.z(), p.z(), 0.05f) << "sphere " << i;
+		EXPECT_NEAR(q.x(), p.x(), 0.05f) << "sphere " << i;
+		EXPECT_NEAR(q.y(), p.y(), 0.05f) << "sphere " << i;
+	}
+}
+
+#endif
@@ -0,0 +1,121 @@
+#include "StdAfx.h"
+
+#define TEST_CASE_NAME testGkProfiler
+
+
+class gkProfilerTestCall : public gkCall
+{
+public:
+	gkProfilerTestCall() : m_zones(0) {}
+
+	void run(void)
+	{
+		{
+			GK_PROFILE("Worker");
+		}
+
+		gkProfiler::StatsArray stats;
+		gkProfiler::getSingleton().getStats(stats);
+		m_zones = stats.size();
+	}
+
+	UTsize m_zones;
+};
+
+
+static const gkProfiler::Stats* gkProfilerTestFind(const gkProfiler::StatsArray& stats, const gkString& name)
+{
+	for (UTsize i = 0; i < stats.size(); ++i)
+	{
+		if (stats[i].name == name)
+			return &stats[i];
+	}
+	return 0;
+}
+
+
+TEST(TEST_CASE_NAME, testCallPaths)
+{
+	gkProfiler profiler;
+
+	gkProfiler::ZoneId outer = gkProfiler::registerZone("Outer");
+	gkProfiler::ZoneId inner = gkProfiler::registerZone("Inner");
+	EXPECT_EQ(gkProfiler::registerZone("Outer"), outer);
+
+	for (int frame = 0; frame < 3; ++frame)
+	{
+		for (int i = 0; i < 2; ++i)
+		{
+			profiler.begin(outer);
+			profiler.begin(inner);
+			profiler.end();
+			profiler.end();
+		}
+
+		// the same zone on another path is a node of its own
+		profiler.begin(inner);
+		profiler.end();
+
+		profiler.nextFrame();
+	}
+
+	gkProfiler::StatsArray stats;
+	profiler.getStats(stats);
+
+	// repeated frames reuse the nodes
+	ASSERT_EQ(stats.size(), 3U);
+
+	EXPECT_EQ(stats[0].name, gkString("Outer"));
+	EXPECT_EQ(stats[0].depth, 0);
+	EXPECT_EQ(stats[0].calls, 2U);
+
+	EXPECT_EQ(stats[1].name, gkString("Inner"));
+	EXPECT_EQ(stats[1].depth, 1);
+	EXPECT_EQ(stats[1].calls, 2U);
+
+	EXPECT_EQ(stats[2].name, gkString("Inner"));
+	EXPECT_EQ(stats[2].depth, 0);
+	EXPECT_EQ(stats[2].calls, 1U);
+}
+
+
+TEST(TEST_CASE_NAME, testDisabledZones)
+{
+	gkProfiler profiler;
+	EXPECT_FALSE(profiler.isDetailed());
+
+	{
+		GK_PROFILE_ZONE(UT_NPOS);
+	}
+	profiler.nextFrame();
+
+	gkProfiler::StatsArray stats;
+	profiler.getStats(stats);
+	EXPECT_TRUE(stats.empty());
+}
+
+
+TEST(TEST_CASE_NAME, testReleaseThread)
+{
+	gkProfiler profiler;
+	profiler.begin("Main");
+	profiler.end();
+
+	gkProfilerTestCall* call = new gkProfilerTestCall();
+	gkThread* thread = new gkThread(call);
+	thread->join();
+	delete thread;
+
+	// seen while the worker ran
+	EXPECT_EQ(call->m_zones, 2U);
+	delete call;
+
+	// and gone with it
+	gkProfiler::StatsArray stats;
+	profiler.getStats(stats);
+	EXPECT_EQ(stats.size(), 1U);
+	EXPECT_TRUE(gkProfilerTestFind(stats, "Main") != 0);
+	EXPECT_TRUE(gkProfilerTestFind(stats, "Worker") == 0);
+
+	EXPECT_NE(profiler.getReport().find("[Main]"), gkString::npos);
+}
@@ -0,0 +1,123 @@
+#include "StdAfx.h"
+
+#define TEST_CASE_NAME testGkRayBatch
+
+// a row of unit boxes along x at 0, 4, 8, ...
+class RayBatchWorld
+{
+public:
+	btDefaultCollisionConfiguration m_config;
+	btCollisionDispatcher           m_dispatcher;
+	btDbvtBroadphase                m_broadphase;
+	btCollisionWorld                m_world;
+	btBoxShape                      m_box;
+	btCollisionObject               m_objects[8];
+
+	RayBatchWorld()
+		:	m_dispatcher(&m_config),
+		    m_world(&m_dispatcher, &m_broadphase, &m_config),
+		    m_box(btVector3(1, 1, 1))
+	{
+		for (int i = 0; i < 8; ++i)
+		{
+			btTransform trans;
+			trans.setIdentity();
+			trans.setOrigin(btVector3(btScalar(i * 4), 0, 0));
+
+			m_objects[i].setCollisionShape(&m_box);
+			m_objects[i].setWorldTransform(trans);
+			m_world.addCollisionObject(&m_objects[i]);
+		}
+		m_world.updateAabbs();
+	}
+
+	~RayBatchWorld()
+	{
+		for (int i = 0; i < 8; ++i)
+			m_world.removeCollisionObject(&m_objects[i]);
+	}
+};
+
+TEST(TEST_CASE_NAME, testClosestHit)
+{
+	RayBatchWorld w;
+	gkRayBatch batch;
+
+	// along the row from the left, down onto box 2, above everything
+	UTsize along = batch.queue(gkVector3(-10, 0, 0), gkVector3(40, 0, 0), 0, 0);
+	UTsize down  = batch.queue(gkVector3(8, 0, 10), gkVector3(8, 0, -10), 0, 0);
+	UTsize miss  = batch.queue(gkVector3(-10, 0, 5), gkVector3(40, 0, 5), 0, 0);
+	UTsize skip  = batch.queue(gkVector3(-10, 0, 0), gkVector3(40, 0, 0), 0, &w.m_objects[0]);
+	UTsize sweep = batch.queue(gkVector3(-10, 0, 1.5f), gkVector3(40, 0, 1.5f), 1, 0);
+
+	EXPECT_EQ(batch.getQueuedCount(), 5u);
+	batch.run(&w.m_broadphase, 0);
+	EXPECT_EQ(batch.getQueuedCount(), 0u);
+
+	const gkRayBatch::Hits& hits = batch.getHits();
+	ASSERT_EQ(hits.size(), 5u);
+
+	EXPECT_TRUE(hits[along].collisionObject == &w.m_objects[0]);
+	EXPECT_NEAR(hits[along].point.x, -1, 1e-4);
+	EXPECT_NEAR(hits[along].normal.x, -1, 1e-4);
+
+	EXPECT_TRUE(hits[down].collisionObject == &w.m_objects[2]);
+	EXPECT_NEAR(hits[down].point.z, 1, 1e-4);
+
+	EXPECT_TRUE(hits[miss].collisionObject == 0);
+	EXPECT_FLOAT_EQ(hits[miss].fraction, 1);
+
+	EXPECT_TRUE(hits[skip].collisionObject == &w.m_objects[1]);
+
+	// the sphere grazes the tops the ray passes over
+	EXPECT_TRUE(hits[sweep].collisionObject == &w.m_objects[0]);
+}
+
+TEST(TEST_CASE_NAME, testInvalidate)
+{
+	RayBatchWorld w;
+	gkRayBatch batch;
+
+	UTsize a = batch.queue(gkVector3(-10, 0, 0), gkVector3(40, 0, 0), 0, 0);
+	UTsize b = batch.queue(gkVector3(12, 0, 10), gkVector3(12, 0, -10), 0, 0);
+	batch.run(&w.m_broadphase, 0);
+
+	// object 0 goes away before the hits are read
+	batch.invalidate(&w.m_objects[0]);
+
+	EXPECT_TRUE(batch.getHits()[a].collisionObject == 0);
+	EXPECT_TRUE(batch.getHits()[a].object == 0);
+	EXPECT_TRUE(batch.getHits()[b].collisionObject == &w.m_objects[3]);
+
+	// a queued query stops ignoring it
+	UTsize c = batch.queue(gkVector3(-10, 0, 0), gkVector3(40, 0, 0), 0, &w.m_objects[5]);
+	batch.invalidate(&w.m_objects[5]);
+	batch.run(&w.m_broadphase, 0);
+	EXPECT_TRUE(batch.getHits()[c].collisionObject == &w.m_objects[0]);
+}
+
+TEST(TEST_CASE_NAME, testThreaded)
+{
+	RayBatchWorld w;
+	gkRayBatch serial, threaded;
+	gkThreadPool pool("RayBatchTest", 4);
+
+	const int count = 10 * gkRayBatch::CHUNK + 7;
+	for (int i = 0; i < count; ++i)
+	{
+		const gkScalar x = gkScalar(i % 40) - 5;
+		const gkScalar r = (i % 3) == 0 ? 0.5f : 0.f;
+		serial.queue(gkVector3(x, 0, 10), gkVector3(x, 0, -10), r, 0);
+		threaded.queue(gkVector3(x, 0, 10), gkVector3(x, 0, -10), r, 0);
+	}
+
+	serial.run(&w.m_broadphase, 0);
+	threaded.run(&w.m_broadphase, &pool);
+
+	ASSERT_EQ(threaded.getHits().size(), (UTsize)count);
+	for (int i = 0; i < count; ++i)
+	{
+		EXPECT_TRUE(serial.getHits()[i].collisionObject == threaded.getHits()[i].collisionObject);
+		EXPECT_FLOAT_EQ(serial.getHits()[i].fraction, threaded.getHits()[i].fraction);
+	}
+}
@@ -0,0 +1,117 @@
+#include "StdAfx.h"
+
+#define TEST_CASE_NAME testGkRecast
+
+#ifdef OGREKIT_COMPILE_RECAST
+
+// 30 x 30 floor in navigation space (y up), 3 x 3 tiles of 64 cells
+static PMESHDATA gkRecastTestFloor(void)
+{
+	gkMeshData* floor = new gkMeshData;
+	floor->verts.push_back(gkVector3(0, 0, 0));
+	floor->verts.push_back(gkVector3(0, 0, 30));
+	floor->verts.push_back(gkVector3(30, 0, 30));
+	floor->verts.push_back(gkVector3(30, 0, 0));
+
+	const int tris[] = {0, 1, 2, 0, 2, 3};
+	floor->tris.assign(tris, tris + 6);
+	return PMESHDATA(floor);
+}
+
+static gkRecast::Config gkRecastTestConfig(void)
+{
+	gkRecast::Config config;
+	config.TILED = true;
+	return config;
+}
+
+static bool gkRecastTestPath(PDT_NAV_MESH navMesh, const gkVector3& from, const gkVector3& to)
+{
+	// findPath takes blender space, z up
+	PATH_POINTS path;
+	return gkRecast::findPath(navMesh, from, to, gkVector3(2, 2, 4), 256, path);
+}
+
+TEST(TEST_CASE_NAME, testTileLayout)
+{
+	gkRecast::Config config = gkRecastTestConfig();
+	PDT_NAV_MESH navMesh = gkRecast::createTiledNavMesh(gkRecastTestFloor(), config);
+	ASSERT_TRUE(navMesh.get() && navMesh->m_p);
+
+	EXPECT_TRUE(gkRecast::hasTileLayout(navMesh, config));
+
+	gkRecast::Config other = config;
+	other.TILE_SIZE = 32;
+	EXPECT_FALSE(gkRecast::hasTileLayout(navMesh, other));
+	EXPECT_FALSE(gkRecast::hasTileLayout(PDT_NAV_MESH(), config));
+
+	// a change inside the middle tile, away from its borders
+	const gkScalar width = config.TILE_SIZE * config.CELL_SIZE;
+	gkVector3 mid(width * 1.5f, 0, width * 1.5f);
+
+	gkRecast::TILE_SET tiles;
+	gkRecast::getTiles(navMesh, config, mid - gkVector3(1, 0, 1), mid + gkVector3(1, 0, 1), tiles);
+	ASSERT_EQ(tiles.size(), 1U);
+	EXPECT_TRUE(*tiles.begin() == gkRecast::TileCoord(1, 1));
+
+	// one straddling the line between two tiles, listed once each
+	gkVector3 edge(width, 0, width * 1.5f);
+	gkRecast::getTiles(navMesh, config, edge, edge, tiles);
+	gkRecast::getTiles(navMesh, config, edge, edge, tiles);
+	EXPECT_EQ(tiles.size(), 2U);
+	EXPECT_EQ(tiles.count(gkRecast::TileCoord(0, 1)), 1U);
+
+	// clamped to the grid
+	EXPECT_EQ(navMesh->m_tilesX, 3);
+	EXPECT_EQ(navMesh->m_tilesY, 3);
+
+	tiles.clear();
+	gkRecast::getTiles(navMesh, config, gkVector3(-1000, 0, -1000), gkVector3(1000, 0, 1000), tiles);
+	EXPECT_EQ(tiles.size(), 9U);
+	EXPECT_EQ(tiles.begin()->x, 0);
+	EXPECT_EQ(tiles.rbegin()->y, 2);
+
+	tiles.clear();
+	gkRecast::getTiles(navMesh, config, gkVector3(500, 0, 500), gkVector3(600, 0, 600), tiles);
+	EXPECT_TRUE(tiles.empty());
+
+	// tile bounds include the border the tile is rasterized with
+	gkVector3 bmin, bmax;
+	gkRecast::getTileBounds(navMesh, config, gkRecast::TileCoord(1, 1), bmin, bmax);
+	EXPECT_LT(bmin.x, width);
+	EXPECT_GT(bmax.x, width * 2);
+	EXPECT_LT(bmin.z, width);
+	EXPECT_GT(bmax.z, width * 2);
+}
+
+TEST(TEST_CASE_NAME, testReplaceTiles)
+{
+	gkRecast::Config config = gkRecastTestConfig();
+	PMESHDATA floor = gkRecastTestFloor();
+	PDT_NAV_MESH navMesh = gkRecast::createTiledNavMesh(floor, config);
+	ASSERT_TRUE(navMesh.get() && navMesh->m_p);
+
+	const gkScalar width = config.TILE_SIZE * config.CELL_SIZE;
+	gkVector3 corner(2, 2, 0), mid(width * 1.5f, width * 1.5f, 0);
+	EXPECT_TRUE(gkRecastTestPath(navMesh, corner, mid));
+
+	gkRecast::TILE_COORDS tiles;
+	tiles.push_back(gkRecast::TileCoord(1, 1));
+
+	// without geometry the tile is dropped
+	PMESHDATA empty(new gkMeshData);
+	PDT_TILES built = gkRecast::buildTiles(empty, config, navMesh, tiles);
+	ASSERT_TRUE(built.get());
+	ASSERT_EQ(built->m_tiles.size(), 1U);
+	EXPECT_TRUE(built->m_tiles[0].data == 0);
+
+	EXPECT_EQ(gkRecast::replaceTiles(navMesh, built), 0);
+	EXPECT_FALSE(gkRecastTestPath(navMesh, corner, mid));
+
+	// and comes back connected to its neighbours
+	built = gkRecast::buildTiles(floor, config, navMesh, tiles);
+	EXPECT_EQ(gkRecast::replaceTiles(navMesh, built), 1);
+	EXPECT_TRUE(gkRecastTestPath(navMesh, corner, mid));
+}
+
+#endif
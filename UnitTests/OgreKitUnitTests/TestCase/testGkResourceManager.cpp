@@ -0,0 +1,82 @@
+#include "StdAfx.h"
+
+#define TEST_CASE_NAME testGkResourceManager
+
+class gkTestResourceManager : public gkResourceManager
+{
+public:
+	gkTestResourceManager() : gkResourceManager("TestManager", "TestResource") {}
+	virtual ~gkTestResourceManager() { destroyAll(); }
+
+	gkResource* createImpl(const gkResourceName& name, const gkResourceHandle& handle)
+	{
+		return new gkResource(this, name, handle);
+	}
+};
+
+TEST(TEST_CASE_NAME, testGetByName)
+{
+	gkTestResourceManager mgr;
+
+	gkResource* a = mgr.create(gkResourceName("Mesh", "LevelA"));
+	gkResource* b = mgr.create(gkResourceName("Mesh", "LevelB"));
+	gkResource* c = mgr.create(gkResourceName("Other"));
+
+	EXPECT_TRUE(a && b && c);
+	EXPECT_EQ(mgr.getByName(gkResourceName("Mesh", "LevelA")), a);
+	EXPECT_EQ(mgr.getByName(gkResourceName("Mesh", "LevelB")), b);
+	EXPECT_EQ(mgr.getByName(gkResourceName("Other")), c);
+	EXPECT_TRUE(mgr.getByName(gkResourceName("Other", "LevelA")) == 0);
+	EXPECT_TRUE(mgr.getByName(gkResourceName("Missing")) == 0);
+
+	// a name without group matches any group
+	gkResource* any = mgr.getByName(gkResourceName("Mesh"));
+	EXPECT_TRUE(any == a || any == b);
+
+	EXPECT_TRUE(mgr.create(gkResourceName("Mesh", "LevelA")) == 0);
+}
+
+TEST(TEST_CASE_NAME, testDestroy)
+{
+	gkTestResourceManager mgr;
+
+	gkResource* a = mgr.create(gkResourceName("Mesh", "LevelA"));
+	gkResource* b = mgr.create(gkResourceName("Mesh", "LevelB"));
+	mgr.create(gkResourceName("Text", "LevelB"));
+
+	mgr.destroy(a);
+	EXPECT_TRUE(mgr.getByName(gkResourceName("Mesh", "LevelA")) == 0);
+	EXPECT_EQ(mgr.getByName(gkResourceName("Mesh")), b);
+
+	mgr.destroyGroup("LevelB");
+	EXPECT_EQ(mgr.getResourceCount(), 0);
+	EXPECT_TRUE(mgr.getByName(gkResourceName("Mesh")) == 0);
+	EXPECT_TRUE(mgr.getByName(gkResourceName("Text", "LevelB")) == 0);
+
+	gkResource* c = mgr.create(gkResourceName("Mesh", "LevelA"));
+	EXPECT_EQ(mgr.getByName(gkResourceName("Mesh")), c);
+
+	mgr.destroy(gkResourceName("Mesh", "LevelA"));
+	EXPECT_FALSE(mgr.exists(gkResourceName("Mesh")));
+}
+
+TEST(TEST_CASE_NAME, testMany)
+{
+	gkTestResourceManager mgr;
+
+	const int count = 10000;
+	for (int i = 0; i < count; ++i)
+		mgr.create(gkResourceName(utStringFormat("Res%i", i), utStringFormat("Group%i", i % 7)));
+
+	EXPECT_EQ(mgr.getResourceCount(), count);
+
+	for (int i = 0; i < count; i += 97)
+	{
+		gkResource* res = mgr.getByName(gkResourceName(utStringFormat("Res%i", i), utStringFormat("Group%i", i % 7)));
+		EXPECT_TRUE(res != 0);
+		EXPECT_EQ(mgr.getByName(gkResourceName(utStringFormat("Res%i", i))), res);
+	}
+
+	mgr.destroyAll();
+	EXPECT_EQ(mgr.getResourceCount(), 0);
+}
@@ -0,0 +1,258 @@
+#include "StdAfx.h"
+#include "BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h"
+
+#define TEST_CASE_NAME testGkShapeCache
+
+#define SHAPE_CACHE_DIR "."
+
+
+// a flat 8 x 8 grid of collision faces
+class gkShapeCacheTestMesh : public gkMesh
+{
+public:
+	gkShapeCacheTestMesh(const gkString& name)
+		:    gkMesh(0, gkResourceName(name), -1)
+	{
+		gkSubMesh* sub = new gkSubMesh();
+
+		for (int y = 0; y < 8; ++y)
+		{
+			for (int x = 0; x < 8; ++x)
+			{
+				gkVertex v[4];
+				v[0].co = gkVector3(gkScalar(x),     gkScalar(y),     0);
+				v[1].co = gkVector3(gkScalar(x + 1), gkScalar(y),     0);
+				v[2].co = gkVector3(gkScalar(x + 1), gkScalar(y + 1), 0);
+				v[3].co = gkVector3(gkScalar(x),     gkScalar(y + 1), 0);
+
+				const unsigned int i = (y * 9 + x);
+				sub->addTriangle(v[0], i, v[1], i + 1, v[2], i + 10, gkTriangle::TRI_COLLIDER);
+				sub->addTriangle(v[0], i, v[2], i + 10, v[3], i + 9, gkTriangle::TRI_COLLIDER);
+			}
+		}
+
+		addSubMesh(sub);
+	}
+};
+
+
+// same naming as the cache, the mesh name and an FNV-1a hash of the faces
+class gkShapeCacheTestFileName : public btInternalTriangleIndexCallback
+{
+public:
+	gkShapeCacheTestFileName(gkMesh* mesh) : m_hash(2166136261u)
+	{
+		btVector3 aabbMin(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT), aabbMax(-aabbMin);
+		mesh->getTriMesh()->InternalProcessAllTriangles(this, aabbMin, aabbMax);
+
+		gkPath path(SHAPE_CACHE_DIR);
+		path.append(utStringFormat("%s_%08x.bvh", mesh->getName().c_str(), (unsigned int)m_hash));
+		m_name = path.getPath();
+	}
+
+	void internalProcessTriangleIndex(btVector3* triangle, int partId, int triangleIndex)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			btScalar co[3] = {triangle[i].x(), triangle[i].y(), triangle[i].z()};
+
+			const unsigned char* p = reinterpret_cast<const unsigned char*>(co);
+			for (size_t b = 0; b < sizeof(co); ++b)
+				m_hash = (m_hash ^ p[b]) * 16777619u;
+		}
+	}
+
+	UThash   m_hash;
+	gkString m_name;
+};
+
+
+// faces whose bounds a ray straight down through the grid crosses, both
+// halves of the quad below it. Goes through the BVH nodes.
+class gkShapeCacheTestRay : public btTriangleCallback
+{
+public:
+	gkShapeCacheTestRay(btBvhTriangleMeshShape* shape, gkScalar x, gkScalar y) : m_hits(0)
+	{
+		shape->performRaycast(this, btVector3(x, y, 5), btVector3(x, y, -5));
+	}
+
+	void processTriangle(btVector3* triangle, int partId, int triangleIndex) { ++m_hits; }
+
+	int m_hits;
+};
+
+
+static long gkShapeCacheTestFileSize(const gkString& name)
+{
+	FILE* fp = fopen(name.c_str(), "rb");
+	if (!fp)
+		return -1;
+
+	fseek(fp, 0, SEEK_END);
+	long size = ftell(fp);
+	fclose(fp);
+	return size;
+}
+
+
+TEST(TEST_CASE_NAME, testSharedShapes)
+{
+	gkUserDefs defs;
+	gkEngine engine(&defs);
+	gkShapeCache cache;
+
+	btCollisionShape* a = cache.acquire(0, SH_BOX, gkVector3(1, 2, 3), gkVector3::UNIT_SCALE, 0.04f);
+	btCollisionShape* b = cache.acquire(0, SH_BOX, gkVector3(1, 2, 3), gkVector3::UNIT_SCALE, 0.04f);
+	btCollisionShape* c = cache.acquire(0, SH_BOX, gkVector3(1, 2, 3), gkVector3(2, 2, 2), 0.04f);
+	ASSERT_TRUE(a != 0 && c != 0);
+
+	// one shape per distinct size, scale and margin
+	EXPECT_EQ(a, b);
+	EXPECT_NE(a, c);
+	EXPECT_EQ(cache.getShapeCount(), 2U);
+
+	// only the cache's own shapes
+	btSphereShape other(1);
+	EXPECT_FALSE(cache.release(&other));
+
+	// gone with the last reference
+	EXPECT_TRUE(cache.release(a));
+	EXPECT_EQ(cache.getShapeCount(), 2U);
+	EXPECT_TRUE(cache.release(b));
+	EXPECT_TRUE(cache.release(c));
+	EXPECT_EQ(cache.getShapeCount(), 0U);
+}
+
+
+TEST(TEST_CASE_NAME, testScaledShareBase)
+{
+	gkUserDefs defs;
+	gkEngine engine(&defs);
+	gkShapeCacheTestMesh mesh("ShapeCacheScaled");
+	gkShapeCache cache;
+
+	btCollisionShape* unit = cache.acquire(&mesh, SH_BVH_MESH, gkVector3::ZERO, gkVector3::UNIT_SCALE, 0.04f);
+	btCollisionShape* big = cache.acquire(&mesh, SH_BVH_MESH, gkVector3::ZERO, gkVector3(2, 2, 2), 0.04f);
+	ASSERT_TRUE(unit != 0 && big != 0);
+
+	// scaled copies wrap the unit scale tree
+	btScaledBvhTriangleMeshShape* scaled = dynamic_cast<btScaledBvhTriangleMeshShape*>(big);
+	ASSERT_TRUE(scaled != 0);
+	EXPECT_EQ(scaled->getChildShape(), unit);
+	EXPECT_EQ(cache.getShapeCount(), 2U);
+
+	// the wrapper keeps the base alive
+	EXPECT_TRUE(cache.release(unit));
+	EXPECT_EQ(cache.getShapeCount(), 2U);
+	EXPECT_EQ(cache.acquire(&mesh, SH_BVH_MESH, gkVector3::ZERO, gkVector3::UNIT_SCALE, 0.04f), unit);
+	EXPECT_TRUE(cache.release(unit));
+
+	EXPECT_TRUE(cache.release(big));
+	EXPECT_EQ(cache.getShapeCount(), 0U);
+
+	// a scaled hull alone brings its unit scale base along
+	btCollisionShape* hull = cache.acquire(&mesh, SH_CONVEX_TRIMESH, gkVector3::ZERO, gkVector3(1, 1, 3), 0.04f);
+	ASSERT_TRUE(hull != 0);
+	EXPECT_EQ(cache.getShapeCount(), 2U);
+	EXPECT_TRUE(gkMathUtils::get(hull->getLocalScaling()) == gkVector3(1, 1, 3));
+
+	EXPECT_TRUE(cache.release(hull));
+	EXPECT_EQ(cache.getShapeCount(), 0U);
+}
+
+
+TEST(TEST_CASE_NAME, testBvhFile)
+{
+	gkUserDefs defs;
+	defs.bvhCachePath = SHAPE_CACHE_DIR;
+	gkEngine engine(&defs);
+
+	gkShapeCacheTestMesh mesh("ShapeCacheFile");
+	gkShapeCacheTestFileName file(&mesh);
+	remove(file.m_name.c_str());
+
+	// built and written on the first use
+	{
+		gkShapeCache cache;
+		btBvhTriangleMeshShape* shape = static_cast<btBvhTriangleMeshShape*>(cache.acquire(&mesh, SH_BVH_MESH, gkVector3::ZERO, gkVector3::UNIT_SCALE, 0.04f));
+		ASSERT_TRUE(shape != 0);
+		EXPECT_TRUE(shape->getOwnsBvh());
+		EXPECT_EQ(gkShapeCacheTestRay(shape, 2.3f, 5.6f).m_hits, 2);
+		cache.release(shape);
+	}
+
+	const long size = gkShapeCacheTestFileSize(file.m_name);
+	ASSERT_GT(size, 0);
+
+	// loaded in place the next time, and just as usable
+	{
+		gkShapeCache cache;
+		btBvhTriangleMeshShape* shape = static_cast<btBvhTriangleMeshShape*>(cache.acquire(&mesh, SH_BVH_MESH, gkVector3::ZERO, gkVector3::UNIT_SCALE, 0.04f));
+		ASSERT_TRUE(shape != 0);
+		EXPECT_FALSE(shape->getOwnsBvh());
+		EXPECT_EQ(gkShapeCacheTestRay(shape, 2.3f, 5.6f).m_hits, 2);
+		EXPECT_EQ(gkShapeCacheTestRay(shape, 7.9f, 0.1f).m_hits, 2);
+		EXPECT_EQ(gkShapeCacheTestRay(shape, 9.5f, 0.5f).m_hits, 0);
+		cache.release(shape);
+	}
+
+	// a header from another build, bump the version
+	{
+		FILE* fp = fopen(file.m_name.c_str(), "r+b");
+		ASSERT_TRUE(fp != 0);
+		UTuint32 version = 0;
+		fseek(fp, sizeof(UTuint32), SEEK_SET);
+		ASSERT_EQ(fread(&version, sizeof(version), 1, fp), 1U);
+		++version;
+		fseek(fp, sizeof(UTuint32), SEEK_SET);
+		fwrite(&version, sizeof(version), 1, fp);
+		fclose(fp);
+	}
+
+	// rejected, rebuilt and written again
+	{
+		gkShapeCache cache;
+		btBvhTriangleMeshShape* shape = static_cast<btBvhTriangleMeshShape*>(cache.acquire(&mesh, SH_BVH_MESH, gkVector3::ZERO, gkVector3::UNIT_SCALE, 0.04f));
+		ASSERT_TRUE(shape != 0);
+		EXPECT_TRUE(shape->getOwnsBvh());
+		EXPECT_EQ(gkShapeCacheTestRay(shape, 2.3f, 5.6f).m_hits, 2);
+		cache.release(shape);
+	}
+
+	// an interrupted write, the header is fine but the nodes are cut short
+	{
+		utArray<char> data;
+		data.resize(size / 2);
+
+		FILE* fp = fopen(file.m_name.c_str(), "rb");
+		ASSERT_TRUE(fp != 0);
+		ASSERT_EQ(fread(data.ptr(), data.size(), 1, fp), 1U);
+		fclose(fp);
+
+		fp = fopen(file.m_name.c_str(), "wb");
+		ASSERT_TRUE(fp != 0);
+		fwrite(data.ptr(), data.size(), 1, fp);
+		fclose(fp);
+	}
+
+	{
+		gkShapeCache cache;
+		btBvhTriangleMeshShape* shape = static_cast<btBvhTriangleMeshShape*>(cache.acquire(&mesh, SH_BVH_MESH, gkVector3::ZERO, gkVector3::UNIT_SCALE, 0.04f));
+		ASSERT_TRUE(shape != 0);
+		EXPECT_TRUE(shape->getOwnsBvh());
+		cache.release(shape);
+	}
+
+	// the rewritten file loads again
+	{
+		gkShapeCache cache;
+		btBvhTriangleMeshShape* shape = static_cast<btBvhTriangleMeshShape*>(cache.acquire(&mesh, SH_BVH_MESH, gkVector3::ZERO, gkVector3::UNIT_SCALE, 0.04f));
+		ASSERT_TRUE(shape != 0);
+		EXPECT_FALSE(shape->getOwnsBvh());
+		cache.release(shape);
+	}
+
+	EXPECT_EQ(gkShapeCacheTestFileSize(file.m_name), size);
+	remove(file.m_name.c_str());
+}
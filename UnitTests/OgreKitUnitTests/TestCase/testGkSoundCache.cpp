@@ -0,0 +1,185 @@
+#include "StdAfx.h"
+
+#define TEST_CASE_NAME testGkSoundCache
+
+#ifdef OGREKIT_OPENAL_SOUND
+
+#define SND_LEN     4096
+#define SND_BUDGET  (SND_LEN * 4)
+
+
+// mono 16 bit silence in a wave file held in memory
+class gkSoundCacheTestWave
+{
+public:
+	gkSoundCacheTestWave(const gkString& name, int len)
+		:    m_sound(0, gkResourceName(name), 0)
+	{
+		const int rate = 8000;
+		const int fmt[4] = {16, (1 << 16) | 1, rate, rate * 2};
+		const short align[2] = {2, 16};
+
+		m_file.resize(44 + len);
+		char* p = m_file.ptr();
+		memset(p, 0, m_file.size());
+
+		int riff = 36 + len;
+		memcpy(p, "RIFF", 4);       memcpy(p + 4, &riff, 4);
+		memcpy(p + 8, "WAVEfmt ", 8);
+		memcpy(p + 16, fmt, 16);    memcpy(p + 32, align, 4);
+		memcpy(p + 36, "data", 4);  memcpy(p + 40, &len, 4);
+
+		m_sound.load(m_file.ptr(), m_file.size());
+	}
+
+	utArray<char> m_file;
+	gkSound       m_sound;
+};
+
+
+class gkSoundCacheTestContext
+{
+public:
+	gkSoundCacheTestContext()
+		:    m_device(alcOpenDevice(NULL)), m_context(0)
+	{
+		if (m_device)
+			m_context = alcCreateContext(m_device, 0);
+		if (m_context)
+			alcMakeContextCurrent(m_context);
+	}
+
+	~gkSoundCacheTestContext()
+	{
+		if (m_context)
+		{
+			alcMakeContextCurrent(0);
+			alcDestroyContext(m_context);
+		}
+		if (m_device)
+			alcCloseDevice(m_device);
+	}
+
+	// machines without an audio device skip these tests
+	bool isValid(void) const {return m_context != 0;}
+
+private:
+	ALCdevice*  m_device;
+	ALCcontext* m_context;
+};
+
+
+TEST(TEST_CASE_NAME, testHit)
+{
+	gkSoundCacheTestContext ctx;
+	if (!ctx.isValid())
+		return;
+
+	gkSoundCache cache(SND_BUDGET);
+	gkSoundCacheTestWave wave("Hit", SND_LEN);
+	ASSERT_TRUE(wave.m_sound.getStream() != 0);
+
+	// first playback streams
+	UTsize len = 0;
+	EXPECT_EQ(cache.acquire(&wave.m_sound, len), 0U);
+	EXPECT_EQ(cache.getSize(), 0U);
+
+	// the second decodes, later ones share the buffer
+	ALuint first = cache.acquire(&wave.m_sound, len);
+	EXPECT_NE(first, 0U);
+	EXPECT_EQ(len, (UTsize)SND_LEN);
+	EXPECT_EQ(cache.getSize(), (UTsize)SND_LEN);
+
+	EXPECT_EQ(cache.acquire(&wave.m_sound, len), first);
+	EXPECT_EQ(cache.getSize(), (UTsize)SND_LEN);
+
+	cache.release(first);
+	cache.release(first);
+
+	// forgotten with the sound
+	cache.releaseSound(&wave.m_sound);
+	EXPECT_EQ(cache.getSize(), 0U);
+}
+
+
+TEST(TEST_CASE_NAME, testEviction)
+{
+	gkSoundCacheTestContext ctx;
+	if (!ctx.isValid())
+		return;
+
+	gkSoundCache cache(SND_BUDGET);
+
+	const int count = 5;
+	gkSoundCacheTestWave* waves[count];
+	ALuint buffers[count];
+	UTsize len;
+
+	for (int i = 0; i < count; ++i)
+		waves[i] = new gkSoundCacheTestWave("Evict" + Ogre::StringConverter::toString(i), SND_LEN);
+
+	// fill the budget, every entry still playing
+	for (int i = 0; i < count - 1; ++i)
+	{
+		cache.acquire(&waves[i]->m_sound, len);
+		buffers[i] = cache.acquire(&waves[i]->m_sound, len);
+		EXPECT_NE(buffers[i], 0U);
+	}
+	EXPECT_EQ(cache.getSize(), (UTsize)SND_BUDGET);
+
+	// nothing can go, the last one streams
+	gkSound* last = &waves[count - 1]->m_sound;
+	cache.acquire(last, len);
+	EXPECT_EQ(cache.acquire(last, len), 0U);
+	EXPECT_EQ(cache.getSize(), (UTsize)SND_BUDGET);
+
+	// stopped entries go least recently used first
+	cache.release(buffers[2]);
+	cache.release(buffers[1]);
+
+	buffers[count - 1] = cache.acquire(last, len);
+	EXPECT_NE(buffers[count - 1], 0U);
+	EXPECT_EQ(cache.getSize(), (UTsize)SND_BUDGET);
+
+	// 2 is still cached, 1 went
+	EXPECT_EQ(cache.acquire(&waves[2]->m_sound, len), buffers[2]);
+	EXPECT_EQ(cache.getSize(), (UTsize)SND_BUDGET);
+
+	cache.clear();
+	EXPECT_EQ(cache.getSize(), 0U);
+
+	for (int i = 0; i < count; ++i)
+		delete waves[i];
+}
+
+
+TEST(TEST_CASE_NAME, testStreamedFallback)
+{
+	gkSoundCacheTestContext ctx;
+	if (!ctx.isValid())
+		return;
+
+	UTsize len;
+
+	// longer than a quarter of the budget
+	{
+		gkSoundCache cache(SND_BUDGET);
+		gkSoundCacheTestWave wave("Long", SND_LEN + 2);
+
+		for (int i = 0; i < 3; ++i)
+			EXPECT_EQ(cache.acquire(&wave.m_sound, len), 0U);
+		EXPECT_EQ(cache.getSize(), 0U);
+	}
+
+	// a budget of 0 turns the cache off
+	{
+		gkSoundCache cache(0);
+		gkSoundCacheTestWave wave("Off", SND_LEN);
+
+		for (int i = 0; i < 3; ++i)
+			EXPECT_EQ(cache.acquire(&wave.m_sound, len), 0U);
+		EXPECT_EQ(cache.getSize(), 0U);
+	}
+}
+
+#endif
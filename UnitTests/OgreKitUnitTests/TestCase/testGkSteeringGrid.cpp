@@ -0,0 +1,162 @@
+#include "StdAfx.h"
+
+#define TEST_CASE_NAME testGkSteeringGrid
+
+#ifdef OGREKIT_COMPILE_OPENSTEER
+
+class gkSteeringTestObjectManager : public gkInstancedManager
+{
+public:
+	gkSteeringTestObjectManager() : gkInstancedManager("TestObjectManager", "TestObject") {}
+
+	gkResource* createImpl(const gkResourceName& name, const gkResourceHandle& handle)
+	{
+		return new gkGameObject(this, name, handle);
+	}
+};
+
+// agent of radius 1 that never steers, only keeps its grid cell current
+class gkTestSteeringObject : public gkSteeringObject
+{
+public:
+	gkTestSteeringObject(gkGameObject* obj)
+		:    gkSteeringObject(obj, 1, gkVector3::UNIT_Y, gkVector3::UNIT_Z, gkVector3::UNIT_X)
+	{
+	}
+
+	bool steering(STATE& newState, const float elapsedTime) { return false; }
+};
+
+class gkTestSteeringAgents
+{
+public:
+	gkTestSteeringAgents() { gkSteeringObject::getGrid().setCellSize(4); }
+
+	~gkTestSteeringAgents()
+	{
+		for (UTsize i = 0; i < m_agents.size(); ++i)
+		{
+			gkGameObject* obj = m_agents[i]->getObject();
+			delete m_agents[i];
+			delete obj;
+		}
+	}
+
+	gkSteeringObject* add(const gkVector3& pos)
+	{
+		gkString name = "Agent" + Ogre::StringConverter::toString(m_agents.size());
+
+		gkGameObject* obj = new gkGameObject(&m_mgr, gkResourceName(name), -1);
+		obj->getProperties().m_physics.m_mass = 1;
+		obj->getProperties().m_physics.m_radius = 1;
+		obj->getProperties().m_transform.loc = pos;
+
+		m_agents.push_back(new gkTestSteeringObject(obj));
+		return m_agents.back();
+	}
+
+	void move(gkSteeringObject* agent, const gkVector3& pos)
+	{
+		agent->getObject()->getProperties().m_transform.loc = pos;
+		agent->update(0);
+	}
+
+private:
+	gkSteeringTestObjectManager m_mgr;
+	utArray<gkSteeringObject*> m_agents;
+};
+
+static bool gkSteeringTestHas(const gkSteeringObject::NEIGHBORS& agents, gkSteeringObject* agent)
+{
+	return agents.find(agent) != UT_NPOS;
+}
+
+TEST(TEST_CASE_NAME, testNeighbors)
+{
+	gkTestSteeringAgents agents;
+	gkSteeringObject* a = agents.add(gkVector3(0, 0, 0));
+	gkSteeringObject* b = agents.add(gkVector3(3, 0, 0));
+	gkSteeringObject* c = agents.add(gkVector3(-9, 1, 0));
+	agents.add(gkVector3(40, 40, 0));
+
+	EXPECT_EQ(gkSteeringObject::getGrid().getAgentCount(), 4U);
+
+	// touching spheres count, the agent's radius included
+	gkSteeringObject::NEIGHBORS out;
+	gkSteeringObject::getNeighbors(gkVector3(0, 0, 0), 2.5f, out);
+	EXPECT_EQ(out.size(), 2U);
+	EXPECT_TRUE(gkSteeringTestHas(out, a));
+	EXPECT_TRUE(gkSteeringTestHas(out, b));
+
+	out.clear();
+	gkSteeringObject::getNeighbors(gkVector3(0, 0, 0), 2.5f, out, a);
+	EXPECT_EQ(out.size(), 1U);
+	EXPECT_TRUE(gkSteeringTestHas(out, b));
+
+	// a few cells away
+	out.clear();
+	gkSteeringObject::getNeighbors(gkVector3(0, 0, 0), 9, out);
+	EXPECT_EQ(out.size(), 3U);
+	EXPECT_TRUE(gkSteeringTestHas(out, c));
+
+	// an area larger than the populated cells gives the same answer
+	out.clear();
+	gkSteeringObject::getNeighbors(gkVector3(0, 0, 0), 1000, out);
+	EXPECT_EQ(out.size(), 4U);
+}
+
+TEST(TEST_CASE_NAME, testCorridor)
+{
+	gkTestSteeringAgents agents;
+	gkSteeringObject* near = agents.add(gkVector3(10, 2, 0));
+	gkSteeringObject* behind = agents.add(gkVector3(-3, 0, 0));
+	agents.add(gkVector3(10, 6, 0));
+
+	gkSteeringObject::NEIGHBORS out;
+	gkSteeringObject::getNeighborsInCorridor(gkVector3(0, 0, 0), gkVector3(20, 0, 0), 1.5f, out);
+	EXPECT_EQ(out.size(), 1U);
+	EXPECT_TRUE(gkSteeringTestHas(out, near));
+
+	// the ends are rounded
+	out.clear();
+	gkSteeringObject::getNeighborsInCorridor(gkVector3(0, 0, 0), gkVector3(20, 0, 0), 2.5f, out);
+	EXPECT_EQ(out.size(), 2U);
+	EXPECT_TRUE(gkSteeringTestHas(out, behind));
+}
+
+TEST(TEST_CASE_NAME, testMoveAndRemove)
+{
+	gkSteeringObject::NEIGHBORS out;
+
+	{
+		gkTestSteeringAgents agents;
+		gkSteeringObject* a = agents.add(gkVector3(0, 0, 0));
+
+		// moved across several cells, found at the new place only
+		agents.move(a, gkVector3(50, -30, 0));
+
+		gkSteeringObject::getNeighbors(gkVector3(0, 0, 0), 2, out);
+		EXPECT_TRUE(out.empty());
+
+		gkSteeringObject::getNeighbors(gkVector3(50, -30, 0), 2, out);
+		EXPECT_EQ(out.size(), 1U);
+		EXPECT_TRUE(gkSteeringTestHas(out, a));
+
+		// rebinned to the new cell size
+		gkSteeringObject::getGrid().setCellSize(16);
+		EXPECT_EQ(gkSteeringObject::getGrid().getCellSize(), 16);
+
+		out.clear();
+		gkSteeringObject::getNeighbors(gkVector3(50, -30, 0), 2, out);
+		EXPECT_EQ(out.size(), 1U);
+	}
+
+	// destroyed agents leave the grid
+	EXPECT_EQ(gkSteeringObject::getGrid().getAgentCount(), 0U);
+
+	out.clear();
+	gkSteeringObject::getNeighbors(gkVector3(50, -30, 0), 2, out);
+	EXPECT_TRUE(out.empty());
+}
+
+#endif
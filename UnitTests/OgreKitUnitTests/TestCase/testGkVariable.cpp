@@ -0,0 +1,98 @@
+#include "StdAfx.h"
+
+#define TEST_CASE_NAME testGkVariable
+
+TEST(TEST_CASE_NAME, testTypes)
+{
+	gkVariable var;
+	EXPECT_EQ(var.getType(), gkVariable::VAR_NULL);
+	EXPECT_EQ(var.getValueInt(), 0);
+
+	var.setValue(42);
+	EXPECT_EQ(var.getType(), gkVariable::VAR_INT);
+	EXPECT_EQ(var.getValueInt(), 42);
+	EXPECT_EQ(var.getValueReal(), 42.f);
+	EXPECT_TRUE(var.getValueBool());
+
+	var.setValue(1.5f);
+	EXPECT_EQ(var.getType(), gkVariable::VAR_REAL);
+	EXPECT_EQ(var.getValueReal(), 1.5f);
+	EXPECT_EQ(var.getValueInt(), 1);
+
+	var.setValue(gkVector3(1, 2, 3));
+	EXPECT_EQ(var.getType(), gkVariable::VAR_VEC3);
+	EXPECT_EQ(var.getValueVector3(), gkVector3(1, 2, 3));
+	EXPECT_EQ(var.getValueVector2(), gkVector2(0, 0));
+
+	gkMatrix4 mat(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+	var.setValue(mat);
+	EXPECT_EQ(var.getType(), gkVariable::VAR_MAT4);
+	EXPECT_TRUE(var.getValueMatrix4() == mat);
+
+	var.setValue(gkString("hello"));
+	EXPECT_EQ(var.getType(), gkVariable::VAR_STRING);
+	EXPECT_EQ(var.getValueString(), "hello");
+
+	var.setValue(false);
+	EXPECT_EQ(var.getType(), gkVariable::VAR_BOOL);
+	EXPECT_EQ(var.getValueString(), "false");
+}
+
+TEST(TEST_CASE_NAME, testParse)
+{
+	gkVariable var;
+
+	var.setValue(gkVariable::VAR_INT, "12");
+	EXPECT_EQ(var.getType(), gkVariable::VAR_INT);
+	EXPECT_EQ(var.getValueInt(), 12);
+
+	var.setValue(gkVariable::VAR_VEC2, "1 2");
+	EXPECT_EQ(var.getType(), gkVariable::VAR_VEC2);
+	EXPECT_EQ(var.getValueVector2(), gkVector2(1, 2));
+
+	var.setValue(gkVariable::VAR_STRING, "text");
+	EXPECT_EQ(var.getType(), gkVariable::VAR_STRING);
+	EXPECT_EQ(var.getValueString(), "text");
+}
+
+TEST(TEST_CASE_NAME, testCopy)
+{
+	gkVariable var;
+	var.setValue(gkString("first"));
+	var.makeDefault();
+
+	gkVariable* cl = var.clone();
+	var.setValue(gkString("second"));
+
+	EXPECT_EQ(cl->getValueString(), "first");
+	EXPECT_EQ(var.getValueString(), "second");
+
+	var.setValue(7);
+	var.reset();
+	EXPECT_EQ(var.getType(), gkVariable::VAR_STRING);
+	EXPECT_EQ(var.getValueString(), "first");
+
+	cl->assign(var);
+	var.setValue(3);
+	EXPECT_EQ(cl->getValueString(), "first");
+
+	delete cl;
+}
+
+TEST(TEST_CASE_NAME, testCompare)
+{
+	gkVariable a(5), b(7), c;
+	c.setValue(gkVariable::VAR_INT, "5");
+
+	EXPECT_TRUE(a < b);
+	EXPECT_TRUE(a == c);
+	EXPECT_TRUE(a <= c && a >= c);
+	EXPECT_TRUE(b != c);
+
+	a.add(b);
+	EXPECT_EQ(a.getValueInt(), 12);
+
+	a.setReadOnly(true);
+	a.setValue(1);
+	EXPECT_EQ(a.getValueInt(), 12);
+}
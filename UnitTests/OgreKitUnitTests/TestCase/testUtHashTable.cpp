@@ -66,5 +66,137 @@ TEST(TEST_CASE_NAME, testNestedType)
 	EXPECT_TRUE(section.find("key2") != UT_NPOS);
 	EXPECT_TRUE(group.find("key3") != UT_NPOS);
 
-	//EXPECT_STREQ(group.get("key3")->get("key2")->get("key1")->c_str(), "value1");
+	EXPECT_STREQ(group.get("key3")->get("key2")->get("key1")->c_str(), "value1");
+}
+
+TEST(TEST_CASE_NAME, testRemove)
+{
+	utHashTable<utIntHashKey, int> table1;
+
+	const int count = 1000;
+	for (int i = 0; i < count; i++)
+		table1.insert(i, i);
+
+	for (int i = 0; i < count; i += 2)
+		table1.remove(i);
+
+	EXPECT_EQ(table1.size(), count/2);
+
+	for (int i = 0; i < count; i++)
+	{
+		UTsize pos = table1.find(i);
+		if (i & 1)
+		{
+			ASSERT_TRUE(pos != UT_NPOS);
+			EXPECT_EQ(table1.at(pos), i);
+		}
+		else
+			EXPECT_EQ(pos, UT_NPOS);
+	}
+
+	// removed keys can be added back
+	for (int i = 0; i < count; i += 2)
+		EXPECT_TRUE(table1.insert(i, i));
+	EXPECT_EQ(table1.size(), count);
+}
+
+class testCollidingKey
+{
+public:
+	int m_key;
+
+	testCollidingKey() : m_key(0) {}
+	testCollidingKey(int k) : m_key(k) {}
+
+	UThash hash(void) const { return (UThash)(m_key & 3); }
+
+	bool operator== (const testCollidingKey &v) const {return m_key == v.m_key;}
+	bool operator!= (const testCollidingKey &v) const {return m_key != v.m_key;}
+};
+
+TEST(TEST_CASE_NAME, testKeyEquality)
+{
+	utHashTable<testCollidingKey, int> table1;
+
+	const int count = 100;
+	for (int i = 0; i < count; i++)
+		EXPECT_TRUE(table1.insert(i, i));
+
+	EXPECT_EQ(table1.size(), count);
+	EXPECT_FALSE(table1.insert(5, 0));
+
+	for (int i = 0; i < count; i += 3)
+		table1.remove(i);
+
+	for (int i = 0; i < count; i++)
+	{
+		int* v = table1.get(i);
+		if (i % 3)
+		{
+			ASSERT_TRUE(v != 0);
+			EXPECT_EQ(*v, i);
+		}
+		else
+			EXPECT_TRUE(v == 0);
+	}
+}
+
+TEST(TEST_CASE_NAME, testClearCache)
+{
+	utHashTable<utHashedString, int> table1;
+
+	table1.insert("a", 1);
+	table1.insert("b", 2);
+	UTsize capacity = table1.capacity();
+
+	table1.clear(true);
+	EXPECT_EQ(table1.size(), 0);
+	EXPECT_EQ(table1.capacity(), capacity);
+	EXPECT_EQ(table1.find("a"), UT_NPOS);
+
+	table1.insert("b", 3);
+	ASSERT_TRUE(table1.get("b") != 0);
+	EXPECT_EQ(*table1.get("b"), 3);
+}
+
+TEST(TEST_CASE_NAME, testCopy)
+{
+	utHashTable<utIntHashKey, int> table1;
+
+	const int count = 100;
+	for (int i = 0; i < count; i++)
+		table1.insert(i * 7, i);
+
+	utHashTable<utIntHashKey, int> table2(table1);
+	utHashTable<utIntHashKey, int> table3;
+	table3.insert(-1, -1);
+	table3 = table1;
+
+	for (int i = 0; i < count; i++)
+	{
+		ASSERT_TRUE(table2.get(i * 7) != 0);
+		EXPECT_EQ(*table2.get(i * 7), i);
+		ASSERT_TRUE(table3.get(i * 7) != 0);
+		EXPECT_EQ(*table3.get(i * 7), i);
+	}
+	EXPECT_EQ(table3.find(-1), UT_NPOS);
+}
+
+TEST(TEST_CASE_NAME, testHashSet)
+{
+	int values[64];
+	utHashSet<void*> set1;
+	set1.reserve(64);
+	EXPECT_EQ(set1.capacity(), 64);
+
+	for (int i = 0; i < 64; i++)
+		EXPECT_TRUE(set1.insert(&values[i]));
+	EXPECT_FALSE(set1.insert(&values[0]));
+
+	for (int i = 0; i < 64; i += 2)
+		set1.erase(&values[i]);
+
+	EXPECT_EQ(set1.size(), 32);
+	for (int i = 0; i < 64; i++)
+		EXPECT_EQ(set1.find(&values[i]) != UT_NPOS, (i & 1) != 0);
 }
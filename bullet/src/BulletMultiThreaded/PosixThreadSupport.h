@@ -61,12 +61,17 @@ public:
 
                 pthread_t thread;
                 sem_t* startSemaphore;
+                sem_t* mainSemaphore;   // the owning thread support's
 
         unsigned long threadUsed;
 	};
 private:
 
 	btAlignedObjectArray<btSpuStatus>	m_activeSpuStatus;
+
+	// signals how many threads finished their task, one per instance so
+	// several thread supports (collision, solver, worlds) can coexist
+	sem_t*	m_mainSemaphore;
 public:
 	///Setup and initialize SPU/CELL/Libspe2
 